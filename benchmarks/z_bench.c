@@ -0,0 +1,581 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "zenoh-pico/api/constants.h"
+#include "zenoh-pico/protocol/codec/core.h"
+#include "zenoh-pico/protocol/codec/network.h"
+#include "zenoh-pico/protocol/codec/transport.h"
+#include "zenoh-pico/protocol/definitions/network.h"
+#include "zenoh-pico/protocol/definitions/transport.h"
+#include "zenoh-pico/protocol/iobuf.h"
+#include "zenoh-pico/protocol/keyexpr.h"
+#include "zenoh-pico/system/platform.h"
+#include "zenoh-pico/utils/checksum.h"
+#include "zenoh-pico/utils/result.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#define MIN_DURATION_NS 200000000ULL
+#define MAX_OPS ((size_t)1 << 30)
+#define BUF_SIZE 65535
+
+/*=============================*/
+/*     Allocation counting     */
+/*=============================*/
+// Counts the calls to the system allocator, whichever backend zp_malloc is built with
+static size_t allocs = 0;
+
+#if defined(__GLIBC__)
+#define COUNTS_ALLOCS 1
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void __libc_free(void *ptr);
+
+void *malloc(size_t size) {
+    allocs++;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t nmemb, size_t size) {
+    allocs++;
+    return __libc_calloc(nmemb, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    allocs++;
+    return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr) { __libc_free(ptr); }
+#else
+#define COUNTS_ALLOCS 0
+#endif
+
+/*=============================*/
+/*           Harness           */
+/*=============================*/
+typedef struct {
+    const char *name;
+    void *(*setup)(const void *arg);
+    void (*run)(void *ctx, size_t ops);
+    void (*teardown)(void *ctx);
+    const void *arg;
+} bench_t;
+
+uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+// Doubles the number of operations until a run lasts MIN_DURATION_NS, and reports that run
+void bench_run(const bench_t *b) {
+    void *ctx = b->setup(b->arg);
+    b->run(ctx, 1);  // Warms up the caches and the allocator
+
+    size_t ops = 1;
+    uint64_t elapsed = 0;
+    size_t allocated = 0;
+    while (true) {
+        size_t before = allocs;
+        uint64_t start = now_ns();
+        b->run(ctx, ops);
+        elapsed = now_ns() - start;
+        allocated = allocs - before;
+        if (elapsed >= MIN_DURATION_NS || ops >= MAX_OPS) {
+            break;
+        }
+        ops = ops * 2;
+    }
+    printf("%-36s %12.1f ns/op", b->name, (double)elapsed / (double)ops);
+    if (COUNTS_ALLOCS == 1) {
+        printf(" %10.2f allocs/op", (double)allocated / (double)ops);
+    }
+    printf(" %12zu ops\n", ops);
+    fflush(stdout);
+
+    b->teardown(ctx);
+}
+
+/*=============================*/
+/*            ZInts            */
+/*=============================*/
+#define ZINTS_ENCODED 1024
+
+typedef struct {
+    _z_zint_t value;
+    _z_wbuf_t wbf;
+    _z_zbuf_t zbf;  // ZINTS_ENCODED times the value
+} zint_ctx_t;
+
+void *zint_setup(const void *arg) {
+    zint_ctx_t *ctx = (zint_ctx_t *)zp_malloc(sizeof(zint_ctx_t));
+    ctx->value = *(const _z_zint_t *)arg;
+    ctx->wbf = _z_wbuf_make(BUF_SIZE, false);
+    for (size_t i = 0; i < ZINTS_ENCODED; i++) {
+        assert(_z_zint_encode(&ctx->wbf, ctx->value) == _Z_RES_OK);
+    }
+    ctx->zbf = _z_wbuf_to_zbuf(&ctx->wbf);
+    _z_wbuf_reset(&ctx->wbf);
+    return ctx;
+}
+
+void zint_encode_run(void *arg, size_t ops) {
+    zint_ctx_t *ctx = (zint_ctx_t *)arg;
+    for (size_t i = 0; i < ops; i++) {
+        if (_z_wbuf_space_left(&ctx->wbf) < (size_t)16) {
+            _z_wbuf_reset(&ctx->wbf);
+        }
+        (void)_z_zint_encode(&ctx->wbf, ctx->value);
+    }
+}
+
+void zint_decode_run(void *arg, size_t ops) {
+    zint_ctx_t *ctx = (zint_ctx_t *)arg;
+    _z_zint_t value = 0;
+    for (size_t i = 0; i < ops; i++) {
+        if (_z_zbuf_can_read(&ctx->zbf) == false) {
+            _z_zbuf_set_rpos(&ctx->zbf, 0);
+        }
+        (void)_z_zint_decode(&value, &ctx->zbf);
+    }
+    assert(value == ctx->value);
+}
+
+void zint_teardown(void *arg) {
+    zint_ctx_t *ctx = (zint_ctx_t *)arg;
+    _z_wbuf_clear(&ctx->wbf);
+    _z_zbuf_clear(&ctx->zbf);
+    zp_free(ctx);
+}
+
+static const _z_zint_t zint_1b = 0x7f;
+static const _z_zint_t zint_2b = 0x3fff;
+static const _z_zint_t zint_4b = 0xfffffff;
+static const _z_zint_t zint_max = UINT64_MAX;
+
+/*=============================*/
+/*      Network messages       */
+/*=============================*/
+static const char *key = "demo/example/zenoh-pico/bench";
+static uint8_t payload[1024];
+
+typedef struct {
+    _z_network_message_t msg;
+    _z_wbuf_t wbf;
+    _z_zbuf_t zbf;  // The encoded message
+} n_msg_ctx_t;
+
+typedef struct {
+    int tag;
+    size_t payload_len;
+} n_msg_arg_t;
+
+// Makes a message of the common shape of its kind, aliasing key and payload
+_z_network_message_t make_n_msg(int tag, size_t payload_len) {
+    _z_network_message_t msg;
+    _z_keyexpr_t ke = _z_rname(key);
+    _z_value_t value = {.payload = _z_bytes_wrap(payload, payload_len),
+                        .encoding = {.prefix = Z_ENCODING_PREFIX_APP_OCTET_STREAM, .suffix = _z_bytes_empty()}};
+    if (tag == _Z_N_PUSH) {
+        _z_m_push_commons_t commons = {._timestamp = _z_timestamp_null(), ._source_info = _z_source_info_null()};
+        _z_push_body_t body = {
+            ._is_put = true,
+            ._body._put = {._commons = commons, ._payload = value.payload, ._encoding = value.encoding},
+        };
+        msg = _z_n_msg_make_push(&ke, &body);
+    } else if (tag == _Z_N_REQUEST) {
+        _z_bytes_t params = _z_bytes_wrap((const uint8_t *)"time=[now(-1h)..]", 17);
+        msg = _z_msg_make_query(&ke, &params, 42, Z_CONSOLIDATION_MODE_AUTO, &value
+#if Z_FEATURE_ATTACHMENT == 1
+                                ,
+                                z_attachment_null()
+#endif
+        );
+    } else {
+        msg = _z_n_msg_make_reply(42, &ke, &value);
+    }
+    return msg;
+}
+
+void *n_msg_setup(const void *arg) {
+    const n_msg_arg_t *a = (const n_msg_arg_t *)arg;
+    n_msg_ctx_t *ctx = (n_msg_ctx_t *)zp_malloc(sizeof(n_msg_ctx_t));
+    ctx->msg = make_n_msg(a->tag, a->payload_len);
+    ctx->wbf = _z_wbuf_make(BUF_SIZE, false);
+    assert(_z_network_message_encode(&ctx->wbf, &ctx->msg) == _Z_RES_OK);
+    ctx->zbf = _z_wbuf_to_zbuf(&ctx->wbf);
+    _z_wbuf_reset(&ctx->wbf);
+    return ctx;
+}
+
+void n_msg_encode_run(void *arg, size_t ops) {
+    n_msg_ctx_t *ctx = (n_msg_ctx_t *)arg;
+    for (size_t i = 0; i < ops; i++) {
+        _z_wbuf_reset(&ctx->wbf);
+        (void)_z_network_message_encode(&ctx->wbf, &ctx->msg);
+    }
+}
+
+void n_msg_decode_run(void *arg, size_t ops) {
+    n_msg_ctx_t *ctx = (n_msg_ctx_t *)arg;
+    for (size_t i = 0; i < ops; i++) {
+        _z_zbuf_set_rpos(&ctx->zbf, 0);
+        _z_network_message_t msg;
+        assert(_z_network_message_decode(&msg, &ctx->zbf) == _Z_RES_OK);
+        _z_n_msg_clear(&msg);
+    }
+}
+
+void n_msg_teardown(void *arg) {
+    n_msg_ctx_t *ctx = (n_msg_ctx_t *)arg;
+    _z_n_msg_clear(&ctx->msg);
+    _z_wbuf_clear(&ctx->wbf);
+    _z_zbuf_clear(&ctx->zbf);
+    zp_free(ctx);
+}
+
+static const n_msg_arg_t push_8b = {.tag = _Z_N_PUSH, .payload_len = 8};
+static const n_msg_arg_t push_1kb = {.tag = _Z_N_PUSH, .payload_len = 1024};
+static const n_msg_arg_t request_0b = {.tag = _Z_N_REQUEST, .payload_len = 0};
+static const n_msg_arg_t response_8b = {.tag = _Z_N_RESPONSE, .payload_len = 8};
+static const n_msg_arg_t response_1kb = {.tag = _Z_N_RESPONSE, .payload_len = 1024};
+
+/*=============================*/
+/*           Frames            */
+/*=============================*/
+typedef struct {
+    uint8_t header;
+    _z_zbuf_t zbf;  // The encoded frame, without its header
+} frame_ctx_t;
+
+// Encodes a frame of n pushes of 8 bytes
+void *frame_setup(const void *arg) {
+    size_t n = *(const size_t *)arg;
+    frame_ctx_t *ctx = (frame_ctx_t *)zp_malloc(sizeof(frame_ctx_t));
+    _z_network_message_vec_t msgs = _z_network_message_vec_make(n);
+    for (size_t i = 0; i < n; i++) {
+        _z_network_message_t *msg = (_z_network_message_t *)zp_malloc(sizeof(_z_network_message_t));
+        *msg = make_n_msg(_Z_N_PUSH, 8);
+        _z_network_message_vec_append(&msgs, msg);
+    }
+    _z_transport_message_t frame = _z_t_msg_make_frame(1234, msgs, true);
+    _z_wbuf_t wbf = _z_wbuf_make(BUF_SIZE, false);
+    assert(_z_frame_encode(&wbf, frame._header, &frame._body._frame) == _Z_RES_OK);
+    ctx->header = frame._header;
+    ctx->zbf = _z_wbuf_to_zbuf(&wbf);
+    _z_wbuf_clear(&wbf);
+    _z_t_msg_clear(&frame);
+    return ctx;
+}
+
+void frame_decode_run(void *arg, size_t ops) {
+    frame_ctx_t *ctx = (frame_ctx_t *)arg;
+    for (size_t i = 0; i < ops; i++) {
+        _z_zbuf_set_rpos(&ctx->zbf, 0);
+        _z_t_msg_frame_t frame;
+        assert(_z_frame_decode(&frame, &ctx->zbf, ctx->header) == _Z_RES_OK);
+        _z_t_msg_frame_clear(&frame);
+    }
+}
+
+void frame_decode_stream_run(void *arg, size_t ops) {
+    frame_ctx_t *ctx = (frame_ctx_t *)arg;
+    for (size_t i = 0; i < ops; i++) {
+        _z_zbuf_set_rpos(&ctx->zbf, 0);
+        _z_t_msg_frame_t frame;
+        assert(_z_frame_decode_stream(&frame, &ctx->zbf, ctx->header) == _Z_RES_OK);
+        _z_network_message_t msg;
+        int8_t ret = _Z_RES_OK;
+        while (_z_frame_next(&frame, &msg, &ret) == true) {
+            _z_n_msg_clear(&msg);
+        }
+        assert(ret == _Z_RES_OK);
+        _z_t_msg_frame_clear(&frame);
+    }
+}
+
+void frame_teardown(void *arg) {
+    frame_ctx_t *ctx = (frame_ctx_t *)arg;
+    _z_zbuf_clear(&ctx->zbf);
+    zp_free(ctx);
+}
+
+static const size_t frame_1 = 1;
+static const size_t frame_16 = 16;
+static const size_t frame_64 = 64;
+
+/*=============================*/
+/*          IO buffers         */
+/*=============================*/
+typedef struct {
+    size_t len;
+    _z_wbuf_t wbf;
+    _z_zbuf_t zbf;
+} iobuf_ctx_t;
+
+void *iobuf_setup(const void *arg) {
+    iobuf_ctx_t *ctx = (iobuf_ctx_t *)zp_malloc(sizeof(iobuf_ctx_t));
+    ctx->len = *(const size_t *)arg;
+    ctx->wbf = _z_wbuf_make(BUF_SIZE, false);
+    ctx->zbf = _z_zbuf_make(BUF_SIZE);
+    _z_zbuf_set_wpos(&ctx->zbf, BUF_SIZE);
+    return ctx;
+}
+
+void wbuf_write_bytes_run(void *arg, size_t ops) {
+    iobuf_ctx_t *ctx = (iobuf_ctx_t *)arg;
+    for (size_t i = 0; i < ops; i++) {
+        if (_z_wbuf_space_left(&ctx->wbf) < ctx->len) {
+            _z_wbuf_reset(&ctx->wbf);
+        }
+        (void)_z_wbuf_write_bytes(&ctx->wbf, payload, 0, ctx->len);
+    }
+}
+
+void zbuf_read_bytes_run(void *arg, size_t ops) {
+    iobuf_ctx_t *ctx = (iobuf_ctx_t *)arg;
+    uint8_t dest[1024];
+    for (size_t i = 0; i < ops; i++) {
+        if (_z_zbuf_len(&ctx->zbf) < ctx->len) {
+            _z_zbuf_set_rpos(&ctx->zbf, 0);
+        }
+        _z_zbuf_read_bytes(&ctx->zbf, dest, 0, ctx->len);
+    }
+}
+
+void iobuf_teardown(void *arg) {
+    iobuf_ctx_t *ctx = (iobuf_ctx_t *)arg;
+    _z_wbuf_clear(&ctx->wbf);
+    _z_zbuf_clear(&ctx->zbf);
+    zp_free(ctx);
+}
+
+static const size_t bytes_8 = 8;
+static const size_t bytes_64 = 64;
+static const size_t bytes_1024 = 1024;
+
+/*=============================*/
+/*            CRC32            */
+/*=============================*/
+typedef struct {
+    size_t len;
+    uint8_t *buf;
+    volatile uint32_t sink;
+} crc_ctx_t;
+
+// The bit-at-a-time implementation _z_crc32 used to be, as a baseline for the table and folding kernels
+uint32_t crc32_bitwise(const uint8_t *message, size_t len) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc = crc ^ (uint32_t)message[i];
+        for (uint8_t j = 0; j < (uint8_t)8; j++) {
+            crc = (crc >> 1) ^ ((uint32_t)0x04C11DB7 & (uint32_t)(-(int32_t)(crc & (uint32_t)1)));
+        }
+    }
+    return ~crc;
+}
+
+void *crc_setup(const void *arg) {
+    crc_ctx_t *ctx = (crc_ctx_t *)zp_malloc(sizeof(crc_ctx_t));
+    ctx->len = *(const size_t *)arg;
+    ctx->buf = (uint8_t *)zp_malloc(ctx->len);
+    for (size_t i = 0; i < ctx->len; i++) {
+        ctx->buf[i] = (uint8_t)(i * 31);
+    }
+    assert(_z_crc32(ctx->buf, ctx->len) == crc32_bitwise(ctx->buf, ctx->len));
+    return ctx;
+}
+
+void crc_run(void *arg, size_t ops) {
+    crc_ctx_t *ctx = (crc_ctx_t *)arg;
+    for (size_t i = 0; i < ops; i++) {
+        ctx->sink = _z_crc32(ctx->buf, ctx->len);
+    }
+}
+
+void crc_bitwise_run(void *arg, size_t ops) {
+    crc_ctx_t *ctx = (crc_ctx_t *)arg;
+    for (size_t i = 0; i < ops; i++) {
+        ctx->sink = crc32_bitwise(ctx->buf, ctx->len);
+    }
+}
+
+void crc_teardown(void *arg) {
+    crc_ctx_t *ctx = (crc_ctx_t *)arg;
+    zp_free(ctx->buf);
+    zp_free(ctx);
+}
+
+static const size_t bytes_64k = 65536;
+
+/*=============================*/
+/*       Key expressions       */
+/*=============================*/
+typedef struct {
+    const char *left;
+    const char *right;
+} ke_pair_t;
+
+void *ke_setup(const void *arg) { return (void *)arg; }
+
+void ke_intersects_run(void *arg, size_t ops) {
+    const ke_pair_t *p = (const ke_pair_t *)arg;
+    size_t llen = strlen(p->left);
+    size_t rlen = strlen(p->right);
+    for (size_t i = 0; i < ops; i++) {
+        assert(_z_keyexpr_intersects(p->left, llen, p->right, rlen) == true);
+    }
+}
+
+void ke_includes_run(void *arg, size_t ops) {
+    const ke_pair_t *p = (const ke_pair_t *)arg;
+    size_t llen = strlen(p->left);
+    size_t rlen = strlen(p->right);
+    for (size_t i = 0; i < ops; i++) {
+        assert(_z_keyexpr_includes(p->left, llen, p->right, rlen) == true);
+    }
+}
+
+// Canonizes a copy of the left key expression, as the canonization is in place
+void ke_canonize_run(void *arg, size_t ops) {
+    const ke_pair_t *p = (const ke_pair_t *)arg;
+    size_t len = strlen(p->left);
+    char buf[256];
+    for (size_t i = 0; i < ops; i++) {
+        memcpy(buf, p->left, len);
+        size_t canon_len = len;
+        assert(_z_keyexpr_canonize(buf, &canon_len) == Z_KEYEXPR_CANON_SUCCESS);
+    }
+}
+
+void ke_teardown(void *arg) { (void)arg; }
+
+typedef struct {
+    _z_keyexpr_compiled_t left;
+    const char *right;
+} ke_compiled_ctx_t;
+
+void *ke_compiled_setup(const void *arg) {
+    const ke_pair_t *p = (const ke_pair_t *)arg;
+    ke_compiled_ctx_t *ctx = (ke_compiled_ctx_t *)malloc(sizeof(ke_compiled_ctx_t));
+    int8_t res = _z_keyexpr_compile(&ctx->left, p->left, strlen(p->left));
+    assert(res == _Z_RES_OK);
+    (void)res;
+    ctx->right = p->right;
+    return ctx;
+}
+
+void ke_compiled_intersects_run(void *arg, size_t ops) {
+    const ke_compiled_ctx_t *ctx = (const ke_compiled_ctx_t *)arg;
+    size_t rlen = strlen(ctx->right);
+    for (size_t i = 0; i < ops; i++) {
+        assert(_z_keyexpr_compiled_intersects(&ctx->left, ctx->right, rlen) == true);
+    }
+}
+
+void ke_compiled_teardown(void *arg) {
+    ke_compiled_ctx_t *ctx = (ke_compiled_ctx_t *)arg;
+    _z_keyexpr_compiled_clear(&ctx->left);
+    free(ctx);
+}
+
+static const ke_pair_t ke_exact = {"demo/example/zenoh-pico/bench", "demo/example/zenoh-pico/bench"};
+static const ke_pair_t ke_star = {"demo/*/zenoh-pico/*", "demo/example/zenoh-pico/bench"};
+static const ke_pair_t ke_double_star = {"demo/**/bench", "demo/example/zenoh-pico/bench"};
+static const ke_pair_t ke_dsl = {"demo/ex$*/zenoh-$*/bench", "demo/example/zenoh-pico/bench"};
+static const ke_pair_t ke_long = {"a/b/c/d/e/f/g/h/i/j/k/l/m/n/o/p/**", "a/b/c/d/e/f/g/h/i/j/k/l/m/n/o/p/q/r/s/t"};
+static const ke_pair_t ke_canon = {"demo/example/zenoh-pico/bench", NULL};
+static const ke_pair_t ke_not_canon = {"demo/**/**/*/**/bench", NULL};
+
+/*=============================*/
+/*           Suite             */
+/*=============================*/
+#define ZINT_BENCHES(size, v)                                                      \
+    {"zint/encode/" size, zint_setup, zint_encode_run, zint_teardown, &(v)}, \
+        {"zint/decode/" size, zint_setup, zint_decode_run, zint_teardown, &(v)}
+#define N_MSG_BENCHES(kind, a)                                                    \
+    {"n_msg/encode/" kind, n_msg_setup, n_msg_encode_run, n_msg_teardown, &(a)}, \
+        {"n_msg/decode/" kind, n_msg_setup, n_msg_decode_run, n_msg_teardown, &(a)}
+#define FRAME_BENCHES(n, a)                                                    \
+    {"frame/decode/" n, frame_setup, frame_decode_run, frame_teardown, &(a)}, \
+        {"frame/decode_stream/" n, frame_setup, frame_decode_stream_run, frame_teardown, &(a)}
+#define IOBUF_BENCHES(n, a)                                                            \
+    {"wbuf/write_bytes/" n, iobuf_setup, wbuf_write_bytes_run, iobuf_teardown, &(a)}, \
+        {"zbuf/read_bytes/" n, iobuf_setup, zbuf_read_bytes_run, iobuf_teardown, &(a)}
+#define CRC_BENCHES(n, a)                                                 \
+    {"crc32/bitwise/" n, crc_setup, crc_bitwise_run, crc_teardown, &(a)}, \
+        {"crc32/z_crc32/" n, crc_setup, crc_run, crc_teardown, &(a)}
+#define KE_BENCHES(shape, a)                                                                                   \
+    {"keyexpr/intersects/" shape, ke_setup, ke_intersects_run, ke_teardown, &(a)},                             \
+        {"keyexpr/includes/" shape, ke_setup, ke_includes_run, ke_teardown, &(a)},                             \
+        {"keyexpr/compiled/" shape, ke_compiled_setup, ke_compiled_intersects_run, ke_compiled_teardown, &(a)}
+
+static const bench_t benches[] = {
+    ZINT_BENCHES("1B", zint_1b),
+    ZINT_BENCHES("2B", zint_2b),
+    ZINT_BENCHES("4B", zint_4b),
+    ZINT_BENCHES("10B", zint_max),
+    N_MSG_BENCHES("push/8B", push_8b),
+    N_MSG_BENCHES("push/1KB", push_1kb),
+    N_MSG_BENCHES("request/query", request_0b),
+    N_MSG_BENCHES("response/reply/8B", response_8b),
+    N_MSG_BENCHES("response/reply/1KB", response_1kb),
+    FRAME_BENCHES("1msg", frame_1),
+    FRAME_BENCHES("16msgs", frame_16),
+    FRAME_BENCHES("64msgs", frame_64),
+    IOBUF_BENCHES("8B", bytes_8),
+    IOBUF_BENCHES("64B", bytes_64),
+    IOBUF_BENCHES("1KB", bytes_1024),
+    CRC_BENCHES("8B", bytes_8),
+    CRC_BENCHES("64B", bytes_64),
+    CRC_BENCHES("1KB", bytes_1024),
+    CRC_BENCHES("64KB", bytes_64k),
+    KE_BENCHES("exact", ke_exact),
+    KE_BENCHES("star", ke_star),
+    KE_BENCHES("double_star", ke_double_star),
+    KE_BENCHES("dsl", ke_dsl),
+    KE_BENCHES("long", ke_long),
+    {"keyexpr/canonize/canon", ke_setup, ke_canonize_run, ke_teardown, &ke_canon},
+    {"keyexpr/canonize/not_canon", ke_setup, ke_canonize_run, ke_teardown, &ke_not_canon},
+};
+
+int main(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "-h") == 0) {
+        printf("USAGE: ./z_bench [filter]\n");
+        printf("  Runs the micro-benchmarks whose name contains the filter, or all of them\n");
+        printf("  Build with CMAKE_BUILD_TYPE=Release for meaningful results\n");
+        return 0;
+    }
+    const char *filter = (argc > 1) ? argv[1] : "";
+
+    for (size_t i = 0; i < sizeof(payload); i++) {
+        payload[i] = (uint8_t)i;
+    }
+    for (size_t i = 0; i < sizeof(benches) / sizeof(benches[0]); i++) {
+        if (strstr(benches[i].name, filter) != NULL) {
+            bench_run(&benches[i]);
+        }
+    }
+    return 0;
+}
@@ -23,27 +23,261 @@
 
 #if Z_FEATURE_SUBSCRIPTION == 1 && Z_FEATURE_PUBLICATION == 1 && Z_FEATURE_MULTI_THREAD == 1
 
-#define DEFAULT_PKT_SIZE 8
+#define DEFAULT_PKT_SIZE "8"
 #define DEFAULT_PING_NB 100
 #define DEFAULT_WARMUP_MS 1000
+#define DEFAULT_RATE 0
+#define DEFAULT_TIMEOUT_MS 1000
+#define POLL_US 10
+#define DEFAULT_FORMAT "csv"
+#define MAX_SIZES 32
+// Each ping starts with the id of its run and its sequence number in the run, repeated by the pong
+#define HEADER_SIZE (2 * sizeof(uint32_t))
 
-static zp_condvar_t cond;
-static zp_mutex_t mutex;
+/*------------------ Histogram ------------------*/
+// A log-linear histogram in the fashion of HdrHistogram: each power of two is split in HIST_SUB_COUNT buckets,
+// so that a recorded value is off by less than 1 / HIST_SUB_COUNT of itself.
+#define HIST_SUB_BITS 7
+#define HIST_SUB_COUNT ((uint64_t)1 << HIST_SUB_BITS)
+#define HIST_MAX_SHIFT 30
+#define HIST_LEN ((HIST_MAX_SHIFT + 2) * HIST_SUB_COUNT)
+#define HIST_MAX_VALUE ((HIST_SUB_COUNT << (HIST_MAX_SHIFT + 1)) - 1)
+
+typedef struct {
+    uint64_t counts[HIST_LEN];
+    uint64_t total;
+    uint64_t min;
+    uint64_t max;
+    double sum;
+} histogram_t;
+
+void hist_reset(histogram_t* h) {
+    memset(h, 0, sizeof(histogram_t));
+    h->min = HIST_MAX_VALUE;
+}
+
+size_t hist_index(uint64_t value) {
+    size_t idx = (size_t)value;
+    if (value >= HIST_SUB_COUNT) {
+        size_t shift = 0;
+        while ((value >> shift) >= (HIST_SUB_COUNT << 1)) {
+            shift++;
+        }
+        idx = ((shift + 1) << HIST_SUB_BITS) + (size_t)((value >> shift) - HIST_SUB_COUNT);
+    }
+    return idx;
+}
+
+// The highest value counted in the bucket idx
+uint64_t hist_value(size_t idx) {
+    uint64_t value = idx;
+    if (idx >= HIST_SUB_COUNT) {
+        size_t shift = (idx >> HIST_SUB_BITS) - 1;
+        value = ((((uint64_t)idx & (HIST_SUB_COUNT - 1)) + HIST_SUB_COUNT) << shift) + (((uint64_t)1 << shift) - 1);
+    }
+    return value;
+}
+
+void hist_record(histogram_t* h, uint64_t value) {
+    if (value > HIST_MAX_VALUE) {
+        value = HIST_MAX_VALUE;
+    }
+    h->counts[hist_index(value)]++;
+    h->total++;
+    h->sum += (double)value;
+    if (value < h->min) {
+        h->min = value;
+    }
+    if (value > h->max) {
+        h->max = value;
+    }
+}
+
+uint64_t hist_percentile(const histogram_t* h, double percentile) {
+    uint64_t value = 0;
+    if (h->total > 0) {
+        uint64_t rank = (uint64_t)((percentile / 100.0) * (double)h->total + 0.5);
+        if (rank < 1) {
+            rank = 1;
+        }
+        uint64_t seen = 0;
+        for (size_t idx = 0; idx < HIST_LEN; idx++) {
+            seen += h->counts[idx];
+            if (seen >= rank) {
+                value = hist_value(idx);
+                break;
+            }
+        }
+        if (value > h->max) {
+            value = h->max;
+        }
+    }
+    return value;
+}
+
+/*------------------ Pings ------------------*/
+// Shared with the subscriber callback, under the mutex
+static struct {
+    zp_mutex_t mutex;
+    uint32_t run;                // The replies to the pings of other runs are ignored
+    uint32_t sent;               // The pings of the run sent so far
+    uint32_t received;           // The pongs of the run received so far
+    unsigned int rate;           // The pings per second, or 0 to send the next ping once the previous one is answered
+    unsigned long start_us;      // When the first ping of a fixed-rate run was due
+    unsigned long last_sent_us;  // When the last ping of a closed-loop run was sent
+    histogram_t hist;            // The round-trip times of the run, in µs
+} state;
+static zp_clock_t origin;
+
+unsigned long now_us(void) { return zp_clock_elapsed_us(&origin); }
+
+// When the ping seq was meant to be sent: measuring from there, rather than from the actual send time, keeps the
+// delays of a stalled sender in the results instead of omitting them
+unsigned long intended_us(uint32_t seq) {
+    unsigned long t = state.last_sent_us;
+    if (state.rate > 0) {
+        t = state.start_us + (unsigned long)(((uint64_t)seq * 1000000) / state.rate);
+    }
+    return t;
+}
 
 void callback(const z_sample_t* sample, void* context) {
-    (void)sample;
     (void)context;
-    zp_condvar_signal(&cond);
+    unsigned long now = now_us();
+    if (sample->payload.len >= HEADER_SIZE) {
+        uint32_t run, seq;
+        memcpy(&run, sample->payload.start, sizeof(uint32_t));
+        memcpy(&seq, sample->payload.start + sizeof(uint32_t), sizeof(uint32_t));
+        zp_mutex_lock(&state.mutex);
+        // A closed-loop run only waits for the pong of its last ping
+        if (run == state.run && seq < state.sent && (state.rate > 0 || seq + 1 == state.sent)) {
+            unsigned long sent = intended_us(seq);
+            hist_record(&state.hist, now > sent ? now - sent : 0);
+            state.received++;
+        }
+        zp_mutex_unlock(&state.mutex);
+    }
 }
-void drop(void* context) {
-    (void)context;
-    zp_condvar_free(&cond);
+void drop(void* context) { (void)context; }
+
+void ping(z_publisher_t pub, uint8_t* data, unsigned int size, uint32_t seq) {
+    memcpy(data, &state.run, sizeof(uint32_t));
+    memcpy(data + sizeof(uint32_t), &seq, sizeof(uint32_t));
+    z_publisher_put(pub, data, size, NULL);
+}
+
+// Waits, with the mutex locked, until count pongs are received or DEFAULT_TIMEOUT_MS elapsed
+void wait_pongs(uint32_t count) {
+    zp_clock_t start = zp_clock_now();
+    while (state.received < count && zp_clock_elapsed_ms(&start) < DEFAULT_TIMEOUT_MS) {
+        zp_mutex_unlock(&state.mutex);
+        zp_sleep_us(POLL_US);
+        zp_mutex_lock(&state.mutex);
+    }
+}
+
+// Sends count pings, or as many as fit in duration_us if count is 0, and collects their round-trip times
+void run_pings(z_publisher_t pub, uint8_t* data, unsigned int size, unsigned int rate, unsigned int count,
+               unsigned long duration_us, histogram_t* hist, uint32_t* sent) {
+    zp_mutex_lock(&state.mutex);
+    state.run++;
+    state.sent = 0;
+    state.received = 0;
+    state.rate = rate;
+    state.start_us = now_us();
+    hist_reset(&state.hist);
+    unsigned long start = state.start_us;
+    if (rate == 0) {
+        // Closed loop: the mutex is only released while waiting for the pong, a lost ping times out
+        for (uint32_t seq = 0; (count > 0) ? (seq < count) : (now_us() - start < duration_us); seq++) {
+            uint32_t received = state.received;
+            state.last_sent_us = now_us();
+            state.sent = seq + 1;
+            ping(pub, data, size, seq);
+            wait_pongs(received + 1);
+        }
+    } else {
+        // Open loop: the pings are sent on schedule, whether or not the previous ones are answered
+        zp_mutex_unlock(&state.mutex);
+        for (uint32_t seq = 0; (count > 0) ? (seq < count) : (now_us() - start < duration_us); seq++) {
+            unsigned long due = start + (unsigned long)(((uint64_t)seq * 1000000) / rate);
+            unsigned long now = now_us();
+            while (now < due) {
+                if (due - now > 1000) {
+                    zp_sleep_us(due - now - 500);
+                }
+                now = now_us();
+            }
+            zp_mutex_lock(&state.mutex);
+            state.sent = seq + 1;
+            zp_mutex_unlock(&state.mutex);
+            ping(pub, data, size, seq);
+        }
+        zp_mutex_lock(&state.mutex);
+        wait_pongs(state.sent);
+    }
+    *sent = state.sent;
+    memcpy(hist, &state.hist, sizeof(histogram_t));
+    // Late pongs no longer match the run
+    state.run++;
+    zp_mutex_unlock(&state.mutex);
+}
+
+/*------------------ Report ------------------*/
+static const double percentiles[] = {50.0, 90.0, 99.0, 99.9};
+static const char* percentile_names[] = {"p50", "p90", "p99", "p99_9"};
+#define PERCENTILES (sizeof(percentiles) / sizeof(percentiles[0]))
+
+void print_header(const char* format) {
+    if (strcmp(format, "csv") == 0) {
+        printf("size,rate,sent,received,min_us,mean_us");
+        for (size_t i = 0; i < PERCENTILES; i++) {
+            printf(",%s_us", percentile_names[i]);
+        }
+        printf(",max_us\n");
+    } else {
+        printf("[");
+    }
+}
+
+void print_result(const char* format, int first, unsigned int size, unsigned int rate, uint32_t sent,
+                  const histogram_t* h) {
+    unsigned long long min = h->total > 0 ? (unsigned long long)h->min : 0;
+    double mean = h->total > 0 ? h->sum / (double)h->total : 0.0;
+    if (strcmp(format, "csv") == 0) {
+        printf("%u,%u,%u,%llu,%llu,%.1f", size, rate, sent, (unsigned long long)h->total, min, mean);
+        for (size_t i = 0; i < PERCENTILES; i++) {
+            printf(",%llu", (unsigned long long)hist_percentile(h, percentiles[i]));
+        }
+        printf(",%llu\n", (unsigned long long)h->max);
+    } else {
+        printf("%s\n  {\"size\": %u, \"rate\": %u, \"sent\": %u, \"received\": %llu", first ? "" : ",", size, rate,
+               sent, (unsigned long long)h->total);
+        printf(", \"min_us\": %llu, \"mean_us\": %.1f", min, mean);
+        for (size_t i = 0; i < PERCENTILES; i++) {
+            printf(", \"%s_us\": %llu", percentile_names[i], (unsigned long long)hist_percentile(h, percentiles[i]));
+        }
+        printf(", \"max_us\": %llu}", (unsigned long long)h->max);
+    }
+    fflush(stdout);
+}
+
+void print_footer(const char* format) {
+    if (strcmp(format, "json") == 0) {
+        printf("\n]\n");
+    }
 }
 
 struct args_t {
-    unsigned int size;             // -s
+    unsigned int sizes[MAX_SIZES];  // -s
+    unsigned int number_of_sizes;
     unsigned int number_of_pings;  // -n
     unsigned int warmup_ms;        // -w
+    unsigned int rate;             // -r
+    const char* format;            // -o
+    const char* mode;              // -m
+    const char* clocator;          // -e
+    const char* llocator;          // -l
     uint8_t help_requested;        // -h
 };
 struct args_t parse_args(int argc, char** argv);
@@ -53,17 +287,37 @@ int main(int argc, char** argv) {
     if (args.help_requested) {
         printf(
             "\
-		-n (optional, int, default=%d): the number of pings to be attempted\n\
-		-s (optional, int, default=%d): the size of the payload embedded in the ping and repeated by the pong\n\
-		-w (optional, int, default=%d): the warmup time in ms during which pings will be emitted but not measured\n\
-		-c (optional, string): the path to a configuration file for the session. If this option isn't passed, the default configuration will be used.\n\
+		-s (optional, int list, default=%s): the comma separated sizes of the payload embedded in the ping and repeated by the pong, at least %u bytes\n\
+		-n (optional, int, default=%d): the number of pings to be measured for each size\n\
+		-w (optional, int, default=%d): the warmup time in ms during which pings will be emitted but not measured, for each size\n\
+		-r (optional, int, default=%d): the pings per second, sent on schedule whether or not the previous ones are answered. If 0, each ping is sent once the previous one is answered\n\
+		-o (optional, csv|json, default=%s): the format of the round-trip time percentiles printed for each size\n\
+		-m (optional, client|peer, default=client): the mode of the session\n\
+		-e (optional, string): the locator to connect to\n\
+		-l (optional, string): the locator to listen on\n\
 		",
-            DEFAULT_PKT_SIZE, DEFAULT_PING_NB, DEFAULT_WARMUP_MS);
+            DEFAULT_PKT_SIZE, (unsigned int)HEADER_SIZE, DEFAULT_PING_NB, DEFAULT_WARMUP_MS, DEFAULT_RATE,
+            DEFAULT_FORMAT);
         return 1;
     }
-    zp_mutex_init(&mutex);
-    zp_condvar_init(&cond);
+    if (args.number_of_sizes == 0) {
+        printf("Payload sizes must be at least %u bytes\n", (unsigned int)HEADER_SIZE);
+        return -1;
+    }
+    if (strcmp(args.format, "csv") != 0 && strcmp(args.format, "json") != 0) {
+        printf("Unknown output format: %s\n", args.format);
+        return -1;
+    }
+    origin = zp_clock_now();
+    zp_mutex_init(&state.mutex);
     z_owned_config_t config = z_config_default();
+    zp_config_insert(z_loan(config), Z_CONFIG_MODE_KEY, z_string_make(args.mode));
+    if (args.clocator != NULL) {
+        zp_config_insert(z_loan(config), Z_CONFIG_CONNECT_KEY, z_string_make(args.clocator));
+    }
+    if (args.llocator != NULL) {
+        zp_config_insert(z_loan(config), Z_CONFIG_LISTEN_KEY, z_string_make(args.llocator));
+    }
     z_owned_session_t session = z_open(z_move(config));
     if (!z_check(session)) {
         printf("Unable to open session!\n");
@@ -92,33 +346,33 @@ int main(int argc, char** argv) {
         return -1;
     }
 
-    uint8_t* data = zp_malloc(args.size);
-    for (unsigned int i = 0; i < args.size; i++) {
-        data[i] = (uint8_t)(i % 10);
-    }
-    zp_mutex_lock(&mutex);
-    if (args.warmup_ms) {
-        printf("Warming up for %dms...\n", args.warmup_ms);
-        zp_clock_t warmup_start = zp_clock_now();
-        unsigned long elapsed_us = 0;
-        while (elapsed_us < args.warmup_ms * 1000) {
-            z_publisher_put(z_loan(pub), data, args.size, NULL);
-            zp_condvar_wait(&cond, &mutex);
-            elapsed_us = zp_clock_elapsed_us(&warmup_start);
+    unsigned int max_size = 0;
+    for (unsigned int i = 0; i < args.number_of_sizes; i++) {
+        if (args.sizes[i] > max_size) {
+            max_size = args.sizes[i];
         }
     }
-    unsigned long* results = zp_malloc(sizeof(unsigned long) * args.number_of_pings);
-    for (unsigned int i = 0; i < args.number_of_pings; i++) {
-        zp_clock_t measure_start = zp_clock_now();
-        z_publisher_put(z_loan(pub), data, args.size, NULL);
-        zp_condvar_wait(&cond, &mutex);
-        results[i] = zp_clock_elapsed_us(&measure_start);
+    uint8_t* data = zp_malloc(max_size);
+    for (unsigned int i = 0; i < max_size; i++) {
+        data[i] = (uint8_t)(i % 10);
     }
-    for (unsigned int i = 0; i < args.number_of_pings; i++) {
-        printf("%d bytes: seq=%d rtt=%luµs, lat=%luµs\n", args.size, i, results[i], results[i] / 2);
+    histogram_t* hist = zp_malloc(sizeof(histogram_t));
+    uint32_t sent = 0;
+
+    print_header(args.format);
+    for (unsigned int i = 0; i < args.number_of_sizes; i++) {
+        unsigned int size = args.sizes[i];
+        if (args.warmup_ms) {
+            fprintf(stderr, "Warming up for %ums with %u bytes...\n", args.warmup_ms, size);
+            run_pings(z_loan(pub), data, size, args.rate, 0, (unsigned long)args.warmup_ms * 1000, hist, &sent);
+        }
+        fprintf(stderr, "Measuring %u pings of %u bytes...\n", args.number_of_pings, size);
+        run_pings(z_loan(pub), data, size, args.rate, args.number_of_pings, 0, hist, &sent);
+        print_result(args.format, i == 0, size, args.rate, sent, hist);
     }
-    zp_mutex_unlock(&mutex);
-    zp_free(results);
+    print_footer(args.format);
+
+    zp_free(hist);
     zp_free(data);
     z_drop(z_move(pub));
     z_drop(z_move(sub));
@@ -127,6 +381,8 @@ int main(int argc, char** argv) {
     zp_stop_lease_task(z_loan(session));
 
     z_close(z_move(session));
+
+    zp_mutex_free(&state.mutex);
 }
 
 char* getopt(int argc, char** argv, char option) {
@@ -149,27 +405,51 @@ struct args_t parse_args(int argc, char** argv) {
             return (struct args_t){.help_requested = 1};
         }
     }
+    struct args_t args = {
+        .number_of_pings = DEFAULT_PING_NB,
+        .warmup_ms = DEFAULT_WARMUP_MS,
+        .rate = DEFAULT_RATE,
+        .format = DEFAULT_FORMAT,
+        .mode = "client",
+    };
     char* arg = getopt(argc, argv, 's');
-    unsigned int size = DEFAULT_PKT_SIZE;
+    const char* sizes = DEFAULT_PKT_SIZE;
     if (arg) {
-        size = (unsigned int)atoi(arg);
+        sizes = arg;
+    }
+    while (*sizes != '\0' && args.number_of_sizes < MAX_SIZES) {
+        char* end = NULL;
+        unsigned long size = strtoul(sizes, &end, 10);
+        if (end == sizes || size < HEADER_SIZE) {
+            args.number_of_sizes = 0;
+            break;
+        }
+        args.sizes[args.number_of_sizes++] = (unsigned int)size;
+        sizes = (*end == ',') ? end + 1 : end;
     }
     arg = getopt(argc, argv, 'n');
-    unsigned int number_of_pings = DEFAULT_PING_NB;
     if (arg) {
-        number_of_pings = (unsigned int)atoi(arg);
+        args.number_of_pings = (unsigned int)atoi(arg);
     }
     arg = getopt(argc, argv, 'w');
-    unsigned int warmup_ms = DEFAULT_WARMUP_MS;
     if (arg) {
-        warmup_ms = (unsigned int)atoi(arg);
+        args.warmup_ms = (unsigned int)atoi(arg);
     }
-    return (struct args_t){
-        .help_requested = 0,
-        .size = size,
-        .number_of_pings = number_of_pings,
-        .warmup_ms = warmup_ms,
-    };
+    arg = getopt(argc, argv, 'r');
+    if (arg) {
+        args.rate = (unsigned int)atoi(arg);
+    }
+    arg = getopt(argc, argv, 'o');
+    if (arg) {
+        args.format = arg;
+    }
+    arg = getopt(argc, argv, 'm');
+    if (arg) {
+        args.mode = arg;
+    }
+    args.clocator = getopt(argc, argv, 'e');
+    args.llocator = getopt(argc, argv, 'l');
+    return args;
 }
 #else
 int main(void) {
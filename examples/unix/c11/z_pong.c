@@ -12,7 +12,9 @@
 //   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
 //
 
-#include "stdio.h"
+#include <stdio.h>
+#include <string.h>
+
 #include "zenoh-pico.h"
 
 #if Z_FEATURE_SUBSCRIPTION == 1 && Z_FEATURE_PUBLICATION == 1
@@ -29,10 +31,20 @@ void drop(void* context) {
     //  valid.
 }
 
+char* getopt(int argc, char** argv, char option);
+
 int main(int argc, char** argv) {
-    (void)argc;
-    (void)argv;
+    const char* mode = getopt(argc, argv, 'm');
+    const char* clocator = getopt(argc, argv, 'e');
+    const char* llocator = getopt(argc, argv, 'l');
     z_owned_config_t config = z_config_default();
+    zp_config_insert(z_loan(config), Z_CONFIG_MODE_KEY, z_string_make(mode != NULL ? mode : "client"));
+    if (clocator != NULL) {
+        zp_config_insert(z_loan(config), Z_CONFIG_CONNECT_KEY, z_string_make(clocator));
+    }
+    if (llocator != NULL) {
+        zp_config_insert(z_loan(config), Z_CONFIG_LISTEN_KEY, z_string_make(llocator));
+    }
     z_owned_session_t session = z_open(z_move(config));
     if (!z_check(session)) {
         printf("Unable to open session!\n");
@@ -70,6 +82,20 @@ int main(int argc, char** argv) {
 
     z_close(z_move(session));
 }
+
+char* getopt(int argc, char** argv, char option) {
+    for (int i = 0; i < argc; i++) {
+        size_t len = strlen(argv[i]);
+        if (len >= 2 && argv[i][0] == '-' && argv[i][1] == option) {
+            if (len > 2 && argv[i][2] == '=') {
+                return argv[i] + 3;
+            } else if (i + 1 < argc) {
+                return argv[i + 1];
+            }
+        }
+    }
+    return NULL;
+}
 #else
 int main(void) {
     printf(
@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+
+#include <ctype.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <zenoh-pico.h>
+
+void print_stats(const zp_stats_t *stats) {
+    printf("          %12s %12s\n", "tx", "rx");
+    printf("bytes     %12zu %12zu\n", stats->tx_bytes, stats->rx_bytes);
+    printf("batches   %12zu %12zu\n", stats->tx_batches, stats->rx_batches);
+    printf("messages  %12zu %12zu\n", stats->tx_n_msgs, stats->rx_n_msgs);
+    printf("fragments %12zu %12zu\n", stats->tx_fragments, stats->rx_fragments);
+    printf("keepalive %12zu %12zu\n", stats->tx_keep_alives, stats->rx_keep_alives);
+    printf("drops: %zu congestion, %zu out of order, %zu undecodable, %zu partly reassembled\n", stats->tx_cc_drops,
+           stats->rx_sn_drops, stats->rx_decode_errors, stats->rx_reassembly_aborts);
+}
+
+int main(int argc, char **argv) {
+    const char *mode = "client";
+    char *clocator = NULL;
+    char *llocator = NULL;
+    int n = 10;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "e:m:l:n:")) != -1) {
+        switch (opt) {
+            case 'e':
+                clocator = optarg;
+                break;
+            case 'm':
+                mode = optarg;
+                break;
+            case 'l':
+                llocator = optarg;
+                break;
+            case 'n':
+                n = atoi(optarg);
+                break;
+            case '?':
+                if (optopt == 'e' || optopt == 'm' || optopt == 'l' || optopt == 'n') {
+                    fprintf(stderr, "Option -%c requires an argument.\n", optopt);
+                } else {
+                    fprintf(stderr, "Unknown option `-%c'.\n", optopt);
+                }
+                return 1;
+            default:
+                return -1;
+        }
+    }
+
+    z_owned_config_t config = z_config_default();
+    zp_config_insert(z_loan(config), Z_CONFIG_MODE_KEY, z_string_make(mode));
+    if (clocator != NULL) {
+        zp_config_insert(z_loan(config), Z_CONFIG_CONNECT_KEY, z_string_make(clocator));
+    }
+    if (llocator != NULL) {
+        zp_config_insert(z_loan(config), Z_CONFIG_LISTEN_KEY, z_string_make(llocator));
+    }
+
+    printf("Opening session...\n");
+    z_owned_session_t s = z_open(z_move(config));
+    if (!z_check(s)) {
+        printf("Unable to open session!\n");
+        return -1;
+    }
+
+    // Start read and lease tasks for zenoh-pico
+    if (zp_start_read_task(z_loan(s), NULL) < 0 || zp_start_lease_task(z_loan(s), NULL) < 0) {
+        printf("Unable to start read and lease tasks\n");
+        z_close(z_session_move(&s));
+        return -1;
+    }
+
+    for (int idx = 0; idx < n; ++idx) {
+        sleep(1);
+        zp_stats_t stats;
+        if (zp_stats_get(z_loan(s), &stats) < 0) {
+            printf("Unable to get the transport statistics, is Z_FEATURE_STATS enabled?\n");
+            break;
+        }
+        printf("\n[%4d] Transport statistics:\n", idx);
+        print_stats(&stats);
+    }
+
+    // Stop read and lease tasks for zenoh-pico
+    zp_stop_read_task(z_loan(s));
+    zp_stop_lease_task(z_loan(s));
+
+    z_close(z_move(s));
+}
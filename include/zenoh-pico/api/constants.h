@@ -224,6 +224,16 @@ typedef enum {
 typedef enum { Z_SUBMODE_PUSH = 0, Z_SUBMODE_PULL = 1 } z_submode_t;
 #define Z_SUBMODE_DEFAULT Z_SUBMODE_PUSH
 
+/**
+ * Subscriber callback dispatch values.
+ *
+ * Enumerators:
+ *     Z_DISPATCH_INLINE: The callback runs on the task that received the sample, e.g. the read task.
+ *     Z_DISPATCH_POOLED: The callback runs on a worker of the dispatch pool, in the order the samples were received.
+ */
+typedef enum { Z_DISPATCH_INLINE = 0, Z_DISPATCH_POOLED = 1 } z_dispatch_t;
+#define Z_DISPATCH_DEFAULT Z_DISPATCH_INLINE
+
 /**
  * Query target values.
  *
@@ -274,6 +274,55 @@ int8_t z_keyexpr_equals(z_keyexpr_t l, z_keyexpr_t r);
  */
 int8_t zp_keyexpr_equals_null_terminated(const char *l, const char *r);
 
+/**
+ * Compiles a canonical keyexpr to be matched against many keyexprs with :c:func:`zp_keyexpr_compiled_includes` and
+ * :c:func:`zp_keyexpr_compiled_intersects`. The keyexpr is borrowed and must outlive its compiled form, which must
+ * be released with :c:func:`zp_keyexpr_compiled_drop`.
+ *
+ * Parameters:
+ *   compiled: A pointer to the :c:type:`zp_keyexpr_compiled_t` to compile the keyexpr into.
+ *   keyexpr: Pointer to the keyexpr in its string representation as a null terminated string.
+ *
+ * Returns:
+ *   Returns ``0`` if the keyexpr is compiled successfully, or a ``negative value`` otherwise.
+ *   Error codes are defined in :c:enum:`zp_keyexpr_canon_status_t` if the keyexpr is not canon.
+ */
+int8_t zp_keyexpr_compile(zp_keyexpr_compiled_t *compiled, const char *keyexpr);
+
+/**
+ * Releases the memory of a keyexpr compiled with :c:func:`zp_keyexpr_compile`.
+ *
+ * Parameters:
+ *   compiled: A pointer to the :c:type:`zp_keyexpr_compiled_t` to release.
+ */
+void zp_keyexpr_compiled_drop(zp_keyexpr_compiled_t *compiled);
+
+/**
+ * Check if a compiled keyexpr contains another keyexpr in its set.
+ *
+ * Parameters:
+ *   l: A pointer to the compiled keyexpr.
+ *   r: The second keyexpr.
+ *
+ * Returns:
+ *   Returns ``0`` if ``l`` includes ``r``, i.e. the set defined by ``l`` contains every key belonging to the set
+ * defined by ``r``. Otherwise, it returns a ``-1``, or other ``negative value`` for errors.
+ */
+int8_t zp_keyexpr_compiled_includes(const zp_keyexpr_compiled_t *l, z_keyexpr_t r);
+
+/**
+ * Check if a compiled keyexpr intersects with another keyexpr.
+ *
+ * Parameters:
+ *   l: A pointer to the compiled keyexpr.
+ *   r: The second keyexpr.
+ *
+ * Returns:
+ *   Returns ``0`` if the keyexprs intersect, i.e. there exists at least one key which is contained in both of the
+ * sets defined by ``l`` and ``r``. Otherwise, it returns a ``-1``, or other ``negative value`` for errors.
+ */
+int8_t zp_keyexpr_compiled_intersects(const zp_keyexpr_compiled_t *l, z_keyexpr_t r);
+
 /**
  * Return a new, zenoh-allocated, empty configuration.
  * It consists in an empty set of properties for zenoh session configuration.
@@ -1343,6 +1392,84 @@ int8_t zp_start_lease_task(z_session_t zs, const zp_task_lease_options_t *option
  */
 int8_t zp_stop_lease_task(z_session_t zs);
 
+/**
+ * Constructs the default values for the session TX task.
+ *
+ * Returns:
+ *   Returns the constructed :c:type:`zp_task_tx_options_t`.
+ */
+zp_task_tx_options_t zp_task_tx_options_default(void);
+
+/**
+ * Start a separate task to send the network messages of the session.
+ *
+ * While it runs, publications, queries and declarations are queued for this task to send them, instead of being
+ * written on the link by the calling thread. When the queue is full, messages with blocking congestion control wait
+ * for room and the others are dropped. Only available on unicast transports, with ``Z_FEATURE_TX_QUEUE`` enabled.
+ * Note that the task can be implemented in form of thread, process, etc. and its implementation is platform-dependent.
+ *
+ * Parameters:
+ *   zs: A loaned instance of the the :c:type:`z_session_t` where to start the TX task.
+ *   options: The options to apply when starting the TX task. If ``NULL`` is passed, the default options will be
+ * applied.
+ *
+ * Returns:
+ *   Returns ``0`` if the TX task started successfully, or a ``negative value`` otherwise.
+ */
+int8_t zp_start_tx_task(z_session_t zs, const zp_task_tx_options_t *options);
+
+/**
+ * Stop the TX task, once it sent the queued messages.
+ *
+ * Parameters:
+ *   zs: A loaned instance of the the :c:type:`z_session_t` where to stop the TX task.
+ *
+ * Returns:
+ *   Returns ``0`` if the TX task stopped successfully, or a ``negative value`` otherwise.
+ */
+int8_t zp_stop_tx_task(z_session_t zs);
+
+/**
+ * Constructs the default values for the session dispatch tasks.
+ *
+ * Returns:
+ *   Returns the constructed :c:type:`zp_task_dispatch_options_t`.
+ */
+zp_task_dispatch_options_t zp_task_dispatch_options_default(void);
+
+/**
+ * Start the worker tasks running the callbacks of the subscribers declared with ``Z_DISPATCH_POOLED`` dispatch.
+ *
+ * While they run, the read task only copies the samples of these subscribers in the queue of a worker, so that slow
+ * callbacks do not hold back the reading of the link. The samples of a subscriber always go to the same worker, and
+ * its callback runs on them in the order they were received. When the queue of a worker is full, the read task waits
+ * for room. The samples published locally from a pooled callback are dispatched inline, on the worker running it.
+ * Only available with ``Z_FEATURE_DISPATCH_POOL`` enabled.
+ * Note that the tasks can be implemented in form of threads, processes, etc. and their implementation is
+ * platform-dependent.
+ *
+ * Parameters:
+ *   zs: A loaned instance of the the :c:type:`z_session_t` where to start the dispatch tasks.
+ *   options: The options to apply when starting the dispatch tasks. If ``NULL`` is passed, the default options will
+ * be applied. The number of workers is set when the tasks are first started.
+ *
+ * Returns:
+ *   Returns ``0`` if the dispatch tasks started successfully, or a ``negative value`` otherwise.
+ */
+int8_t zp_start_dispatch_tasks(z_session_t zs, const zp_task_dispatch_options_t *options);
+
+/**
+ * Stop the dispatch tasks, once they ran the callbacks on the queued samples. The callbacks of the pooled subscribers
+ * then run on the read task again.
+ *
+ * Parameters:
+ *   zs: A loaned instance of the the :c:type:`z_session_t` where to stop the dispatch tasks.
+ *
+ * Returns:
+ *   Returns ``0`` if the dispatch tasks stopped successfully, or a ``negative value`` otherwise.
+ */
+int8_t zp_stop_dispatch_tasks(z_session_t zs);
+
 /************* Single Thread helpers **************/
 /**
  * Constructs the default values for the reading procedure.
@@ -1376,7 +1503,8 @@ zp_send_keep_alive_options_t zp_send_keep_alive_options_default(void);
 /**
  * Triggers a single execution of keep alive procedure.
  *
- * It will send ``KeepAlive`` messages when needed and will close the session when the lease is expired.
+ * It will send ``KeepAlive`` messages when needed and will close the session when the lease is expired. It also
+ * completes the queries whose timeout elapsed.
  *
  * Parameters:
  *   zs: A loaned instance of the the :c:type:`z_session_t` where trigger the leasing procedure.
@@ -1411,6 +1539,46 @@ zp_send_join_options_t zp_send_join_options_default(void);
  */
 int8_t zp_send_join(z_session_t zs, const zp_send_join_options_t *options);
 
+/**
+ * Constructs the default values for flushing the batched messages.
+ *
+ * Returns:
+ *   Returns the constructed :c:type:`zp_flush_options_t`.
+ */
+zp_flush_options_t zp_flush_options_default(void);
+
+/**
+ * Sends the messages batched on the session, without waiting for the batch to fill up or to expire.
+ *
+ * Messages are only batched when zenoh-pico is built with ``Z_FEATURE_BATCHING``, otherwise this is a no-op.
+ * Batches are also sent once they reach ``Z_BATCH_FLUSH_THRESHOLD`` bytes, and after ``Z_BATCH_FLUSH_DEADLINE_MS``
+ * by the lease task or by :c:func:`zp_read`.
+ *
+ * Parameters:
+ *   zs: A loaned instance of the the :c:type:`z_session_t` whose batched messages to send.
+ *   options: The options to apply to the flush. If ``NULL`` is passed, the default options will be applied.
+ *
+ * Returns:
+ *   Returns ``0`` if the batched messages were sent successfully, or a ``negative value`` otherwise.
+ */
+int8_t zp_flush(z_session_t zs, const zp_flush_options_t *options);
+
+/**
+ * Takes a snapshot of the counters of the session transport: the bytes, batches and messages it sent and received,
+ * and the messages it dropped.
+ *
+ * The counters are updated without synchronizing with each other, so the snapshot may be slightly inconsistent when
+ * taken while the session is in use. Only available with ``Z_FEATURE_STATS`` enabled.
+ *
+ * Parameters:
+ *   zs: A loaned instance of the the :c:type:`z_session_t` whose counters to take.
+ *   stats: A pointer to the :c:type:`zp_stats_t` to fill.
+ *
+ * Returns:
+ *   Returns ``0`` if the snapshot was taken successfully, or a ``negative value`` otherwise.
+ */
+int8_t zp_stats_get(z_session_t zs, zp_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -228,9 +228,12 @@ typedef _z_value_t z_value_t;
  *
  * Members:
  *   z_reliability_t reliability: The subscription reliability.
+ *   z_dispatch_t dispatch: Whether the callback runs on the read task, or on the dispatch pool started with
+ *     :c:func:`zp_start_dispatch_tasks`. Pooled callbacks run inline while the pool is not running.
  */
 typedef struct {
     z_reliability_t reliability;
+    z_dispatch_t dispatch;
 } z_subscriber_options_t;
 
 /**
@@ -355,11 +358,14 @@ typedef struct {
  *   z_query_target_t target: The queryables that should be targeted by this get.
  *   z_query_consolidation_t consolidation: The replies consolidation strategy to apply on replies.
  *   z_value_t value: The payload to include in the query.
+ *   uint32_t timeout_ms: The time in milliseconds after which the query completes, even if replies are missing. Set
+ *                        it to 0 for the query to only complete on its final reply.
  */
 typedef struct {
     z_value_t value;
     z_query_consolidation_t consolidation;
     z_query_target_t target;
+    uint32_t timeout_ms;
 #if Z_FEATURE_ATTACHMENT == 1
 // TODO:ATT z_attachment_t attachment;
 #endif
@@ -389,6 +395,34 @@ typedef struct {
 #endif
 } zp_task_lease_options_t;
 
+/**
+ * Represents the set of options that can be applied to the TX task,
+ * whenever issued via :c:func:`zp_start_tx_task`.
+ */
+typedef struct {
+#if Z_FEATURE_MULTI_THREAD == 1
+    zp_task_attr_t *task_attributes;
+#else
+    uint8_t __dummy;  // Just to avoid empty structures that might cause undefined behavior
+#endif
+} zp_task_tx_options_t;
+
+/**
+ * Represents the set of options that can be applied to the dispatch tasks,
+ * whenever issued via :c:func:`zp_start_dispatch_tasks`.
+ *
+ * Members:
+ *   size_t workers: The number of worker tasks, ``Z_DISPATCH_POOL_WORKERS`` by default.
+ */
+typedef struct {
+#if Z_FEATURE_MULTI_THREAD == 1
+    zp_task_attr_t *task_attributes;
+    size_t workers;
+#else
+    uint8_t __dummy;  // Just to avoid empty structures that might cause undefined behavior
+#endif
+} zp_task_dispatch_options_t;
+
 /**
  * Represents the set of options that can be applied to the read operation,
  * whenever issued via :c:func:`zp_read`.
@@ -413,6 +447,43 @@ typedef struct {
     uint8_t __dummy;  // Just to avoid empty structures that might cause undefined behavior
 } zp_send_join_options_t;
 
+/**
+ * Represents the set of options that can be applied to the flush of batched messages,
+ * whenever issued via :c:func:`zp_flush`.
+ */
+typedef struct {
+    uint8_t __dummy;  // Just to avoid empty structures that might cause undefined behavior
+} zp_flush_options_t;
+
+/**
+ * Represents a snapshot of the counters of the transport of a session, as taken by :c:func:`zp_stats_get`.
+ * The counters start from zero when the session is opened, and wrap around once they reach ``SIZE_MAX``.
+ *
+ * Members:
+ *   size_t tx_bytes: The bytes sent on the link, including the length prefixes of stream links.
+ *   size_t tx_batches: The batches sent on the link, each in a single write or datagram.
+ *   size_t tx_n_msgs: The network messages sent, whether framed or fragmented.
+ *   size_t tx_fragments: The fragments sent.
+ *   size_t tx_keep_alives: The keep-alive messages sent.
+ *   size_t tx_cc_drops: The network messages dropped because of congestion control.
+ *   size_t rx_bytes: The bytes received from the link, including the length prefixes of stream links.
+ *   size_t rx_batches: The batches received from the link.
+ *   size_t rx_n_msgs: The network messages received, whether framed or reassembled.
+ *   size_t rx_fragments: The fragments received.
+ *   size_t rx_keep_alives: The keep-alive messages received.
+ *   size_t rx_sn_drops: The frames and fragments dropped because their sequence number is out of order.
+ *   size_t rx_decode_errors: The transport or network messages that could not be decoded.
+ *   size_t rx_reassembly_aborts: The fragmented messages given up before their last fragment.
+ */
+typedef _z_stats_t zp_stats_t;
+
+/**
+ * Represents a canonical key expression compiled by :c:func:`zp_keyexpr_compile`, to be matched against many key
+ * expressions, such as the keys of the samples received by a subscriber, without parsing it again on each match.
+ * It borrows the string it was compiled from, which must outlive it.
+ */
+typedef _z_keyexpr_compiled_t zp_keyexpr_compiled_t;
+
 /**
  * Represents a data sample.
  *
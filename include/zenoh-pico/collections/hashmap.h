@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_COLLECTIONS_HASHMAP_H
+#define ZENOH_PICO_COLLECTIONS_HASHMAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zenoh-pico/collections/element.h"
+
+/*-------- hash functions --------*/
+size_t _z_hash_bytes(size_t seed, const void *bytes, size_t len);
+size_t _z_hash_str(size_t seed, const char *str);
+size_t _z_hash_uint(size_t seed, uint64_t val);
+
+/*-------- open-addressing hashmap --------*/
+#define _Z_DEFAULT_HASHMAP_CAPACITY 16
+
+/**
+ * Compares a value stored in a :c:type:`_z_hashmap_t` with a lookup key.
+ */
+typedef _Bool (*_z_hashmap_key_eq_f)(const void *val, const void *key);
+
+/**
+ * A slot of a :c:type:`_z_hashmap_t`.
+ *
+ * Members:
+ *   size_t _hash: The hash of the key of the value.
+ *   void *_val: The value, NULL if the slot is empty.
+ */
+typedef struct {
+    size_t _hash;
+    void *_val;
+} _z_hashmap_slot_t;
+
+/**
+ * A linear-probing hashmap of non-owned values.
+ *
+ * The key of each value is implicit: callers provide its hash on insertion, and a hash plus a comparison function
+ * on lookup. This allows indexing the same values by different keys without duplicating them. Several values may
+ * share the same key, in which case lookups return the first one found.
+ *
+ * Members:
+ *   size_t _capacity: The number of slots, always a power of two. Lazily allocated on first insertion.
+ *   size_t _len: The number of values in the hashmap.
+ *   size_t _used: The number of non-empty slots, including the ones left by removed values.
+ *   _z_hashmap_slot_t *_slots: The slots.
+ */
+typedef struct {
+    size_t _capacity;
+    size_t _len;
+    size_t _used;
+    _z_hashmap_slot_t *_slots;
+} _z_hashmap_t;
+
+void _z_hashmap_init(_z_hashmap_t *map);
+_z_hashmap_t _z_hashmap_make(void);
+
+int8_t _z_hashmap_insert(_z_hashmap_t *map, size_t hash, void *val);
+void *_z_hashmap_get(const _z_hashmap_t *map, size_t hash, _z_hashmap_key_eq_f f, const void *key);
+void *_z_hashmap_remove(_z_hashmap_t *map, size_t hash, _z_hashmap_key_eq_f f, const void *key);
+
+size_t _z_hashmap_len(const _z_hashmap_t *map);
+_Bool _z_hashmap_is_empty(const _z_hashmap_t *map);
+
+void _z_hashmap_clear(_z_hashmap_t *map, z_element_free_f f);
+
+#endif /* ZENOH_PICO_COLLECTIONS_HASHMAP_H */
@@ -0,0 +1,86 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_COLLECTIONS_MPSC_H
+#define ZENOH_PICO_COLLECTIONS_MPSC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*-------- bounded lock-free multi-producer single-consumer queue --------*/
+/**
+ * A bounded lock-free queue of slots, with any number of producers and a single consumer.
+ *
+ * The queue only orders the slots, their contents live in an array owned by the caller and indexed by slot. A
+ * producer claims a slot, fills its contents, then publishes it. The consumer peeks the oldest published slot,
+ * consumes its contents, then pops it. Slots are consumed in claim order, so a claimed slot must always be published.
+ *
+ * The queue does not block. Consumers waiting for a published slot, and producers waiting for a free one, park
+ * themselves before sleeping on their own condition variable, and are woken up by the other side when the publish or
+ * pop calls report it. Parking tells whether the awaited event happened in the meantime, so that no wake up is lost.
+ *
+ * Closing the queue makes the next claims fail, so that the consumer may drain it for good once the slots claimed
+ * before closing are published. The closer waits for them the same way, parking itself before sleeping, and is woken
+ * up by the producers when the publish call reports it, or when a failed claim finds it parked.
+ *
+ * Members:
+ *   size_t *_seqs: The sequence number of each slot, telling whether it is free, claimed or published.
+ *   size_t _capacity: The number of slots, always a power of two.
+ *   size_t _head: The position of the next slot to claim, shared by the producers.
+ *   size_t _tail: The position of the next slot to consume, only accessed by the consumer.
+ *   size_t _consumer_parked: Whether the consumer is waiting for a published slot.
+ *   size_t _closer_parked: Whether the closer is waiting for the slots claimed before closing to be published.
+ *   size_t _producers_parked: The number of producers waiting for a free slot.
+ *   size_t _claiming: The number of producers between the start of a claim and the publication of the slot.
+ *   size_t _closed: Whether the queue is closed to the producers.
+ */
+typedef struct {
+    size_t *_seqs;
+    size_t _capacity;
+    size_t _head;
+    size_t _tail;
+    size_t _consumer_parked;
+    size_t _closer_parked;
+    size_t _producers_parked;
+    size_t _claiming;
+    size_t _closed;
+} _z_mpsc_t;
+
+int8_t _z_mpsc_init(_z_mpsc_t *q, size_t capacity);
+
+size_t _z_mpsc_claim(_z_mpsc_t *q);
+_Bool _z_mpsc_publish(_z_mpsc_t *q, size_t slot);
+size_t _z_mpsc_peek(const _z_mpsc_t *q);
+_Bool _z_mpsc_pop(_z_mpsc_t *q);
+
+_Bool _z_mpsc_consumer_park(_z_mpsc_t *q);
+void _z_mpsc_consumer_unpark(_z_mpsc_t *q);
+_Bool _z_mpsc_producer_park(_z_mpsc_t *q);
+void _z_mpsc_producer_unpark(_z_mpsc_t *q);
+
+void _z_mpsc_close(_z_mpsc_t *q);
+void _z_mpsc_open(_z_mpsc_t *q);
+_Bool _z_mpsc_is_closed(const _z_mpsc_t *q);
+_Bool _z_mpsc_has_claims(const _z_mpsc_t *q);
+_Bool _z_mpsc_closer_park(_z_mpsc_t *q);
+void _z_mpsc_closer_unpark(_z_mpsc_t *q);
+_Bool _z_mpsc_closer_is_parked(const _z_mpsc_t *q);
+
+size_t _z_mpsc_capacity(const _z_mpsc_t *q);
+_Bool _z_mpsc_is_empty(const _z_mpsc_t *q);
+
+void _z_mpsc_clear(_z_mpsc_t *q);
+
+#endif /* ZENOH_PICO_COLLECTIONS_MPSC_H */
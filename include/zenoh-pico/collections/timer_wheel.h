@@ -0,0 +1,75 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_COLLECTIONS_TIMER_WHEEL_H
+#define ZENOH_PICO_COLLECTIONS_TIMER_WHEEL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*-------- hierarchical timer wheel --------*/
+#define _Z_TIMER_WHEEL_LEVELS 3
+#define _Z_TIMER_WHEEL_SLOT_BITS 6
+#define _Z_TIMER_WHEEL_SLOTS (1 << _Z_TIMER_WHEEL_SLOT_BITS)
+
+/**
+ * A timer of a :c:type:`_z_timer_wheel_t`. Timers are intrusive: they are embedded in the object they expire, and
+ * the wheel only links them together. A zeroed timer is a valid unscheduled timer.
+ *
+ * Members:
+ *   struct _z_timer_t *_next: The next timer of the same slot, or of the list of expired timers.
+ *   struct _z_timer_t **_pprev: The link pointing to this timer, NULL if the timer is not scheduled.
+ *   uint64_t _expiry: The tick at which the timer expires.
+ *   void *_arg: The object the timer belongs to.
+ */
+typedef struct _z_timer_t {
+    struct _z_timer_t *_next;
+    struct _z_timer_t **_pprev;
+    uint64_t _expiry;
+    void *_arg;
+} _z_timer_t;
+
+void _z_timer_init(_z_timer_t *timer, void *arg);
+_Bool _z_timer_is_scheduled(const _z_timer_t *timer);
+
+/**
+ * A hierarchical timer wheel, counting time in ticks of a caller defined duration.
+ *
+ * Each level has :c:macro:`_Z_TIMER_WHEEL_SLOTS` slots, each slot of a level spanning a whole turn of the level
+ * below. Timers are placed in the lowest level able to hold them, and moved down as the wheel turns, so that both
+ * scheduling and cancelling a timer take constant time. Timers farther than the three levels are parked in the last
+ * slot reachable and placed again when it comes up.
+ *
+ * Members:
+ *   uint64_t _now: The next tick to process.
+ *   size_t _len: The number of scheduled timers.
+ *   _z_timer_t *_slots: The lists of timers of each slot of each level.
+ */
+typedef struct {
+    uint64_t _now;
+    size_t _len;
+    _z_timer_t *_slots[_Z_TIMER_WHEEL_LEVELS][_Z_TIMER_WHEEL_SLOTS];
+} _z_timer_wheel_t;
+
+void _z_timer_wheel_init(_z_timer_wheel_t *tw, uint64_t now);
+
+void _z_timer_wheel_add(_z_timer_wheel_t *tw, _z_timer_t *timer, uint64_t expiry);
+void _z_timer_wheel_remove(_z_timer_wheel_t *tw, _z_timer_t *timer);
+_z_timer_t *_z_timer_wheel_advance(_z_timer_wheel_t *tw, uint64_t now);
+
+size_t _z_timer_wheel_len(const _z_timer_wheel_t *tw);
+_Bool _z_timer_wheel_is_empty(const _z_timer_wheel_t *tw);
+
+#endif /* ZENOH_PICO_COLLECTIONS_TIMER_WHEEL_H */
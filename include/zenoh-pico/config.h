@@ -239,6 +239,41 @@
 #define Z_FEATURE_ATTACHMENT 1
 #endif
 
+/**
+ * Enable the batching of consecutive network messages sent on a unicast transport.
+ */
+#ifndef Z_FEATURE_BATCHING
+#define Z_FEATURE_BATCHING 0
+#endif
+
+/**
+ * Enable the unicast transmit queue, decoupling publishers from the link. Requires multi-thread.
+ */
+#ifndef Z_FEATURE_TX_QUEUE
+#define Z_FEATURE_TX_QUEUE 0
+#endif
+
+/**
+ * Enable the dispatch pool, running the callbacks of pooled subscribers off the read task. Requires multi-thread.
+ */
+#ifndef Z_FEATURE_DISPATCH_POOL
+#define Z_FEATURE_DISPATCH_POOL 0
+#endif
+
+/**
+ * Back zp_malloc with size-class slabs and per-thread caches instead of the system allocator. Unix only.
+ */
+#ifndef Z_FEATURE_SLAB_ALLOCATOR
+#define Z_FEATURE_SLAB_ALLOCATOR 0
+#endif
+
+/**
+ * Count the bytes, batches, messages and drops of the transports, as reported by zp_stats_get.
+ */
+#ifndef Z_FEATURE_STATS
+#define Z_FEATURE_STATS 1
+#endif
+
 /*------------------ Compile-time configuration properties ------------------*/
 /**
  * Default length for Zenoh ID. Maximum size is 16 bytes.
@@ -281,6 +316,22 @@
 #define Z_JOIN_INTERVAL 2500
 #endif
 
+/**
+ * Default time in milliseconds after which a query completes, whether or not all the replies were received. Set it
+ * to 0 for queries to only complete on their final reply.
+ */
+#ifndef Z_GET_TIMEOUT_DEFAULT
+#define Z_GET_TIMEOUT_DEFAULT 10000
+#endif
+
+/**
+ * Resolution in milliseconds of the query timeouts. The lease task checks them at this pace while queries are
+ * pending.
+ */
+#ifndef Z_QUERY_TIMEOUT_TICK_MS
+#define Z_QUERY_TIMEOUT_TICK_MS 100
+#endif
+
 /**
  * Default socket timeout in milliseconds.
  */
@@ -303,6 +354,14 @@
 #define Z_IOSLICE_SIZE 128
 #endif
 
+/**
+ * Minimum size of a payload to be sent in place from the user buffer, rather than copied into the batch, on links
+ * able to gather several buffers in a single write. Set it to 0 to always copy payloads.
+ */
+#ifndef Z_TX_ZERO_COPY_MIN_SIZE
+#define Z_TX_ZERO_COPY_MIN_SIZE 1024
+#endif
+
 /**
  * Default maximum batch size possible to be received or sent.
  */
@@ -316,6 +375,85 @@
 #define Z_BATCH_MULTICAST_SIZE 8192
 #endif
 
+/**
+ * Size in bytes from which a unicast batch is sent without waiting for more messages, when batching is enabled.
+ */
+#ifndef Z_BATCH_FLUSH_THRESHOLD
+#define Z_BATCH_FLUSH_THRESHOLD 8192
+#endif
+
+/**
+ * Maximum time in milliseconds a message is held in a unicast batch, when batching is enabled. The lease task only
+ * keeps batches open, and wakes up at this pace, while network messages keep being sent.
+ */
+#ifndef Z_BATCH_FLUSH_DEADLINE_MS
+#define Z_BATCH_FLUSH_DEADLINE_MS 1
+#endif
+
+/**
+ * Number of network messages each priority class of the unicast transmit queue holds, when enabled. Must be a power
+ * of two.
+ */
+#ifndef Z_TX_QUEUE_SIZE
+#define Z_TX_QUEUE_SIZE 64
+#endif
+
+/**
+ * Number of priority classes of the transmit queue, from 1 to 8. Each class has its own queue of Z_TX_QUEUE_SIZE
+ * network messages, the message priorities being spread evenly over the classes. The TX task sends the messages of
+ * the higher classes first. Set to 1 to send the messages in FIFO order.
+ */
+#ifndef Z_TX_QUEUE_PRIORITIES
+#define Z_TX_QUEUE_PRIORITIES 2
+#endif
+
+/**
+ * Size in bytes of the buffer of each transmit queue entry. Larger messages get a buffer of their own size.
+ */
+#ifndef Z_TX_QUEUE_ENTRY_SIZE
+#define Z_TX_QUEUE_ENTRY_SIZE 1024
+#endif
+
+/**
+ * Default number of worker tasks of the dispatch pool, when enabled.
+ */
+#ifndef Z_DISPATCH_POOL_WORKERS
+#define Z_DISPATCH_POOL_WORKERS 2
+#endif
+
+/**
+ * Number of samples the queue of each dispatch pool worker holds, when enabled. Must be a power of two. Once the
+ * queue of a worker is full, the read task waits for the worker to make room.
+ */
+#ifndef Z_DISPATCH_POOL_QUEUE_SIZE
+#define Z_DISPATCH_POOL_QUEUE_SIZE 64
+#endif
+
+/**
+ * Number of free blocks of each size class cached by each thread, when the slab allocator is enabled. A thread
+ * allocates and frees from its cache without synchronisation, and exchanges half of it with the shared pool of the
+ * size class when it runs empty or full.
+ */
+#ifndef Z_SLAB_MAGAZINE_SIZE
+#define Z_SLAB_MAGAZINE_SIZE 32
+#endif
+
+/**
+ * Size in bytes of the chunks the slab allocator requests from the system allocator and carves into blocks, when
+ * enabled. Chunks are kept for the lifetime of the process.
+ */
+#ifndef Z_SLAB_CHUNK_SIZE
+#define Z_SLAB_CHUNK_SIZE 16384
+#endif
+
+/**
+ * Number of datagrams received, or fragments sent, with a single system call by the multicast transport on links
+ * able to. Each slot reserves a buffer of the batch size. Set to 1 to receive and send one datagram at a time.
+ */
+#ifndef Z_DATAGRAM_SLOTS
+#define Z_DATAGRAM_SLOTS 8
+#endif
+
 /**
  * Default maximum size for fragmented messages.
  */
@@ -323,6 +461,14 @@
 #define Z_FRAG_MAX_SIZE 300000
 #endif
 
+/**
+ * Number of defragmentation buffers kept by a transport for the next fragmented messages. The buffers are lent to the
+ * reliability channels, and to the peers on multicast transports, while a message is reassembled.
+ */
+#ifndef Z_DEFRAG_POOL_SIZE
+#define Z_DEFRAG_POOL_SIZE 2
+#endif
+
 /**
  * Default "nop" instruction
  */
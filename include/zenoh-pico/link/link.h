@@ -94,8 +94,18 @@ typedef int8_t (*_z_f_link_listen)(struct _z_link_t *self);
 typedef void (*_z_f_link_close)(struct _z_link_t *self);
 typedef size_t (*_z_f_link_write)(const struct _z_link_t *self, const uint8_t *ptr, size_t len);
 typedef size_t (*_z_f_link_write_all)(const struct _z_link_t *self, const uint8_t *ptr, size_t len);
+typedef size_t (*_z_f_link_write_vec)(const struct _z_link_t *self, const _z_bytes_t *bufs, size_t count);
+// Maximum number of buffers gathered by a single _z_f_link_write_vec call
+#define _Z_LINK_WRITE_VEC_MAX 16
+
 typedef size_t (*_z_f_link_read)(const struct _z_link_t *self, uint8_t *ptr, size_t len, _z_bytes_t *addr);
 typedef size_t (*_z_f_link_read_exact)(const struct _z_link_t *self, uint8_t *ptr, size_t len, _z_bytes_t *addr);
+typedef size_t (*_z_f_link_read_multi)(const struct _z_link_t *self, uint8_t *const *ptrs, size_t *lens, size_t count,
+                                       _z_bytes_t *addrs);
+typedef size_t (*_z_f_link_write_multi)(const struct _z_link_t *self, const _z_bytes_t *dgrams, size_t count);
+// Maximum number of datagrams received or sent by a single _z_f_link_read_multi or _z_f_link_write_multi call
+#define _Z_LINK_MULTI_DATAGRAM_MAX 16
+
 typedef void (*_z_f_link_free)(struct _z_link_t *self);
 
 typedef struct _z_link_t {
@@ -127,8 +137,11 @@ typedef struct _z_link_t {
     _z_f_link_close _close_f;
     _z_f_link_write _write_f;
     _z_f_link_write_all _write_all_f;
+    _z_f_link_write_vec _write_vec_f;  // Optional, NULL if the link cannot gather buffers in a single write
     _z_f_link_read _read_f;
     _z_f_link_read_exact _read_exact_f;
+    _z_f_link_read_multi _read_multi_f;    // Optional, NULL if the link cannot receive several datagrams at once
+    _z_f_link_write_multi _write_multi_f;  // Optional, NULL if the link cannot send several datagrams at once
     _z_f_link_free _free_f;
 
     uint16_t _mtu;
@@ -143,5 +156,7 @@ int8_t _z_listen_link(_z_link_t *zl, const char *locator);
 int8_t _z_link_send_wbuf(const _z_link_t *zl, const _z_wbuf_t *wbf);
 size_t _z_link_recv_zbuf(const _z_link_t *zl, _z_zbuf_t *zbf, _z_bytes_t *addr);
 size_t _z_link_recv_exact_zbuf(const _z_link_t *zl, _z_zbuf_t *zbf, size_t len, _z_bytes_t *addr);
+size_t _z_link_recv_multi_zbuf(const _z_link_t *zl, _z_zbuf_t *zbfs, size_t count, _z_bytes_t *addrs);
+int8_t _z_link_send_multi_wbuf(const _z_link_t *zl, const _z_wbuf_t *wbfs, size_t count);
 
 #endif /* ZENOH_PICO_LINK_H */
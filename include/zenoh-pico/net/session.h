@@ -21,6 +21,8 @@
 #include "zenoh-pico/collections/list.h"
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/protocol/core.h"
+#include "zenoh-pico/protocol/ketrie.h"
+#include "zenoh-pico/session/dispatch.h"
 #include "zenoh-pico/session/session.h"
 #include "zenoh-pico/utils/config.h"
 
@@ -48,11 +50,18 @@ typedef struct _z_session_t {
     // Session declarations
     _z_resource_list_t *_local_resources;
     _z_resource_list_t *_remote_resources;
+    _z_resource_index_t _local_resources_index;
+    _z_resource_index_t _remote_resources_index;
 
     // Session subscriptions
 #if Z_FEATURE_SUBSCRIPTION == 1
     _z_subscription_rc_list_t *_local_subscriptions;
     _z_subscription_rc_list_t *_remote_subscriptions;
+    _z_ketrie_t _local_subscriptions_index;
+    _z_ketrie_t _remote_subscriptions_index;
+#endif
+#if Z_FEATURE_DISPATCH_POOL == 1 && Z_FEATURE_SUBSCRIPTION == 1
+    _z_dispatch_pool_t _dispatch_pool;
 #endif
 
     // Session queryables
@@ -60,7 +69,9 @@ typedef struct _z_session_t {
     _z_session_queryable_rc_list_t *_local_queryable;
 #endif
 #if Z_FEATURE_QUERY == 1
-    _z_pending_query_list_t *_pending_queries;
+    _z_hashmap_t _pending_queries_index;  // The pending queries indexed by their id, the session's references
+    _z_timer_wheel_t _pending_queries_timeouts;
+    zp_clock_t _pending_queries_epoch;  // The origin of the ticks of the timeouts
 #endif
 } _z_session_t;
 
@@ -132,6 +143,27 @@ int8_t _zp_send_keep_alive(_z_session_t *z);
  */
 int8_t _zp_send_join(_z_session_t *z);
 
+/**
+ * Send the network messages batched on the session transport, if any.
+ *
+ * Parameters:
+ *     session: The zenoh-net session. The caller keeps its ownership.
+ * Returns:
+ *     ``0`` in case of success, ``-1`` in case of failure.
+ */
+int8_t _zp_flush(_z_session_t *z);
+
+/**
+ * Take a snapshot of the counters of the session transport.
+ *
+ * Parameters:
+ *     session: The zenoh-net session. The caller keeps its ownership.
+ *     stats: The snapshot to fill.
+ * Returns:
+ *     ``0`` in case of success, ``-1`` in case of failure.
+ */
+int8_t _zp_stats_get(_z_session_t *z, _z_stats_t *stats);
+
 #if Z_FEATURE_MULTI_THREAD == 1
 /**
  * Start a separate task to read from the network and process the messages
@@ -182,6 +214,49 @@ int8_t _zp_start_lease_task(_z_session_t *z, zp_task_attr_t *attr);
  *     ``0`` in case of success, ``-1`` in case of failure.
  */
 int8_t _zp_stop_lease_task(_z_session_t *z);
+
+/**
+ * Start a separate task to send the network messages of the session. Publishers queue their messages, which this
+ * task frames and sends, instead of writing them on the link themselves. Only available on unicast transports.
+ *
+ * Parameters:
+ *     session: The zenoh-net session. The caller keeps its ownership.
+ * Returns:
+ *     ``0`` in case of success, ``-1`` in case of failure.
+ */
+int8_t _zp_start_tx_task(_z_session_t *z, zp_task_attr_t *attr);
+
+/**
+ * Stop the TX task, once it sent the queued network messages.
+ *
+ * Parameters:
+ *     session: The zenoh-net session. The caller keeps its ownership.
+ * Returns:
+ *     ``0`` in case of success, ``-1`` in case of failure.
+ */
+int8_t _zp_stop_tx_task(_z_session_t *z);
+
+/**
+ * Start the worker tasks running the callbacks of the pooled subscribers. The read task copies their samples in the
+ * queue of a worker, instead of running the callbacks itself.
+ *
+ * Parameters:
+ *     session: The zenoh-net session. The caller keeps its ownership.
+ *     workers: The number of worker tasks, only applied the first time the pool is started.
+ * Returns:
+ *     ``0`` in case of success, ``-1`` in case of failure.
+ */
+int8_t _zp_start_dispatch_tasks(_z_session_t *z, zp_task_attr_t *attr, size_t workers);
+
+/**
+ * Stop the dispatch worker tasks, once they ran the callbacks on the queued samples.
+ *
+ * Parameters:
+ *     session: The zenoh-net session. The caller keeps its ownership.
+ * Returns:
+ *     ``0`` in case of success, ``-1`` in case of failure.
+ */
+int8_t _zp_stop_dispatch_tasks(_z_session_t *z);
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
 #endif /* INCLUDE_ZENOH_PICO_NET_SESSION_H */
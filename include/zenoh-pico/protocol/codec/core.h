@@ -93,4 +93,24 @@ int8_t _z_timestamp_encode(_z_wbuf_t *buf, const _z_timestamp_t *ts);
 int8_t _z_timestamp_encode_ext(_z_wbuf_t *buf, const _z_timestamp_t *ts);
 int8_t _z_timestamp_decode(_z_timestamp_t *ts, _z_zbuf_t *buf);
 
+/*------------------ Reserved encoding ------------------*/
+// The encoders below write straight to a cursor returned by _z_wbuf_reserve, and return the cursor past the bytes
+// they wrote. The reservation must cover their maximum length, counting _Z_ZINT_MAX_LEN bytes for each varint.
+#define _Z_ZINT_MAX_LEN 10
+#define _Z_KEYEXPR_MAX_LEN(suffix_len) ((size_t)(2 * _Z_ZINT_MAX_LEN) + (suffix_len))
+#define _Z_TIMESTAMP_MAX_LEN (_Z_ZINT_MAX_LEN + 1 + Z_TSID_LENGTH)
+#define _Z_TIMESTAMP_EXT_MAX_LEN (_Z_ZINT_MAX_LEN + _Z_TIMESTAMP_MAX_LEN)
+
+uint8_t *_z_uint8_encode_at(uint8_t *cursor, uint8_t u8);
+uint8_t *_z_zint_encode_at(uint8_t *cursor, uint64_t v);
+uint8_t *_z_bytes_val_encode_at(uint8_t *cursor, const uint8_t *bs, size_t len);
+uint8_t *_z_bytes_encode_at(uint8_t *cursor, const _z_bytes_t *bs);
+// Whether _z_bytes_val_encode wraps bytes of this length in place rather than copying them
+_Bool _z_bytes_val_is_wrapped(const _z_wbuf_t *wbf, size_t len);
+
+// Only writes the suffix of the keyexpr if suffix_len is not zero
+uint8_t *_z_keyexpr_encode_at(uint8_t *cursor, const _z_keyexpr_t *ke, size_t suffix_len);
+uint8_t *_z_timestamp_encode_at(uint8_t *cursor, const _z_timestamp_t *ts);
+uint8_t *_z_timestamp_encode_ext_at(uint8_t *cursor, const _z_timestamp_t *ts);
+
 #endif /* INCLUDE_ZENOH_PICO_PROTOCOL_CODEC_CORE_H */
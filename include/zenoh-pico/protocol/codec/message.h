@@ -38,6 +38,9 @@ int8_t _z_ack_decode(_z_msg_ack_t *ack, _z_zbuf_t *zbf, uint8_t header);
 
 int8_t _z_push_body_encode(_z_wbuf_t *wbf, const _z_push_body_t *pshb);
 int8_t _z_push_body_decode(_z_push_body_t *body, _z_zbuf_t *zbf, uint8_t header);
+// The bytes to reserve for _z_push_body_encode_at, or 0 if the body can only be encoded by _z_push_body_encode
+size_t _z_push_body_encode_max_len(const _z_wbuf_t *wbf, const _z_push_body_t *pshb);
+uint8_t *_z_push_body_encode_at(uint8_t *cursor, const _z_push_body_t *pshb);
 
 int8_t _z_put_encode(_z_wbuf_t *wbf, const _z_msg_put_t *put);
 int8_t _z_put_decode(_z_msg_put_t *put, _z_zbuf_t *zbf, uint8_t header);
@@ -24,6 +24,7 @@ int8_t _z_scouting_message_decode(_z_scouting_message_t *msg, _z_zbuf_t *buf);
 
 int8_t _z_transport_message_encode(_z_wbuf_t *buf, const _z_transport_message_t *msg);
 int8_t _z_transport_message_decode(_z_transport_message_t *msg, _z_zbuf_t *buf);
+int8_t _z_transport_message_decode_stream(_z_transport_message_t *msg, _z_zbuf_t *buf);
 
 int8_t _z_join_encode(_z_wbuf_t *wbf, uint8_t header, const _z_t_msg_join_t *msg);
 int8_t _z_join_decode(_z_t_msg_join_t *msg, _z_zbuf_t *zbf, uint8_t header);
@@ -42,6 +43,8 @@ int8_t _z_keep_alive_decode(_z_t_msg_keep_alive_t *msg, _z_zbuf_t *zbf, uint8_t
 
 int8_t _z_frame_encode(_z_wbuf_t *wbf, uint8_t header, const _z_t_msg_frame_t *msg);
 int8_t _z_frame_decode(_z_t_msg_frame_t *msg, _z_zbuf_t *zbf, uint8_t header);
+int8_t _z_frame_decode_stream(_z_t_msg_frame_t *msg, _z_zbuf_t *zbf, uint8_t header);
+_Bool _z_frame_next(_z_t_msg_frame_t *msg, _z_network_message_t *nm, int8_t *ret);
 
 int8_t _z_fragment_encode(_z_wbuf_t *wbf, uint8_t header, const _z_t_msg_fragment_t *msg);
 int8_t _z_fragment_decode(_z_t_msg_fragment_t *msg, _z_zbuf_t *zbf, uint8_t header);
@@ -294,11 +294,13 @@ typedef struct {
  *     _z_period_t *period: The subscription period.
  *     z_reliability_t reliability: The subscription reliability.
  *     _z_submode_t mode: The subscription mode.
+ *     z_dispatch_t dispatch: The task running the subscription callback.
  */
 typedef struct {
     _z_period_t period;
     z_reliability_t reliability;
     z_submode_t mode;
+    z_dispatch_t dispatch;
 } _z_subinfo_t;
 
 typedef struct {
@@ -65,6 +65,7 @@ typedef struct {
 #define _z_n_qos_make(express, nodrop, priority) \
     (_z_n_qos_t) { ._val = (((express) << 4) | ((nodrop) << 3) | (priority)) }
 #define _Z_N_QOS_DEFAULT _z_n_qos_make(0, 0, 5)
+#define _z_n_qos_get_priority(n_qos) ((z_priority_t)((n_qos)._val & 0x07))
 
 // RESPONSE FINAL message flags:
 //      Z Extensions       if Z==1 then Zenoh extensions are present
@@ -221,6 +222,7 @@ typedef struct {
 } _z_network_message_t;
 typedef _z_network_message_t _z_zenoh_message_t;
 void _z_n_msg_clear(_z_network_message_t *m);
+z_priority_t _z_n_msg_get_priority(const _z_network_message_t *m);
 void _z_n_msg_free(_z_network_message_t **m);
 inline static void _z_msg_clear(_z_zenoh_message_t *msg) { _z_n_msg_clear(msg); }
 inline static void _z_msg_free(_z_zenoh_message_t **msg) { _z_n_msg_free(msg); }
@@ -20,6 +20,7 @@
 
 #include "zenoh-pico/link/endpoint.h"
 #include "zenoh-pico/protocol/definitions/network.h"
+#include "zenoh-pico/protocol/iobuf.h"
 
 #define _Z_MID_SCOUT 0x01
 #define _Z_MID_HELLO 0x02
@@ -443,8 +444,12 @@ void _z_t_msg_keep_alive_clear(_z_t_msg_keep_alive_t *msg);
 //
 // - if R==1 then the FRAME is sent on the reliable channel, best-effort otherwise.
 //
+// When decoded with _z_transport_message_decode_stream, the network messages are not decoded upfront: _stream points
+// to the buffer they are read from, one at a time, with _z_frame_next.
+//
 typedef struct {
     _z_network_message_vec_t _messages;
+    _z_zbuf_t *_stream;
     _z_zint_t _sn;
 } _z_t_msg_frame_t;
 void _z_t_msg_frame_clear(_z_t_msg_frame_t *msg);
@@ -99,6 +99,7 @@ typedef struct {
     size_t _w_idx;
     size_t _capacity;
     size_t _expansion_step;
+    size_t _wrap_threshold;  // Bytes of at least this size are wrapped rather than copied, 0 to always copy
 } _z_wbuf_t;
 
 _z_wbuf_t _z_wbuf_make(size_t capacity, _Bool is_expandable);
@@ -112,6 +113,11 @@ int8_t _z_wbuf_write_bytes(_z_wbuf_t *wbf, const uint8_t *bs, size_t offset, siz
 int8_t _z_wbuf_wrap_bytes(_z_wbuf_t *wbf, const uint8_t *bs, size_t offset, size_t length);
 void _z_wbuf_put(_z_wbuf_t *wbf, uint8_t b, size_t pos);
 
+// Reserves max_len contiguous bytes at the write position, and returns a cursor to write up to max_len bytes straight
+// to them, or NULL if the current ioslice does not have them. Only the bytes given to _z_wbuf_commit are written.
+uint8_t *_z_wbuf_reserve(_z_wbuf_t *wbf, size_t max_len);
+void _z_wbuf_commit(_z_wbuf_t *wbf, size_t used);
+
 size_t _z_wbuf_get_rpos(const _z_wbuf_t *wbf);
 size_t _z_wbuf_get_wpos(const _z_wbuf_t *wbf);
 void _z_wbuf_set_rpos(_z_wbuf_t *wbf, size_t r_pos);
@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_PROTOCOL_KETRIE_H
+#define ZENOH_PICO_PROTOCOL_KETRIE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zenoh-pico/collections/list.h"
+
+/*-------- Key expression trie --------*/
+/**
+ * A node of a :c:type:`_z_ketrie_t`, labelled by a single key expression chunk.
+ *
+ * Children are split by kind: verbatim and plain chunks are kept sorted to be binary searched, chunks containing
+ * ``*`` or ``$*`` are kept aside and always visited, and the ``**`` child (if any) is kept on its own.
+ *
+ * Members:
+ *   char *_chunk: The owned, null-terminated, chunk label.
+ *   size_t _chunk_len: The length of the chunk label.
+ *   struct _z_ketrie_node_t *_parent: The parent node, or NULL for the root.
+ *   struct _z_ketrie_node_t **_literals: The sorted array of non-wild children.
+ *   struct _z_ketrie_node_t **_wilds: The array of wild, non-superwild, children.
+ *   struct _z_ketrie_node_t *_superwild: The ``**`` child.
+ *   _z_list_t *_vals: The values registered with a key expression ending on this node. Values are not owned.
+ *   size_t _mark: The last lookup epoch in which the values of this node have been reported.
+ */
+typedef struct _z_ketrie_node_t {
+    char *_chunk;
+    size_t _chunk_len;
+    struct _z_ketrie_node_t *_parent;
+    struct _z_ketrie_node_t **_literals;
+    size_t _literals_len;
+    size_t _literals_capacity;
+    struct _z_ketrie_node_t **_wilds;
+    size_t _wilds_len;
+    size_t _wilds_capacity;
+    struct _z_ketrie_node_t *_superwild;
+    _z_list_t *_vals;
+    size_t _mark;
+} _z_ketrie_node_t;
+
+/**
+ * An index of values by key expression, matching a key expression in time proportional to its depth.
+ *
+ * Lookups are conservative: every value whose key expression intersects the looked up one is reported,
+ * but some non-intersecting values may be reported as well (e.g. sub-chunk wildcards are not resolved).
+ * Callers must confirm each candidate with :c:func:`_z_keyexpr_intersects`.
+ *
+ * Members:
+ *   _z_ketrie_node_t *_root: The root node, lazily allocated on first insertion.
+ *   size_t _epoch: The lookup counter, used to report the values of each node only once per lookup.
+ */
+typedef struct {
+    _z_ketrie_node_t *_root;
+    size_t _epoch;
+} _z_ketrie_t;
+
+typedef void (*_z_ketrie_visit_f)(void *val, void *arg);
+
+void _z_ketrie_init(_z_ketrie_t *trie);
+_z_ketrie_t _z_ketrie_make(void);
+
+int8_t _z_ketrie_insert(_z_ketrie_t *trie, const char *key, size_t len, void *val);
+void _z_ketrie_remove(_z_ketrie_t *trie, const char *key, size_t len, const void *val);
+void _z_ketrie_intersecting(_z_ketrie_t *trie, const char *key, size_t len, _z_ketrie_visit_f f, void *arg);
+
+_Bool _z_ketrie_is_empty(const _z_ketrie_t *trie);
+void _z_ketrie_clear(_z_ketrie_t *trie);
+
+#endif /* ZENOH_PICO_PROTOCOL_KETRIE_H */
@@ -24,6 +24,59 @@ zp_keyexpr_canon_status_t _z_keyexpr_canonize(char *start, size_t *len);
 _Bool _z_keyexpr_includes(const char *lstart, const size_t llen, const char *rstart, const size_t rlen);
 _Bool _z_keyexpr_intersects(const char *lstart, const size_t llen, const char *rstart, const size_t rlen);
 
+/*------------------ Compiled keyexprs ------------------*/
+#define _Z_KE_CHUNK_LITERAL 0    // A chunk without wildcards
+#define _Z_KE_CHUNK_VERBATIM 1   // A chunk starting with ``@``, only matched by itself
+#define _Z_KE_CHUNK_WILD 2       // The ``*`` chunk
+#define _Z_KE_CHUNK_SUPERWILD 3  // The ``**`` chunk
+#define _Z_KE_CHUNK_DSL 4        // A chunk containing ``$*``
+
+/**
+ * A chunk of a compiled key expression.
+ *
+ * Members:
+ *   size_t _start: The offset of the chunk in the key expression.
+ *   size_t _len: The length of the chunk.
+ *   uint8_t _kind: The kind of chunk, one of the ``_Z_KE_CHUNK_*`` values.
+ */
+typedef struct {
+    size_t _start;
+    size_t _len;
+    uint8_t _kind;
+} _z_keyexpr_chunk_t;
+
+/**
+ * A canonical key expression split once into its chunks, to be matched against many other key expressions without
+ * parsing it again. It borrows the key expression it was compiled from, which must outlive it.
+ *
+ * Members:
+ *   const char *_start: The compiled key expression.
+ *   size_t _len: The length of the compiled key expression.
+ *   _z_keyexpr_chunk_t *_chunks: The chunks of the key expression, or NULL if it could not be compiled.
+ *   size_t _n_chunks: The number of chunks.
+ *   size_t _n_prefix_chunks: The number of literal and verbatim chunks before the first wild or DSL one.
+ *   size_t _prefix_len: The length of these chunks, with the separators between them.
+ *   _Bool _has_superwild: Whether the key expression contains a ``**`` chunk.
+ */
+typedef struct {
+    const char *_start;
+    size_t _len;
+    _z_keyexpr_chunk_t *_chunks;
+    size_t _n_chunks;
+    size_t _n_prefix_chunks;
+    size_t _prefix_len;
+    _Bool _has_superwild;
+} _z_keyexpr_compiled_t;
+
+static inline _z_keyexpr_compiled_t _z_keyexpr_compiled_null(void) {
+    _z_keyexpr_compiled_t ke = {0};
+    return ke;
+}
+int8_t _z_keyexpr_compile(_z_keyexpr_compiled_t *ke, const char *start, size_t len);
+void _z_keyexpr_compiled_clear(_z_keyexpr_compiled_t *ke);
+_Bool _z_keyexpr_compiled_includes(const _z_keyexpr_compiled_t *l, const char *rstart, size_t rlen);
+_Bool _z_keyexpr_compiled_intersects(const _z_keyexpr_compiled_t *l, const char *rstart, size_t rlen);
+
 /*------------------ clone/Copy/Free helpers ------------------*/
 void _z_keyexpr_copy(_z_keyexpr_t *dst, const _z_keyexpr_t *src);
 _z_keyexpr_t _z_keyexpr_duplicate(_z_keyexpr_t src);
@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef INCLUDE_ZENOH_PICO_SESSION_DISPATCH_H
+#define INCLUDE_ZENOH_PICO_SESSION_DISPATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zenoh-pico/collections/mpsc.h"
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/session/session.h"
+#include "zenoh-pico/system/platform.h"
+
+#if Z_FEATURE_DISPATCH_POOL == 1
+#if Z_FEATURE_MULTI_THREAD == 0
+#error "The dispatch pool requires worker tasks, activate multi-thread or deactivate Z_FEATURE_DISPATCH_POOL"
+#endif
+#endif
+
+#if Z_FEATURE_DISPATCH_POOL == 1 && Z_FEATURE_SUBSCRIPTION == 1
+/**
+ * A sample waiting in the queue of a dispatch pool worker, for the worker to run the subscription callback on it.
+ *
+ * Members:
+ *   _z_subscription_rc_t _sub: A reference to the subscription, ``NULL`` if the sample could not be copied.
+ *   _z_sample_t _sample: The sample, owning a copy of its key expression, payload and encoding.
+ *   _z_owned_encoded_attachment_t _attachment: The attachment of the sample, copied in its encoded form.
+ */
+typedef struct {
+    _z_subscription_rc_t _sub;
+    _z_sample_t _sample;
+#if Z_FEATURE_ATTACHMENT == 1
+    _z_owned_encoded_attachment_t _attachment;
+#endif
+} _z_dispatch_job_t;
+
+/**
+ * A worker task of the dispatch pool, with its own queue of samples. The samples of a subscription always go to the
+ * same worker, which runs the callback on them in the order they were received.
+ *
+ * Members:
+ *   _z_mpsc_t _queue: The order of the jobs, filled by the read task and the local publishers.
+ *   _z_dispatch_job_t *_jobs: The Z_DISPATCH_POOL_QUEUE_SIZE jobs, indexed by queue slot.
+ *   zp_mutex_t _mutex: The mutex the worker and the producers wait on.
+ *   zp_condvar_t _cond_ready: Signaled when a job is published.
+ *   zp_condvar_t _cond_space: Signaled when a job is done.
+ *   zp_task_t *_task: The worker task, ``NULL`` while stopped.
+ *   zp_task_t _self: A copy of the worker task handle, to recognize the callbacks running on the worker.
+ *   volatile _Bool _running: Whether the worker task runs.
+ */
+typedef struct {
+    _z_mpsc_t _queue;
+    _z_dispatch_job_t *_jobs;
+    zp_mutex_t _mutex;
+    zp_condvar_t _cond_ready;
+    zp_condvar_t _cond_space;
+    zp_task_t *_task;
+    zp_task_t _self;
+    volatile _Bool _running;
+} _z_dispatch_worker_t;
+
+/**
+ * The worker tasks running the callbacks of the pooled subscribers of a session. The workers are allocated when the
+ * pool is first started, and kept until the session is cleared.
+ *
+ * Members:
+ *   _z_dispatch_worker_t *_workers: The workers.
+ *   size_t _len: The number of workers, ``0`` until the pool is first started.
+ */
+typedef struct {
+    _z_dispatch_worker_t *_workers;
+    size_t _len;
+} _z_dispatch_pool_t;
+
+void _z_dispatch_pool_init(_z_dispatch_pool_t *pool);
+int8_t _z_dispatch_pool_start(_z_dispatch_pool_t *pool, zp_task_attr_t *attr, size_t workers);
+int8_t _z_dispatch_pool_stop(_z_dispatch_pool_t *pool);
+void _z_dispatch_pool_clear(_z_dispatch_pool_t *pool);
+
+_Bool _z_dispatch_pool_enqueue(_z_dispatch_pool_t *pool, _z_subscription_rc_t *sub, const _z_sample_t *sample);
+#endif
+
+#endif /* INCLUDE_ZENOH_PICO_SESSION_DISPATCH_H */
@@ -24,11 +24,23 @@ _z_zint_t _z_get_query_id(_z_session_t *zn);
 
 _z_pending_query_t *_z_get_pending_query_by_id(_z_session_t *zn, const _z_zint_t id);
 
+/**
+ * Registers a pending query, the session taking a reference to it. The query is created with a single reference owned
+ * by its creator, which releases it with :c:func:`_z_pending_query_release` once it no longer accesses the query.
+ */
 int8_t _z_register_pending_query(_z_session_t *zn, _z_pending_query_t *pq);
+void _z_pending_query_release(_z_session_t *zn, _z_pending_query_t *pq);
 int8_t _z_trigger_query_reply_partial(_z_session_t *zn, _z_zint_t reply_context, const _z_keyexpr_t keyexpr,
                                       const _z_bytes_t payload, const _z_encoding_t encoding, const _z_zint_t kind,
                                       const _z_timestamp_t timestamp);
 int8_t _z_trigger_query_reply_final(_z_session_t *zn, _z_zint_t id);
+/**
+ * Completes the pending queries whose timeout elapsed, as if they received their final reply.
+ *
+ * Returns:
+ *     ``true`` if some pending queries are still to time out, ``false`` otherwise.
+ */
+_Bool _z_expire_pending_queries(_z_session_t *zn);
 void _z_unregister_pending_query(_z_session_t *zn, _z_pending_query_t *pq);
 void _z_flush_pending_queries(_z_session_t *zn);
 #endif
@@ -23,6 +23,9 @@
 uint32_t _z_get_entity_id(_z_session_t *zn);
 
 /*------------------ Resource ------------------*/
+void _z_resource_index_init(_z_resource_index_t *idx);
+void _z_resource_index_clear(_z_resource_index_t *idx);
+
 uint16_t _z_get_resource_id(_z_session_t *zn);
 _z_resource_t *_z_get_resource_by_id(_z_session_t *zn, uint16_t mapping, _z_zint_t rid);
 _z_resource_t *_z_get_resource_by_key(_z_session_t *zn, const _z_keyexpr_t *keyexpr);
@@ -33,7 +36,12 @@ void _z_unregister_resources_for_peer(_z_session_t *zn, uint16_t mapping);
 void _z_flush_resources(_z_session_t *zn);
 
 _z_keyexpr_t __unsafe_z_get_expanded_key_from_key(_z_session_t *zn, const _z_keyexpr_t *keyexpr);
+_z_keyexpr_t __unsafe_z_get_borrowed_expanded_key_from_key(_z_session_t *zn, const _z_keyexpr_t *keyexpr,
+                                                           _z_expanded_key_rc_t *ref);
 _z_resource_t *__unsafe_z_get_resource_by_id(_z_session_t *zn, uint16_t mapping, _z_zint_t id);
+#if Z_FEATURE_SUBSCRIPTION == 1
+void __unsafe_z_invalidate_subscription_caches(_z_session_t *zn);
+#endif
 _z_resource_t *__unsafe_z_get_resource_matching_key(_z_session_t *zn, const _z_keyexpr_t *keyexpr);
 
 #endif /* INCLUDE_ZENOH_PICO_SESSION_RESOURCE_H */
@@ -19,11 +19,14 @@
 #include <stdint.h>
 
 #include "zenoh-pico/collections/element.h"
+#include "zenoh-pico/collections/hashmap.h"
 #include "zenoh-pico/collections/list.h"
 #include "zenoh-pico/collections/refcount.h"
 #include "zenoh-pico/collections/string.h"
+#include "zenoh-pico/collections/timer_wheel.h"
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/protocol/core.h"
+#include "zenoh-pico/protocol/keyexpr.h"
 #include "zenoh-pico/transport/manager.h"
 
 /**
@@ -69,19 +72,6 @@ typedef struct {
 void _z_reply_clear(_z_reply_t *src);
 void _z_reply_free(_z_reply_t **hello);
 
-typedef struct {
-    _z_keyexpr_t _key;
-    uint16_t _id;
-    uint16_t _refcount;
-} _z_resource_t;
-
-_Bool _z_resource_eq(const _z_resource_t *one, const _z_resource_t *two);
-void _z_resource_clear(_z_resource_t *res);
-void _z_resource_free(_z_resource_t **res);
-
-_Z_ELEM_DEFINE(_z_resource, _z_resource_t, _z_noop_size, _z_resource_clear, _z_noop_copy)
-_Z_LIST_DEFINE(_z_resource, _z_resource_t)
-
 /**
  * The callback signature of the functions handling data messages.
  */
@@ -89,6 +79,7 @@ typedef void (*_z_data_handler_t)(const _z_sample_t *sample, void *arg);
 
 typedef struct {
     _z_keyexpr_t _key;
+    _z_keyexpr_compiled_t _compiled;
     uint16_t _key_id;
     uint32_t _id;
     _z_data_handler_t _callback;
@@ -104,6 +95,67 @@ _Z_REFCOUNT_DEFINE(_z_subscription, _z_subscription)
 _Z_ELEM_DEFINE(_z_subscriber, _z_subscription_t, _z_noop_size, _z_subscription_clear, _z_noop_copy)
 _Z_ELEM_DEFINE(_z_subscription_rc, _z_subscription_rc_t, _z_noop_size, _z_subscription_rc_drop, _z_noop_copy)
 _Z_LIST_DEFINE(_z_subscription_rc, _z_subscription_rc_t)
+_Z_ARRAY_DEFINE(_z_subscription_rc, _z_subscription_rc_t)
+
+/**
+ * The local subscriptions intersecting a declared resource, precomputed to dispatch the samples received on it
+ * without matching them. It is shared by reference with the samples being dispatched, so that it outlives its
+ * invalidation.
+ */
+typedef _z_subscription_rc_array_t _z_subscription_cache_t;
+
+static inline void _z_subscription_cache_clear(_z_subscription_cache_t *cache) {
+    _z_subscription_rc_array_clear(cache);
+}
+
+_Z_REFCOUNT_DEFINE(_z_subscription_cache, _z_subscription_cache)
+
+/**
+ * The fully expanded key of a declared resource. It is shared by reference with the samples being dispatched on
+ * the resource, so that it outlives a concurrent undeclaration.
+ *
+ * Members:
+ *   char *_suffix: The owned, null-terminated, expanded key.
+ *   size_t _len: The length of the expanded key.
+ */
+typedef struct {
+    char *_suffix;
+    size_t _len;
+} _z_expanded_key_t;
+
+void _z_expanded_key_clear(_z_expanded_key_t *key);
+
+_Z_REFCOUNT_DEFINE(_z_expanded_key, _z_expanded_key)
+
+typedef struct {
+    _z_keyexpr_t _key;
+    uint16_t _id;
+    uint16_t _refcount;
+    _z_expanded_key_rc_t _expanded_key;
+#if Z_FEATURE_SUBSCRIPTION == 1
+    _z_subscription_cache_rc_t _subscriptions;
+#endif
+} _z_resource_t;
+
+_Bool _z_resource_eq(const _z_resource_t *one, const _z_resource_t *two);
+void _z_resource_clear(_z_resource_t *res);
+void _z_resource_free(_z_resource_t **res);
+
+_Z_ELEM_DEFINE(_z_resource, _z_resource_t, _z_noop_size, _z_resource_clear, _z_noop_copy)
+_Z_LIST_DEFINE(_z_resource, _z_resource_t)
+
+/**
+ * The lookup indexes of a resource list. Resources are owned by the list, the indexes only reference them.
+ *
+ * Members:
+ *   _z_hashmap_t _by_id: The resources indexed by their mapping and id.
+ *   _z_hashmap_t _by_key: The resources indexed by their mapping, prefix id and suffix.
+ */
+typedef struct {
+    _z_hashmap_t _by_id;
+    _z_hashmap_t _by_key;
+} _z_resource_index_t;
+
 
 typedef struct {
     _z_keyexpr_t _key;
@@ -118,6 +170,7 @@ typedef void (*_z_queryable_handler_t)(const z_query_t *query, void *arg);
 
 typedef struct {
     _z_keyexpr_t _key;
+    _z_keyexpr_compiled_t _compiled;
     uint32_t _id;
     _z_queryable_handler_t _callback;
     _z_drop_handler_t _dropper;
@@ -137,13 +190,29 @@ _Z_LIST_DEFINE(_z_session_queryable_rc, _z_session_queryable_rc_t)
 typedef struct {
     _z_reply_t _reply;
     _z_timestamp_t _tstamp;
+    size_t _hash;  // Hash of the key expression of the reply
 } _z_pending_reply_t;
 
-_Bool _z_pending_reply_eq(const _z_pending_reply_t *one, const _z_pending_reply_t *two);
 void _z_pending_reply_clear(_z_pending_reply_t *res);
 
-_Z_ELEM_DEFINE(_z_pending_reply, _z_pending_reply_t, _z_noop_size, _z_pending_reply_clear, _z_noop_copy)
-_Z_LIST_DEFINE(_z_pending_reply, _z_pending_reply_t)
+/**
+ * The replies kept to consolidate a query, one per key expression.
+ *
+ * Members:
+ *   _z_pending_reply_t *_replies: The replies, in a growable array.
+ *   size_t _len: The number of replies.
+ *   size_t _capacity: The number of replies the array can hold.
+ *   _z_hashmap_t _by_key: The replies indexed by their key expression.
+ */
+typedef struct {
+    _z_pending_reply_t *_replies;
+    size_t _len;
+    size_t _capacity;
+    _z_hashmap_t _by_key;
+} _z_pending_replies_t;
+
+void _z_pending_replies_init(_z_pending_replies_t *prs);
+void _z_pending_replies_clear(_z_pending_replies_t *prs);
 
 struct __z_reply_handler_wrapper_t;  // Forward declaration to be used in _z_reply_handler_t
 /**
@@ -159,7 +228,10 @@ typedef struct {
     void *_call_arg;  // TODO[API-NET]: These two can be merged into one, when API and NET are a single layer
     void *_drop_arg;  // TODO[API-NET]: These two can be merged into one, when API and NET are a single layer
     char *_parameters;
-    _z_pending_reply_list_t *_pending_replies;
+    _z_pending_replies_t _pending_replies;
+    _z_timer_t _timeout;
+    uint32_t _timeout_ms;  // 0 if the query never expires
+    size_t _refcount;      // Held by its creator, the session and the callbacks in progress, under the session mutex
     z_query_target_t _target;
     z_consolidation_mode_t _consolidation;
     _Bool _anykey;
@@ -36,6 +36,9 @@ void _z_close_tcp(_z_sys_net_socket_t *sock);
 size_t _z_read_exact_tcp(const _z_sys_net_socket_t sock, uint8_t *ptr, size_t len);
 size_t _z_read_tcp(const _z_sys_net_socket_t sock, uint8_t *ptr, size_t len);
 size_t _z_send_tcp(const _z_sys_net_socket_t sock, const uint8_t *ptr, size_t len);
+#if defined(_Z_SYS_NET_SEND_VEC_MAX)
+size_t _z_send_vec_tcp(const _z_sys_net_socket_t sock, const _z_bytes_t *bufs, size_t count);
+#endif
 #endif
 
 #endif /* ZENOH_PICO_SYSTEM_LINK_TCP_H */
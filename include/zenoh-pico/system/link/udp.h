@@ -40,6 +40,15 @@ size_t _z_read_exact_udp_unicast(const _z_sys_net_socket_t sock, uint8_t *ptr, s
 size_t _z_read_udp_unicast(const _z_sys_net_socket_t sock, uint8_t *ptr, size_t len);
 size_t _z_send_udp_unicast(const _z_sys_net_socket_t sock, const uint8_t *ptr, size_t len,
                            const _z_sys_net_endpoint_t rep);
+#if defined(_Z_SYS_NET_SEND_VEC_MAX)
+size_t _z_send_vec_udp_unicast(const _z_sys_net_socket_t sock, const _z_bytes_t *bufs, size_t count,
+                               const _z_sys_net_endpoint_t rep);
+#endif
+#if defined(_Z_SYS_NET_MULTI_DATAGRAM_MAX)
+size_t _z_read_multi_udp_unicast(const _z_sys_net_socket_t sock, uint8_t *const *ptrs, size_t *lens, size_t count);
+size_t _z_send_multi_udp_unicast(const _z_sys_net_socket_t sock, const _z_bytes_t *dgrams, size_t count,
+                                 const _z_sys_net_endpoint_t rep);
+#endif
 
 // Multicast
 int8_t _z_open_udp_multicast(_z_sys_net_socket_t *sock, const _z_sys_net_endpoint_t rep, _z_sys_net_endpoint_t *lep,
@@ -54,6 +63,16 @@ size_t _z_read_udp_multicast(const _z_sys_net_socket_t sock, uint8_t *ptr, size_
                              _z_bytes_t *ep);
 size_t _z_send_udp_multicast(const _z_sys_net_socket_t sock, const uint8_t *ptr, size_t len,
                              const _z_sys_net_endpoint_t rep);
+#if defined(_Z_SYS_NET_SEND_VEC_MAX)
+size_t _z_send_vec_udp_multicast(const _z_sys_net_socket_t sock, const _z_bytes_t *bufs, size_t count,
+                                 const _z_sys_net_endpoint_t rep);
+#endif
+#if defined(_Z_SYS_NET_MULTI_DATAGRAM_MAX)
+size_t _z_read_multi_udp_multicast(const _z_sys_net_socket_t sock, uint8_t *const *ptrs, size_t *lens, size_t count,
+                                   const _z_sys_net_endpoint_t lep, _z_bytes_t *addrs);
+size_t _z_send_multi_udp_multicast(const _z_sys_net_socket_t sock, const _z_bytes_t *dgrams, size_t count,
+                                   const _z_sys_net_endpoint_t rep);
+#endif
 #endif
 
 #endif /* ZENOH_PICO_SYSTEM_LINK_UDP_H */
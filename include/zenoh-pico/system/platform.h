@@ -58,12 +58,41 @@ void *zp_malloc(size_t size);
 void *zp_realloc(void *ptr, size_t size);
 void zp_free(void *ptr);
 
+#if Z_FEATURE_SLAB_ALLOCATOR == 1
+#if !defined(ZENOH_LINUX) && !defined(ZENOH_MACOS) && !defined(ZENOH_BSD)
+#error "The slab allocator is only available on unix platforms, deactivate Z_FEATURE_SLAB_ALLOCATOR"
+#endif
+
+/**
+ * Counters of the slab allocator behind zp_malloc, since the start of the process. In steady state, allocations are
+ * served by the slabs and these counters stay still.
+ *
+ * Members:
+ *   size_t system_allocs: The calls to the system allocator, for new chunks and for blocks larger than the size
+ *     classes.
+ *   size_t system_frees: The blocks larger than the size classes given back to the system allocator.
+ *   size_t chunks: The chunks carved into blocks of a size class.
+ *   size_t refills: The times a thread cache took free blocks from the shared pool of a size class.
+ *   size_t flushes: The times a thread cache gave free blocks back to the shared pool of a size class.
+ */
+typedef struct {
+    size_t system_allocs;
+    size_t system_frees;
+    size_t chunks;
+    size_t refills;
+    size_t flushes;
+} zp_malloc_stats_t;
+
+void zp_malloc_stats_get(zp_malloc_stats_t *stats);
+#endif
+
 #if Z_FEATURE_MULTI_THREAD == 1
 /*------------------ Thread ------------------*/
 int8_t zp_task_init(zp_task_t *task, zp_task_attr_t *attr, void *(*fun)(void *), void *arg);
 int8_t zp_task_join(zp_task_t *task);
 int8_t zp_task_cancel(zp_task_t *task);
 void zp_task_free(zp_task_t **task);
+_Bool zp_task_is_current(const zp_task_t *task);
 
 /*------------------ Mutex ------------------*/
 int8_t zp_mutex_init(zp_mutex_t *m);
@@ -31,16 +31,32 @@ typedef pthread_mutex_t zp_mutex_t;
 typedef pthread_cond_t zp_condvar_t;
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
+// Maximum number of buffers gathered by a single vectored socket send, see _z_send_vec_tcp
+#define _Z_SYS_NET_SEND_VEC_MAX 16
+
+#if defined(ZENOH_LINUX)
+// Maximum number of datagrams received or sent by a single system call, see _z_read_multi_udp_multicast
+#define _Z_SYS_NET_MULTI_DATAGRAM_MAX 16
+#endif
+
 typedef struct timespec zp_clock_t;
 typedef struct timeval zp_time_t;
 
+#if Z_FEATURE_LINK_SERIAL == 1
+// Frame buffers of a serial link, see src/system/unix/network.c
+struct _z_serial_frames_t;
+#endif
+
 typedef struct {
     union {
 #if Z_FEATURE_LINK_TCP == 1 || Z_FEATURE_LINK_UDP_MULTICAST == 1 || Z_FEATURE_LINK_UDP_UNICAST == 1 || \
-    Z_FEATURE_RAWETH_TRANSPORT == 1
+    Z_FEATURE_RAWETH_TRANSPORT == 1 || Z_FEATURE_LINK_SERIAL == 1
         int _fd;
 #endif
     };
+#if Z_FEATURE_LINK_SERIAL == 1
+    struct _z_serial_frames_t *_serial;
+#endif
 } _z_sys_net_socket_t;
 
 typedef struct {
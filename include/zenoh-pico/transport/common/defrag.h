@@ -0,0 +1,69 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_TRANSPORT_DEFRAG_H
+#define ZENOH_PICO_TRANSPORT_DEFRAG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/protocol/definitions/network.h"
+#include "zenoh-pico/protocol/iobuf.h"
+
+#if Z_DEFRAG_POOL_SIZE < 1
+#error "Z_DEFRAG_POOL_SIZE must be at least 1"
+#endif
+
+/*------------------ Defragmentation pool ------------------*/
+/**
+ * The defragmentation buffers kept by a transport once their message is reassembled, to be reused by the next one.
+ *
+ * Members:
+ *   _z_zbuf_t _bufs[Z_DEFRAG_POOL_SIZE]: The free buffers, with their capacity.
+ *   size_t _len: The number of free buffers.
+ */
+typedef struct {
+    _z_zbuf_t _bufs[Z_DEFRAG_POOL_SIZE];
+    size_t _len;
+} _z_defrag_pool_t;
+
+int8_t _z_defrag_pool_init(_z_defrag_pool_t *pool, size_t prealloc);
+void _z_defrag_pool_clear(_z_defrag_pool_t *pool);
+
+/*------------------ Defragmentation buffer ------------------*/
+/**
+ * The reassembly buffer of a reliability channel. The fragments are appended to a single contiguous buffer, lent by
+ * the pool of the transport for the time of the message, and the network message is decoded in place.
+ *
+ * Members:
+ *   _z_zbuf_t _zbuf: The fragments received so far, without buffer if no message is being reassembled.
+ *   _Bool _drop: Whether the message exceeds Z_FRAG_MAX_SIZE, or could not be buffered, and must be dropped.
+ */
+typedef struct {
+    _z_zbuf_t _zbuf;
+    _Bool _drop;
+} _z_defrag_t;
+
+void _z_defrag_init(_z_defrag_t *dbuf);
+size_t _z_defrag_len(const _z_defrag_t *dbuf);
+
+int8_t _z_defrag_push(_z_defrag_t *dbuf, _z_defrag_pool_t *pool, const _z_bytes_t *fragment);
+int8_t _z_defrag_decode(_z_defrag_t *dbuf, _z_network_message_t *n_msg);
+void _z_defrag_release(_z_defrag_t *dbuf, _z_defrag_pool_t *pool);
+
+void _z_defrag_copy(_z_defrag_t *dst, const _z_defrag_t *src);
+void _z_defrag_clear(_z_defrag_t *dbuf);
+
+#endif /* ZENOH_PICO_TRANSPORT_DEFRAG_H */
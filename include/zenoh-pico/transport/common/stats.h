@@ -0,0 +1,77 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_TRANSPORT_STATS_H
+#define ZENOH_PICO_TRANSPORT_STATS_H
+
+#include <stddef.h>
+
+#include "zenoh-pico/config.h"
+
+/**
+ * The counters of a transport, since it was opened. The counters wrap around once they reach ``SIZE_MAX``.
+ *
+ * Members:
+ *   size_t tx_bytes: The bytes sent on the link, including the length prefixes of stream links.
+ *   size_t tx_batches: The batches sent on the link, each in a single write or datagram.
+ *   size_t tx_n_msgs: The network messages sent, whether framed or fragmented.
+ *   size_t tx_fragments: The fragments sent.
+ *   size_t tx_keep_alives: The keep-alive messages sent.
+ *   size_t tx_cc_drops: The network messages dropped because of congestion control.
+ *   size_t rx_bytes: The bytes received from the link, including the length prefixes of stream links.
+ *   size_t rx_batches: The batches received from the link.
+ *   size_t rx_n_msgs: The network messages received, whether framed or reassembled.
+ *   size_t rx_fragments: The fragments received.
+ *   size_t rx_keep_alives: The keep-alive messages received.
+ *   size_t rx_sn_drops: The frames and fragments dropped because their sequence number is out of order.
+ *   size_t rx_decode_errors: The transport or network messages that could not be decoded.
+ *   size_t rx_reassembly_aborts: The fragmented messages given up before their last fragment.
+ */
+typedef struct {
+    size_t tx_bytes;
+    size_t tx_batches;
+    size_t tx_n_msgs;
+    size_t tx_fragments;
+    size_t tx_keep_alives;
+    size_t tx_cc_drops;
+    size_t rx_bytes;
+    size_t rx_batches;
+    size_t rx_n_msgs;
+    size_t rx_fragments;
+    size_t rx_keep_alives;
+    size_t rx_sn_drops;
+    size_t rx_decode_errors;
+    size_t rx_reassembly_aborts;
+} _z_stats_t;
+
+void _z_stats_init(_z_stats_t *stats);
+void _z_stats_snapshot(_z_stats_t *dst, const _z_stats_t *src);
+
+#if Z_FEATURE_STATS == 1
+// The counters are updated by the tasks and the API threads concurrently, without ordering each other
+#if Z_FEATURE_MULTI_THREAD == 1 && (defined(ZENOH_COMPILER_GCC) || defined(ZENOH_COMPILER_CLANG) || defined(__GNUC__))
+#define _Z_STATS_ADD(stats, counter, n) (void)__atomic_fetch_add(&(stats).counter, (size_t)(n), __ATOMIC_RELAXED)
+#define _Z_STATS_LOAD(stats, counter) __atomic_load_n(&(stats).counter, __ATOMIC_RELAXED)
+#else
+#define _Z_STATS_ADD(stats, counter, n) ((stats).counter += (size_t)(n))
+#define _Z_STATS_LOAD(stats, counter) ((stats).counter)
+#endif
+#else
+#define _Z_STATS_ADD(stats, counter, n)
+#define _Z_STATS_LOAD(stats, counter) ((stats).counter)
+#endif
+
+#define _Z_STATS_INC(stats, counter) _Z_STATS_ADD(stats, counter, 1)
+
+#endif /* ZENOH_PICO_TRANSPORT_STATS_H */
@@ -27,6 +27,7 @@ int8_t __unsafe_z_serialize_zenoh_fragment(_z_wbuf_t *dst, _z_wbuf_t *src, z_rel
 
 /*------------------ Transmission and Reception helpers ------------------*/
 int8_t _z_send_t_msg(_z_transport_t *zt, const _z_transport_message_t *t_msg);
+int8_t _z_flush(_z_transport_t *zt);
 int8_t _z_link_send_t_msg(const _z_link_t *zl, const _z_transport_message_t *t_msg);
 
 #endif /* ZENOH_PICO_TRANSPORT_TX_H */
@@ -20,16 +20,19 @@
 
 #include "zenoh-pico/collections/bytes.h"
 #include "zenoh-pico/collections/element.h"
+#include "zenoh-pico/collections/mpsc.h"
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/link/link.h"
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/protocol/definitions/transport.h"
+#include "zenoh-pico/transport/common/defrag.h"
+#include "zenoh-pico/transport/common/stats.h"
 
 typedef struct {
 #if Z_FEATURE_FRAGMENTATION == 1
-    // Defragmentation buffers
-    _z_wbuf_t _dbuf_reliable;
-    _z_wbuf_t _dbuf_best_effort;
+    // Defragmentation buffers, lent by the pool of the transport
+    _z_defrag_t _dbuf_reliable;
+    _z_defrag_t _dbuf_best_effort;
 #endif
 
     _z_id_t _remote_zid;
@@ -63,6 +66,27 @@ typedef struct _z_transport_multicast_t _z_transport_multicast_t;
 // Send function prototype
 typedef int8_t (*_zp_f_send_tmsg)(_z_transport_multicast_t *self, const _z_transport_message_t *t_msg);
 
+#if Z_FEATURE_TX_QUEUE == 1
+#if Z_FEATURE_MULTI_THREAD == 0
+#error "The transmit queue requires a TX task, activate multi-thread or deactivate Z_FEATURE_TX_QUEUE"
+#endif
+#if Z_TX_QUEUE_PRIORITIES < 1 || Z_TX_QUEUE_PRIORITIES > Z_PRIORITIES_NUM
+#error "The number of transmit queue priority classes must be between 1 and 8"
+#endif
+
+/**
+ * A network message encoded in the transmit queue, waiting for the TX task to frame and send it.
+ *
+ * Members:
+ *   _z_wbuf_t _wbuf: The encoded network message, empty if it failed to encode.
+ *   z_reliability_t _reliability: The reliability of the frame to send the message in.
+ */
+typedef struct {
+    _z_wbuf_t _wbuf;
+    z_reliability_t _reliability;
+} _z_tx_queue_entry_t;
+#endif
+
 typedef struct {
     // Session associated to the transport
     _z_session_t *_session;
@@ -76,9 +100,10 @@ typedef struct {
     _z_link_t _link;
 
 #if Z_FEATURE_FRAGMENTATION == 1
-    // Defragmentation buffer
-    _z_wbuf_t _dbuf_reliable;
-    _z_wbuf_t _dbuf_best_effort;
+    // Defragmentation buffers
+    _z_defrag_pool_t _dbuf_pool;
+    _z_defrag_t _dbuf_reliable;
+    _z_defrag_t _dbuf_best_effort;
 #endif
 
     // Regular Buffers
@@ -95,6 +120,15 @@ typedef struct {
     _z_zint_t _sn_rx_best_effort;
     volatile _z_zint_t _lease;
 
+#if Z_FEATURE_BATCHING == 1
+    // Frame kept open in _wbuf to append the next network messages
+    zp_clock_t _batch_start;
+    z_reliability_t _batch_reliability;
+    volatile _Bool _batch_pending;
+    _Bool _batch_armed;     // Whether a batch may be kept open, the lease task then waking up in time to flush it
+    _Bool _batch_activity;  // Whether network messages were sent since the lease task last armed the batches
+#endif
+
 #if Z_FEATURE_MULTI_THREAD == 1
     zp_task_t *_read_task;
     zp_task_t *_lease_task;
@@ -102,6 +136,22 @@ typedef struct {
     volatile _Bool _lease_task_running;
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
+#if Z_FEATURE_TX_QUEUE == 1
+    // Network messages queued by the publishers by priority class, framed and sent by the TX task
+    _z_mpsc_t _tx_queues[Z_TX_QUEUE_PRIORITIES];
+    _z_tx_queue_entry_t *_tx_queue_entries;  // Z_TX_QUEUE_SIZE entries per priority class
+    zp_mutex_t _mutex_tx_queue;
+    zp_condvar_t _cond_tx_ready;
+    zp_condvar_t _cond_tx_space[Z_TX_QUEUE_PRIORITIES];
+    zp_condvar_t _cond_tx_claims;  // Signaled for the sender draining the queues once closed
+    zp_task_t *_tx_task;
+    volatile _Bool _tx_task_running;
+#endif
+
+#if Z_FEATURE_STATS == 1
+    _z_stats_t _stats;
+#endif
+
     volatile _Bool _received;
     volatile _Bool _transmitted;
 } _z_transport_unicast_t;
@@ -125,6 +175,21 @@ typedef struct _z_transport_multicast_t {
     _z_wbuf_t _wbuf;
     _z_zbuf_t _zbuf;
 
+    // Datagram slots to receive, or send, several datagrams with a single system call. NULL if the link cannot.
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_zbuf_t *_rx_slots;
+    _z_bytes_t *_rx_slot_addrs;
+#endif  // Z_FEATURE_MULTI_THREAD == 1
+#if Z_FEATURE_FRAGMENTATION == 1
+    _z_wbuf_t *_tx_slots;
+#endif
+    size_t _slots_len;
+
+#if Z_FEATURE_FRAGMENTATION == 1
+    // Defragmentation buffers lent to the peers
+    _z_defrag_pool_t _dbuf_pool;
+#endif
+
     // SN initial numbers
     _z_zint_t _sn_res;
     _z_zint_t _sn_tx_reliable;
@@ -144,6 +209,10 @@ typedef struct _z_transport_multicast_t {
     volatile _Bool _lease_task_running;
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
+#if Z_FEATURE_STATS == 1
+    _z_stats_t _stats;
+#endif
+
     volatile _Bool _transmitted;
 } _z_transport_multicast_t;
 
@@ -185,5 +254,8 @@ typedef struct {
 int8_t _z_transport_close(_z_transport_t *zt, uint8_t reason);
 void _z_transport_clear(_z_transport_t *zt);
 void _z_transport_free(_z_transport_t **zt);
+#if Z_FEATURE_STATS == 1
+void _z_transport_get_stats(const _z_transport_t *zt, _z_stats_t *stats);
+#endif
 
 #endif /* INCLUDE_ZENOH_PICO_TRANSPORT_TRANSPORT_H */
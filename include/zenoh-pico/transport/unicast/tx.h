@@ -21,5 +21,15 @@
 int8_t _z_unicast_send_n_msg(_z_session_t *zn, const _z_network_message_t *z_msg, z_reliability_t reliability,
                              z_congestion_control_t cong_ctrl);
 int8_t _z_unicast_send_t_msg(_z_transport_unicast_t *ztu, const _z_transport_message_t *t_msg);
+int8_t _z_unicast_flush(_z_transport_unicast_t *ztu);
+int8_t _z_unicast_flush_expired(_z_transport_unicast_t *ztu);
+_Bool _z_unicast_arm_batches(_z_transport_unicast_t *ztu);
+int8_t _z_unicast_disarm_batches(_z_transport_unicast_t *ztu);
+
+#if Z_FEATURE_TX_QUEUE == 1 && Z_FEATURE_UNICAST_TRANSPORT == 1
+int8_t _zp_unicast_start_tx_task(_z_transport_unicast_t *ztu, zp_task_attr_t *attr, zp_task_t *task);
+int8_t _zp_unicast_stop_tx_task(_z_transport_unicast_t *ztu);
+void _z_unicast_tx_queue_clear(_z_transport_unicast_t *ztu);
+#endif /* Z_FEATURE_TX_QUEUE == 1 && Z_FEATURE_UNICAST_TRANSPORT == 1 */
 
 #endif /* ZENOH_PICO_TRANSPORT_LINK_TX_H */
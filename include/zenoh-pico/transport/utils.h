@@ -17,6 +17,7 @@
 
 #include <stdbool.h>
 
+#include "zenoh-pico/link/link.h"
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/protocol/definitions/transport.h"
 
@@ -31,4 +32,7 @@ _z_zint_t _z_sn_decrement(const _z_zint_t sn_resolution, const _z_zint_t sn);
 void _z_conduit_sn_list_copy(_z_conduit_sn_list_t *dst, const _z_conduit_sn_list_t *src);
 void _z_conduit_sn_list_decrement(const _z_zint_t sn_resolution, _z_conduit_sn_list_t *sns);
 
+/*------------------ Batch helpers ------------------*/
+size_t _z_batch_wire_len(const _z_link_t *zl, size_t len);
+
 #endif /* ZENOH_PICO_TRANSPORT_UTILS_H */
@@ -21,4 +21,20 @@
 size_t _z_cobs_encode(const uint8_t *input, size_t input_len, uint8_t *output);
 size_t _z_cobs_decode(const uint8_t *input, size_t input_len, uint8_t *output);
 
+/**
+ * Streaming COBS encoder: the input is fed in as many pieces as needed, which produces the same bytes as
+ * _z_cobs_encode on the concatenated input without having to assemble it first.
+ * The output must have room for the input plus one overhead byte per 254 input bytes and one more.
+ */
+typedef struct {
+    uint8_t *_start;
+    uint8_t *_pos;   // Next output byte
+    uint8_t *_code;  // Code byte of the current block
+    uint8_t _count;  // Value of the code byte of the current block so far
+} _z_cobs_encoder_t;
+
+void _z_cobs_encoder_init(_z_cobs_encoder_t *enc, uint8_t *output);
+void _z_cobs_encoder_update(_z_cobs_encoder_t *enc, const uint8_t *input, size_t input_len);
+size_t _z_cobs_encoder_finish(_z_cobs_encoder_t *enc);
+
 #endif /* ZENOH_PICO_UTILS_ENCODING_H */
@@ -26,6 +26,45 @@ typedef struct {
     char const *delimiter;
 } _z_splitstr_t;
 
+// The bytes classified at once by _z_str_classify: 32 with AVX2, 16 with SSE2, NEON or the portable fallback
+#if defined(__AVX2__)
+#define _Z_STR_CLASS_BLOCK 32
+#else
+#define _Z_STR_CLASS_BLOCK 16
+#endif
+
+/**
+ * The bytes of a block of a key expression that have a special meaning, as bitmasks where bit ``i`` stands for the
+ * ``i``-th byte of the block.
+ */
+typedef struct {
+    uint32_t slash;
+    uint32_t star;
+    uint32_t dollar;
+    uint32_t at;
+} _z_str_class_t;
+
+/**
+ * Classifies the ``len`` bytes from ``start`` into ``cls``, where ``len`` is at most ``_Z_STR_CLASS_BLOCK``.
+ * The bytes are compared all at once with SSE2, AVX2 or NEON when the target has them.
+ */
+void _z_str_classify(const char *start, size_t len, _z_str_class_t *cls);
+
+/**
+ * A non-null-terminated equivalent of libc's `strchr`, and its reverse, scanning a block of bytes at once when the
+ * target has SIMD instructions.
+ *
+ * Returns NULL if ``c`` is not found in ``[start, end)``.
+ * If found, the return pointer will point to the first (resp. last) occurrence of ``c``.
+ */
+char const *_z_strchr_se(char const *start, char const *end, char c);
+char const *_z_strrchr_se(char const *start, char const *end, char c);
+
+/**
+ * Counts the bits set in ``mask``.
+ */
+size_t _z_bits_count(uint32_t mask);
+
 /**
  * The reverse equivalent of libc's `strstr`.
  *
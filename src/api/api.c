@@ -202,6 +202,43 @@ int8_t zp_keyexpr_equals_null_terminated(const char *l, const char *r) {
     return ret;
 }
 
+int8_t zp_keyexpr_compile(zp_keyexpr_compiled_t *compiled, const char *keyexpr) {
+    int8_t ret = _Z_ERR_GENERIC;
+
+    if (keyexpr != NULL) {
+        ret = _z_keyexpr_compile(compiled, keyexpr, strlen(keyexpr));
+        if (ret != _Z_RES_OK) {
+            _z_keyexpr_compiled_clear(compiled);
+        }
+    } else {
+        *compiled = _z_keyexpr_compiled_null();
+    }
+
+    return ret;
+}
+
+void zp_keyexpr_compiled_drop(zp_keyexpr_compiled_t *compiled) { _z_keyexpr_compiled_clear(compiled); }
+
+int8_t zp_keyexpr_compiled_includes(const zp_keyexpr_compiled_t *l, z_keyexpr_t r) {
+    int8_t ret = _Z_ERR_GENERIC;
+
+    if ((l->_chunks != NULL) && (r._id == Z_RESOURCE_ID_NONE) && (r._suffix != NULL)) {
+        ret = (_z_keyexpr_compiled_includes(l, r._suffix, strlen(r._suffix)) == true) ? 0 : -1;
+    }
+
+    return ret;
+}
+
+int8_t zp_keyexpr_compiled_intersects(const zp_keyexpr_compiled_t *l, z_keyexpr_t r) {
+    int8_t ret = _Z_ERR_GENERIC;
+
+    if ((l->_chunks != NULL) && (r._id == Z_RESOURCE_ID_NONE) && (r._suffix != NULL)) {
+        ret = (_z_keyexpr_compiled_intersects(l, r._suffix, strlen(r._suffix)) == true) ? 0 : -1;
+    }
+
+    return ret;
+}
+
 z_owned_config_t z_config_new(void) { return (z_owned_config_t){._value = _z_config_empty()}; }
 
 z_owned_config_t z_config_default(void) { return (z_owned_config_t){._value = _z_config_default()}; }
@@ -783,7 +820,7 @@ OWNED_FUNCTIONS_PTR_INTERNAL(z_reply_t, z_owned_reply_t, reply, _z_reply_free, _
 z_get_options_t z_get_options_default(void) {
     return (z_get_options_t) {
         .target = z_query_target_default(), .consolidation = z_query_consolidation_default(),
-        .value = {.encoding = z_encoding_default(), .payload = _z_bytes_empty()},
+        .value = {.encoding = z_encoding_default(), .payload = _z_bytes_empty()}, .timeout_ms = Z_GET_TIMEOUT_DEFAULT,
 #if Z_FEATURE_ATTACHMENT == 1
         // TODO:ATT.attachment = z_attachment_null()
 #endif
@@ -814,6 +851,7 @@ int8_t z_get(z_session_t zs, z_keyexpr_t keyexpr, const char *parameters, z_owne
         opt.consolidation = options->consolidation;
         opt.target = options->target;
         opt.value = options->value;
+        opt.timeout_ms = options->timeout_ms;
     }
 
     if (opt.consolidation.mode == Z_CONSOLIDATION_MODE_AUTO) {
@@ -835,7 +873,7 @@ int8_t z_get(z_session_t zs, z_keyexpr_t keyexpr, const char *parameters, z_owne
     }
 
     ret = _z_query(&zs._val.in->val, keyexpr, parameters, opt.target, opt.consolidation.mode, opt.value,
-                   __z_reply_handler, wrapped_ctx, callback->drop, ctx
+                   __z_reply_handler, wrapped_ctx, callback->drop, ctx, opt.timeout_ms
 #if Z_FEATURE_ATTACHMENT == 1
                    ,
                    z_attachment_null()
@@ -965,7 +1003,7 @@ OWNED_FUNCTIONS_PTR_CLONE(z_pull_subscriber_t, z_owned_pull_subscriber_t, pull_s
 void z_pull_subscriber_drop(z_owned_pull_subscriber_t *val) { z_undeclare_pull_subscriber(val); }
 
 z_subscriber_options_t z_subscriber_options_default(void) {
-    return (z_subscriber_options_t){.reliability = Z_RELIABILITY_DEFAULT};
+    return (z_subscriber_options_t){.reliability = Z_RELIABILITY_DEFAULT, .dispatch = Z_DISPATCH_DEFAULT};
 }
 
 z_pull_subscriber_options_t z_pull_subscriber_options_default(void) {
@@ -1010,6 +1048,7 @@ z_owned_subscriber_t z_declare_subscriber(z_session_t zs, z_keyexpr_t keyexpr, z
     _z_subinfo_t subinfo = _z_subinfo_push_default();
     if (options != NULL) {
         subinfo.reliability = options->reliability;
+        subinfo.dispatch = options->dispatch;
     }
     _z_subscriber_t *sub = _z_declare_subscriber(&zs._val, key, subinfo, callback->call, callback->drop, ctx);
     if (suffix != NULL) {
@@ -1153,6 +1192,73 @@ int8_t zp_stop_lease_task(z_session_t zs) {
 #endif
 }
 
+zp_task_tx_options_t zp_task_tx_options_default(void) {
+    return (zp_task_tx_options_t) {
+#if Z_FEATURE_MULTI_THREAD == 1
+        .task_attributes = NULL
+#else
+        .__dummy = 0
+#endif
+    };
+}
+
+int8_t zp_start_tx_task(z_session_t zs, const zp_task_tx_options_t *options) {
+    (void)(options);
+#if Z_FEATURE_MULTI_THREAD == 1
+    zp_task_tx_options_t opt = zp_task_tx_options_default();
+    if (options != NULL) {
+        opt.task_attributes = options->task_attributes;
+    }
+    return _zp_start_tx_task(&zs._val.in->val, opt.task_attributes);
+#else
+    (void)(zs);
+    return -1;
+#endif
+}
+
+int8_t zp_stop_tx_task(z_session_t zs) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    return _zp_stop_tx_task(&zs._val.in->val);
+#else
+    (void)(zs);
+    return -1;
+#endif
+}
+
+zp_task_dispatch_options_t zp_task_dispatch_options_default(void) {
+    return (zp_task_dispatch_options_t) {
+#if Z_FEATURE_MULTI_THREAD == 1
+        .task_attributes = NULL, .workers = Z_DISPATCH_POOL_WORKERS
+#else
+        .__dummy = 0
+#endif
+    };
+}
+
+int8_t zp_start_dispatch_tasks(z_session_t zs, const zp_task_dispatch_options_t *options) {
+    (void)(options);
+#if Z_FEATURE_MULTI_THREAD == 1
+    zp_task_dispatch_options_t opt = zp_task_dispatch_options_default();
+    if (options != NULL) {
+        opt.task_attributes = options->task_attributes;
+        opt.workers = options->workers;
+    }
+    return _zp_start_dispatch_tasks(&zs._val.in->val, opt.task_attributes, opt.workers);
+#else
+    (void)(zs);
+    return -1;
+#endif
+}
+
+int8_t zp_stop_dispatch_tasks(z_session_t zs) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    return _zp_stop_dispatch_tasks(&zs._val.in->val);
+#else
+    (void)(zs);
+    return -1;
+#endif
+}
+
 zp_read_options_t zp_read_options_default(void) { return (zp_read_options_t){.__dummy = 0}; }
 
 int8_t zp_read(z_session_t zs, const zp_read_options_t *options) {
@@ -1175,6 +1281,15 @@ int8_t zp_send_join(z_session_t zs, const zp_send_join_options_t *options) {
     (void)(options);
     return _zp_send_join(&zs._val.in->val);
 }
+
+zp_flush_options_t zp_flush_options_default(void) { return (zp_flush_options_t){.__dummy = 0}; }
+
+int8_t zp_flush(z_session_t zs, const zp_flush_options_t *options) {
+    (void)(options);
+    return _zp_flush(&zs._val.in->val);
+}
+
+int8_t zp_stats_get(z_session_t zs, zp_stats_t *stats) { return _zp_stats_get(&zs._val.in->val, stats); }
 #if Z_FEATURE_ATTACHMENT == 1
 void _z_bytes_pair_clear(struct _z_bytes_pair_t *this_) {
     _z_bytes_clear(&this_->key);
@@ -0,0 +1,168 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/collections/hashmap.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "zenoh-pico/system/platform.h"
+#include "zenoh-pico/utils/result.h"
+
+/*-------- hash functions --------*/
+// FNV-1a, folded on size_t
+size_t _z_hash_bytes(size_t seed, const void *bytes, size_t len) {
+    uint64_t h = 0xcbf29ce484222325ULL ^ (uint64_t)seed;
+    const uint8_t *b = (const uint8_t *)bytes;
+    for (size_t i = 0; i < len; i++) {
+        h = h ^ (uint64_t)b[i];
+        h = h * 0x100000001b3ULL;
+    }
+    return (size_t)(h ^ (h >> 32));
+}
+
+size_t _z_hash_str(size_t seed, const char *str) { return _z_hash_bytes(seed, str, strlen(str)); }
+
+size_t _z_hash_uint(size_t seed, uint64_t val) {
+    // splitmix64 finalizer
+    uint64_t h = val + 0x9e3779b97f4a7c15ULL + ((uint64_t)seed << 6) + ((uint64_t)seed >> 2);
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    h = h ^ (h >> 31);
+    return (size_t)(h ^ (h >> 32));
+}
+
+/*-------- open-addressing hashmap --------*/
+// Marks the slots of removed values, so that probing goes on past them
+static char _z_hashmap_tombstone;
+#define _Z_HASHMAP_TOMBSTONE ((void *)&_z_hashmap_tombstone)
+
+void _z_hashmap_init(_z_hashmap_t *map) {
+    map->_capacity = 0;
+    map->_len = 0;
+    map->_used = 0;
+    map->_slots = NULL;
+}
+
+_z_hashmap_t _z_hashmap_make(void) {
+    _z_hashmap_t map;
+    _z_hashmap_init(&map);
+    return map;
+}
+
+static void __z_hashmap_place(_z_hashmap_slot_t *slots, size_t capacity, size_t hash, void *val) {
+    size_t mask = capacity - (size_t)1;
+    size_t idx = hash & mask;
+    while ((slots[idx]._val != NULL) && (slots[idx]._val != _Z_HASHMAP_TOMBSTONE)) {
+        idx = (idx + (size_t)1) & mask;
+    }
+    slots[idx]._hash = hash;
+    slots[idx]._val = val;
+}
+
+static int8_t __z_hashmap_resize(_z_hashmap_t *map, size_t capacity) {
+    _z_hashmap_slot_t *slots = (_z_hashmap_slot_t *)zp_malloc(capacity * sizeof(_z_hashmap_slot_t));
+    if (slots == NULL) {
+        return _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+    }
+    (void)memset(slots, 0, capacity * sizeof(_z_hashmap_slot_t));
+
+    for (size_t i = 0; i < map->_capacity; i++) {
+        void *val = map->_slots[i]._val;
+        if ((val != NULL) && (val != _Z_HASHMAP_TOMBSTONE)) {
+            __z_hashmap_place(slots, capacity, map->_slots[i]._hash, val);
+        }
+    }
+    zp_free(map->_slots);
+    map->_slots = slots;
+    map->_capacity = capacity;
+    map->_used = map->_len;
+    return _Z_RES_OK;
+}
+
+int8_t _z_hashmap_insert(_z_hashmap_t *map, size_t hash, void *val) {
+    // Keep the load factor, removed values included, below 3/4
+    if (((map->_used + (size_t)1) << 2) > (map->_capacity * (size_t)3)) {
+        size_t capacity = (map->_capacity == (size_t)0) ? (size_t)_Z_DEFAULT_HASHMAP_CAPACITY : map->_capacity;
+        // Only grow if the live values need it, otherwise rehashing in place drops the tombstones
+        while (((map->_len + (size_t)1) << 1) > capacity) {
+            capacity = capacity << 1;
+        }
+        int8_t ret = __z_hashmap_resize(map, capacity);
+        if (ret != _Z_RES_OK) {
+            return ret;
+        }
+    }
+
+    size_t mask = map->_capacity - (size_t)1;
+    size_t idx = hash & mask;
+    while ((map->_slots[idx]._val != NULL) && (map->_slots[idx]._val != _Z_HASHMAP_TOMBSTONE)) {
+        idx = (idx + (size_t)1) & mask;
+    }
+    if (map->_slots[idx]._val == NULL) {
+        map->_used = map->_used + (size_t)1;
+    }
+    map->_slots[idx]._hash = hash;
+    map->_slots[idx]._val = val;
+    map->_len = map->_len + (size_t)1;
+    return _Z_RES_OK;
+}
+
+static _z_hashmap_slot_t *__z_hashmap_find(const _z_hashmap_t *map, size_t hash, _z_hashmap_key_eq_f f,
+                                           const void *key) {
+    _z_hashmap_slot_t *ret = NULL;
+    if (map->_len != (size_t)0) {
+        size_t mask = map->_capacity - (size_t)1;
+        size_t idx = hash & mask;
+        while (map->_slots[idx]._val != NULL) {
+            _z_hashmap_slot_t *slot = &map->_slots[idx];
+            if ((slot->_val != _Z_HASHMAP_TOMBSTONE) && (slot->_hash == hash) && (f(slot->_val, key) == true)) {
+                ret = slot;
+                break;
+            }
+            idx = (idx + (size_t)1) & mask;
+        }
+    }
+    return ret;
+}
+
+void *_z_hashmap_get(const _z_hashmap_t *map, size_t hash, _z_hashmap_key_eq_f f, const void *key) {
+    _z_hashmap_slot_t *slot = __z_hashmap_find(map, hash, f, key);
+    return (slot != NULL) ? slot->_val : NULL;
+}
+
+void *_z_hashmap_remove(_z_hashmap_t *map, size_t hash, _z_hashmap_key_eq_f f, const void *key) {
+    void *ret = NULL;
+    _z_hashmap_slot_t *slot = __z_hashmap_find(map, hash, f, key);
+    if (slot != NULL) {
+        ret = slot->_val;
+        slot->_val = _Z_HASHMAP_TOMBSTONE;
+        map->_len = map->_len - (size_t)1;
+    }
+    return ret;
+}
+
+size_t _z_hashmap_len(const _z_hashmap_t *map) { return map->_len; }
+
+_Bool _z_hashmap_is_empty(const _z_hashmap_t *map) { return map->_len == (size_t)0; }
+
+void _z_hashmap_clear(_z_hashmap_t *map, z_element_free_f f) {
+    for (size_t i = 0; i < map->_capacity; i++) {
+        if ((map->_slots[i]._val != NULL) && (map->_slots[i]._val != _Z_HASHMAP_TOMBSTONE)) {
+            f(&map->_slots[i]._val);
+        }
+    }
+    zp_free(map->_slots);
+    _z_hashmap_init(map);
+}
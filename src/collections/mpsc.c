@@ -0,0 +1,210 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/collections/mpsc.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/system/platform.h"
+#include "zenoh-pico/utils/result.h"
+
+#if defined(ZENOH_COMPILER_GCC) || defined(ZENOH_COMPILER_CLANG) || defined(__GNUC__)
+#define __z_mpsc_load(p) __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define __z_mpsc_load_relaxed(p) __atomic_load_n(p, __ATOMIC_RELAXED)
+#define __z_mpsc_store(p, v) __atomic_store_n(p, v, __ATOMIC_SEQ_CST)
+#define __z_mpsc_cas(p, e, v) __atomic_compare_exchange_n(p, e, v, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#define __z_mpsc_add(p, v) (void)__atomic_fetch_add(p, v, __ATOMIC_SEQ_CST)
+#define __z_mpsc_sub(p, v) (void)__atomic_fetch_sub(p, v, __ATOMIC_SEQ_CST)
+#define __z_mpsc_fence() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#elif Z_FEATURE_TX_QUEUE == 0 && Z_FEATURE_DISPATCH_POOL == 0
+// Not shared between threads without the transmit queue or the dispatch pool
+#define __z_mpsc_load(p) (*(p))
+#define __z_mpsc_load_relaxed(p) (*(p))
+#define __z_mpsc_store(p, v) (*(p) = (v))
+#define __z_mpsc_cas(p, e, v) ((*(p) == *(e)) ? ((*(p) = (v)), true) : ((*(e) = *(p)), false))
+#define __z_mpsc_add(p, v) (*(p) += (v))
+#define __z_mpsc_sub(p, v) (*(p) -= (v))
+#define __z_mpsc_fence()
+#else
+#error "The lock-free queue requires the GCC atomic builtins, use GCC or Clang or deactivate its users"
+#endif
+
+// Slot sequence numbers, for a slot at position pos:
+//  - seq == pos: the slot is free to be claimed
+//  - seq == pos + 1: the slot is published, ready to be consumed
+//  - seq == pos + capacity: the slot has been consumed, free for the next round
+int8_t _z_mpsc_init(_z_mpsc_t *q, size_t capacity) {
+    int8_t ret = _Z_RES_OK;
+
+    q->_capacity = 0;
+    q->_head = 0;
+    q->_tail = 0;
+    q->_consumer_parked = 0;
+    q->_closer_parked = 0;
+    q->_producers_parked = 0;
+    q->_claiming = 0;
+    q->_closed = 0;
+    q->_seqs = NULL;
+    if ((capacity == (size_t)0) || ((capacity & (capacity - (size_t)1)) != (size_t)0)) {
+        ret = _Z_ERR_GENERIC;
+    } else {
+        q->_seqs = (size_t *)zp_malloc(capacity * sizeof(size_t));
+        if (q->_seqs != NULL) {
+            for (size_t i = 0; i < capacity; i++) {
+                q->_seqs[i] = i;
+            }
+            q->_capacity = capacity;
+        } else {
+            ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+        }
+    }
+
+    return ret;
+}
+
+size_t _z_mpsc_claim(_z_mpsc_t *q) {
+    size_t ret = SIZE_MAX;
+
+    // Announce the claim before checking that the queue is open, so that closing it waits for the slot to be published
+    __z_mpsc_add(&q->_claiming, (size_t)1);
+    __z_mpsc_fence();
+    size_t mask = q->_capacity - (size_t)1;
+    size_t pos = __z_mpsc_load_relaxed(&q->_head);
+    while ((q->_capacity > (size_t)0) && (__z_mpsc_load(&q->_closed) == (size_t)0)) {
+        // Signed difference, to be safe when positions wrap around
+        intptr_t dif = (intptr_t)(__z_mpsc_load(&q->_seqs[pos & mask]) - pos);
+        if (dif == 0) {
+            // The slot is free, race the other producers for it
+            if (__z_mpsc_cas(&q->_head, &pos, pos + (size_t)1) == true) {
+                ret = pos & mask;
+                break;
+            }
+        } else if (dif < 0) {
+            // The slot has not been consumed since the last round, the queue is full
+            break;
+        } else {
+            // Another producer claimed the slot
+            pos = __z_mpsc_load_relaxed(&q->_head);
+        }
+    }
+    if (ret == SIZE_MAX) {
+        __z_mpsc_sub(&q->_claiming, (size_t)1);
+    }
+
+    return ret;
+}
+
+_Bool _z_mpsc_publish(_z_mpsc_t *q, size_t slot) {
+    // Only the claiming producer writes the sequence of a claimed slot
+    __z_mpsc_store(&q->_seqs[slot], __z_mpsc_load_relaxed(&q->_seqs[slot]) + (size_t)1);
+    __z_mpsc_sub(&q->_claiming, (size_t)1);
+    __z_mpsc_fence();
+    return (__z_mpsc_load(&q->_consumer_parked) != (size_t)0) || (__z_mpsc_load(&q->_closer_parked) != (size_t)0);
+}
+
+size_t _z_mpsc_peek(const _z_mpsc_t *q) {
+    size_t ret = SIZE_MAX;
+
+    if (q->_capacity > (size_t)0) {
+        size_t slot = q->_tail & (q->_capacity - (size_t)1);
+        if (__z_mpsc_load(&q->_seqs[slot]) == q->_tail + (size_t)1) {
+            ret = slot;
+        }
+    }
+
+    return ret;
+}
+
+_Bool _z_mpsc_pop(_z_mpsc_t *q) {
+    size_t slot = q->_tail & (q->_capacity - (size_t)1);
+    __z_mpsc_store(&q->_seqs[slot], q->_tail + q->_capacity);
+    q->_tail = q->_tail + (size_t)1;
+    __z_mpsc_fence();
+    return __z_mpsc_load(&q->_producers_parked) != (size_t)0;
+}
+
+static _Bool __z_mpsc_is_full(const _z_mpsc_t *q) {
+    size_t pos = __z_mpsc_load(&q->_head);
+    intptr_t dif = (intptr_t)(__z_mpsc_load(&q->_seqs[pos & (q->_capacity - (size_t)1)]) - pos);
+    return dif < 0;
+}
+
+// The publishers read the parking flag after publishing, and the consumer checks for published slots after
+// parking, so at least one of them sees the other
+_Bool _z_mpsc_consumer_park(_z_mpsc_t *q) {
+    __z_mpsc_store(&q->_consumer_parked, (size_t)1);
+    __z_mpsc_fence();
+    return _z_mpsc_peek(q) == SIZE_MAX;
+}
+
+void _z_mpsc_consumer_unpark(_z_mpsc_t *q) { __z_mpsc_store(&q->_consumer_parked, (size_t)0); }
+
+_Bool _z_mpsc_producer_park(_z_mpsc_t *q) {
+    __z_mpsc_add(&q->_producers_parked, (size_t)1);
+    __z_mpsc_fence();
+    return __z_mpsc_is_full(q);
+}
+
+void _z_mpsc_producer_unpark(_z_mpsc_t *q) { __z_mpsc_sub(&q->_producers_parked, (size_t)1); }
+
+// The producers announce their claim before checking that the queue is open, and the closer checks for claims after
+// closing it, so at least one of them sees the other
+void _z_mpsc_close(_z_mpsc_t *q) {
+    __z_mpsc_store(&q->_closed, (size_t)1);
+    __z_mpsc_fence();
+}
+
+void _z_mpsc_open(_z_mpsc_t *q) { __z_mpsc_store(&q->_closed, (size_t)0); }
+
+_Bool _z_mpsc_is_closed(const _z_mpsc_t *q) { return __z_mpsc_load(&q->_closed) != (size_t)0; }
+
+_Bool _z_mpsc_has_claims(const _z_mpsc_t *q) { return __z_mpsc_load(&q->_claiming) != (size_t)0; }
+
+// The producers read the parking flag after publishing or giving up a claim, and the closer checks for claims after
+// parking, so at least one of them sees the other
+_Bool _z_mpsc_closer_park(_z_mpsc_t *q) {
+    __z_mpsc_store(&q->_closer_parked, (size_t)1);
+    __z_mpsc_fence();
+    return _z_mpsc_has_claims(q);
+}
+
+void _z_mpsc_closer_unpark(_z_mpsc_t *q) { __z_mpsc_store(&q->_closer_parked, (size_t)0); }
+
+_Bool _z_mpsc_closer_is_parked(const _z_mpsc_t *q) {
+    // Ordered after the failed claim, which does not publish anything
+    __z_mpsc_fence();
+    return __z_mpsc_load(&q->_closer_parked) != (size_t)0;
+}
+
+size_t _z_mpsc_capacity(const _z_mpsc_t *q) { return q->_capacity; }
+
+_Bool _z_mpsc_is_empty(const _z_mpsc_t *q) {
+    size_t head = __z_mpsc_load(&q->_head);
+    return head == q->_tail;
+}
+
+void _z_mpsc_clear(_z_mpsc_t *q) {
+    zp_free(q->_seqs);
+    q->_seqs = NULL;
+    q->_capacity = 0;
+    q->_head = 0;
+    q->_tail = 0;
+    q->_consumer_parked = 0;
+    q->_closer_parked = 0;
+    q->_producers_parked = 0;
+    q->_claiming = 0;
+    q->_closed = 0;
+}
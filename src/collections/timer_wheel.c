@@ -0,0 +1,143 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/collections/timer_wheel.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#define _Z_TIMER_WHEEL_SLOT_MASK ((uint64_t)_Z_TIMER_WHEEL_SLOTS - (uint64_t)1)
+// The number of ticks spanned by a whole turn of the given number of levels
+#define _Z_TIMER_WHEEL_SPAN(levels) ((uint64_t)1 << ((levels) * _Z_TIMER_WHEEL_SLOT_BITS))
+
+void _z_timer_init(_z_timer_t *timer, void *arg) {
+    timer->_next = NULL;
+    timer->_pprev = NULL;
+    timer->_expiry = 0;
+    timer->_arg = arg;
+}
+
+_Bool _z_timer_is_scheduled(const _z_timer_t *timer) { return timer->_pprev != NULL; }
+
+void _z_timer_wheel_init(_z_timer_wheel_t *tw, uint64_t now) {
+    tw->_now = now;
+    tw->_len = 0;
+    (void)memset(tw->_slots, 0, sizeof(tw->_slots));
+}
+
+static void __z_timer_wheel_link(_z_timer_t **slot, _z_timer_t *timer) {
+    timer->_next = *slot;
+    if (timer->_next != NULL) {
+        timer->_next->_pprev = &timer->_next;
+    }
+    timer->_pprev = slot;
+    *slot = timer;
+}
+
+static void __z_timer_wheel_unlink(_z_timer_t *timer) {
+    *timer->_pprev = timer->_next;
+    if (timer->_next != NULL) {
+        timer->_next->_pprev = timer->_pprev;
+    }
+    timer->_next = NULL;
+    timer->_pprev = NULL;
+}
+
+// Places a timer relative to the next tick to process, the timer expiring no earlier than it
+static void __z_timer_wheel_place(_z_timer_wheel_t *tw, _z_timer_t *timer) {
+    uint64_t delta = timer->_expiry - tw->_now;
+    _z_timer_t **slot = NULL;
+    if (delta < _Z_TIMER_WHEEL_SPAN(1)) {
+        slot = &tw->_slots[0][timer->_expiry & _Z_TIMER_WHEEL_SLOT_MASK];
+    } else if (delta < _Z_TIMER_WHEEL_SPAN(2)) {
+        slot = &tw->_slots[1][(timer->_expiry >> _Z_TIMER_WHEEL_SLOT_BITS) & _Z_TIMER_WHEEL_SLOT_MASK];
+    } else {
+        // Beyond the last level, park the timer in the farthest slot and place it again from there
+        uint64_t at = timer->_expiry;
+        if (delta >= _Z_TIMER_WHEEL_SPAN(_Z_TIMER_WHEEL_LEVELS)) {
+            at = tw->_now + _Z_TIMER_WHEEL_SPAN(_Z_TIMER_WHEEL_LEVELS) - (uint64_t)1;
+        }
+        slot = &tw->_slots[2][(at >> (2 * _Z_TIMER_WHEEL_SLOT_BITS)) & _Z_TIMER_WHEEL_SLOT_MASK];
+    }
+    __z_timer_wheel_link(slot, timer);
+}
+
+void _z_timer_wheel_add(_z_timer_wheel_t *tw, _z_timer_t *timer, uint64_t expiry) {
+    if (_z_timer_is_scheduled(timer) == true) {
+        _z_timer_wheel_remove(tw, timer);
+    }
+    // Timers already due expire on the next tick processed
+    timer->_expiry = (expiry < tw->_now) ? tw->_now : expiry;
+    __z_timer_wheel_place(tw, timer);
+    tw->_len = tw->_len + (size_t)1;
+}
+
+void _z_timer_wheel_remove(_z_timer_wheel_t *tw, _z_timer_t *timer) {
+    if (_z_timer_is_scheduled(timer) == true) {
+        __z_timer_wheel_unlink(timer);
+        tw->_len = tw->_len - (size_t)1;
+    }
+}
+
+// Moves the timers of a slot down to the levels below, now that the wheel reached it
+static void __z_timer_wheel_cascade(_z_timer_wheel_t *tw, _z_timer_t **slot) {
+    _z_timer_t *timer = *slot;
+    *slot = NULL;
+    while (timer != NULL) {
+        _z_timer_t *next = timer->_next;
+        __z_timer_wheel_place(tw, timer);
+        timer = next;
+    }
+}
+
+/**
+ * Processes the ticks up to the given one included, and returns the timers that expired, in expiry order. The
+ * returned timers are no longer scheduled, and are chained by their ``_next`` member until NULL.
+ */
+_z_timer_t *_z_timer_wheel_advance(_z_timer_wheel_t *tw, uint64_t now) {
+    _z_timer_t *expired = NULL;
+    _z_timer_t **tail = &expired;
+
+    while ((tw->_now <= now) && (tw->_len > (size_t)0)) {
+        uint64_t tick = tw->_now;
+        if ((tick & _Z_TIMER_WHEEL_SLOT_MASK) == (uint64_t)0) {
+            uint64_t index1 = (tick >> _Z_TIMER_WHEEL_SLOT_BITS) & _Z_TIMER_WHEEL_SLOT_MASK;
+            if (index1 == (uint64_t)0) {
+                uint64_t index2 = (tick >> (2 * _Z_TIMER_WHEEL_SLOT_BITS)) & _Z_TIMER_WHEEL_SLOT_MASK;
+                __z_timer_wheel_cascade(tw, &tw->_slots[2][index2]);
+            }
+            __z_timer_wheel_cascade(tw, &tw->_slots[1][index1]);
+        }
+
+        _z_timer_t **slot = &tw->_slots[0][tick & _Z_TIMER_WHEEL_SLOT_MASK];
+        while (*slot != NULL) {
+            _z_timer_t *timer = *slot;
+            __z_timer_wheel_unlink(timer);
+            tw->_len = tw->_len - (size_t)1;
+            *tail = timer;
+            tail = &timer->_next;
+        }
+        tw->_now = tick + (uint64_t)1;
+    }
+
+    // Nothing left to expire, skip the remaining ticks at once
+    if (tw->_now <= now) {
+        tw->_now = now + (uint64_t)1;
+    }
+    return expired;
+}
+
+size_t _z_timer_wheel_len(const _z_timer_wheel_t *tw) { return tw->_len; }
+
+_Bool _z_timer_wheel_is_empty(const _z_timer_wheel_t *tw) { return tw->_len == (size_t)0; }
@@ -151,6 +151,85 @@ size_t _z_link_recv_exact_zbuf(const _z_link_t *link, _z_zbuf_t *zbf, size_t len
     return rb;
 }
 
+size_t _z_link_recv_multi_zbuf(const _z_link_t *link, _z_zbuf_t *zbfs, size_t count, _z_bytes_t *addrs) {
+    size_t rb = SIZE_MAX;
+
+    if ((link->_read_multi_f != NULL) && (count > (size_t)1)) {
+        uint8_t *ptrs[_Z_LINK_MULTI_DATAGRAM_MAX];
+        size_t lens[_Z_LINK_MULTI_DATAGRAM_MAX];
+        count = (count < (size_t)_Z_LINK_MULTI_DATAGRAM_MAX) ? count : (size_t)_Z_LINK_MULTI_DATAGRAM_MAX;
+        for (size_t i = 0; i < count; i++) {
+            ptrs[i] = _z_zbuf_get_wptr(&zbfs[i]);
+            lens[i] = _z_zbuf_space_left(&zbfs[i]);
+        }
+        rb = link->_read_multi_f(link, ptrs, lens, count, addrs);
+        if (rb != SIZE_MAX) {
+            for (size_t i = 0; i < rb; i++) {
+                _z_zbuf_set_wpos(&zbfs[i], _z_zbuf_get_wpos(&zbfs[i]) + lens[i]);
+            }
+        }
+    } else if (count > (size_t)0) {
+        // Fall back to a single datagram per call
+        if (_z_link_recv_zbuf(link, &zbfs[0], addrs) != SIZE_MAX) {
+            rb = 1;
+        }
+    }
+
+    return rb;
+}
+
+static int8_t __z_link_write_vec(const _z_link_t *link, const _z_bytes_t *bufs, size_t count, size_t len) {
+    int8_t ret = _Z_RES_OK;
+    size_t wb = link->_write_vec_f(link, bufs, count);
+    if ((wb == SIZE_MAX) || (wb != len)) {
+        ret = _Z_ERR_TRANSPORT_TX_FAILED;
+    }
+    return ret;
+}
+
+static int8_t __z_link_send_wbuf_vec(const _z_link_t *link, const _z_wbuf_t *wbf) {
+    int8_t ret = _Z_RES_OK;
+
+    // Gather the ioslices, in as few writes as possible for stream links
+    _z_bytes_t bufs[_Z_LINK_WRITE_VEC_MAX];
+    size_t count = 0;
+    size_t len = 0;
+    for (size_t i = 0; (i < _z_wbuf_len_iosli(wbf)) && (ret == _Z_RES_OK); i++) {
+        _z_bytes_t bs = _z_iosli_to_bytes(_z_wbuf_get_iosli(wbf, i));
+        if (bs.len > (size_t)0) {
+            if (count == (size_t)_Z_LINK_WRITE_VEC_MAX) {
+                ret = __z_link_write_vec(link, bufs, count, len);
+                count = 0;
+                len = 0;
+            }
+            bufs[count] = bs;
+            count = count + (size_t)1;
+            len = len + bs.len;
+        }
+    }
+    if ((ret == _Z_RES_OK) && (count > (size_t)0)) {
+        ret = __z_link_write_vec(link, bufs, count, len);
+    }
+
+    return ret;
+}
+
+static int8_t __z_link_send_wbuf_contiguous(const _z_link_t *link, const _z_wbuf_t *wbf) {
+    int8_t ret = _Z_RES_OK;
+
+    // Datagrams can't be split across writes, copy the ioslices together
+    _z_zbuf_t zbf = _z_wbuf_to_zbuf(wbf);
+    size_t len = _z_zbuf_len(&zbf);
+    if (_z_zbuf_capacity(&zbf) != len) {
+        ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+    } else if (link->_write_f(link, _z_zbuf_get_rptr(&zbf), len) != len) {
+        ret = _Z_ERR_TRANSPORT_TX_FAILED;
+    }
+    _z_zbuf_clear(&zbf);
+
+    return ret;
+}
+
 int8_t _z_link_send_wbuf(const _z_link_t *link, const _z_wbuf_t *wbf) {
     int8_t ret = _Z_RES_OK;
     _Bool link_is_streamed = false;
@@ -164,22 +243,62 @@ int8_t _z_link_send_wbuf(const _z_link_t *link, const _z_wbuf_t *wbf) {
             link_is_streamed = false;
             break;
     }
-    for (size_t i = 0; (i < _z_wbuf_len_iosli(wbf)) && (ret == _Z_RES_OK); i++) {
-        _z_bytes_t bs = _z_iosli_to_bytes(_z_wbuf_get_iosli(wbf, i));
-        size_t n = bs.len;
-        do {
-            size_t wb = link->_write_f(link, bs.start, n);
-            if (wb == SIZE_MAX) {
-                ret = _Z_ERR_TRANSPORT_TX_FAILED;
-                break;
+
+    size_t slices = _z_wbuf_len_iosli(wbf);
+    if ((slices > (size_t)1) && (link->_write_vec_f != NULL) &&
+        ((link_is_streamed == true) || (slices <= (size_t)_Z_LINK_WRITE_VEC_MAX))) {
+        // Send the wrapped bytes in place, without copying them
+        ret = __z_link_send_wbuf_vec(link, wbf);
+    } else if ((slices > (size_t)1) && (link_is_streamed == false)) {
+        ret = __z_link_send_wbuf_contiguous(link, wbf);
+    } else {
+        for (size_t i = 0; (i < _z_wbuf_len_iosli(wbf)) && (ret == _Z_RES_OK); i++) {
+            _z_bytes_t bs = _z_iosli_to_bytes(_z_wbuf_get_iosli(wbf, i));
+            size_t n = bs.len;
+            do {
+                size_t wb = link->_write_f(link, bs.start, n);
+                if (wb == SIZE_MAX) {
+                    ret = _Z_ERR_TRANSPORT_TX_FAILED;
+                    break;
+                }
+                if (link_is_streamed && wb != n) {
+                    ret = _Z_ERR_TRANSPORT_TX_FAILED;
+                    break;
+                }
+                n = n - wb;
+                bs.start = bs.start + (bs.len - n);
+            } while (n > (size_t)0);
+        }
+    }
+
+    return ret;
+}
+
+int8_t _z_link_send_multi_wbuf(const _z_link_t *link, const _z_wbuf_t *wbfs, size_t count) {
+    int8_t ret = _Z_RES_OK;
+
+    // Only contiguous buffers can be sent as single datagrams
+    _Bool contiguous = (link->_write_multi_f != NULL) && (count > (size_t)1);
+    for (size_t i = 0; (i < count) && (contiguous == true); i++) {
+        contiguous = _z_wbuf_len_iosli(&wbfs[i]) == (size_t)1;
+    }
+
+    if (contiguous == true) {
+        _z_bytes_t dgrams[_Z_LINK_MULTI_DATAGRAM_MAX];
+        for (size_t i = 0; (i < count) && (ret == _Z_RES_OK); i += (size_t)_Z_LINK_MULTI_DATAGRAM_MAX) {
+            size_t n = count - i;
+            n = (n < (size_t)_Z_LINK_MULTI_DATAGRAM_MAX) ? n : (size_t)_Z_LINK_MULTI_DATAGRAM_MAX;
+            for (size_t j = 0; j < n; j++) {
+                dgrams[j] = _z_iosli_to_bytes(_z_wbuf_get_iosli(&wbfs[i + j], 0));
             }
-            if (link_is_streamed && wb != n) {
+            if (link->_write_multi_f(link, dgrams, n) != n) {
                 ret = _Z_ERR_TRANSPORT_TX_FAILED;
-                break;
             }
-            n = n - wb;
-            bs.start = bs.start + (bs.len - n);
-        } while (n > (size_t)0);
+        }
+    } else {
+        for (size_t i = 0; (i < count) && (ret == _Z_RES_OK); i++) {
+            ret = _z_link_send_wbuf(link, &wbfs[i]);
+        }
     }
 
     return ret;
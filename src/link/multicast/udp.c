@@ -155,6 +155,12 @@ size_t _z_f_link_write_all_udp_multicast(const _z_link_t *self, const uint8_t *p
     return _z_send_udp_multicast(self->_socket._udp._msock, ptr, len, self->_socket._udp._rep);
 }
 
+#if defined(_Z_SYS_NET_SEND_VEC_MAX)
+size_t _z_f_link_write_vec_udp_multicast(const _z_link_t *self, const _z_bytes_t *bufs, size_t count) {
+    return _z_send_vec_udp_multicast(self->_socket._udp._msock, bufs, count, self->_socket._udp._rep);
+}
+#endif
+
 size_t _z_f_link_read_udp_multicast(const _z_link_t *self, uint8_t *ptr, size_t len, _z_bytes_t *addr) {
     return _z_read_udp_multicast(self->_socket._udp._sock, ptr, len, self->_socket._udp._lep, addr);
 }
@@ -163,6 +169,17 @@ size_t _z_f_link_read_exact_udp_multicast(const _z_link_t *self, uint8_t *ptr, s
     return _z_read_exact_udp_multicast(self->_socket._udp._sock, ptr, len, self->_socket._udp._lep, addr);
 }
 
+#if defined(_Z_SYS_NET_MULTI_DATAGRAM_MAX)
+size_t _z_f_link_read_multi_udp_multicast(const _z_link_t *self, uint8_t *const *ptrs, size_t *lens, size_t count,
+                                          _z_bytes_t *addrs) {
+    return _z_read_multi_udp_multicast(self->_socket._udp._sock, ptrs, lens, count, self->_socket._udp._lep, addrs);
+}
+
+size_t _z_f_link_write_multi_udp_multicast(const _z_link_t *self, const _z_bytes_t *dgrams, size_t count) {
+    return _z_send_multi_udp_multicast(self->_socket._udp._msock, dgrams, count, self->_socket._udp._rep);
+}
+#endif
+
 uint16_t _z_get_link_mtu_udp_multicast(void) {
     // @TODO: the return value should change depending on the target platform.
     return 1450;
@@ -192,8 +209,20 @@ int8_t _z_new_link_udp_multicast(_z_link_t *zl, _z_endpoint_t endpoint) {
 
     zl->_write_f = _z_f_link_write_udp_multicast;
     zl->_write_all_f = _z_f_link_write_all_udp_multicast;
+#if defined(_Z_SYS_NET_SEND_VEC_MAX)
+    zl->_write_vec_f = _z_f_link_write_vec_udp_multicast;
+#else
+    zl->_write_vec_f = NULL;
+#endif
     zl->_read_f = _z_f_link_read_udp_multicast;
     zl->_read_exact_f = _z_f_link_read_exact_udp_multicast;
+#if defined(_Z_SYS_NET_MULTI_DATAGRAM_MAX)
+    zl->_read_multi_f = _z_f_link_read_multi_udp_multicast;
+    zl->_write_multi_f = _z_f_link_write_multi_udp_multicast;
+#else
+    zl->_read_multi_f = NULL;
+    zl->_write_multi_f = NULL;
+#endif
 
     return ret;
 }
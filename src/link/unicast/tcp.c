@@ -138,6 +138,12 @@ size_t _z_f_link_write_all_tcp(const _z_link_t *zl, const uint8_t *ptr, size_t l
     return _z_send_tcp(zl->_socket._tcp._sock, ptr, len);
 }
 
+#if defined(_Z_SYS_NET_SEND_VEC_MAX)
+size_t _z_f_link_write_vec_tcp(const _z_link_t *zl, const _z_bytes_t *bufs, size_t count) {
+    return _z_send_vec_tcp(zl->_socket._tcp._sock, bufs, count);
+}
+#endif
+
 size_t _z_f_link_read_tcp(const _z_link_t *zl, uint8_t *ptr, size_t len, _z_bytes_t *addr) {
     (void)(addr);
     return _z_read_tcp(zl->_socket._tcp._sock, ptr, len);
@@ -176,8 +182,15 @@ int8_t _z_new_link_tcp(_z_link_t *zl, _z_endpoint_t *endpoint) {
 
     zl->_write_f = _z_f_link_write_tcp;
     zl->_write_all_f = _z_f_link_write_all_tcp;
+#if defined(_Z_SYS_NET_SEND_VEC_MAX)
+    zl->_write_vec_f = _z_f_link_write_vec_tcp;
+#else
+    zl->_write_vec_f = NULL;
+#endif
     zl->_read_f = _z_f_link_read_tcp;
     zl->_read_exact_f = _z_f_link_read_exact_tcp;
+    zl->_read_multi_f = NULL;
+    zl->_write_multi_f = NULL;
 
     return ret;
 }
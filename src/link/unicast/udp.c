@@ -144,6 +144,12 @@ size_t _z_f_link_write_all_udp_unicast(const _z_link_t *self, const uint8_t *ptr
     return _z_send_udp_unicast(self->_socket._udp._sock, ptr, len, self->_socket._udp._rep);
 }
 
+#if defined(_Z_SYS_NET_SEND_VEC_MAX)
+size_t _z_f_link_write_vec_udp_unicast(const _z_link_t *self, const _z_bytes_t *bufs, size_t count) {
+    return _z_send_vec_udp_unicast(self->_socket._udp._sock, bufs, count, self->_socket._udp._rep);
+}
+#endif
+
 size_t _z_f_link_read_udp_unicast(const _z_link_t *self, uint8_t *ptr, size_t len, _z_bytes_t *addr) {
     (void)(addr);
     return _z_read_udp_unicast(self->_socket._udp._sock, ptr, len);
@@ -154,6 +160,18 @@ size_t _z_f_link_read_exact_udp_unicast(const _z_link_t *self, uint8_t *ptr, siz
     return _z_read_exact_udp_unicast(self->_socket._udp._sock, ptr, len);
 }
 
+#if defined(_Z_SYS_NET_MULTI_DATAGRAM_MAX)
+size_t _z_f_link_read_multi_udp_unicast(const _z_link_t *self, uint8_t *const *ptrs, size_t *lens, size_t count,
+                                        _z_bytes_t *addrs) {
+    (void)(addrs);
+    return _z_read_multi_udp_unicast(self->_socket._udp._sock, ptrs, lens, count);
+}
+
+size_t _z_f_link_write_multi_udp_unicast(const _z_link_t *self, const _z_bytes_t *dgrams, size_t count) {
+    return _z_send_multi_udp_unicast(self->_socket._udp._sock, dgrams, count, self->_socket._udp._rep);
+}
+#endif
+
 uint16_t _z_get_link_mtu_udp_unicast(void) {
     // @TODO: the return value should change depending on the target platform.
     return 1450;
@@ -182,8 +200,20 @@ int8_t _z_new_link_udp_unicast(_z_link_t *zl, _z_endpoint_t endpoint) {
 
     zl->_write_f = _z_f_link_write_udp_unicast;
     zl->_write_all_f = _z_f_link_write_all_udp_unicast;
+#if defined(_Z_SYS_NET_SEND_VEC_MAX)
+    zl->_write_vec_f = _z_f_link_write_vec_udp_unicast;
+#else
+    zl->_write_vec_f = NULL;
+#endif
     zl->_read_f = _z_f_link_read_udp_unicast;
     zl->_read_exact_f = _z_f_link_read_exact_udp_unicast;
+#if defined(_Z_SYS_NET_MULTI_DATAGRAM_MAX)
+    zl->_read_multi_f = _z_f_link_read_multi_udp_unicast;
+    zl->_write_multi_f = _z_f_link_write_multi_udp_unicast;
+#else
+    zl->_read_multi_f = NULL;
+    zl->_write_multi_f = NULL;
+#endif
 
     return ret;
 }
@@ -177,8 +177,11 @@ int8_t _z_new_link_ws(_z_link_t *zl, _z_endpoint_t *endpoint) {
 
     zl->_write_f = _z_f_link_write_ws;
     zl->_write_all_f = _z_f_link_write_all_ws;
+    zl->_write_vec_f = NULL;
     zl->_read_f = _z_f_link_read_ws;
     zl->_read_exact_f = _z_f_link_read_exact_ws;
+    zl->_read_multi_f = NULL;
+    zl->_write_multi_f = NULL;
 
     return ret;
 }
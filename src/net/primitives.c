@@ -191,6 +191,8 @@ _z_subscriber_t *_z_declare_subscriber(_z_session_rc_t *zn, _z_keyexpr_t keyexpr
     s._id = _z_get_entity_id(&zn->in->val);
     s._key_id = keyexpr._id;
     s._key = _z_get_expanded_key_from_key(&zn->in->val, &keyexpr);
+    // A key expression that can not be compiled is still matched, only more slowly
+    (void)_z_keyexpr_compile(&s._compiled, s._key._suffix, (s._key._suffix != NULL) ? strlen(s._key._suffix) : 0);
     s._info = sub_info;
     s._callback = callback;
     s._dropper = dropper;
@@ -273,6 +275,8 @@ _z_queryable_t *_z_declare_queryable(_z_session_rc_t *zn, _z_keyexpr_t keyexpr,
     _z_session_queryable_t q;
     q._id = _z_get_entity_id(&zn->in->val);
     q._key = _z_get_expanded_key_from_key(&zn->in->val, &keyexpr);
+    // A key expression that can not be compiled is still matched, only more slowly
+    (void)_z_keyexpr_compile(&q._compiled, q._key._suffix, (q._key._suffix != NULL) ? strlen(q._key._suffix) : 0);
     q._complete = complete;
     q._callback = callback;
     q._dropper = dropper;
@@ -378,7 +382,7 @@ int8_t _z_send_reply(const _z_query_t *query, _z_keyexpr_t keyexpr, const _z_val
 /*------------------ Query ------------------*/
 int8_t _z_query(_z_session_t *zn, _z_keyexpr_t keyexpr, const char *parameters, const z_query_target_t target,
                 const z_consolidation_mode_t consolidation, _z_value_t value, _z_reply_handler_t callback,
-                void *arg_call, _z_drop_handler_t dropper, void *arg_drop
+                void *arg_call, _z_drop_handler_t dropper, void *arg_drop, uint32_t timeout_ms
 #if Z_FEATURE_ATTACHMENT == 1
                 ,
                 z_attachment_t attachment
@@ -397,10 +401,13 @@ int8_t _z_query(_z_session_t *zn, _z_keyexpr_t keyexpr, const char *parameters,
         pq->_anykey = (strstr(pq->_parameters, Z_SELECTOR_QUERY_MATCH) == NULL) ? false : true;
         pq->_callback = callback;
         pq->_dropper = dropper;
-        pq->_pending_replies = NULL;
+        _z_pending_replies_init(&pq->_pending_replies);
         pq->_call_arg = arg_call;
         pq->_drop_arg = arg_drop;
+        pq->_timeout_ms = timeout_ms;
+        pq->_refcount = 1;
 
+        // The query may complete or expire as soon as it is registered, the reference kept here keeps it alive
         ret = _z_register_pending_query(zn, pq);  // Add the pending query to the current session
         if (ret == _Z_RES_OK) {
             _z_bytes_t params = _z_bytes_wrap((uint8_t *)pq->_parameters, strlen(pq->_parameters));
@@ -415,9 +422,8 @@ int8_t _z_query(_z_session_t *zn, _z_keyexpr_t keyexpr, const char *parameters,
                 _z_unregister_pending_query(zn, pq);
                 ret = _Z_ERR_TRANSPORT_TX_FAILED;
             }
-        } else {
-            _z_pending_query_clear(pq);
         }
+        _z_pending_query_release(zn, pq);
     }
 
     return ret;
@@ -23,9 +23,11 @@
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/net/memory.h"
 #include "zenoh-pico/protocol/core.h"
+#include "zenoh-pico/session/query.h"
 #include "zenoh-pico/session/utils.h"
 #include "zenoh-pico/transport/common/lease.h"
 #include "zenoh-pico/transport/common/read.h"
+#include "zenoh-pico/transport/common/tx.h"
 #include "zenoh-pico/transport/multicast.h"
 #include "zenoh-pico/transport/multicast/lease.h"
 #include "zenoh-pico/transport/multicast/read.h"
@@ -34,6 +36,7 @@
 #include "zenoh-pico/transport/unicast.h"
 #include "zenoh-pico/transport/unicast/lease.h"
 #include "zenoh-pico/transport/unicast/read.h"
+#include "zenoh-pico/transport/unicast/tx.h"
 #include "zenoh-pico/utils/logging.h"
 #include "zenoh-pico/utils/uuid.h"
 
@@ -174,10 +177,30 @@ _z_config_t *_z_info(const _z_session_t *zn) {
 
 int8_t _zp_read(_z_session_t *zn) { return _z_read(&zn->_tp); }
 
-int8_t _zp_send_keep_alive(_z_session_t *zn) { return _z_send_keep_alive(&zn->_tp); }
+int8_t _zp_send_keep_alive(_z_session_t *zn) {
+#if Z_FEATURE_QUERY == 1
+    // Without a lease task, the query timeouts are checked along with the lease
+    (void)_z_expire_pending_queries(zn);
+#endif
+    return _z_send_keep_alive(&zn->_tp);
+}
 
 int8_t _zp_send_join(_z_session_t *zn) { return _z_send_join(&zn->_tp); }
 
+int8_t _zp_flush(_z_session_t *zn) { return _z_flush(&zn->_tp); }
+
+int8_t _zp_stats_get(_z_session_t *zn, _z_stats_t *stats) {
+    int8_t ret = _Z_RES_OK;
+#if Z_FEATURE_STATS == 1
+    _z_transport_get_stats(&zn->_tp, stats);
+#else
+    _ZP_UNUSED(zn);
+    _z_stats_init(stats);
+    ret = _Z_ERR_GENERIC;
+#endif
+    return ret;
+}
+
 #if Z_FEATURE_MULTI_THREAD == 1
 int8_t _zp_start_read_task(_z_session_t *zn, zp_task_attr_t *attr) {
     int8_t ret = _Z_RES_OK;
@@ -276,4 +299,67 @@ int8_t _zp_stop_lease_task(_z_session_t *zn) {
     }
     return ret;
 }
+
+int8_t _zp_start_tx_task(_z_session_t *zn, zp_task_attr_t *attr) {
+    int8_t ret = _Z_RES_OK;
+#if Z_FEATURE_TX_QUEUE == 1 && Z_FEATURE_UNICAST_TRANSPORT == 1
+    // Allocate task
+    zp_task_t *task = (zp_task_t *)zp_malloc(sizeof(zp_task_t));
+    if (task == NULL) {
+        ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+    } else if (zn->_tp._type == _Z_TRANSPORT_UNICAST_TYPE) {
+        ret = _zp_unicast_start_tx_task(&zn->_tp._transport._unicast, attr, task);
+    } else {
+        ret = _Z_ERR_TRANSPORT_NOT_AVAILABLE;
+    }
+    // Free task if operation failed
+    if (ret != _Z_RES_OK) {
+        zp_free(task);
+    }
+#else
+    _ZP_UNUSED(zn);
+    _ZP_UNUSED(attr);
+    ret = _Z_ERR_TRANSPORT_NOT_AVAILABLE;
+#endif
+    return ret;
+}
+
+int8_t _zp_stop_tx_task(_z_session_t *zn) {
+    int8_t ret = _Z_RES_OK;
+#if Z_FEATURE_TX_QUEUE == 1 && Z_FEATURE_UNICAST_TRANSPORT == 1
+    if (zn->_tp._type == _Z_TRANSPORT_UNICAST_TYPE) {
+        ret = _zp_unicast_stop_tx_task(&zn->_tp._transport._unicast);
+    } else {
+        ret = _Z_ERR_TRANSPORT_NOT_AVAILABLE;
+    }
+#else
+    _ZP_UNUSED(zn);
+    ret = _Z_ERR_TRANSPORT_NOT_AVAILABLE;
+#endif
+    return ret;
+}
+
+int8_t _zp_start_dispatch_tasks(_z_session_t *zn, zp_task_attr_t *attr, size_t workers) {
+    int8_t ret = _Z_RES_OK;
+#if Z_FEATURE_DISPATCH_POOL == 1 && Z_FEATURE_SUBSCRIPTION == 1
+    ret = _z_dispatch_pool_start(&zn->_dispatch_pool, attr, workers);
+#else
+    _ZP_UNUSED(zn);
+    _ZP_UNUSED(attr);
+    _ZP_UNUSED(workers);
+    ret = _Z_ERR_GENERIC;
+#endif
+    return ret;
+}
+
+int8_t _zp_stop_dispatch_tasks(_z_session_t *zn) {
+    int8_t ret = _Z_RES_OK;
+#if Z_FEATURE_DISPATCH_POOL == 1 && Z_FEATURE_SUBSCRIPTION == 1
+    ret = _z_dispatch_pool_stop(&zn->_dispatch_pool);
+#else
+    _ZP_UNUSED(zn);
+    ret = _Z_ERR_GENERIC;
+#endif
+    return ret;
+}
 #endif  // Z_FEATURE_MULTI_THREAD == 1
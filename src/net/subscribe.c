@@ -18,6 +18,7 @@ _z_subinfo_t _z_subinfo_push_default(void) {
     _z_subinfo_t si;
     si.reliability = Z_RELIABILITY_RELIABLE;
     si.mode = Z_SUBMODE_PUSH;
+    si.dispatch = Z_DISPATCH_INLINE;
     si.period = (_z_period_t){.origin = 0, .period = 0, .duration = 0};
     return si;
 }
@@ -26,6 +27,7 @@ _z_subinfo_t _z_subinfo_pull_default(void) {
     _z_subinfo_t si;
     si.reliability = Z_RELIABILITY_RELIABLE;
     si.mode = Z_SUBMODE_PULL;
+    si.dispatch = Z_DISPATCH_INLINE;
     si.period = (_z_period_t){.origin = 0, .period = 0, .duration = 0};
     return si;
 }
@@ -15,11 +15,167 @@
 #include "zenoh-pico/protocol/codec.h"
 
 #include <stdint.h>
+#include <string.h>
 
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/utils/logging.h"
+#include "zenoh-pico/utils/pointers.h"
 #include "zenoh-pico/utils/result.h"
 
+/*------------------ varint ------------------*/
+// The first 8 bytes of a varint, i.e. its lowest 56 bits, are read and written as a single 64-bit word, and at most
+// two more bytes hold the upper bits of 64-bit values. The byte by byte paths only remain near the end of the buffers.
+#define _Z_VARINT_WORD_LEN 8
+#define _Z_VARINT_WORD_MASK (((uint64_t)1 << 56) - (uint64_t)1)
+#define _Z_VARINT_CONT_BITS ((uint64_t)0x8080808080808080)
+
+// Assembled with shifts rather than cast, so that they are both endian agnostic and free of alignment requirements.
+// Compilers merge them into a single unaligned load or store wherever the target allows it.
+static inline uint64_t __z_le64_load(const uint8_t *p) {
+    return (uint64_t)p[0] | ((uint64_t)p[1] << 8) | ((uint64_t)p[2] << 16) | ((uint64_t)p[3] << 24) |
+           ((uint64_t)p[4] << 32) | ((uint64_t)p[5] << 40) | ((uint64_t)p[6] << 48) | ((uint64_t)p[7] << 56);
+}
+
+static inline void __z_le64_store(uint8_t *p, uint64_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+    p[4] = (uint8_t)(v >> 32);
+    p[5] = (uint8_t)(v >> 40);
+    p[6] = (uint8_t)(v >> 48);
+    p[7] = (uint8_t)(v >> 56);
+}
+
+static inline size_t __z_varint_len(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)((63 - __builtin_clzll(v | (uint64_t)1)) / 7 + 1);
+#else
+    size_t len = 1;
+    for (uint64_t lv = v >> 7; lv != (uint64_t)0; lv = lv >> 7) {
+        len = len + (size_t)1;
+    }
+    return len;
+#endif
+}
+
+// The index of the first byte whose bit is set in stop, which only has the top bit of each byte possibly set
+static inline size_t __z_varint_stop_idx(uint64_t stop) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_ctzll(stop) >> 3;
+#else
+    size_t idx = 0;
+    for (uint64_t s = stop >> 7; (s & (uint64_t)1) == (uint64_t)0; s = s >> 8) {
+        idx = idx + (size_t)1;
+    }
+    return idx;
+#endif
+}
+
+uint8_t *_z_zint_encode_at(uint8_t *cursor, uint64_t v) {
+    if (v < (uint64_t)0x80) {
+        cursor[0] = (uint8_t)v;
+        return _z_ptr_u8_offset(cursor, 1);
+    }
+    size_t len = __z_varint_len(v);
+    // Spread the 7-bit groups into bytes: 28 bits per half, then 14 bits per quarter, then 7 bits per byte
+    uint64_t x = v & _Z_VARINT_WORD_MASK;
+    x = ((x & (uint64_t)0x00fffffff0000000) << 4) | (x & (uint64_t)0x000000000fffffff);
+    x = ((x & (uint64_t)0x0fffc0000fffc000) << 2) | (x & (uint64_t)0x00003fff00003fff);
+    x = ((x & (uint64_t)0x3f803f803f803f80) << 1) | (x & (uint64_t)0x007f007f007f007f);
+    if (len <= (size_t)_Z_VARINT_WORD_LEN) {
+        // Every byte but the last one has the continuation bit, the bytes past it are overwritten by next writes
+        x = x | (_Z_VARINT_CONT_BITS & (((uint64_t)1 << ((len - (size_t)1) * (size_t)8)) - (uint64_t)1));
+        __z_le64_store(cursor, x);
+    } else {
+        __z_le64_store(cursor, x | _Z_VARINT_CONT_BITS);
+        cursor[8] = (uint8_t)((v >> 56) & (uint64_t)0x7f);
+        if (len == (size_t)_Z_ZINT_MAX_LEN) {
+            cursor[8] = cursor[8] | (uint8_t)0x80;
+            cursor[9] = (uint8_t)(v >> 63);
+        }
+    }
+    return _z_ptr_u8_offset(cursor, (ptrdiff_t)len);
+}
+
+static int8_t __z_varint_encode(_z_wbuf_t *wbf, uint64_t v) {
+    int8_t ret = _Z_RES_OK;
+
+    // Ids, lengths and flags mostly fit a single byte, which needs no reservation
+    if (v < (uint64_t)0x80) {
+        return _z_wbuf_write(wbf, (uint8_t)v);
+    }
+    size_t len = __z_varint_len(v);
+    uint8_t *cursor = _z_wbuf_reserve(wbf, (len > (size_t)_Z_VARINT_WORD_LEN) ? len : (size_t)_Z_VARINT_WORD_LEN);
+    if (cursor != NULL) {
+        (void)_z_zint_encode_at(cursor, v);
+        _z_wbuf_commit(wbf, len);
+    } else {
+        uint64_t lv = v;
+        while ((lv > (uint64_t)0x7f) && (ret == _Z_RES_OK)) {
+            uint8_t c = (uint8_t)(lv & (uint64_t)0x7f) | (uint8_t)0x80;
+            ret = _z_wbuf_write(wbf, c);
+            lv = lv >> (uint64_t)7;
+        }
+        if (ret == _Z_RES_OK) {
+            ret = _z_wbuf_write(wbf, (uint8_t)lv);
+        }
+    }
+
+    return ret;
+}
+
+static int8_t __z_varint_decode(uint64_t *v, _z_zbuf_t *zbf) {
+    int8_t ret = _Z_RES_OK;
+    *v = 0;
+
+    size_t readable = _z_zbuf_len(zbf);
+    const uint8_t *p = _z_zbuf_get_rptr(zbf);
+    // A first byte without the continuation bit is the whole varint
+    if ((readable > (size_t)0) && (p[0] < (uint8_t)0x80)) {
+        *v = p[0];
+        _z_zbuf_set_rpos(zbf, _z_zbuf_get_rpos(zbf) + (size_t)1);
+        return ret;
+    }
+    uint64_t word = 0;
+    uint64_t stop = 0;
+    if (readable >= (size_t)_Z_VARINT_WORD_LEN) {
+        word = __z_le64_load(p);
+        stop = ~word & _Z_VARINT_CONT_BITS;
+    }
+    // Keep the bytes up to the first one without the continuation bit, then pack their 7-bit groups
+    uint64_t x = word & (stop ^ (stop - (uint64_t)1)) & ~_Z_VARINT_CONT_BITS;
+    x = ((x & (uint64_t)0x7f007f007f007f00) >> 1) | (x & (uint64_t)0x007f007f007f007f);
+    x = ((x & (uint64_t)0x3fff00003fff0000) >> 2) | (x & (uint64_t)0x00003fff00003fff);
+    x = ((x & (uint64_t)0x0fffffff00000000) >> 4) | (x & (uint64_t)0x000000000fffffff);
+
+    if (stop != (uint64_t)0) {
+        *v = x;
+        _z_zbuf_set_rpos(zbf, _z_zbuf_get_rpos(zbf) + __z_varint_stop_idx(stop) + (size_t)1);
+    } else if ((readable >= (size_t)_Z_ZINT_MAX_LEN) && ((p[8] < (uint8_t)0x80) || (p[9] < (uint8_t)0x80))) {
+        *v = x | ((uint64_t)(p[8] & (uint8_t)0x7f) << 56);
+        size_t len = (size_t)_Z_ZINT_MAX_LEN - (size_t)1;
+        if (p[8] > (uint8_t)0x7f) {
+            *v = *v | ((uint64_t)p[9] << 63);
+            len = (size_t)_Z_ZINT_MAX_LEN;
+        }
+        _z_zbuf_set_rpos(zbf, _z_zbuf_get_rpos(zbf) + len);
+    } else {
+        uint8_t i = 0;
+        uint8_t u8 = 0;
+        do {
+            if (_z_uint8_decode(&u8, zbf) == _Z_RES_OK) {
+                *v = *v | (((uint64_t)u8 & (uint64_t)0x7f) << i);
+                i = i + (uint8_t)7;
+            } else {
+                ret |= _Z_ERR_MESSAGE_DESERIALIZATION_FAILED;
+            }
+        } while (u8 > (uint8_t)0x7f);
+    }
+
+    return ret;
+}
+
 /*------------------ period ------------------*/
 int8_t _z_period_encode(_z_wbuf_t *buf, const _z_period_t *tp) {
     _Z_RETURN_IF_ERR(_z_uint_encode(buf, tp->origin))
@@ -101,39 +257,22 @@ int8_t _z_whatami_decode(z_whatami_t *en, _z_zbuf_t *zbf) {
     return ret;
 }
 
-int8_t _z_uint_encode(_z_wbuf_t *wbf, unsigned int uint) {
-    unsigned int lv = uint;
-
-    while (lv > (unsigned int)0x7f) {
-        uint8_t c = (uint8_t)(lv & (unsigned int)0x7f) | (uint8_t)0x80;
-        _Z_RETURN_IF_ERR(_z_wbuf_write(wbf, c))
-        lv = lv >> (unsigned int)7;
-    }
-
-    uint8_t c = (uint8_t)(lv & (unsigned int)0xff);
-    return _z_wbuf_write(wbf, c);
-}
+int8_t _z_uint_encode(_z_wbuf_t *wbf, unsigned int uint) { return __z_varint_encode(wbf, (uint64_t)uint); }
 
 int8_t _z_uint_decode(unsigned int *uint, _z_zbuf_t *zbf) {
-    int8_t ret = _Z_RES_OK;
-    *uint = 0;
-
-    uint8_t i = 0;
-    uint8_t u8 = 0;
-    do {
-        if (_z_uint8_decode(&u8, zbf) == _Z_RES_OK) {
-            *uint = *uint | (((unsigned int)u8 & (unsigned int)0x7f) << (unsigned int)i);
-            i = i + (uint8_t)7;
-        } else {
-            ret |= _Z_ERR_MESSAGE_DESERIALIZATION_FAILED;
-        }
-    } while (u8 > (uint8_t)0x7f);
-
+    uint64_t v = 0;
+    int8_t ret = __z_varint_decode(&v, zbf);
+    *uint = (unsigned int)v;
     return ret;
 }
 
 int8_t _z_uint8_encode(_z_wbuf_t *wbf, uint8_t u8) { return _z_wbuf_write(wbf, u8); }
 
+uint8_t *_z_uint8_encode_at(uint8_t *cursor, uint8_t u8) {
+    cursor[0] = u8;
+    return _z_ptr_u8_offset(cursor, 1);
+}
+
 int8_t _z_uint8_decode(uint8_t *u8, _z_zbuf_t *zbf) {
     int8_t ret = _Z_RES_OK;
     *u8 = 0;
@@ -170,70 +309,14 @@ int8_t _z_uint16_decode(uint16_t *u16, _z_zbuf_t *zbf) {
     return ret;
 }
 
-int8_t _z_uint64_encode(_z_wbuf_t *wbf, uint64_t u64) {
-    uint64_t lv = u64;
+int8_t _z_uint64_encode(_z_wbuf_t *wbf, uint64_t u64) { return __z_varint_encode(wbf, u64); }
 
-    while (lv > (uint64_t)0x7f) {
-        uint8_t c = (uint8_t)(lv & (uint64_t)0x7f) | (uint8_t)0x80;
-        _Z_RETURN_IF_ERR(_z_wbuf_write(wbf, c))
-        lv = lv >> (_z_zint_t)7;
-    }
-
-    uint8_t c = lv & (uint64_t)0xff;
-    return _z_wbuf_write(wbf, c);
-}
-
-int8_t _z_uint64_decode(uint64_t *u64, _z_zbuf_t *zbf) {
-    int8_t ret = _Z_RES_OK;
-    *u64 = 0;
-
-    uint8_t i = 0;
-    uint8_t u8 = 0;
-    do {
-        if (_z_uint8_decode(&u8, zbf) == _Z_RES_OK) {
-            *u64 = *u64 | (((_z_zint_t)u8 & 0x7f) << i);
-            i = i + (uint8_t)7;
-        } else {
-            ret |= _Z_ERR_MESSAGE_DESERIALIZATION_FAILED;
-        }
-    } while (u8 > (uint8_t)0x7f);
-
-    return ret;
-}
+int8_t _z_uint64_decode(uint64_t *u64, _z_zbuf_t *zbf) { return __z_varint_decode(u64, zbf); }
 
 /*------------------ z_zint ------------------*/
-uint8_t _z_zint_len(_z_zint_t v) {
-    uint8_t len = 1;
-    while (v > 0x7f) {
-        v >>= 7;
-        len++;
-    }
-    return len;
-}
-int8_t _z_zint_encode(_z_wbuf_t *wbf, _z_zint_t v) {
-    _z_zint_t lv = v;
-
-    while (lv > 0x7f) {
-        uint8_t c = (lv & 0x7f) | 0x80;
-        _Z_RETURN_IF_ERR(_z_wbuf_write(wbf, c))
-        lv = lv >> (_z_zint_t)7;
-    }
-
-    uint8_t c = lv & 0xff;
-    return _z_wbuf_write(wbf, c);
-}
-int8_t _z_zint64_encode(_z_wbuf_t *wbf, uint64_t v) {
-    uint64_t lv = v;
-
-    while (lv > 0x7f) {
-        uint8_t c = (lv & 0x7f) | 0x80;
-        _Z_RETURN_IF_ERR(_z_wbuf_write(wbf, c))
-        lv = lv >> (uint64_t)7;
-    }
-
-    uint8_t c = lv & 0xff;
-    return _z_wbuf_write(wbf, c);
-}
+uint8_t _z_zint_len(_z_zint_t v) { return (uint8_t)__z_varint_len((uint64_t)v); }
+int8_t _z_zint_encode(_z_wbuf_t *wbf, _z_zint_t v) { return __z_varint_encode(wbf, (uint64_t)v); }
+int8_t _z_zint64_encode(_z_wbuf_t *wbf, uint64_t v) { return __z_varint_encode(wbf, v); }
 int8_t _z_zint16_decode(uint16_t *zint, _z_zbuf_t *zbf) {
     int8_t ret = _Z_RES_OK;
     _z_zint_t buf;
@@ -257,45 +340,23 @@ int8_t _z_zint32_decode(uint32_t *zint, _z_zbuf_t *zbf) {
     return ret;
 }
 int8_t _z_zint_decode(_z_zint_t *zint, _z_zbuf_t *zbf) {
-    int8_t ret = _Z_RES_OK;
-    *zint = 0;
-
-    uint8_t i = 0;
-    uint8_t u8 = 0;
-    do {
-        if (_z_uint8_decode(&u8, zbf) == _Z_RES_OK) {
-            *zint = *zint | (((_z_zint_t)u8 & 0x7f) << i);
-            i = i + (uint8_t)7;
-        } else {
-            ret |= _Z_ERR_MESSAGE_DESERIALIZATION_FAILED;
-        }
-    } while (u8 > (uint8_t)0x7f);
-
+    uint64_t v = 0;
+    int8_t ret = __z_varint_decode(&v, zbf);
+    *zint = (_z_zint_t)v;
     return ret;
 }
-int8_t _z_zint64_decode(uint64_t *zint, _z_zbuf_t *zbf) {
-    int8_t ret = _Z_RES_OK;
-    *zint = 0;
-
-    uint8_t i = 0;
-    uint8_t u8 = 0;
-    do {
-        if (_z_uint8_decode(&u8, zbf) == _Z_RES_OK) {
-            *zint = *zint | (((uint64_t)u8 & 0x7f) << i);
-            i = i + (uint8_t)7;
-        } else {
-            ret |= _Z_ERR_MESSAGE_DESERIALIZATION_FAILED;
-        }
-    } while (u8 > (uint8_t)0x7f);
+int8_t _z_zint64_decode(uint64_t *zint, _z_zbuf_t *zbf) { return __z_varint_decode(zint, zbf); }
 
-    return ret;
+/*------------------ uint8_array ------------------*/
+_Bool _z_bytes_val_is_wrapped(const _z_wbuf_t *wbf, size_t len) {
+    return ((wbf->_expansion_step != 0) && (len > (size_t)Z_TSID_LENGTH)) ||
+           ((wbf->_wrap_threshold != 0) && (len >= wbf->_wrap_threshold));
 }
 
-/*------------------ uint8_array ------------------*/
 int8_t _z_bytes_val_encode(_z_wbuf_t *wbf, const _z_bytes_t *bs) {
     int8_t ret = _Z_RES_OK;
 
-    if ((wbf->_expansion_step != 0) && (bs->len > Z_TSID_LENGTH)) {
+    if (_z_bytes_val_is_wrapped(wbf, bs->len) == true) {
         ret |= _z_wbuf_wrap_bytes(wbf, bs->start, 0, bs->len);
     } else {
         ret |= _z_wbuf_write_bytes(wbf, bs->start, 0, bs->len);
@@ -314,6 +375,17 @@ int8_t _z_bytes_encode(_z_wbuf_t *wbf, const _z_bytes_t *bs) {
 }
 size_t _z_bytes_encode_len(const _z_bytes_t *bs) { return _z_zint_len(bs->len) + bs->len; }
 
+uint8_t *_z_bytes_val_encode_at(uint8_t *cursor, const uint8_t *bs, size_t len) {
+    if (len > (size_t)0) {
+        (void)memcpy(cursor, bs, len);
+    }
+    return _z_ptr_u8_offset(cursor, (ptrdiff_t)len);
+}
+
+uint8_t *_z_bytes_encode_at(uint8_t *cursor, const _z_bytes_t *bs) {
+    return _z_bytes_val_encode_at(_z_zint_encode_at(cursor, bs->len), bs->start, bs->len);
+}
+
 int8_t _z_bytes_val_decode_na(_z_bytes_t *bs, _z_zbuf_t *zbf) {
     int8_t ret = _Z_RES_OK;
 
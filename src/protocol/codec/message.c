@@ -34,6 +34,7 @@
 #include "zenoh-pico/protocol/iobuf.h"
 #include "zenoh-pico/protocol/keyexpr.h"
 #include "zenoh-pico/utils/logging.h"
+#include "zenoh-pico/utils/pointers.h"
 #include "zenoh-pico/utils/result.h"
 
 /*=============================*/
@@ -60,7 +61,6 @@ int8_t _z_id_encode_as_zbytes(_z_wbuf_t *wbf, const _z_id_t *id) {
     uint8_t len = _z_id_len(*id);
 
     if (len != 0) {
-        printf("ZIDLEN: %d\n", len);
         _z_bytes_t buf = _z_bytes_wrap(id->id, len);
         ret = _z_bytes_encode(wbf, &buf);
     } else {
@@ -97,6 +97,17 @@ int8_t _z_timestamp_encode_ext(_z_wbuf_t *wbf, const _z_timestamp_t *ts) {
     return _z_timestamp_encode(wbf, ts);
 }
 
+uint8_t *_z_timestamp_encode_at(uint8_t *cursor, const _z_timestamp_t *ts) {
+    uint8_t zidlen = _z_id_len(ts->id);
+    uint8_t *cur = _z_zint_encode_at(cursor, ts->time);
+    cur = _z_uint8_encode_at(cur, zidlen);
+    return _z_bytes_val_encode_at(cur, ts->id.id, zidlen);
+}
+uint8_t *_z_timestamp_encode_ext_at(uint8_t *cursor, const _z_timestamp_t *ts) {
+    uint8_t *cur = _z_zint_encode_at(cursor, _z_zint_len(ts->time) + 1 + _z_id_len(ts->id));
+    return _z_timestamp_encode_at(cur, ts);
+}
+
 int8_t _z_timestamp_decode(_z_timestamp_t *ts, _z_zbuf_t *zbf) {
     _Z_DEBUG("Decoding _TIMESTAMP");
     int8_t ret = _Z_RES_OK;
@@ -120,6 +131,15 @@ int8_t _z_keyexpr_encode(_z_wbuf_t *wbf, _Bool has_suffix, const _z_keyexpr_t *f
     return ret;
 }
 
+uint8_t *_z_keyexpr_encode_at(uint8_t *cursor, const _z_keyexpr_t *ke, size_t suffix_len) {
+    uint8_t *cur = _z_zint_encode_at(cursor, ke->_id);
+    if (suffix_len > (size_t)0) {
+        cur = _z_zint_encode_at(cur, suffix_len);
+        cur = _z_bytes_val_encode_at(cur, (const uint8_t *)ke->_suffix, suffix_len);
+    }
+    return cur;
+}
+
 int8_t _z_keyexpr_decode(_z_keyexpr_t *ke, _z_zbuf_t *zbf, _Bool has_suffix) {
     _Z_DEBUG("Decoding _RESKEY");
     int8_t ret = _Z_RES_OK;
@@ -242,6 +262,17 @@ int8_t _z_source_info_encode_ext(_z_wbuf_t *wbf, const _z_source_info_t *info) {
     _Z_RETURN_IF_ERR(_z_zint_encode(wbf, info->_source_sn));
     return ret;
 }
+// The length prefix, the zid length, the zid, the entity id and the sequence number
+#define _Z_SOURCE_INFO_EXT_MAX_LEN (_Z_ZINT_MAX_LEN + 1 + Z_ZID_LENGTH + 2 * _Z_ZINT_MAX_LEN)
+static uint8_t *__z_source_info_encode_ext_at(uint8_t *cursor, const _z_source_info_t *info) {
+    uint8_t zidlen = _z_id_len(info->_id);
+    uint8_t *cur = _z_zint_encode_at(
+        cursor, (size_t)1 + zidlen + _z_zint_len(info->_entity_id) + _z_zint_len(info->_source_sn));
+    cur = _z_uint8_encode_at(cur, zidlen << 4);
+    cur = _z_bytes_val_encode_at(cur, info->_id.id, zidlen);
+    cur = _z_zint_encode_at(cur, info->_entity_id);
+    return _z_zint_encode_at(cur, info->_source_sn);
+}
 #if Z_FEATURE_ATTACHMENT == 1
 int8_t _z_attachment_encode_ext_kv(_z_bytes_t key, _z_bytes_t value, void *ctx) {
     _z_wbuf_t *wbf = (_z_wbuf_t *)ctx;
@@ -257,56 +288,111 @@ int8_t _z_attachment_encode_ext(_z_wbuf_t *wbf, z_attachment_t att) {
 }
 #endif
 /*------------------ Push Body Field ------------------*/
-int8_t _z_push_body_encode(_z_wbuf_t *wbf, const _z_push_body_t *pshb) {
-    (void)(wbf);
-    (void)(pshb);
-    uint8_t header = pshb->_is_put ? _Z_MID_Z_PUT : _Z_MID_Z_DEL;
-    _Bool has_source_info = _z_id_check(pshb->_body._put._commons._source_info._id) ||
-                            pshb->_body._put._commons._source_info._source_sn != 0 ||
-                            pshb->_body._put._commons._source_info._entity_id != 0;
+typedef struct {
+    uint8_t header;
+    _Bool has_timestamp;
+    _Bool has_encoding;
+    _Bool has_source_info;
+    _Bool has_attachment;
+} __z_push_body_fields_t;
+
+static __z_push_body_fields_t __z_push_body_fields(const _z_push_body_t *pshb) {
+    __z_push_body_fields_t f;
+    f.header = pshb->_is_put ? _Z_MID_Z_PUT : _Z_MID_Z_DEL;
+    f.has_source_info = _z_id_check(pshb->_body._put._commons._source_info._id) ||
+                        pshb->_body._put._commons._source_info._source_sn != 0 ||
+                        pshb->_body._put._commons._source_info._entity_id != 0;
 #if Z_FEATURE_ATTACHMENT == 1
     z_attachment_t att = _z_encoded_as_attachment(&pshb->_body._put._attachment);
-    _Bool has_attachment = pshb->_is_put && z_attachment_check(&att);
+    f.has_attachment = pshb->_is_put && z_attachment_check(&att);
 #else
-    _Bool has_attachment = false;
+    f.has_attachment = false;
 #endif
-    _Bool has_timestamp = _z_timestamp_check(&pshb->_body._put._commons._timestamp);
-    _Bool has_encoding = false;
-    if (has_source_info || has_attachment) {
-        header |= _Z_FLAG_Z_Z;
+    f.has_timestamp = _z_timestamp_check(&pshb->_body._put._commons._timestamp);
+    f.has_encoding = false;
+    if (f.has_source_info || f.has_attachment) {
+        f.header |= _Z_FLAG_Z_Z;
     }
     if (pshb->_is_put) {
-        if (has_timestamp) {
-            header |= _Z_FLAG_Z_P_T;
+        if (f.has_timestamp) {
+            f.header |= _Z_FLAG_Z_P_T;
         }
-        has_encoding = pshb->_body._put._encoding.prefix != Z_ENCODING_PREFIX_EMPTY ||
-                       !_z_bytes_is_empty(&pshb->_body._put._encoding.suffix);
-        if (has_encoding) {
-            header |= _Z_FLAG_Z_P_E;
+        f.has_encoding = pshb->_body._put._encoding.prefix != Z_ENCODING_PREFIX_EMPTY ||
+                         !_z_bytes_is_empty(&pshb->_body._put._encoding.suffix);
+        if (f.has_encoding) {
+            f.header |= _Z_FLAG_Z_P_E;
         }
     } else {
-        if (has_timestamp) {
-            header |= _Z_FLAG_Z_D_T;
+        if (f.has_timestamp) {
+            f.header |= _Z_FLAG_Z_D_T;
         }
     }
-    _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, header));
-    if (has_timestamp) {
+    return f;
+}
+
+size_t _z_push_body_encode_max_len(const _z_wbuf_t *wbf, const _z_push_body_t *pshb) {
+    __z_push_body_fields_t f = __z_push_body_fields(pshb);
+    size_t len = 0;
+    // Attachments are encoded while iterating over them, and wrapped payloads do not go in the reserved bytes
+    if ((f.has_attachment == false) &&
+        ((pshb->_is_put == false) || (_z_bytes_val_is_wrapped(wbf, pshb->_body._put._payload.len) == false))) {
+        len = 1;
+        if (f.has_timestamp) {
+            len = len + (size_t)_Z_TIMESTAMP_MAX_LEN;
+        }
+        if (f.has_encoding) {
+            len = len + (size_t)(2 * _Z_ZINT_MAX_LEN) + pshb->_body._put._encoding.suffix.len;
+        }
+        if (f.has_source_info) {
+            len = len + (size_t)1 + (size_t)_Z_SOURCE_INFO_EXT_MAX_LEN;
+        }
+        if (pshb->_is_put) {
+            len = len + (size_t)_Z_ZINT_MAX_LEN + pshb->_body._put._payload.len;
+        }
+    }
+    return len;
+}
+
+uint8_t *_z_push_body_encode_at(uint8_t *cursor, const _z_push_body_t *pshb) {
+    __z_push_body_fields_t f = __z_push_body_fields(pshb);
+    uint8_t *cur = _z_uint8_encode_at(cursor, f.header);
+    if (f.has_timestamp) {
+        cur = _z_timestamp_encode_at(cur, &pshb->_body._put._commons._timestamp);
+    }
+    if (f.has_encoding) {
+        cur = _z_zint_encode_at(cur, pshb->_body._put._encoding.prefix);
+        cur = _z_bytes_encode_at(cur, &pshb->_body._put._encoding.suffix);
+    }
+    if (f.has_source_info) {
+        cur = _z_uint8_encode_at(cur, _Z_MSG_EXT_ENC_ZBUF | 0x01);
+        cur = __z_source_info_encode_ext_at(cur, &pshb->_body._put._commons._source_info);
+    }
+    if (pshb->_is_put) {
+        cur = _z_bytes_encode_at(cur, &pshb->_body._put._payload);
+    }
+    return cur;
+}
+
+static int8_t __z_push_body_write(_z_wbuf_t *wbf, const _z_push_body_t *pshb) {
+    __z_push_body_fields_t f = __z_push_body_fields(pshb);
+    _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, f.header));
+    if (f.has_timestamp) {
         _Z_RETURN_IF_ERR(_z_timestamp_encode(wbf, &pshb->_body._put._commons._timestamp));
     }
 
-    if (has_encoding) {
+    if (f.has_encoding) {
         _Z_RETURN_IF_ERR(_z_encoding_prefix_encode(wbf, pshb->_body._put._encoding.prefix));
         _Z_RETURN_IF_ERR(_z_bytes_encode(wbf, &pshb->_body._put._encoding.suffix));
     }
 
-    if (has_source_info) {
-        _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ENC_ZBUF | 0x01 | (has_attachment ? _Z_FLAG_Z_Z : 0)));
+    if (f.has_source_info) {
+        _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ENC_ZBUF | 0x01 | (f.has_attachment ? _Z_FLAG_Z_Z : 0)));
         _Z_RETURN_IF_ERR(_z_source_info_encode_ext(wbf, &pshb->_body._put._commons._source_info));
     }
 #if Z_FEATURE_ATTACHMENT == 1
-    if (has_attachment) {
+    if (f.has_attachment) {
         _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ENC_ZBUF | 0x03));
-        _Z_RETURN_IF_ERR(_z_attachment_encode_ext(wbf, att));
+        _Z_RETURN_IF_ERR(_z_attachment_encode_ext(wbf, _z_encoded_as_attachment(&pshb->_body._put._attachment)));
     }
 #endif
     if (pshb->_is_put) {
@@ -315,6 +401,20 @@ int8_t _z_push_body_encode(_z_wbuf_t *wbf, const _z_push_body_t *pshb) {
 
     return 0;
 }
+
+int8_t _z_push_body_encode(_z_wbuf_t *wbf, const _z_push_body_t *pshb) {
+    int8_t ret = _Z_RES_OK;
+
+    size_t max_len = _z_push_body_encode_max_len(wbf, pshb);
+    uint8_t *start = (max_len != (size_t)0) ? _z_wbuf_reserve(wbf, max_len) : NULL;
+    if (start != NULL) {
+        _z_wbuf_commit(wbf, _z_ptr_u8_diff(_z_push_body_encode_at(start, pshb), start));
+    } else {
+        ret = __z_push_body_write(wbf, pshb);
+    }
+
+    return ret;
+}
 int8_t _z_push_body_decode_extensions(_z_msg_ext_t *extension, void *ctx) {
     _z_push_body_t *pshb = (_z_push_body_t *)ctx;
     int8_t ret = _Z_RES_OK;
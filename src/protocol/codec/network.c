@@ -17,6 +17,7 @@
 #include <assert.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "zenoh-pico/api/constants.h"
 #include "zenoh-pico/api/types.h"
@@ -32,11 +33,13 @@
 #include "zenoh-pico/protocol/ext.h"
 #include "zenoh-pico/protocol/iobuf.h"
 #include "zenoh-pico/utils/logging.h"
+#include "zenoh-pico/utils/pointers.h"
 #include "zenoh-pico/utils/result.h"
 
 /*------------------ Push Message ------------------*/
 
 int8_t _z_push_encode(_z_wbuf_t *wbf, const _z_n_msg_push_t *msg) {
+    int8_t ret = _Z_RES_OK;
     uint8_t header = _Z_MID_N_PUSH | (_z_keyexpr_is_local(&msg->_key) ? _Z_FLAG_N_REQUEST_M : 0);
     _Bool has_suffix = _z_keyexpr_has_suffix(msg->_key);
     _Bool has_qos_ext = msg->_qos._val != _Z_N_QOS_DEFAULT._val;
@@ -47,22 +50,44 @@ int8_t _z_push_encode(_z_wbuf_t *wbf, const _z_n_msg_push_t *msg) {
     if (has_qos_ext || has_timestamp_ext) {
         header |= _Z_FLAG_N_Z;
     }
-    _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, header));
-    _Z_RETURN_IF_ERR(_z_keyexpr_encode(wbf, has_suffix, &msg->_key));
 
-    if (has_qos_ext) {
-        _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ENC_ZINT | 0x01 | (has_timestamp_ext << 7)));
-        _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, msg->_qos._val));
-    }
+    // A push whose body fits in the reserved bytes is encoded at once, the other ones field by field
+    size_t suffix_len = has_suffix ? strlen(msg->_key._suffix) : 0;
+    size_t body_len = _z_push_body_encode_max_len(wbf, &msg->_body);
+    size_t max_len = 1 + _Z_KEYEXPR_MAX_LEN(suffix_len) + (has_qos_ext ? 2 : 0) +
+                     (has_timestamp_ext ? 1 + _Z_TIMESTAMP_EXT_MAX_LEN : 0) + body_len;
+    uint8_t *start = (body_len != 0) ? _z_wbuf_reserve(wbf, max_len) : NULL;
+    if (start != NULL) {
+        uint8_t *cur = _z_uint8_encode_at(start, header);
+        cur = _z_keyexpr_encode_at(cur, &msg->_key, suffix_len);
+        if (has_qos_ext) {
+            cur = _z_uint8_encode_at(cur, _Z_MSG_EXT_ENC_ZINT | 0x01 | (has_timestamp_ext << 7));
+            cur = _z_uint8_encode_at(cur, msg->_qos._val);
+        }
+        if (has_timestamp_ext) {
+            cur = _z_uint8_encode_at(cur, _Z_MSG_EXT_ENC_ZBUF | 0x02);
+            cur = _z_timestamp_encode_ext_at(cur, &msg->_timestamp);
+        }
+        cur = _z_push_body_encode_at(cur, &msg->_body);
+        _z_wbuf_commit(wbf, _z_ptr_u8_diff(cur, start));
+    } else {
+        _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, header));
+        _Z_RETURN_IF_ERR(_z_keyexpr_encode(wbf, has_suffix, &msg->_key));
 
-    if (has_timestamp_ext) {
-        _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ENC_ZBUF | 0x02));
-        _Z_RETURN_IF_ERR(_z_timestamp_encode_ext(wbf, &msg->_timestamp));
-    }
+        if (has_qos_ext) {
+            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ENC_ZINT | 0x01 | (has_timestamp_ext << 7)));
+            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, msg->_qos._val));
+        }
+
+        if (has_timestamp_ext) {
+            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ENC_ZBUF | 0x02));
+            _Z_RETURN_IF_ERR(_z_timestamp_encode_ext(wbf, &msg->_timestamp));
+        }
 
-    _Z_RETURN_IF_ERR(_z_push_body_encode(wbf, &msg->_body));
+        ret = _z_push_body_encode(wbf, &msg->_body);
+    }
 
-    return _Z_RES_OK;
+    return ret;
 }
 
 int8_t _z_push_decode_ext_cb(_z_msg_ext_t *extension, void *ctx) {
@@ -109,18 +134,59 @@ int8_t _z_push_decode(_z_n_msg_push_t *msg, _z_zbuf_t *zbf, uint8_t header) {
 }
 
 /*------------------ Request Message ------------------*/
-int8_t _z_request_encode(_z_wbuf_t *wbf, const _z_n_msg_request_t *msg) {
-    int8_t ret = _Z_RES_OK;
-    uint8_t header = _Z_MID_N_REQUEST | (_z_keyexpr_is_local(&msg->_key) ? _Z_FLAG_N_REQUEST_M : 0);
-    _Bool has_suffix = _z_keyexpr_has_suffix(msg->_key);
-    if (has_suffix) {
-        header |= _Z_FLAG_N_REQUEST_N;
+// The maximum length of the extensions of a request, up to its body
+static size_t __z_request_exts_max_len(_z_n_msg_request_exts_t exts) {
+    size_t len = 0;
+    if (exts.ext_qos) {
+        len = len + 1 + _Z_ZINT_MAX_LEN;
     }
-    _z_n_msg_request_exts_t exts = _z_n_msg_request_needed_exts(msg);
-    _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, header | (exts.n != 0 ? _Z_FLAG_Z_Z : 0)));
-    _Z_RETURN_IF_ERR(_z_zint_encode(wbf, msg->_rid));
-    _Z_RETURN_IF_ERR(_z_keyexpr_encode(wbf, has_suffix, &msg->_key));
+    if (exts.ext_tstamp) {
+        len = len + 1 + _Z_TIMESTAMP_EXT_MAX_LEN;
+    }
+    if (exts.ext_target) {
+        len = len + 1 + _Z_ZINT_MAX_LEN;
+    }
+    if (exts.ext_budget) {
+        len = len + 1 + _Z_ZINT_MAX_LEN;
+    }
+    if (exts.ext_timeout_ms) {
+        len = len + 1 + _Z_ZINT_MAX_LEN;
+    }
+    return len;
+}
 
+static uint8_t *__z_request_exts_encode_at(uint8_t *cursor, const _z_n_msg_request_t *msg,
+                                           _z_n_msg_request_exts_t exts) {
+    uint8_t *cur = cursor;
+    if (exts.ext_qos) {
+        exts.n -= 1;
+        cur = _z_uint8_encode_at(cur, 0x01 | _Z_MSG_EXT_ENC_ZINT | (exts.n ? _Z_FLAG_Z_Z : 0));
+        cur = _z_zint_encode_at(cur, msg->_ext_qos._val);
+    }
+    if (exts.ext_tstamp) {
+        exts.n -= 1;
+        cur = _z_uint8_encode_at(cur, 0x02 | _Z_MSG_EXT_ENC_ZBUF | (exts.n ? _Z_FLAG_Z_Z : 0));
+        cur = _z_timestamp_encode_ext_at(cur, &msg->_ext_timestamp);
+    }
+    if (exts.ext_target) {
+        exts.n -= 1;
+        cur = _z_uint8_encode_at(cur, 0x04 | _Z_MSG_EXT_ENC_ZINT | (exts.n ? _Z_FLAG_Z_Z : 0) | _Z_MSG_EXT_FLAG_M);
+        cur = _z_zint_encode_at(cur, msg->_ext_target);
+    }
+    if (exts.ext_budget) {
+        exts.n -= 1;
+        cur = _z_uint8_encode_at(cur, 0x05 | _Z_MSG_EXT_ENC_ZINT | (exts.n ? _Z_FLAG_Z_Z : 0));
+        cur = _z_zint_encode_at(cur, msg->_ext_budget);
+    }
+    if (exts.ext_timeout_ms) {
+        exts.n -= 1;
+        cur = _z_uint8_encode_at(cur, 0x06 | _Z_MSG_EXT_ENC_ZINT | (exts.n ? _Z_FLAG_Z_Z : 0));
+        cur = _z_zint_encode_at(cur, msg->_ext_timeout_ms);
+    }
+    return cur;
+}
+
+static int8_t __z_request_exts_write(_z_wbuf_t *wbf, const _z_n_msg_request_t *msg, _z_n_msg_request_exts_t exts) {
     if (exts.ext_qos) {
         exts.n -= 1;
         uint8_t extheader = 0x01 | _Z_MSG_EXT_ENC_ZINT | (exts.n ? _Z_FLAG_Z_Z : 0);
@@ -151,20 +217,66 @@ int8_t _z_request_encode(_z_wbuf_t *wbf, const _z_n_msg_request_t *msg) {
         _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, extheader));
         _Z_RETURN_IF_ERR(_z_zint_encode(wbf, msg->_ext_timeout_ms));
     }
+    return _Z_RES_OK;
+}
 
-    switch (msg->_tag) {
-        case _Z_REQUEST_QUERY: {
-            _Z_RETURN_IF_ERR(_z_query_encode(wbf, &msg->_body._query));
-        } break;
-        case _Z_REQUEST_PUT: {
-            _Z_RETURN_IF_ERR(_z_put_encode(wbf, &msg->_body._put));
-        } break;
-        case _Z_REQUEST_DEL: {
-            _Z_RETURN_IF_ERR(_z_del_encode(wbf, &msg->_body._del));
-        } break;
-        case _Z_REQUEST_PULL: {
-            _Z_RETURN_IF_ERR(_z_pull_encode(wbf, &msg->_body._pull));
-        } break;
+int8_t _z_request_encode(_z_wbuf_t *wbf, const _z_n_msg_request_t *msg) {
+    int8_t ret = _Z_RES_OK;
+    uint8_t header = _Z_MID_N_REQUEST | (_z_keyexpr_is_local(&msg->_key) ? _Z_FLAG_N_REQUEST_M : 0);
+    _Bool has_suffix = _z_keyexpr_has_suffix(msg->_key);
+    if (has_suffix) {
+        header |= _Z_FLAG_N_REQUEST_N;
+    }
+    _z_n_msg_request_exts_t exts = _z_n_msg_request_needed_exts(msg);
+    header |= (exts.n != 0 ? _Z_FLAG_Z_Z : 0);
+
+    // The header of the request, and its body if it is a put or a delete that fits, are encoded at once
+    _z_push_body_t body = _z_push_body_null();
+    size_t body_len = 0;
+    if (msg->_tag == _Z_REQUEST_PUT) {
+        body = (_z_push_body_t){._is_put = true, ._body = {._put = msg->_body._put}};
+        body_len = _z_push_body_encode_max_len(wbf, &body);
+    } else if (msg->_tag == _Z_REQUEST_DEL) {
+        body = (_z_push_body_t){._is_put = false, ._body = {._del = msg->_body._del}};
+        body_len = _z_push_body_encode_max_len(wbf, &body);
+    } else {
+        // Do nothing. Required to be compliant with MISRA 15.7 rule
+    }
+    size_t suffix_len = has_suffix ? strlen(msg->_key._suffix) : 0;
+    size_t max_len = 1 + _Z_ZINT_MAX_LEN + _Z_KEYEXPR_MAX_LEN(suffix_len) + __z_request_exts_max_len(exts);
+    uint8_t *start = _z_wbuf_reserve(wbf, max_len + body_len);
+    if (start != NULL) {
+        uint8_t *cur = _z_uint8_encode_at(start, header);
+        cur = _z_zint_encode_at(cur, msg->_rid);
+        cur = _z_keyexpr_encode_at(cur, &msg->_key, suffix_len);
+        cur = __z_request_exts_encode_at(cur, msg, exts);
+        if (body_len != 0) {
+            cur = _z_push_body_encode_at(cur, &body);
+        }
+        _z_wbuf_commit(wbf, _z_ptr_u8_diff(cur, start));
+    } else {
+        body_len = 0;
+        _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, header));
+        _Z_RETURN_IF_ERR(_z_zint_encode(wbf, msg->_rid));
+        _Z_RETURN_IF_ERR(_z_keyexpr_encode(wbf, has_suffix, &msg->_key));
+        _Z_RETURN_IF_ERR(__z_request_exts_write(wbf, msg, exts));
+    }
+
+    if (body_len == 0) {
+        switch (msg->_tag) {
+            case _Z_REQUEST_QUERY: {
+                _Z_RETURN_IF_ERR(_z_query_encode(wbf, &msg->_body._query));
+            } break;
+            case _Z_REQUEST_PUT: {
+                _Z_RETURN_IF_ERR(_z_put_encode(wbf, &msg->_body._put));
+            } break;
+            case _Z_REQUEST_DEL: {
+                _Z_RETURN_IF_ERR(_z_del_encode(wbf, &msg->_body._del));
+            } break;
+            case _Z_REQUEST_PULL: {
+                _Z_RETURN_IF_ERR(_z_pull_encode(wbf, &msg->_body._pull));
+            } break;
+        }
     }
     return ret;
 }
@@ -244,6 +356,9 @@ int8_t _z_request_decode(_z_n_msg_request_t *msg, _z_zbuf_t *zbf, const uint8_t
 }
 
 /*------------------ Response Message ------------------*/
+// The length prefix, the zid length, the zid and the entity id
+#define _Z_RESPONDER_EXT_MAX_LEN (_Z_ZINT_MAX_LEN + 1 + Z_ZID_LENGTH + _Z_ZINT_MAX_LEN)
+
 int8_t _z_response_encode(_z_wbuf_t *wbf, const _z_n_msg_response_t *msg) {
     int8_t ret = _Z_RES_OK;
     uint8_t header = _Z_MID_N_RESPONSE;
@@ -262,60 +377,108 @@ int8_t _z_response_encode(_z_wbuf_t *wbf, const _z_n_msg_response_t *msg) {
     if (n_ext != 0) {
         _Z_SET_FLAG(header, _Z_FLAG_Z_Z);
     }
+    uint8_t zidlen = _z_id_len(msg->_ext_responder._zid);
 
-    _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, header));
-    _Z_RETURN_IF_ERR(_z_zint_encode(wbf, msg->_request_id));
-    _Z_RETURN_IF_ERR(_z_zint_encode(wbf, msg->_key._id));
-    if (has_suffix) {
-        _Z_RETURN_IF_ERR(_z_str_encode(wbf, msg->_key._suffix))
-    }
-    if (has_qos_ext) {
-        n_ext -= 1;
-        uint8_t extheader = _Z_MSG_EXT_ENC_ZINT | 0x01;
-        if (n_ext != 0) {
-            extheader |= _Z_FLAG_Z_Z;
+    // The header of the response, and its body if it is a put or a delete that fits, are encoded at once
+    _z_push_body_t body = _z_push_body_null();
+    size_t body_len = 0;
+    if (msg->_tag == _Z_RESPONSE_BODY_PUT) {
+        body = (_z_push_body_t){._is_put = true, ._body = {._put = msg->_body._put}};
+        body_len = _z_push_body_encode_max_len(wbf, &body);
+    } else if (msg->_tag == _Z_RESPONSE_BODY_DEL) {
+        body = (_z_push_body_t){._is_put = false, ._body = {._del = msg->_body._del}};
+        body_len = _z_push_body_encode_max_len(wbf, &body);
+    } else {
+        // Do nothing. Required to be compliant with MISRA 15.7 rule
+    }
+    size_t suffix_len = has_suffix ? strlen(msg->_key._suffix) : 0;
+    size_t max_len = 1 + _Z_ZINT_MAX_LEN + _Z_KEYEXPR_MAX_LEN(suffix_len) + (has_qos_ext ? 1 + _Z_ZINT_MAX_LEN : 0) +
+                     (has_ts_ext ? 1 + _Z_TIMESTAMP_EXT_MAX_LEN : 0) +
+                     (has_responder_ext ? 1 + _Z_RESPONDER_EXT_MAX_LEN : 0);
+    uint8_t *start = _z_wbuf_reserve(wbf, max_len + body_len);
+    if (start != NULL) {
+        uint8_t *cur = _z_uint8_encode_at(start, header);
+        cur = _z_zint_encode_at(cur, msg->_request_id);
+        cur = _z_keyexpr_encode_at(cur, &msg->_key, suffix_len);
+        if (has_qos_ext) {
+            n_ext -= 1;
+            cur = _z_uint8_encode_at(cur, _Z_MSG_EXT_ENC_ZINT | 0x01 | (n_ext != 0 ? _Z_FLAG_Z_Z : 0));
+            cur = _z_zint_encode_at(cur, msg->_ext_qos._val);
         }
-        _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, extheader));
-        _Z_RETURN_IF_ERR(_z_zint_encode(wbf, msg->_ext_qos._val));
-    }
-    if (has_ts_ext) {
-        n_ext -= 1;
-        uint8_t extheader = _Z_MSG_EXT_ENC_ZBUF | 0x02 | (n_ext != 0 ? _Z_FLAG_Z_Z : 0);
-        _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, extheader));
-        _Z_RETURN_IF_ERR(_z_timestamp_encode_ext(wbf, &msg->_ext_timestamp));
-    }
-    if (has_responder_ext) {
-        n_ext -= 1;
-        uint8_t extheader = _Z_MSG_EXT_ENC_ZBUF | 0x03 | (n_ext != 0 ? _Z_FLAG_Z_Z : 0);
-        _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, extheader));
-        uint8_t zidlen = _z_id_len(msg->_ext_responder._zid);
-        extheader = (zidlen - 1) << 4;
-        _Z_RETURN_IF_ERR(_z_zint_encode(wbf, zidlen + 1 + _z_zint_len(msg->_ext_responder._eid)));
-        _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, extheader));
-        _Z_RETURN_IF_ERR(_z_wbuf_write_bytes(wbf, msg->_ext_responder._zid.id, 0, zidlen));
-        _Z_RETURN_IF_ERR(_z_zint_encode(wbf, msg->_ext_responder._eid));
-    }
-
-    switch (msg->_tag) {
-        case _Z_RESPONSE_BODY_REPLY: {
-            _Z_RETURN_IF_ERR(_z_reply_encode(wbf, &msg->_body._reply));
-            break;
+        if (has_ts_ext) {
+            n_ext -= 1;
+            cur = _z_uint8_encode_at(cur, _Z_MSG_EXT_ENC_ZBUF | 0x02 | (n_ext != 0 ? _Z_FLAG_Z_Z : 0));
+            cur = _z_timestamp_encode_ext_at(cur, &msg->_ext_timestamp);
         }
-        case _Z_RESPONSE_BODY_ERR: {
-            _Z_RETURN_IF_ERR(_z_err_encode(wbf, &msg->_body._err));
-            break;
+        if (has_responder_ext) {
+            n_ext -= 1;
+            cur = _z_uint8_encode_at(cur, _Z_MSG_EXT_ENC_ZBUF | 0x03 | (n_ext != 0 ? _Z_FLAG_Z_Z : 0));
+            cur = _z_zint_encode_at(cur, zidlen + 1 + _z_zint_len(msg->_ext_responder._eid));
+            cur = _z_uint8_encode_at(cur, (zidlen - 1) << 4);
+            cur = _z_bytes_val_encode_at(cur, msg->_ext_responder._zid.id, zidlen);
+            cur = _z_zint_encode_at(cur, msg->_ext_responder._eid);
         }
-        case _Z_RESPONSE_BODY_ACK: {
-            _Z_RETURN_IF_ERR(_z_ack_encode(wbf, &msg->_body._ack));
-            break;
+        if (body_len != 0) {
+            cur = _z_push_body_encode_at(cur, &body);
         }
-        case _Z_RESPONSE_BODY_PUT: {
-            _Z_RETURN_IF_ERR(_z_put_encode(wbf, &msg->_body._put));
-            break;
+        _z_wbuf_commit(wbf, _z_ptr_u8_diff(cur, start));
+    } else {
+        body_len = 0;
+        _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, header));
+        _Z_RETURN_IF_ERR(_z_zint_encode(wbf, msg->_request_id));
+        _Z_RETURN_IF_ERR(_z_zint_encode(wbf, msg->_key._id));
+        if (has_suffix) {
+            _Z_RETURN_IF_ERR(_z_str_encode(wbf, msg->_key._suffix))
         }
-        case _Z_RESPONSE_BODY_DEL: {
-            _Z_RETURN_IF_ERR(_z_del_encode(wbf, &msg->_body._del));
-            break;
+        if (has_qos_ext) {
+            n_ext -= 1;
+            uint8_t extheader = _Z_MSG_EXT_ENC_ZINT | 0x01;
+            if (n_ext != 0) {
+                extheader |= _Z_FLAG_Z_Z;
+            }
+            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, extheader));
+            _Z_RETURN_IF_ERR(_z_zint_encode(wbf, msg->_ext_qos._val));
+        }
+        if (has_ts_ext) {
+            n_ext -= 1;
+            uint8_t extheader = _Z_MSG_EXT_ENC_ZBUF | 0x02 | (n_ext != 0 ? _Z_FLAG_Z_Z : 0);
+            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, extheader));
+            _Z_RETURN_IF_ERR(_z_timestamp_encode_ext(wbf, &msg->_ext_timestamp));
+        }
+        if (has_responder_ext) {
+            n_ext -= 1;
+            uint8_t extheader = _Z_MSG_EXT_ENC_ZBUF | 0x03 | (n_ext != 0 ? _Z_FLAG_Z_Z : 0);
+            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, extheader));
+            extheader = (zidlen - 1) << 4;
+            _Z_RETURN_IF_ERR(_z_zint_encode(wbf, zidlen + 1 + _z_zint_len(msg->_ext_responder._eid)));
+            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, extheader));
+            _Z_RETURN_IF_ERR(_z_wbuf_write_bytes(wbf, msg->_ext_responder._zid.id, 0, zidlen));
+            _Z_RETURN_IF_ERR(_z_zint_encode(wbf, msg->_ext_responder._eid));
+        }
+    }
+
+    if (body_len == 0) {
+        switch (msg->_tag) {
+            case _Z_RESPONSE_BODY_REPLY: {
+                _Z_RETURN_IF_ERR(_z_reply_encode(wbf, &msg->_body._reply));
+                break;
+            }
+            case _Z_RESPONSE_BODY_ERR: {
+                _Z_RETURN_IF_ERR(_z_err_encode(wbf, &msg->_body._err));
+                break;
+            }
+            case _Z_RESPONSE_BODY_ACK: {
+                _Z_RETURN_IF_ERR(_z_ack_encode(wbf, &msg->_body._ack));
+                break;
+            }
+            case _Z_RESPONSE_BODY_PUT: {
+                _Z_RETURN_IF_ERR(_z_put_encode(wbf, &msg->_body._put));
+                break;
+            }
+            case _Z_RESPONSE_BODY_DEL: {
+                _Z_RETURN_IF_ERR(_z_del_encode(wbf, &msg->_body._del));
+                break;
+            }
         }
     }
 
@@ -337,7 +337,7 @@ int8_t _z_frame_encode(_z_wbuf_t *wbf, uint8_t header, const _z_t_msg_frame_t *m
     return ret;
 }
 
-int8_t _z_frame_decode(_z_t_msg_frame_t *msg, _z_zbuf_t *zbf, uint8_t header) {
+static int8_t __z_frame_decode_header(_z_t_msg_frame_t *msg, _z_zbuf_t *zbf, uint8_t header) {
     int8_t ret = _Z_RES_OK;
     *msg = (_z_t_msg_frame_t){0};
 
@@ -345,26 +345,48 @@ int8_t _z_frame_decode(_z_t_msg_frame_t *msg, _z_zbuf_t *zbf, uint8_t header) {
     if ((ret == _Z_RES_OK) && (_Z_HAS_FLAG(header, _Z_FLAG_T_Z) == true)) {
         ret |= _z_msg_ext_skip_non_mandatories(zbf, 0x04);
     }
+    return ret;
+}
+
+/**
+ * Decodes the next network message of a frame out of ``zbf``. On failure, the reading position is restored.
+ */
+static int8_t __z_frame_decode_message(_z_network_message_t *nm, _z_zbuf_t *zbf) {
+    // Mark the reading position of the iobfer
+    size_t r_pos = _z_zbuf_get_rpos(zbf);
+    *nm = (_z_network_message_t){0};
+    int8_t ret = _z_network_message_decode(nm, zbf);
+    if (ret != _Z_RES_OK) {
+        _z_n_msg_clear(nm);
+        _z_zbuf_set_rpos(zbf, r_pos);  // Restore the reading position of the iobfer
+
+        // FIXME: Check for the return error, since not all of them means a decoding error
+        //        in this particular case. As of now, we roll-back the reading position
+        //        and return to the Zenoh transport-level decoder.
+        //        https://github.com/eclipse-zenoh/zenoh-pico/pull/132#discussion_r1045593602
+        if ((ret & _Z_ERR_MESSAGE_ZENOH_UNKNOWN) == _Z_ERR_MESSAGE_ZENOH_UNKNOWN) {
+            ret = _Z_ERR_MESSAGE_ZENOH_UNKNOWN;
+        }
+    }
+    return ret;
+}
+
+int8_t _z_frame_decode(_z_t_msg_frame_t *msg, _z_zbuf_t *zbf, uint8_t header) {
+    int8_t ret = __z_frame_decode_header(msg, zbf, header);
     if (ret == _Z_RES_OK) {
         msg->_messages = _z_network_message_vec_make(_ZENOH_PICO_FRAME_MESSAGES_VEC_SIZE);
         while (_z_zbuf_len(zbf) > 0) {
-            // Mark the reading position of the iobfer
-            size_t r_pos = _z_zbuf_get_rpos(zbf);
             _z_network_message_t *nm = (_z_network_message_t *)zp_malloc(sizeof(_z_network_message_t));
-            memset(nm, 0, sizeof(_z_network_message_t));
-            ret |= _z_network_message_decode(nm, zbf);
+            if (nm == NULL) {
+                ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+                break;
+            }
+            ret = __z_frame_decode_message(nm, zbf);
             if (ret == _Z_RES_OK) {
                 _z_network_message_vec_append(&msg->_messages, nm);
             } else {
-                _z_n_msg_free(&nm);
-
-                _z_zbuf_set_rpos(zbf, r_pos);  // Restore the reading position of the iobfer
-
-                // FIXME: Check for the return error, since not all of them means a decoding error
-                //        in this particular case. As of now, we roll-back the reading position
-                //        and return to the Zenoh transport-level decoder.
-                //        https://github.com/eclipse-zenoh/zenoh-pico/pull/132#discussion_r1045593602
-                if ((ret & _Z_ERR_MESSAGE_ZENOH_UNKNOWN) == _Z_ERR_MESSAGE_ZENOH_UNKNOWN) {
+                zp_free(nm);
+                if (ret == _Z_ERR_MESSAGE_ZENOH_UNKNOWN) {
                     ret = _Z_RES_OK;
                 }
                 break;
@@ -374,6 +396,38 @@ int8_t _z_frame_decode(_z_t_msg_frame_t *msg, _z_zbuf_t *zbf, uint8_t header) {
     return ret;
 }
 
+int8_t _z_frame_decode_stream(_z_t_msg_frame_t *msg, _z_zbuf_t *zbf, uint8_t header) {
+    int8_t ret = __z_frame_decode_header(msg, zbf, header);
+    if (ret == _Z_RES_OK) {
+        msg->_stream = zbf;
+    }
+    return ret;
+}
+
+/**
+ * Decodes the next network message of a frame decoded with :c:func:`_z_frame_decode_stream` into ``nm``, whose
+ * payloads alias the decoding buffer. Returns ``true`` if a message was decoded, in which case it must be cleared by
+ * the caller before decoding the next one. Returns ``false`` once the frame is exhausted, with ``ret`` set to an error
+ * if it ended on a malformed message.
+ */
+_Bool _z_frame_next(_z_t_msg_frame_t *msg, _z_network_message_t *nm, int8_t *ret) {
+    *ret = _Z_RES_OK;
+    if ((msg->_stream == NULL) || (_z_zbuf_len(msg->_stream) == (size_t)0)) {
+        msg->_stream = NULL;
+        return false;
+    }
+    *ret = __z_frame_decode_message(nm, msg->_stream);
+    if (*ret != _Z_RES_OK) {
+        // The frame ends here, the remaining bytes are left to the transport-level decoder
+        msg->_stream = NULL;
+        if (*ret == _Z_ERR_MESSAGE_ZENOH_UNKNOWN) {
+            *ret = _Z_RES_OK;
+        }
+        return false;
+    }
+    return true;
+}
+
 /*------------------ Fragment Message ------------------*/
 int8_t _z_fragment_encode(_z_wbuf_t *wbf, uint8_t header, const _z_t_msg_fragment_t *msg) {
     int8_t ret = _Z_RES_OK;
@@ -472,7 +526,7 @@ int8_t _z_transport_message_encode(_z_wbuf_t *wbf, const _z_transport_message_t
     return ret;
 }
 
-int8_t _z_transport_message_decode(_z_transport_message_t *msg, _z_zbuf_t *zbf) {
+static int8_t __z_transport_message_decode(_z_transport_message_t *msg, _z_zbuf_t *zbf, _Bool stream) {
     int8_t ret = _Z_RES_OK;
 
     ret |= _z_uint8_decode(&msg->_header, zbf);  // Decode the header
@@ -480,7 +534,11 @@ int8_t _z_transport_message_decode(_z_transport_message_t *msg, _z_zbuf_t *zbf)
         uint8_t mid = _Z_MID(msg->_header);
         switch (mid) {
             case _Z_MID_T_FRAME: {
-                ret |= _z_frame_decode(&msg->_body._frame, zbf, msg->_header);
+                if (stream == true) {
+                    ret |= _z_frame_decode_stream(&msg->_body._frame, zbf, msg->_header);
+                } else {
+                    ret |= _z_frame_decode(&msg->_body._frame, zbf, msg->_header);
+                }
             } break;
             case _Z_MID_T_FRAGMENT: {
                 ret |= _z_fragment_decode(&msg->_body._fragment, zbf, msg->_header);
@@ -512,3 +570,16 @@ int8_t _z_transport_message_decode(_z_transport_message_t *msg, _z_zbuf_t *zbf)
 
     return ret;
 }
+
+int8_t _z_transport_message_decode(_z_transport_message_t *msg, _z_zbuf_t *zbf) {
+    return __z_transport_message_decode(msg, zbf, false);
+}
+
+/**
+ * Same as :c:func:`_z_transport_message_decode`, but leaves the network messages of a FRAME in ``zbf``, to be
+ * decoded one at a time with :c:func:`_z_frame_next`. ``zbf`` must outlive the decoded message, and no other
+ * message can be decoded from it before the frame has been exhausted.
+ */
+int8_t _z_transport_message_decode_stream(_z_transport_message_t *msg, _z_zbuf_t *zbf) {
+    return __z_transport_message_decode(msg, zbf, true);
+}
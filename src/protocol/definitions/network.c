@@ -133,6 +133,30 @@ void _z_n_msg_clear(_z_network_message_t *msg) {
     }
 }
 
+z_priority_t _z_n_msg_get_priority(const _z_network_message_t *msg) {
+    z_priority_t ret = Z_PRIORITY_DEFAULT;
+    switch (msg->_tag) {
+        case _Z_N_PUSH:
+            ret = _z_n_qos_get_priority(msg->_body._push._qos);
+            break;
+        case _Z_N_REQUEST:
+            ret = _z_n_qos_get_priority(msg->_body._request._ext_qos);
+            break;
+        case _Z_N_RESPONSE:
+            ret = _z_n_qos_get_priority(msg->_body._response._ext_qos);
+            break;
+        case _Z_N_RESPONSE_FINAL:
+            // Response finals carry no QoS, they follow the responses sent with the default priority
+            break;
+        case _Z_N_DECLARE:
+            // Declarations go first, as the other messages may refer to the declared entities. Undeclarations go
+            // with them, not to be overtaken by a later declaration of the same entity.
+            ret = _Z_PRIORITY_CONTROL;
+            break;
+    }
+    return ret;
+}
+
 void _z_n_msg_free(_z_network_message_t **msg) {
     _z_network_message_t *ptr = *msg;
 
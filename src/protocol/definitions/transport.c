@@ -34,7 +34,10 @@ void _z_t_msg_close_clear(_z_t_msg_close_t *msg) { (void)(msg); }
 
 void _z_t_msg_keep_alive_clear(_z_t_msg_keep_alive_t *msg) { (void)(msg); }
 
-void _z_t_msg_frame_clear(_z_t_msg_frame_t *msg) { _z_network_message_vec_clear(&msg->_messages); }
+void _z_t_msg_frame_clear(_z_t_msg_frame_t *msg) {
+    _z_network_message_vec_clear(&msg->_messages);
+    msg->_stream = NULL;
+}
 
 void _z_t_msg_fragment_clear(_z_t_msg_fragment_t *msg) { _z_bytes_clear(&msg->_payload); }
 
@@ -213,6 +216,7 @@ _z_transport_message_t _z_t_msg_make_frame(_z_zint_t sn, _z_network_message_vec_
     }
 
     msg._body._frame._messages = messages;
+    msg._body._frame._stream = NULL;
 
     return msg;
 }
@@ -228,6 +232,7 @@ _z_transport_message_t _z_t_msg_make_frame_header(_z_zint_t sn, _Bool is_reliabl
     }
 
     msg._body._frame._messages = _z_network_message_vec_make(0);
+    msg._body._frame._stream = NULL;
 
     return msg;
 }
@@ -292,6 +297,7 @@ void _z_t_msg_copy_keep_alive(_z_t_msg_keep_alive_t *clone, _z_t_msg_keep_alive_
 
 void _z_t_msg_copy_frame(_z_t_msg_frame_t *clone, _z_t_msg_frame_t *msg) {
     clone->_sn = msg->_sn;
+    clone->_stream = NULL;
     _z_network_message_vec_copy(&clone->_messages, &msg->_messages);
 }
 
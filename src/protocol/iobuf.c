@@ -270,6 +270,7 @@ _z_wbuf_t _z_wbuf_make(size_t capacity, _Bool is_expandable) {
     wbf._w_idx = 0;  // This __must__ come after adding ioslices to reset w_idx
     wbf._r_idx = 0;
     wbf._expansion_step = is_expandable ? capacity : 0;
+    wbf._wrap_threshold = 0;
     wbf._capacity = capacity;
 
     return wbf;
@@ -359,8 +360,7 @@ int8_t _z_wbuf_write(_z_wbuf_t *wbf, uint8_t b) {
     _z_iosli_t *ios = _z_wbuf_get_iosli(wbf, wbf->_w_idx);
     size_t writable = _z_iosli_writable(ios);
     if (writable == (size_t)0) {
-        wbf->_w_idx += 1;
-        if (wbf->_ioss._len <= wbf->_w_idx) {
+        if (wbf->_ioss._len <= (wbf->_w_idx + (size_t)1)) {
             if (wbf->_expansion_step != 0) {
                 ios = __z_wbuf_new_iosli(wbf->_expansion_step);
                 _z_iosli_vec_append(&wbf->_ioss, ios);
@@ -368,6 +368,7 @@ int8_t _z_wbuf_write(_z_wbuf_t *wbf, uint8_t b) {
                 return _Z_ERR_TRANSPORT_NO_SPACE;
             }
         }
+        wbf->_w_idx += 1;
         ios = _z_wbuf_get_iosli(wbf, wbf->_w_idx);
     }
     _z_iosli_write(ios, b);
@@ -413,16 +414,43 @@ int8_t _z_wbuf_wrap_bytes(_z_wbuf_t *wbf, const uint8_t *bs, size_t offset, size
 
     _z_iosli_t *ios = _z_wbuf_get_iosli(wbf, wbf->_w_idx);
     size_t writable = _z_iosli_writable(ios);
-    ios->_capacity = ios->_w_pos;  // Block writing on this ioslice
-                                   // The remaining space is allocated in a new ioslice
-
-    _z_iosli_t wios = _z_iosli_wrap(bs, length, offset, offset + length);
-    _z_wbuf_add_iosli(wbf, _z_iosli_clone(&wios));
-    _z_wbuf_add_iosli(wbf, __z_wbuf_new_iosli(writable));
+    if ((wbf->_expansion_step == 0) && (writable < length)) {
+        // The wrapped bytes count against the capacity of non-expandable buffers
+        ret = _Z_ERR_TRANSPORT_NO_SPACE;
+    } else {
+        uint8_t *remaining = _z_ptr_u8_offset(ios->_buf, ios->_w_pos);
+        ios->_capacity = ios->_w_pos;  // Block writing on this ioslice
+
+        _z_iosli_t wios = _z_iosli_wrap(bs, length, offset, offset + length);
+        _z_wbuf_add_iosli(wbf, _z_iosli_clone(&wios));
+        if (wbf->_expansion_step != 0) {
+            // The remaining space is allocated in a new ioslice
+            _z_wbuf_add_iosli(wbf, __z_wbuf_new_iosli(writable));
+        } else {
+            // The remaining space is the unused part of the blocked ioslice, until the buffer is reset
+            _z_iosli_t rios = _z_iosli_wrap(remaining, writable - length, 0, 0);
+            _z_wbuf_add_iosli(wbf, _z_iosli_clone(&rios));
+        }
+    }
 
     return ret;
 }
 
+uint8_t *_z_wbuf_reserve(_z_wbuf_t *wbf, size_t max_len) {
+    uint8_t *cursor = NULL;
+    _z_iosli_t *ios = _z_wbuf_get_iosli(wbf, wbf->_w_idx);
+    if (_z_iosli_writable(ios) >= max_len) {
+        cursor = _z_ptr_u8_offset(ios->_buf, (ptrdiff_t)ios->_w_pos);
+    }
+    return cursor;
+}
+
+void _z_wbuf_commit(_z_wbuf_t *wbf, size_t used) {
+    _z_iosli_t *ios = _z_wbuf_get_iosli(wbf, wbf->_w_idx);
+    assert(used <= _z_iosli_writable(ios));
+    ios->_w_pos = ios->_w_pos + used;
+}
+
 void _z_wbuf_put(_z_wbuf_t *wbf, uint8_t b, size_t pos) {
     size_t current = pos;
     size_t i = 0;
@@ -518,10 +546,26 @@ _z_zbuf_t _z_wbuf_to_zbuf(const _z_wbuf_t *wbf) {
 int8_t _z_wbuf_siphon(_z_wbuf_t *dst, _z_wbuf_t *src, size_t length) {
     int8_t ret = _Z_RES_OK;
 
-    for (size_t i = 0; i < length; i++) {
-        ret = _z_wbuf_write(dst, _z_wbuf_read(src));
-        if (ret != _Z_RES_OK) {
-            break;
+    // Move the bytes one ioslice at a time rather than one byte at a time
+    size_t llength = length;
+    while ((llength > (size_t)0) && (ret == _Z_RES_OK)) {
+        assert(src->_r_idx <= src->_w_idx);
+        _z_iosli_t *ios = _z_wbuf_get_iosli(src, src->_r_idx);
+        size_t readable = _z_iosli_readable(ios);
+        if (readable > (size_t)0) {
+            size_t to_move = (readable <= llength) ? readable : llength;
+            if ((dst->_wrap_threshold != (size_t)0) && (to_move >= dst->_wrap_threshold)) {
+                // Large chunks are referenced in place, the source must outlive the destination content
+                ret = _z_wbuf_wrap_bytes(dst, _z_ptr_u8_offset(ios->_buf, ios->_r_pos), 0, to_move);
+            } else {
+                ret = _z_wbuf_write_bytes(dst, ios->_buf, ios->_r_pos, to_move);
+            }
+            if (ret == _Z_RES_OK) {
+                ios->_r_pos = ios->_r_pos + to_move;
+                llength = llength - to_move;
+            }
+        } else {
+            src->_r_idx = src->_r_idx + (size_t)1;
         }
     }
 
@@ -533,6 +577,7 @@ void _z_wbuf_copy(_z_wbuf_t *dst, const _z_wbuf_t *src) {
     dst->_r_idx = src->_r_idx;
     dst->_w_idx = src->_w_idx;
     dst->_expansion_step = src->_expansion_step;
+    dst->_wrap_threshold = src->_wrap_threshold;
     _z_iosli_vec_copy(&dst->_ioss, &src->_ioss);
 }
 
@@ -541,14 +586,18 @@ void _z_wbuf_reset(_z_wbuf_t *wbf) {
     wbf->_w_idx = 0;
 
     // Reset to default iosli allocation
-    for (size_t i = 0; i < _z_iosli_vec_len(&wbf->_ioss); i++) {
-        _z_iosli_t *ios = _z_wbuf_get_iosli(wbf, i);
+    for (size_t i = _z_iosli_vec_len(&wbf->_ioss); i > (size_t)0; i--) {
+        _z_iosli_t *ios = _z_wbuf_get_iosli(wbf, i - (size_t)1);
         if (ios->_is_alloc == false) {
-            _z_iosli_vec_remove(&wbf->_ioss, i);
+            _z_iosli_vec_remove(&wbf->_ioss, i - (size_t)1);
         } else {
             _z_iosli_reset(ios);
         }
     }
+    if ((wbf->_expansion_step == 0) && (_z_iosli_vec_len(&wbf->_ioss) > (size_t)0)) {
+        // Unblock the ioslice of a non-expandable buffer, blocked by wrapping bytes
+        _z_wbuf_get_iosli(wbf, 0)->_capacity = wbf->_capacity;
+    }
 }
 
 void _z_wbuf_clear(_z_wbuf_t *wbf) { _z_iosli_vec_clear(&wbf->_ioss); }
@@ -0,0 +1,378 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/protocol/ketrie.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "zenoh-pico/system/platform.h"
+#include "zenoh-pico/utils/pointers.h"
+#include "zenoh-pico/utils/result.h"
+
+/*------------------ Chunk helpers ------------------*/
+static _Bool __z_ketrie_chunk_is_superwild(const char *chunk, size_t len) {
+    return (len == (size_t)2) && (chunk[0] == '*') && (chunk[1] == '*');
+}
+
+static _Bool __z_ketrie_chunk_is_wild(const char *chunk, size_t len) {
+    return (len > (size_t)0) && ((memchr(chunk, '*', len) != NULL) || (memchr(chunk, '$', len) != NULL));
+}
+
+static _Bool __z_ketrie_chunk_eq(const _z_ketrie_node_t *node, const char *chunk, size_t len) {
+    return (node->_chunk_len == len) && (memcmp(node->_chunk, chunk, len) == 0);
+}
+
+static int __z_ketrie_chunk_cmp(const _z_ketrie_node_t *node, const char *chunk, size_t len) {
+    int ret = 0;
+    if (node->_chunk_len != len) {
+        ret = (node->_chunk_len < len) ? -1 : 1;
+    } else {
+        ret = memcmp(node->_chunk, chunk, len);
+    }
+    return ret;
+}
+
+/**
+ * Splits the next chunk out of ``[start, end)``. Returns the start of the remaining key, or NULL if the chunk was the
+ * last one.
+ */
+static const char *__z_ketrie_next_chunk(const char *start, const char *end, size_t *chunk_len) {
+    const char *ret = NULL;
+    const char *slash = (const char *)memchr(start, '/', _z_ptr_char_diff(end, start));
+    if (slash != NULL) {
+        *chunk_len = _z_ptr_char_diff(slash, start);
+        ret = _z_cptr_char_offset(slash, 1);
+    } else {
+        *chunk_len = _z_ptr_char_diff(end, start);
+    }
+    return ret;
+}
+
+/*------------------ Node helpers ------------------*/
+static _z_ketrie_node_t *__z_ketrie_node_new(_z_ketrie_node_t *parent, const char *chunk, size_t len) {
+    _z_ketrie_node_t *node = (_z_ketrie_node_t *)zp_malloc(sizeof(_z_ketrie_node_t));
+    if (node != NULL) {
+        (void)memset(node, 0, sizeof(_z_ketrie_node_t));
+        node->_parent = parent;
+        node->_chunk = (char *)zp_malloc(len + (size_t)1);
+        if (node->_chunk == NULL) {
+            zp_free(node);
+            return NULL;
+        }
+        if (len > (size_t)0) {
+            (void)memcpy(node->_chunk, chunk, len);
+        }
+        node->_chunk[len] = '\0';
+        node->_chunk_len = len;
+    }
+    return node;
+}
+
+static void __z_ketrie_node_free(_z_ketrie_node_t **node) {
+    _z_ketrie_node_t *ptr = *node;
+    if (ptr != NULL) {
+        for (size_t i = 0; i < ptr->_literals_len; i++) {
+            __z_ketrie_node_free(&ptr->_literals[i]);
+        }
+        for (size_t i = 0; i < ptr->_wilds_len; i++) {
+            __z_ketrie_node_free(&ptr->_wilds[i]);
+        }
+        __z_ketrie_node_free(&ptr->_superwild);
+        _z_list_free(&ptr->_vals, _z_noop_free);
+        zp_free(ptr->_literals);
+        zp_free(ptr->_wilds);
+        zp_free(ptr->_chunk);
+        zp_free(ptr);
+        *node = NULL;
+    }
+}
+
+static _Bool __z_ketrie_node_is_empty(const _z_ketrie_node_t *node) {
+    return (node->_vals == NULL) && (node->_literals_len == (size_t)0) && (node->_wilds_len == (size_t)0) &&
+           (node->_superwild == NULL);
+}
+
+static int8_t __z_ketrie_array_insert(_z_ketrie_node_t ***array, size_t *len, size_t *capacity, size_t pos,
+                                      _z_ketrie_node_t *node) {
+    if (*len == *capacity) {
+        size_t n_capacity = (*capacity << 1) | (size_t)0x01;
+        _z_ketrie_node_t **n_array = (_z_ketrie_node_t **)zp_malloc(n_capacity * sizeof(_z_ketrie_node_t *));
+        if (n_array == NULL) {
+            return _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+        }
+        if (*array != NULL) {
+            (void)memcpy(n_array, *array, *len * sizeof(_z_ketrie_node_t *));
+            zp_free(*array);
+        }
+        *array = n_array;
+        *capacity = n_capacity;
+    }
+    for (size_t i = *len; i > pos; i--) {
+        (*array)[i] = (*array)[i - (size_t)1];
+    }
+    (*array)[pos] = node;
+    *len = *len + (size_t)1;
+    return _Z_RES_OK;
+}
+
+static void __z_ketrie_array_remove(_z_ketrie_node_t **array, size_t *len, const _z_ketrie_node_t *node) {
+    for (size_t i = 0; i < *len; i++) {
+        if (array[i] == node) {
+            for (size_t j = i + (size_t)1; j < *len; j++) {
+                array[j - (size_t)1] = array[j];
+            }
+            *len = *len - (size_t)1;
+            break;
+        }
+    }
+}
+
+/**
+ * Binary searches the sorted literal children of ``node``. Returns true if found, in which case ``pos`` is the index of
+ * the matching child. Otherwise ``pos`` is the index at which the chunk should be inserted.
+ */
+static _Bool __z_ketrie_find_literal(const _z_ketrie_node_t *node, const char *chunk, size_t len, size_t *pos) {
+    size_t low = 0;
+    size_t high = node->_literals_len;
+    while (low < high) {
+        size_t mid = low + ((high - low) >> 1);
+        int cmp = __z_ketrie_chunk_cmp(node->_literals[mid], chunk, len);
+        if (cmp == 0) {
+            *pos = mid;
+            return true;
+        } else if (cmp < 0) {
+            low = mid + (size_t)1;
+        } else {
+            high = mid;
+        }
+    }
+    *pos = low;
+    return false;
+}
+
+static _z_ketrie_node_t *__z_ketrie_child(_z_ketrie_node_t *node, const char *chunk, size_t len) {
+    _z_ketrie_node_t *ret = NULL;
+    if (__z_ketrie_chunk_is_superwild(chunk, len) == true) {
+        ret = node->_superwild;
+    } else if (__z_ketrie_chunk_is_wild(chunk, len) == true) {
+        for (size_t i = 0; i < node->_wilds_len; i++) {
+            if (__z_ketrie_chunk_eq(node->_wilds[i], chunk, len) == true) {
+                ret = node->_wilds[i];
+                break;
+            }
+        }
+    } else {
+        size_t pos = 0;
+        if (__z_ketrie_find_literal(node, chunk, len, &pos) == true) {
+            ret = node->_literals[pos];
+        }
+    }
+    return ret;
+}
+
+static _z_ketrie_node_t *__z_ketrie_child_or_insert(_z_ketrie_node_t *node, const char *chunk, size_t len) {
+    _z_ketrie_node_t *ret = __z_ketrie_child(node, chunk, len);
+    if (ret == NULL) {
+        ret = __z_ketrie_node_new(node, chunk, len);
+        if (ret != NULL) {
+            int8_t res = _Z_RES_OK;
+            if (__z_ketrie_chunk_is_superwild(chunk, len) == true) {
+                node->_superwild = ret;
+            } else if (__z_ketrie_chunk_is_wild(chunk, len) == true) {
+                res = __z_ketrie_array_insert(&node->_wilds, &node->_wilds_len, &node->_wilds_capacity,
+                                              node->_wilds_len, ret);
+            } else {
+                size_t pos = 0;
+                (void)__z_ketrie_find_literal(node, chunk, len, &pos);
+                res = __z_ketrie_array_insert(&node->_literals, &node->_literals_len, &node->_literals_capacity, pos,
+                                              ret);
+            }
+            if (res != _Z_RES_OK) {
+                __z_ketrie_node_free(&ret);
+            }
+        }
+    }
+    return ret;
+}
+
+/**
+ * Detaches and frees ``node`` and its ancestors as long as they do not hold any value nor children.
+ */
+static void __z_ketrie_prune(_z_ketrie_t *trie, _z_ketrie_node_t *node) {
+    while ((node != NULL) && (__z_ketrie_node_is_empty(node) == true)) {
+        _z_ketrie_node_t *parent = node->_parent;
+        if (parent == NULL) {
+            trie->_root = NULL;
+        } else if (parent->_superwild == node) {
+            parent->_superwild = NULL;
+        } else if (__z_ketrie_chunk_is_wild(node->_chunk, node->_chunk_len) == true) {
+            __z_ketrie_array_remove(parent->_wilds, &parent->_wilds_len, node);
+        } else {
+            __z_ketrie_array_remove(parent->_literals, &parent->_literals_len, node);
+        }
+        __z_ketrie_node_free(&node);
+        node = parent;
+    }
+}
+
+/*------------------ Lookup ------------------*/
+typedef struct {
+    const char *_end;
+    size_t _epoch;
+    _z_ketrie_visit_f _f;
+    void *_arg;
+} __z_ketrie_walk_ctx_t;
+
+static void __z_ketrie_report(__z_ketrie_walk_ctx_t *ctx, _z_ketrie_node_t *node) {
+    if (node->_mark != ctx->_epoch) {
+        node->_mark = ctx->_epoch;
+        for (_z_list_t *xs = node->_vals; xs != NULL; xs = _z_list_tail(xs)) {
+            ctx->_f(_z_list_head(xs), ctx->_arg);
+        }
+    }
+}
+
+/**
+ * Visits every node of the subtree of ``node`` that may match ``rest``, the remaining part of the looked up key
+ * expression. ``rest`` is NULL when the whole key expression has been consumed.
+ */
+static void __z_ketrie_walk(__z_ketrie_walk_ctx_t *ctx, _z_ketrie_node_t *node, const char *rest) {
+    if (rest == NULL) {
+        __z_ketrie_report(ctx, node);
+        // A trailing ** may match zero chunks
+        if (node->_superwild != NULL) {
+            __z_ketrie_walk(ctx, node->_superwild, NULL);
+        }
+        return;
+    }
+
+    size_t len = 0;
+    const char *next = __z_ketrie_next_chunk(rest, ctx->_end, &len);
+    if (__z_ketrie_chunk_is_superwild(rest, len) == true) {
+        // The looked up ** either stops here, or swallows one more chunk of the trie
+        __z_ketrie_walk(ctx, node, next);
+        for (size_t i = 0; i < node->_literals_len; i++) {
+            __z_ketrie_walk(ctx, node->_literals[i], rest);
+        }
+        for (size_t i = 0; i < node->_wilds_len; i++) {
+            __z_ketrie_walk(ctx, node->_wilds[i], rest);
+        }
+        if (node->_superwild != NULL) {
+            __z_ketrie_walk(ctx, node->_superwild, rest);
+        }
+        return;
+    }
+
+    if (__z_ketrie_chunk_is_wild(rest, len) == true) {
+        for (size_t i = 0; i < node->_literals_len; i++) {
+            __z_ketrie_walk(ctx, node->_literals[i], next);
+        }
+    } else {
+        size_t pos = 0;
+        if (__z_ketrie_find_literal(node, rest, len, &pos) == true) {
+            __z_ketrie_walk(ctx, node->_literals[pos], next);
+        }
+    }
+    for (size_t i = 0; i < node->_wilds_len; i++) {
+        __z_ketrie_walk(ctx, node->_wilds[i], next);
+    }
+    if (node->_superwild != NULL) {
+        // The ** of the trie swallows zero or more chunks of the looked up key expression
+        const char *swallowed = rest;
+        for (;;) {
+            __z_ketrie_walk(ctx, node->_superwild, swallowed);
+            if (swallowed == NULL) {
+                break;
+            }
+            size_t ignored = 0;
+            swallowed = __z_ketrie_next_chunk(swallowed, ctx->_end, &ignored);
+        }
+    }
+}
+
+/*------------------ Trie ------------------*/
+void _z_ketrie_init(_z_ketrie_t *trie) {
+    trie->_root = NULL;
+    trie->_epoch = 0;
+}
+
+_z_ketrie_t _z_ketrie_make(void) {
+    _z_ketrie_t trie;
+    _z_ketrie_init(&trie);
+    return trie;
+}
+
+int8_t _z_ketrie_insert(_z_ketrie_t *trie, const char *key, size_t len, void *val) {
+    if (trie->_root == NULL) {
+        trie->_root = __z_ketrie_node_new(NULL, NULL, 0);
+        if (trie->_root == NULL) {
+            return _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+        }
+    }
+
+    const char *end = _z_cptr_char_offset(key, (ptrdiff_t)len);
+    const char *rest = key;
+    _z_ketrie_node_t *node = trie->_root;
+    while ((rest != NULL) && (node != NULL)) {
+        size_t chunk_len = 0;
+        const char *next = __z_ketrie_next_chunk(rest, end, &chunk_len);
+        _z_ketrie_node_t *child = __z_ketrie_child_or_insert(node, rest, chunk_len);
+        if (child == NULL) {
+            __z_ketrie_prune(trie, node);
+        }
+        node = child;
+        rest = next;
+    }
+    if (node == NULL) {
+        return _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+    }
+
+    node->_vals = _z_list_push(node->_vals, val);
+    return _Z_RES_OK;
+}
+
+static _Bool __z_ketrie_val_eq(const void *left, const void *right) { return left == right; }
+
+void _z_ketrie_remove(_z_ketrie_t *trie, const char *key, size_t len, const void *val) {
+    const char *end = _z_cptr_char_offset(key, (ptrdiff_t)len);
+    const char *rest = key;
+    _z_ketrie_node_t *node = trie->_root;
+    while ((rest != NULL) && (node != NULL)) {
+        size_t chunk_len = 0;
+        const char *next = __z_ketrie_next_chunk(rest, end, &chunk_len);
+        node = __z_ketrie_child(node, rest, chunk_len);
+        rest = next;
+    }
+    if (node != NULL) {
+        node->_vals = _z_list_drop_filter(node->_vals, _z_noop_free, __z_ketrie_val_eq, (void *)val);
+        __z_ketrie_prune(trie, node);
+    }
+}
+
+void _z_ketrie_intersecting(_z_ketrie_t *trie, const char *key, size_t len, _z_ketrie_visit_f f, void *arg) {
+    if (trie->_root != NULL) {
+        trie->_epoch = trie->_epoch + (size_t)1;
+        __z_ketrie_walk_ctx_t ctx = {
+            ._end = _z_cptr_char_offset(key, (ptrdiff_t)len), ._epoch = trie->_epoch, ._f = f, ._arg = arg};
+        __z_ketrie_walk(&ctx, trie->_root, key);
+    }
+}
+
+_Bool _z_ketrie_is_empty(const _z_ketrie_t *trie) { return trie->_root == NULL; }
+
+void _z_ketrie_clear(_z_ketrie_t *trie) {
+    __z_ketrie_node_free(&trie->_root);
+    trie->_epoch = 0;
+}
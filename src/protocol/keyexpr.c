@@ -16,6 +16,7 @@
 #include <assert.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "zenoh-pico/protocol/core.h"
@@ -93,7 +94,7 @@ zp_keyexpr_canon_status_t __zp_canon_prefix(const char *start, size_t *len) {
     char const *next_slash;
 
     do {
-        next_slash = strchr(chunk_start, '/');
+        next_slash = _z_strchr_se(chunk_start, end, '/');
         const char *chunk_end = next_slash ? next_slash : end;
         size_t chunk_len = _z_ptr_char_diff(chunk_end, chunk_start);
         switch (chunk_len) {
@@ -107,6 +108,7 @@ zp_keyexpr_canon_status_t __zp_canon_prefix(const char *start, size_t *len) {
                     ret = Z_KEYEXPR_CANON_SINGLE_STAR_AFTER_DOUBLE_STAR;
                 } else {
                     chunk_start = _z_cptr_char_offset(chunk_end, 1);
+                    in_big_wild = false;
                     continue;
                 }
             } break;
@@ -204,9 +206,13 @@ void __zp_singleify(char *start, size_t *len, const char *needle) {
             }
             right_after_needle = true;
             reader = _z_ptr_char_offset(reader, pos);
-        } else {
+        } else if (right_after_needle == true) {
             right_after_needle = false;
             reader = _z_ptr_char_offset(reader, 1);
+        } else {
+            // Nothing is left to singleify before the next occurrence of the first byte of the needle
+            const char *next = _z_strchr_se(_z_ptr_char_offset(reader, 1), end, needle[0]);
+            reader = (next != NULL) ? (char *)next : (char *)end;
         }
     }
 
@@ -238,7 +244,7 @@ void __zp_ke_write_chunk(char **writer, const char *chunk, size_t len, const cha
         writer[0] = _z_ptr_char_offset(writer[0], 1);
     }
 
-    (void)memcpy(writer[0], chunk, len);
+    (void)memmove(writer[0], chunk, len);  // The chunk may overlap where it is written
     writer[0] = _z_ptr_char_offset(writer[0], len);
 }
 
@@ -247,35 +253,26 @@ typedef _Bool (*_z_ke_chunk_matcher)(_z_str_se_t l, _z_str_se_t r);
 
 enum _zp_wildness_t { _ZP_WILDNESS_ANY = 1, _ZP_WILDNESS_SUPERCHUNKS = 2, _ZP_WILDNESS_SUBCHUNK_DSL = 4 };
 int8_t _zp_ke_wildness(_z_str_se_t ke, size_t *n_segments, size_t *n_verbatims) {
-    const char *start = ke.start;
-    const char *end = ke.end;
     int8_t result = 0;
-    char prev_char = 0;
-    for (char const *c = start; c < end; c = _z_cptr_char_offset(c, 1)) {
-        switch (c[0]) {
-            case '*': {
-                result = result | (int8_t)_ZP_WILDNESS_ANY;
-                if (prev_char == '*') {
-                    result = result | (int8_t)_ZP_WILDNESS_SUPERCHUNKS;
-                }
-            } break;
-
-            case '$': {
-                result = result | (int8_t)_ZP_WILDNESS_SUBCHUNK_DSL;
-            } break;
-
-            case '/': {
-                *n_segments = *n_segments + (size_t)1;
-            } break;
-            case '@': {
-                *n_verbatims = *n_verbatims + (size_t)1;
+    uint32_t prev_star = 0;
+    for (char const *c = ke.start; c < ke.end; c = _z_cptr_char_offset(c, _Z_STR_CLASS_BLOCK)) {
+        size_t len = _z_ptr_char_diff(ke.end, c);
+        _z_str_class_t cls;
+        _z_str_classify(c, (len < (size_t)_Z_STR_CLASS_BLOCK) ? len : (size_t)_Z_STR_CLASS_BLOCK, &cls);
+
+        if (cls.star != (uint32_t)0) {
+            result = result | (int8_t)_ZP_WILDNESS_ANY;
+            // A star right after another one, possibly the last byte of the previous block
+            if ((cls.star & ((cls.star << 1) | prev_star)) != (uint32_t)0) {
+                result = result | (int8_t)_ZP_WILDNESS_SUPERCHUNKS;
             }
-            default: {
-                // Do nothing
-            } break;
         }
-
-        prev_char = *c;
+        if (cls.dollar != (uint32_t)0) {
+            result = result | (int8_t)_ZP_WILDNESS_SUBCHUNK_DSL;
+        }
+        *n_segments = *n_segments + _z_bits_count(cls.slash);
+        *n_verbatims = *n_verbatims + _z_bits_count(cls.at);
+        prev_star = cls.star >> (_Z_STR_CLASS_BLOCK - 1);
     }
 
     return result;
@@ -349,15 +346,17 @@ _Bool _z_keyexpr_is_superwild_chunk(_z_str_se_t s) {
 }
 
 _Bool _z_keyexpr_has_verbatim(_z_str_se_t s) {
-    _z_splitstr_t it = {.s = s, .delimiter = _Z_DELIMITER};
-    _z_str_se_t chunk = _z_splitstr_next(&it);
-    while (chunk.start != NULL) {
-        if (chunk.start[0] == _Z_VERBATIM) {
-            return true;
-        }
-        chunk = _z_splitstr_next(&it);
+    _Bool result = false;
+    // Whether the next byte starts a chunk, which the first one always does
+    uint32_t chunk_start = 1;
+    for (char const *c = s.start; (c < s.end) && (result == false); c = _z_cptr_char_offset(c, _Z_STR_CLASS_BLOCK)) {
+        size_t len = _z_ptr_char_diff(s.end, c);
+        _z_str_class_t cls;
+        _z_str_classify(c, (len < (size_t)_Z_STR_CLASS_BLOCK) ? len : (size_t)_Z_STR_CLASS_BLOCK, &cls);
+        result = (cls.at & ((cls.slash << 1) | chunk_start)) != (uint32_t)0;
+        chunk_start = cls.slash >> (_Z_STR_CLASS_BLOCK - 1);
     }
-    return false;
+    return result;
 }
 
 _Bool _z_keyexpr_includes_superwild(_z_str_se_t left, _z_str_se_t right, _z_ke_chunk_matcher chunk_includer) {
@@ -370,7 +369,7 @@ _Bool _z_keyexpr_includes_superwild(_z_str_se_t left, _z_str_se_t right, _z_ke_c
                        : _z_keyexpr_includes_superwild(lrest, right, chunk_includer)) {
                 return true;
             }
-            if (right.start[0] == _Z_VERBATIM) {
+            if ((right.start == NULL) || (right.start[0] == _Z_VERBATIM)) {
                 return false;
             }
             right = _z_splitstr_split_once((_z_splitstr_t){.s = right, .delimiter = _Z_DELIMITER}, &lrest);
@@ -500,9 +499,11 @@ _Bool _z_ke_chunk_intersect_stardsl(_z_str_se_t l, _z_str_se_t r) {
             } else {
                 result = _z_ke_chunk_intersect_rhasstardsl(r, l);
             }
-        } else {
-            // r is guaranteed to have a stardsl if l doesn't and this function has been called.
+        } else if (_z_strstr(r.start, r.end, _Z_DOLLAR_STAR) != NULL) {
             result = _z_ke_chunk_intersect_rhasstardsl(l, r);
+        } else {
+            // Neither chunk has a stardsl, another chunk of the key expressions does: they differ
+            result = false;
         }
     }
 
@@ -689,7 +690,7 @@ zp_keyexpr_canon_status_t _z_keyexpr_canonize(char *start, size_t *len) {
         char *reader = _z_ptr_char_offset(start, canon_len);
         const char *write_start = reader;
         char *writer = reader;
-        char *next_slash = strchr(reader, '/');
+        char *next_slash = (char *)_z_strchr_se(reader, end, '/');
         char const *chunk_end = (next_slash != NULL) ? next_slash : end;
 
         _Bool in_big_wild = false;
@@ -708,7 +709,7 @@ zp_keyexpr_canon_status_t _z_keyexpr_canonize(char *start, size_t *len) {
 
         while (next_slash != NULL) {
             reader = _z_ptr_char_offset(next_slash, 1);
-            next_slash = strchr(reader, '/');
+            next_slash = (char *)_z_strchr_se(reader, end, '/');
             chunk_end = next_slash ? next_slash : end;
             switch (_z_ptr_char_diff(chunk_end, reader)) {
                 case 0: {
@@ -799,4 +800,184 @@ zp_keyexpr_canon_status_t _z_keyexpr_canonize(char *start, size_t *len) {
     return ret;
 }
 
-zp_keyexpr_canon_status_t _z_keyexpr_is_canon(const char *start, size_t len) { return __zp_canon_prefix(start, &len); }
\ No newline at end of file
+zp_keyexpr_canon_status_t _z_keyexpr_is_canon(const char *start, size_t len) { return __zp_canon_prefix(start, &len); }
+
+/*------------------ Compiled keyexprs ------------------*/
+static uint8_t __z_ke_chunk_kind(_z_str_se_t chunk) {
+    uint8_t kind = _Z_KE_CHUNK_LITERAL;
+    if (_z_ke_isdoublestar(chunk) == true) {
+        kind = _Z_KE_CHUNK_SUPERWILD;
+    } else if (_z_keyexpr_is_wild_chunk(chunk) == true) {
+        kind = _Z_KE_CHUNK_WILD;
+    } else if (chunk.start[0] == _Z_VERBATIM) {
+        kind = _Z_KE_CHUNK_VERBATIM;
+    } else if (_z_strchr_se(chunk.start, chunk.end, '$') != NULL) {
+        kind = _Z_KE_CHUNK_DSL;
+    } else {
+        // Do nothing. Required to be compliant with MISRA 15.7 rule
+    }
+    return kind;
+}
+
+int8_t _z_keyexpr_compile(_z_keyexpr_compiled_t *ke, const char *start, size_t len) {
+    *ke = _z_keyexpr_compiled_null();
+    // Even if it can not be compiled, the key expression is still matched through the string matchers
+    ke->_start = start;
+    ke->_len = len;
+
+    int8_t ret = _Z_ERR_GENERIC;
+    if (start != NULL) {
+        ret = _z_keyexpr_is_canon(start, len);
+    }
+    if (ret == _Z_RES_OK) {
+        size_t n_segments = 0;
+        size_t n_verbatims = 0;
+        (void)_zp_ke_wildness((_z_str_se_t){.start = start, .end = _z_cptr_char_offset(start, (ptrdiff_t)len)},
+                              &n_segments, &n_verbatims);
+        ke->_chunks = (_z_keyexpr_chunk_t *)zp_malloc((n_segments + (size_t)1) * sizeof(_z_keyexpr_chunk_t));
+        if (ke->_chunks == NULL) {
+            ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+        }
+    }
+    if (ret == _Z_RES_OK) {
+        _Bool in_prefix = true;
+        _z_splitstr_t it = {.s = {.start = start, .end = _z_cptr_char_offset(start, (ptrdiff_t)len)},
+                            .delimiter = _Z_DELIMITER};
+        for (_z_str_se_t chunk = _z_splitstr_next(&it); chunk.start != NULL; chunk = _z_splitstr_next(&it)) {
+            _z_keyexpr_chunk_t *c = &ke->_chunks[ke->_n_chunks];
+            c->_start = _z_ptr_char_diff(chunk.start, start);
+            c->_len = _z_ptr_char_diff(chunk.end, chunk.start);
+            c->_kind = __z_ke_chunk_kind(chunk);
+            in_prefix = in_prefix && ((c->_kind == _Z_KE_CHUNK_LITERAL) || (c->_kind == _Z_KE_CHUNK_VERBATIM));
+            if (in_prefix == true) {
+                ke->_n_prefix_chunks = ke->_n_prefix_chunks + (size_t)1;
+                ke->_prefix_len = c->_start + c->_len;
+            }
+            ke->_has_superwild = ke->_has_superwild || (c->_kind == _Z_KE_CHUNK_SUPERWILD);
+            ke->_n_chunks = ke->_n_chunks + (size_t)1;
+        }
+    }
+
+    return ret;
+}
+
+void _z_keyexpr_compiled_clear(_z_keyexpr_compiled_t *ke) {
+    zp_free(ke->_chunks);
+    *ke = _z_keyexpr_compiled_null();
+}
+
+static _Bool __z_ke_compiled_chunk_includes(const _z_keyexpr_compiled_t *l, size_t idx, _z_str_se_t r) {
+    const _z_keyexpr_chunk_t *c = &l->_chunks[idx];
+    _z_str_se_t chunk = {.start = _z_cptr_char_offset(l->_start, (ptrdiff_t)c->_start),
+                         .end = _z_cptr_char_offset(l->_start, (ptrdiff_t)(c->_start + c->_len))};
+    size_t rlen = _z_ptr_char_diff(r.end, r.start);
+    _Bool result = false;
+    switch (c->_kind) {
+        case _Z_KE_CHUNK_WILD:
+        case _Z_KE_CHUNK_SUPERWILD: {
+            result = (rlen > (size_t)0) && (r.start[0] != _Z_VERBATIM);
+        } break;
+
+        case _Z_KE_CHUNK_DSL: {
+            result = (rlen > (size_t)0) && _z_ke_chunk_includes_stardsl(chunk, r);
+        } break;
+
+        default: {
+            result = (rlen == c->_len) && (memcmp(chunk.start, r.start, rlen) == 0);
+        } break;
+    }
+    return result;
+}
+
+// Returns the end of the chunk of the key starting at ``start``
+static inline const char *__z_ke_chunk_end(const char *start, const char *end) {
+    const char *slash = _z_strchr_se(start, end, '/');
+    return (slash != NULL) ? slash : end;
+}
+
+/**
+ * Matches a compiled key expression against a key without wildcards, for which inclusion and intersection are the
+ * same. Each ``**`` first matches no chunk, and the last one absorbs one more chunk of the key on each mismatch.
+ * Gives up and sets ``undecided`` if the last ``**`` runs into a verbatim chunk, which it can not absorb.
+ */
+static _Bool __z_keyexpr_compiled_includes_key(const _z_keyexpr_compiled_t *l, const char *rstart, size_t rlen,
+                                               _Bool *undecided) {
+    const char *rend = _z_cptr_char_offset(rstart, (ptrdiff_t)rlen);
+    // The non-wild prefix is compared at once, up to the separator following it
+    _Bool result = (rlen >= l->_prefix_len) && (memcmp(rstart, l->_start, l->_prefix_len) == 0);
+    // The start of the next chunk of the key, or NULL once all of them are matched
+    const char *rc = rstart;
+    if ((result == true) && (l->_n_prefix_chunks > (size_t)0)) {
+        const char *after = _z_cptr_char_offset(rstart, (ptrdiff_t)l->_prefix_len);
+        if (after == rend) {
+            rc = NULL;
+        } else if (after[0] == '/') {
+            rc = _z_cptr_char_offset(after, 1);
+        } else {
+            result = false;
+        }
+    }
+
+    size_t li = l->_n_prefix_chunks;
+    size_t star_li = SIZE_MAX;
+    const char *star_rc = NULL;
+    while ((result == true) && (rc != NULL)) {
+        const char *rc_end = __z_ke_chunk_end(rc, rend);
+        const char *next = (rc_end != rend) ? _z_cptr_char_offset(rc_end, 1) : NULL;
+        if ((li < l->_n_chunks) && (l->_chunks[li]._kind == _Z_KE_CHUNK_SUPERWILD)) {
+            star_li = li;
+            star_rc = rc;
+            li = li + (size_t)1;
+        } else if ((li < l->_n_chunks) &&
+                   (__z_ke_compiled_chunk_includes(l, li, (_z_str_se_t){.start = rc, .end = rc_end}) == true)) {
+            li = li + (size_t)1;
+            rc = next;
+        } else if (star_li == SIZE_MAX) {
+            result = false;
+        } else if ((star_rc < rend) && (star_rc[0] == _Z_VERBATIM)) {
+            *undecided = true;
+            result = false;
+        } else {
+            const char *absorbed_end = __z_ke_chunk_end(star_rc, rend);
+            star_rc = (absorbed_end != rend) ? _z_cptr_char_offset(absorbed_end, 1) : NULL;
+            li = star_li + (size_t)1;
+            rc = star_rc;
+        }
+    }
+    while ((result == true) && (li < l->_n_chunks) && (l->_chunks[li]._kind == _Z_KE_CHUNK_SUPERWILD)) {
+        li = li + (size_t)1;
+    }
+
+    return (result == true) && (li == l->_n_chunks);
+}
+
+typedef _Bool (*_z_ke_matcher)(const char *lstart, const size_t llen, const char *rstart, const size_t rlen);
+
+static _Bool __z_keyexpr_compiled_match(const _z_keyexpr_compiled_t *l, const char *rstart, size_t rlen,
+                                        _z_ke_matcher string_matcher) {
+    // Equal key expressions include each other
+    _Bool result = (rlen == l->_len) && (memcmp(rstart, l->_start, rlen) == 0);
+    _Bool undecided = (result == false);
+    if ((undecided == true) && (l->_chunks != NULL)) {
+        size_t n_segments = 0;
+        size_t n_verbatims = 0;
+        _z_str_se_t r = {.start = rstart, .end = _z_cptr_char_offset(rstart, (ptrdiff_t)rlen)};
+        // A key without wildcards intersects a key expression if and only if it is included in it
+        if (_zp_ke_wildness(r, &n_segments, &n_verbatims) == (int8_t)0) {
+            undecided = false;
+            result = __z_keyexpr_compiled_includes_key(l, rstart, rlen, &undecided);
+        }
+    }
+    if (undecided == true) {
+        result = string_matcher(l->_start, l->_len, rstart, rlen);
+    }
+    return result;
+}
+
+_Bool _z_keyexpr_compiled_includes(const _z_keyexpr_compiled_t *l, const char *rstart, size_t rlen) {
+    return __z_keyexpr_compiled_match(l, rstart, rlen, _z_keyexpr_includes);
+}
+
+_Bool _z_keyexpr_compiled_intersects(const _z_keyexpr_compiled_t *l, const char *rstart, size_t rlen) {
+    return __z_keyexpr_compiled_match(l, rstart, rlen, _z_keyexpr_intersects);
+}
@@ -0,0 +1,439 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/session/dispatch.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "zenoh-pico/protocol/codec/core.h"
+#include "zenoh-pico/protocol/iobuf.h"
+#include "zenoh-pico/protocol/keyexpr.h"
+#include "zenoh-pico/utils/logging.h"
+#include "zenoh-pico/utils/result.h"
+
+#if Z_FEATURE_DISPATCH_POOL == 1 && Z_FEATURE_SUBSCRIPTION == 1
+/*------------------ Dispatch job ------------------*/
+static void __z_dispatch_job_init(_z_dispatch_job_t *job) {
+    job->_sub.in = NULL;
+    job->_sample.keyexpr = _z_keyexpr_null();
+    job->_sample.payload = _z_bytes_empty();
+    job->_sample.timestamp = _z_timestamp_null();
+    job->_sample.encoding.prefix = Z_ENCODING_PREFIX_DEFAULT;
+    job->_sample.encoding.suffix = _z_bytes_empty();
+    job->_sample.kind = Z_SAMPLE_KIND_PUT;
+#if Z_FEATURE_ATTACHMENT == 1
+    job->_attachment.is_encoded = false;
+    job->_attachment.body.decoded = z_attachment_null();
+#endif
+}
+
+static void __z_dispatch_job_clear(_z_dispatch_job_t *job) {
+    _z_keyexpr_clear(&job->_sample.keyexpr);
+    _z_bytes_clear(&job->_sample.payload);
+    _z_bytes_clear(&job->_sample.encoding.suffix);
+#if Z_FEATURE_ATTACHMENT == 1
+    _z_encoded_attachment_drop(&job->_attachment);
+#endif
+    // The subscription is released with the last of its queued samples once undeclared
+    (void)_z_subscription_rc_drop(&job->_sub);
+    __z_dispatch_job_init(job);
+}
+
+static int8_t __z_dispatch_bytes_copy(_z_bytes_t *dst, const _z_bytes_t *src) {
+    int8_t ret = _Z_RES_OK;
+
+    *dst = _z_bytes_empty();
+    if (src->len > (size_t)0) {
+        ret = _z_bytes_init(dst, src->len);
+        if (ret == _Z_RES_OK) {
+            (void)memcpy((uint8_t *)dst->start, src->start, src->len);
+        }
+    }
+
+    return ret;
+}
+
+#if Z_FEATURE_ATTACHMENT == 1
+static int8_t __z_dispatch_attachment_encode_kv(_z_bytes_t key, _z_bytes_t value, void *ctx) {
+    _z_wbuf_t *wbf = (_z_wbuf_t *)ctx;
+    _Z_RETURN_IF_ERR(_z_bytes_encode(wbf, &key));
+    _Z_RETURN_IF_ERR(_z_bytes_encode(wbf, &value));
+    return _Z_RES_OK;
+}
+
+// The attachment may only be iterated while the sample is triggered, keep its key-value pairs encoded
+static int8_t __z_dispatch_attachment_copy(_z_owned_encoded_attachment_t *dst, z_attachment_t att) {
+    int8_t ret = _Z_RES_OK;
+
+    if (z_attachment_check(&att) == true) {
+        dst->is_encoded = true;
+        dst->body.encoded = _z_bytes_empty();
+        size_t len = _z_attachment_estimate_length(att);
+        if (len > (size_t)0) {
+            _z_wbuf_t wbf = _z_wbuf_make(len, false);
+            ret = z_attachment_iterate(att, __z_dispatch_attachment_encode_kv, &wbf);
+            if (ret == _Z_RES_OK) {
+                // Take the ownership of the buffer the pairs were encoded in
+                _z_iosli_t *ios = _z_wbuf_get_iosli(&wbf, 0);
+                dst->body.encoded = (_z_bytes_t){.start = ios->_buf, .len = _z_wbuf_len(&wbf), ._is_alloc = true};
+                ios->_is_alloc = false;
+            }
+            _z_wbuf_clear(&wbf);
+        }
+    } else {
+        dst->is_encoded = false;
+        dst->body.decoded = z_attachment_null();
+    }
+
+    return ret;
+}
+#endif
+
+// Copies the sample borrowed from the caller, for the callback to run once the caller returned
+static int8_t __z_dispatch_job_make(_z_dispatch_job_t *job, _z_subscription_rc_t *sub, const _z_sample_t *sample) {
+    int8_t ret = _Z_RES_OK;
+
+    job->_sample.kind = sample->kind;
+    job->_sample.timestamp = sample->timestamp;
+    job->_sample.encoding.prefix = sample->encoding.prefix;
+    _z_keyexpr_copy(&job->_sample.keyexpr, &sample->keyexpr);
+    if ((sample->keyexpr._suffix != NULL) && (job->_sample.keyexpr._suffix == NULL)) {
+        ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+    }
+    if (ret == _Z_RES_OK) {
+        ret = __z_dispatch_bytes_copy(&job->_sample.payload, &sample->payload);
+    }
+    if (ret == _Z_RES_OK) {
+        ret = __z_dispatch_bytes_copy(&job->_sample.encoding.suffix, &sample->encoding.suffix);
+    }
+#if Z_FEATURE_ATTACHMENT == 1
+    if (ret == _Z_RES_OK) {
+        ret = __z_dispatch_attachment_copy(&job->_attachment, sample->attachment);
+        job->_sample.attachment = _z_encoded_as_attachment(&job->_attachment);
+    }
+#endif
+
+    if (ret == _Z_RES_OK) {
+        job->_sub = _z_subscription_rc_clone(sub);
+    } else {
+        __z_dispatch_job_clear(job);
+    }
+    return ret;
+}
+
+static void __z_dispatch_job_run(_z_dispatch_job_t *job) {
+    if (job->_sub.in != NULL) {
+        job->_sub.in->val._callback(&job->_sample, job->_sub.in->val._arg);
+    }
+    __z_dispatch_job_clear(job);
+}
+
+/*------------------ Dispatch worker ------------------*/
+static void __z_dispatch_worker_pop(_z_dispatch_worker_t *w) {
+    if (_z_mpsc_pop(&w->_queue) == true) {
+        zp_mutex_lock(&w->_mutex);
+        zp_condvar_signal(&w->_cond_space);
+        zp_mutex_unlock(&w->_mutex);
+    }
+}
+
+static void __z_dispatch_worker_drain(_z_dispatch_worker_t *w, _Bool run) {
+    size_t slot = _z_mpsc_peek(&w->_queue);
+    while (slot != SIZE_MAX) {
+        if (run == true) {
+            __z_dispatch_job_run(&w->_jobs[slot]);
+        } else {
+            __z_dispatch_job_clear(&w->_jobs[slot]);
+        }
+        __z_dispatch_worker_pop(w);
+        slot = _z_mpsc_peek(&w->_queue);
+    }
+}
+
+static void *_zp_dispatch_worker_task(void *w_arg) {
+    _z_dispatch_worker_t *w = (_z_dispatch_worker_t *)w_arg;
+
+    // Wait for the worker to be attached, for its callbacks to be recognized as running on it
+    zp_mutex_lock(&w->_mutex);
+    zp_mutex_unlock(&w->_mutex);
+
+    while (w->_running == true) {
+        size_t slot = _z_mpsc_peek(&w->_queue);
+        if (slot != SIZE_MAX) {
+            __z_dispatch_job_run(&w->_jobs[slot]);
+            __z_dispatch_worker_pop(w);
+        } else {
+            // Sleep until a sample is published, or the worker is stopped
+            zp_mutex_lock(&w->_mutex);
+            if (w->_running == true) {
+                if (_z_mpsc_consumer_park(&w->_queue) == true) {
+                    zp_condvar_wait(&w->_cond_ready, &w->_mutex);
+                }
+                _z_mpsc_consumer_unpark(&w->_queue);
+            }
+            zp_mutex_unlock(&w->_mutex);
+        }
+    }
+
+    return NULL;
+}
+
+static void __z_dispatch_worker_free(_z_dispatch_worker_t *w) {
+    zp_free(w->_jobs);
+    w->_jobs = NULL;
+    _z_mpsc_clear(&w->_queue);
+}
+
+static int8_t __z_dispatch_worker_init(_z_dispatch_worker_t *w) {
+    int8_t ret = _Z_RES_OK;
+
+    w->_task = NULL;
+    (void)memset(&w->_self, 0, sizeof(zp_task_t));
+    w->_running = false;
+    w->_jobs = (_z_dispatch_job_t *)zp_malloc((size_t)Z_DISPATCH_POOL_QUEUE_SIZE * sizeof(_z_dispatch_job_t));
+    if (w->_jobs != NULL) {
+        for (size_t i = 0; i < (size_t)Z_DISPATCH_POOL_QUEUE_SIZE; i++) {
+            __z_dispatch_job_init(&w->_jobs[i]);
+        }
+        ret = _z_mpsc_init(&w->_queue, (size_t)Z_DISPATCH_POOL_QUEUE_SIZE);
+        // Closed while the worker is stopped, leaving the samples to their producer
+        _z_mpsc_close(&w->_queue);
+    } else {
+        ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+    }
+
+    if (ret == _Z_RES_OK) {
+        ret = zp_mutex_init(&w->_mutex);
+    }
+    if (ret == _Z_RES_OK) {
+        ret = zp_condvar_init(&w->_cond_ready);
+    }
+    if (ret == _Z_RES_OK) {
+        ret = zp_condvar_init(&w->_cond_space);
+    }
+    if ((ret != _Z_RES_OK) && (w->_jobs != NULL)) {
+        __z_dispatch_worker_free(w);
+    }
+
+    return ret;
+}
+
+static void __z_dispatch_worker_clear(_z_dispatch_worker_t *w) {
+    // Release the samples queued while the worker was stopping, without running their callback
+    __z_dispatch_worker_drain(w, false);
+    __z_dispatch_worker_free(w);
+    zp_condvar_free(&w->_cond_space);
+    zp_condvar_free(&w->_cond_ready);
+    zp_mutex_free(&w->_mutex);
+}
+
+static int8_t __z_dispatch_worker_start(_z_dispatch_worker_t *w, zp_task_attr_t *attr) {
+    int8_t ret = _Z_RES_OK;
+
+    zp_task_t *task = (zp_task_t *)zp_malloc(sizeof(zp_task_t));
+    if (task != NULL) {
+        (void)memset(task, 0, sizeof(zp_task_t));
+        zp_mutex_lock(&w->_mutex);
+        _z_mpsc_open(&w->_queue);
+        w->_running = true;
+        if (zp_task_init(task, attr, _zp_dispatch_worker_task, w) == _Z_RES_OK) {
+            // Copied for the callbacks to look it up while the task is being freed
+            w->_self = *task;
+            w->_task = task;
+        } else {
+            _z_mpsc_close(&w->_queue);
+            w->_running = false;
+            zp_free(task);
+            ret = _Z_ERR_SYSTEM_TASK_FAILED;
+        }
+        zp_mutex_unlock(&w->_mutex);
+    } else {
+        ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+    }
+
+    return ret;
+}
+
+static void __z_dispatch_worker_signal_stop(_z_dispatch_worker_t *w) {
+    if (w->_task != NULL) {
+        // Close the queue, the producers run the callbacks themselves from now on
+        _z_mpsc_close(&w->_queue);
+        w->_running = false;
+        // Wake up the worker, and the producers waiting for it to free a slot
+        zp_mutex_lock(&w->_mutex);
+        zp_condvar_signal(&w->_cond_ready);
+        zp_condvar_signal(&w->_cond_space);
+        zp_mutex_unlock(&w->_mutex);
+    }
+}
+
+/*------------------ Dispatch pool ------------------*/
+void _z_dispatch_pool_init(_z_dispatch_pool_t *pool) {
+    pool->_workers = NULL;
+    pool->_len = 0;
+}
+
+int8_t _z_dispatch_pool_start(_z_dispatch_pool_t *pool, zp_task_attr_t *attr, size_t workers) {
+    int8_t ret = _Z_RES_OK;
+
+    if (pool->_len == (size_t)0) {
+        // The workers are kept once allocated, as the samples are spread over them by subscription
+        size_t len = 0;
+        if (workers == (size_t)0) {
+            ret = _Z_ERR_GENERIC;
+        } else {
+            pool->_workers = (_z_dispatch_worker_t *)zp_malloc(workers * sizeof(_z_dispatch_worker_t));
+            if (pool->_workers == NULL) {
+                ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+            }
+        }
+        while ((ret == _Z_RES_OK) && (len < workers)) {
+            ret = __z_dispatch_worker_init(&pool->_workers[len]);
+            if (ret == _Z_RES_OK) {
+                len = len + (size_t)1;
+            }
+        }
+        if (ret == _Z_RES_OK) {
+            pool->_len = len;
+        } else if (pool->_workers != NULL) {
+            for (size_t i = 0; i < len; i++) {
+                __z_dispatch_worker_clear(&pool->_workers[i]);
+            }
+            zp_free(pool->_workers);
+            pool->_workers = NULL;
+        }
+    } else if (pool->_workers[0]._task != NULL) {
+        // Already running
+        ret = _Z_ERR_GENERIC;
+    }
+
+    if (ret == _Z_RES_OK) {
+        for (size_t i = 0; (i < pool->_len) && (ret == _Z_RES_OK); i++) {
+            ret = __z_dispatch_worker_start(&pool->_workers[i], attr);
+        }
+        if (ret != _Z_RES_OK) {
+            (void)_z_dispatch_pool_stop(pool);
+        }
+    }
+
+    return ret;
+}
+
+int8_t _z_dispatch_pool_stop(_z_dispatch_pool_t *pool) {
+    _Bool stopped = false;
+    for (size_t i = 0; i < pool->_len; i++) {
+        __z_dispatch_worker_signal_stop(&pool->_workers[i]);
+    }
+    for (size_t i = 0; i < pool->_len; i++) {
+        _z_dispatch_worker_t *w = &pool->_workers[i];
+        if (w->_task != NULL) {
+            zp_task_join(w->_task);
+            zp_task_free(&w->_task);
+            stopped = true;
+        }
+    }
+
+    // Once all the workers returned, wait for the producers that claimed a slot before the queues closed, then run
+    // the callbacks on the samples still queued
+    for (size_t i = 0; (i < pool->_len) && (stopped == true); i++) {
+        _z_dispatch_worker_t *w = &pool->_workers[i];
+        zp_mutex_lock(&w->_mutex);
+        while (_z_mpsc_closer_park(&w->_queue) == true) {
+            zp_condvar_wait(&w->_cond_ready, &w->_mutex);
+        }
+        _z_mpsc_closer_unpark(&w->_queue);
+        zp_mutex_unlock(&w->_mutex);
+        __z_dispatch_worker_drain(w, true);
+    }
+    return _Z_RES_OK;
+}
+
+void _z_dispatch_pool_clear(_z_dispatch_pool_t *pool) {
+    (void)_z_dispatch_pool_stop(pool);
+    for (size_t i = 0; i < pool->_len; i++) {
+        __z_dispatch_worker_clear(&pool->_workers[i]);
+    }
+    zp_free(pool->_workers);
+    _z_dispatch_pool_init(pool);
+}
+
+// Whether the calling task is one of the running workers of the pool, e.g. a pooled callback publishing locally
+static _Bool __z_dispatch_pool_is_worker(const _z_dispatch_pool_t *pool) {
+    _Bool ret = false;
+    for (size_t i = 0; (i < pool->_len) && (ret == false); i++) {
+        const _z_dispatch_worker_t *w = &pool->_workers[i];
+        if ((w->_running == true) && (zp_task_is_current(&w->_self) == true)) {
+            ret = true;
+        }
+    }
+    return ret;
+}
+
+/**
+ * Copies a sample in the queue of the worker of its subscription, for the worker to run the callback on it. Waits for
+ * a free slot if the queue is full, unless the caller is a worker itself: it could wait for itself, or for a worker
+ * waiting for it.
+ *
+ * Returns false if the worker is not running, or if the queue is full and the caller is a worker, leaving the sample
+ * to the caller.
+ */
+_Bool _z_dispatch_pool_enqueue(_z_dispatch_pool_t *pool, _z_subscription_rc_t *sub, const _z_sample_t *sample) {
+    _Bool queued = false;
+
+    if (pool->_len > (size_t)0) {
+        // The samples of a subscription all go to the same worker, which keeps them in order
+        _z_dispatch_worker_t *w = &pool->_workers[(size_t)sub->in->val._id % pool->_len];
+        size_t slot = _z_mpsc_claim(&w->_queue);
+        if ((slot == SIZE_MAX) && (_z_mpsc_closer_is_parked(&w->_queue) == true)) {
+            // Stopping the pool waits for this claim to be given up
+            zp_mutex_lock(&w->_mutex);
+            zp_condvar_signal(&w->_cond_ready);
+            zp_mutex_unlock(&w->_mutex);
+        }
+        if ((slot == SIZE_MAX) && (_z_mpsc_is_closed(&w->_queue) == false) &&
+            (__z_dispatch_pool_is_worker(pool) == false)) {
+            zp_mutex_lock(&w->_mutex);
+            while ((slot == SIZE_MAX) && (_z_mpsc_is_closed(&w->_queue) == false)) {
+                if (_z_mpsc_producer_park(&w->_queue) == true) {
+                    zp_condvar_wait(&w->_cond_space, &w->_mutex);
+                }
+                _z_mpsc_producer_unpark(&w->_queue);
+                slot = _z_mpsc_claim(&w->_queue);
+            }
+            if (slot == SIZE_MAX) {
+                // The worker stopped, pass the wake up on to the other waiting producers
+                zp_condvar_signal(&w->_cond_space);
+            }
+            zp_mutex_unlock(&w->_mutex);
+        }
+
+        if (slot != SIZE_MAX) {
+            queued = true;
+            // A claimed slot must be published, the worker skips the empty jobs
+            if (__z_dispatch_job_make(&w->_jobs[slot], sub, sample) != _Z_RES_OK) {
+                _Z_ERROR("Dropping sample because it could not be copied for the dispatch pool");
+            }
+            if (_z_mpsc_publish(&w->_queue, slot) == true) {
+                zp_mutex_lock(&w->_mutex);
+                zp_condvar_signal(&w->_cond_ready);
+                zp_mutex_unlock(&w->_mutex);
+            }
+        }
+    }
+
+    return queued;
+}
+#endif
@@ -16,6 +16,7 @@
 
 #include <stddef.h>
 
+#include "zenoh-pico/collections/hashmap.h"
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/net/memory.h"
 #include "zenoh-pico/protocol/keyexpr.h"
@@ -45,10 +46,6 @@ void _z_reply_free(_z_reply_t **reply) {
     }
 }
 
-_Bool _z_pending_reply_eq(const _z_pending_reply_t *one, const _z_pending_reply_t *two) {
-    return one->_tstamp.time == two->_tstamp.time;
-}
-
 void _z_pending_reply_clear(_z_pending_reply_t *pr) {
     // Free reply
     _z_reply_clear(&pr->_reply);
@@ -57,6 +54,69 @@ void _z_pending_reply_clear(_z_pending_reply_t *pr) {
     _z_timestamp_clear(&pr->_tstamp);
 }
 
+/*------------------ Pending replies ------------------*/
+#define _Z_PENDING_REPLIES_INITIAL_CAPACITY 8
+
+static _Bool __z_pending_reply_key_eq(const void *val, const void *key) {
+    const _z_pending_reply_t *pr = (const _z_pending_reply_t *)val;
+    return _z_str_eq(pr->_reply.data.sample.keyexpr._suffix, (const char *)key);
+}
+
+void _z_pending_replies_init(_z_pending_replies_t *prs) {
+    prs->_replies = NULL;
+    prs->_len = 0;
+    prs->_capacity = 0;
+    _z_hashmap_init(&prs->_by_key);
+}
+
+void _z_pending_replies_clear(_z_pending_replies_t *prs) {
+    for (size_t i = 0; i < prs->_len; i++) {
+        _z_pending_reply_clear(&prs->_replies[i]);
+    }
+    zp_free(prs->_replies);
+    // Replies are owned by the array, the index only references them
+    _z_hashmap_clear(&prs->_by_key, _z_noop_free);
+    _z_pending_replies_init(prs);
+}
+
+/**
+ * Appends an empty reply, indexed by the given hash. The caller fills it in before any lookup can compare its key.
+ */
+static _z_pending_reply_t *__z_pending_replies_push(_z_pending_replies_t *prs, size_t hash) {
+    if (prs->_len == prs->_capacity) {
+        size_t capacity = (prs->_capacity == (size_t)0) ? (size_t)_Z_PENDING_REPLIES_INITIAL_CAPACITY
+                                                        : (prs->_capacity * (size_t)2);
+        _z_pending_reply_t *replies = (_z_pending_reply_t *)zp_malloc(capacity * sizeof(_z_pending_reply_t));
+        if (replies == NULL) {
+            return NULL;
+        }
+        // Index the moved replies from their cached hashes, only giving up the current array once it is complete
+        _z_hashmap_t by_key = _z_hashmap_make();
+        for (size_t i = 0; i < prs->_len; i++) {
+            replies[i] = prs->_replies[i];
+            if (_z_hashmap_insert(&by_key, replies[i]._hash, &replies[i]) != _Z_RES_OK) {
+                _z_hashmap_clear(&by_key, _z_noop_free);
+                zp_free(replies);
+                return NULL;
+            }
+        }
+        _z_hashmap_clear(&prs->_by_key, _z_noop_free);
+        zp_free(prs->_replies);
+        prs->_by_key = by_key;
+        prs->_replies = replies;
+        prs->_capacity = capacity;
+    }
+
+    _z_pending_reply_t *pr = &prs->_replies[prs->_len];
+    if (_z_hashmap_insert(&prs->_by_key, hash, pr) != _Z_RES_OK) {
+        return NULL;
+    }
+    (void)memset(pr, 0, sizeof(_z_pending_reply_t));
+    pr->_hash = hash;
+    prs->_len = prs->_len + (size_t)1;
+    return pr;
+}
+
 void _z_pending_query_clear(_z_pending_query_t *pen_qry) {
     if (pen_qry->_dropper != NULL) {
         pen_qry->_dropper(pen_qry->_drop_arg);
@@ -67,7 +127,7 @@ void _z_pending_query_clear(_z_pending_query_t *pen_qry) {
     _z_keyexpr_clear(&pen_qry->_key);
     _z_str_clear(pen_qry->_parameters);
 
-    _z_pending_reply_list_free(&pen_qry->_pending_replies);
+    _z_pending_replies_clear(&pen_qry->_pending_replies);
 }
 
 _Bool _z_pending_query_eq(const _z_pending_query_t *one, const _z_pending_query_t *two) { return one->_id == two->_id; }
@@ -75,31 +135,81 @@ _Bool _z_pending_query_eq(const _z_pending_query_t *one, const _z_pending_query_
 /*------------------ Query ------------------*/
 _z_zint_t _z_get_query_id(_z_session_t *zn) { return zn->_query_id++; }
 
-_z_pending_query_t *__z_get_pending_query_by_id(_z_pending_query_list_t *pqls, const _z_zint_t id) {
-    _z_pending_query_t *ret = NULL;
+static _Bool __z_pending_query_id_eq(const void *val, const void *key) {
+    return ((const _z_pending_query_t *)val)->_id == *(const _z_zint_t *)key;
+}
+
+static _Bool __z_pending_query_ptr_eq(const void *val, const void *key) { return val == key; }
 
-    _z_pending_query_list_t *xs = pqls;
-    while (xs != NULL) {
-        _z_pending_query_t *pql = _z_pending_query_list_head(xs);
-        if (pql->_id == id) {
-            ret = pql;
-            break;
-        }
+// The current tick of the query timeouts
+static uint64_t __z_pending_queries_tick(_z_session_t *zn) {
+    return (uint64_t)zp_clock_elapsed_ms(&zn->_pending_queries_epoch) / (uint64_t)Z_QUERY_TIMEOUT_TICK_MS;
+}
 
-        xs = _z_pending_query_list_tail(xs);
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_inner
+ */
+_z_pending_query_t *__unsafe__z_get_pending_query_by_id(_z_session_t *zn, const _z_zint_t id) {
+    return (_z_pending_query_t *)_z_hashmap_get(&zn->_pending_queries_index, _z_hash_uint(0, id),
+                                                __z_pending_query_id_eq, &id);
+}
+
+static void __z_pending_query_free(_z_pending_query_t *pen_qry) {
+    // Dropping a pending query triggers the dropper callback that is now the equivalent to a reply with the FINAL
+    _z_pending_query_clear(pen_qry);
+    zp_free(pen_qry);
+}
+
+/**
+ * Releases a reference to a pending query, the last one completing and freeing it.
+ *
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_inner
+ */
+static void __unsafe__z_pending_query_release(_z_pending_query_t *pen_qry) {
+    pen_qry->_refcount = pen_qry->_refcount - (size_t)1;
+    if (pen_qry->_refcount == (size_t)0) {
+        __z_pending_query_free(pen_qry);
     }
+}
 
-    return ret;
+static void __z_pending_query_index_release(void **pen_qry) {
+    __unsafe__z_pending_query_release((_z_pending_query_t *)*pen_qry);
 }
 
 /**
+ * Unlinks a pending query from the session, the reference of the session passing on to the caller.
+ *
  * This function is unsafe because it operates in potentially concurrent data.
  * Make sure that the following mutexes are locked before calling this function:
  *  - zn->_mutex_inner
  */
-_z_pending_query_t *__unsafe__z_get_pending_query_by_id(_z_session_t *zn, const _z_zint_t id) {
-    _z_pending_query_list_t *pqls = zn->_pending_queries;
-    return __z_get_pending_query_by_id(pqls, id);
+static void __unsafe__z_unlink_pending_query(_z_session_t *zn, _z_pending_query_t *pen_qry) {
+    _z_timer_wheel_remove(&zn->_pending_queries_timeouts, &pen_qry->_timeout);
+    (void)_z_hashmap_remove(&zn->_pending_queries_index, _z_hash_uint(0, pen_qry->_id), __z_pending_query_ptr_eq,
+                            pen_qry);
+}
+
+/**
+ * Completes a pending query unlinked from the session, either on its final reply or on its timeout, and releases the
+ * reference the session held. Called without the session mutex: nothing else reaches the stored replies of an
+ * unlinked query, and the user callbacks may take their time.
+ */
+static void __z_finalize_pending_query(_z_session_t *zn, _z_pending_query_t *pen_qry) {
+    // Apply consolidation if needed
+    if (pen_qry->_consolidation == Z_CONSOLIDATION_MODE_LATEST) {
+        _z_pending_replies_t *prs = &pen_qry->_pending_replies;
+        for (size_t i = 0; i < prs->_len; i++) {
+            // Trigger the query handler, the reply moves out of the array
+            pen_qry->_callback(_z_reply_alloc_and_move(&prs->_replies[i]._reply), pen_qry->_call_arg);
+        }
+        _z_pending_replies_clear(prs);
+    }
+
+    _z_pending_query_release(zn, pen_qry);
 }
 
 _z_pending_query_t *_z_get_pending_query_by_id(_z_session_t *zn, const _z_zint_t id) {
@@ -127,11 +237,24 @@ int8_t _z_register_pending_query(_z_session_t *zn, _z_pending_query_t *pen_qry)
 
     _z_pending_query_t *pql = __unsafe__z_get_pending_query_by_id(zn, pen_qry->_id);
     if (pql == NULL) {  // Register query only if a pending one with the same ID does not exist
-        zn->_pending_queries = _z_pending_query_list_push(zn->_pending_queries, pen_qry);
+        ret = _z_hashmap_insert(&zn->_pending_queries_index, _z_hash_uint(0, pen_qry->_id), pen_qry);
     } else {
         ret = _Z_ERR_ENTITY_DECLARATION_FAILED;
     }
 
+    if (ret == _Z_RES_OK) {
+        pen_qry->_refcount = pen_qry->_refcount + (size_t)1;
+
+        _z_timer_init(&pen_qry->_timeout, pen_qry);
+        if (pen_qry->_timeout_ms > (uint32_t)0) {
+            // Round the deadline up to the next tick, so that the query never expires early
+            uint64_t deadline = (uint64_t)zp_clock_elapsed_ms(&zn->_pending_queries_epoch) +
+                                (uint64_t)pen_qry->_timeout_ms + (uint64_t)Z_QUERY_TIMEOUT_TICK_MS - (uint64_t)1;
+            _z_timer_wheel_add(&zn->_pending_queries_timeouts, &pen_qry->_timeout,
+                               deadline / (uint64_t)Z_QUERY_TIMEOUT_TICK_MS);
+        }
+    }
+
 #if Z_FEATURE_MULTI_THREAD == 1
     zp_mutex_unlock(&zn->_mutex_inner);
 #endif  // Z_FEATURE_MULTI_THREAD == 1
@@ -171,62 +294,60 @@ int8_t _z_trigger_query_reply_partial(_z_session_t *zn, const _z_zint_t id, cons
     reply.data.sample.kind = kind;
     reply.data.sample.timestamp = _z_timestamp_duplicate(&timestamp);
 
-    // Verify if this is a newer reply, free the old one in case it is
+    // Keep only the newest reply of each key expression, replacing the older one in place
+    _Bool drop = false;
+    _Bool stored = false;
     if ((ret == _Z_RES_OK) && ((pen_qry->_consolidation == Z_CONSOLIDATION_MODE_LATEST) ||
                                (pen_qry->_consolidation == Z_CONSOLIDATION_MODE_MONOTONIC))) {
-        _Bool drop = false;
-        _z_pending_reply_list_t *pen_rps = pen_qry->_pending_replies;
-        _z_pending_reply_t *pen_rep = NULL;
-        while (pen_rps != NULL) {
-            pen_rep = _z_pending_reply_list_head(pen_rps);
-
-            // Check if this is the same resource key
-            if (_z_str_eq(pen_rep->_reply.data.sample.keyexpr._suffix, reply.data.sample.keyexpr._suffix) == true) {
-                if (timestamp.time <= pen_rep->_tstamp.time) {
-                    drop = true;
-                } else {
-                    pen_qry->_pending_replies =
-                        _z_pending_reply_list_drop_filter(pen_qry->_pending_replies, _z_pending_reply_eq, pen_rep);
-                }
-                break;
+        _z_pending_replies_t *prs = &pen_qry->_pending_replies;
+        const char *suffix = reply.data.sample.keyexpr._suffix;
+        size_t hash = _z_hash_str(0, suffix);
+        _z_pending_reply_t *pen_rep = (_z_pending_reply_t *)_z_hashmap_get(&prs->_by_key, hash,
+                                                                           __z_pending_reply_key_eq, suffix);
+        if (pen_rep != NULL) {
+            if (timestamp.time <= pen_rep->_tstamp.time) {
+                drop = true;
+            } else {
+                _z_pending_reply_clear(pen_rep);
+            }
+        } else {
+            pen_rep = __z_pending_replies_push(prs, hash);
+            if (pen_rep == NULL) {
+                ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
             }
-
-            pen_rps = _z_pending_reply_list_tail(pen_rps);
         }
 
-        if (drop == false) {
-            // Cache most recent reply
-            pen_rep = (_z_pending_reply_t *)zp_malloc(sizeof(_z_pending_reply_t));
-            if (pen_rep != NULL) {
-                if (pen_qry->_consolidation == Z_CONSOLIDATION_MODE_MONOTONIC) {
-                    // No need to store the whole reply in the monotonic mode.
-                    _z_reply_t partial_reply;
-                    (void)memset(&partial_reply, 0,
-                                 sizeof(_z_reply_t));  // Avoid warnings on uninitialized values on the reply
-                    partial_reply.data.sample.keyexpr = _z_keyexpr_duplicate(reply.data.sample.keyexpr);
-                    pen_rep->_reply = partial_reply;
-                } else {
-                    pen_rep->_reply = reply;  // Store the whole reply in the latest mode
-                }
-                pen_rep->_tstamp = _z_timestamp_duplicate(&timestamp);
-                pen_qry->_pending_replies = _z_pending_reply_list_push(pen_qry->_pending_replies, pen_rep);
+        if ((ret == _Z_RES_OK) && (drop == false)) {
+            if (pen_qry->_consolidation == Z_CONSOLIDATION_MODE_MONOTONIC) {
+                // No need to store the whole reply in the monotonic mode.
+                (void)memset(&pen_rep->_reply, 0, sizeof(_z_reply_t));
+                pen_rep->_reply.data.sample.keyexpr = _z_keyexpr_duplicate(reply.data.sample.keyexpr);
             } else {
-                ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+                pen_rep->_reply = reply;  // Store the whole reply in the latest mode
+                stored = true;
             }
+            pen_rep->_tstamp = _z_timestamp_duplicate(&timestamp);
         }
     }
 
+    // The query may complete while its callback runs, keep it alive until then
+    _Bool trigger = (ret == _Z_RES_OK) && (drop == false) && (pen_qry->_consolidation != Z_CONSOLIDATION_MODE_LATEST);
+    if (trigger == true) {
+        pen_qry->_refcount = pen_qry->_refcount + (size_t)1;
+    }
+
 #if Z_FEATURE_MULTI_THREAD == 1
     zp_mutex_unlock(&zn->_mutex_inner);
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
     // Trigger the user callback
-    if ((ret == _Z_RES_OK) && (pen_qry->_consolidation != Z_CONSOLIDATION_MODE_LATEST)) {
+    if (trigger == true) {
         pen_qry->_callback(_z_reply_alloc_and_move(&reply), pen_qry->_call_arg);
-    }
-
-    if (ret != _Z_RES_OK) {
+        _z_pending_query_release(zn, pen_qry);
+    } else if (stored == false) {
         _z_reply_clear(&reply);
+    } else {
+        // Do nothing. Required to be compliant with MISRA 15.7 rule
     }
 
     return ret;
@@ -245,27 +366,64 @@ int8_t _z_trigger_query_reply_final(_z_session_t *zn, _z_zint_t id) {
         ret = _Z_ERR_ENTITY_UNKNOWN;
     }
 
-    // The reply is the final one, apply consolidation if needed
-    if ((ret == _Z_RES_OK) && (pen_qry->_consolidation == Z_CONSOLIDATION_MODE_LATEST)) {
-        while (pen_qry->_pending_replies != NULL) {
-            _z_pending_reply_t *pen_rep = _z_pending_reply_list_head(pen_qry->_pending_replies);
-
-            // Trigger the query handler
-            pen_qry->_callback(_z_reply_alloc_and_move(&pen_rep->_reply), pen_qry->_call_arg);
-            pen_qry->_pending_replies = _z_pending_reply_list_pop(pen_qry->_pending_replies, NULL);
-        }
+    if (ret == _Z_RES_OK) {
+        __unsafe__z_unlink_pending_query(zn, pen_qry);
     }
 
+#if Z_FEATURE_MULTI_THREAD == 1
+    zp_mutex_unlock(&zn->_mutex_inner);
+#endif  // Z_FEATURE_MULTI_THREAD == 1
+
     if (ret == _Z_RES_OK) {
-        // Dropping a pending query triggers the dropper callback that is now the equivalent to a reply with the FINAL
-        zn->_pending_queries = _z_pending_query_list_drop_filter(zn->_pending_queries, _z_pending_query_eq, pen_qry);
+        __z_finalize_pending_query(zn, pen_qry);
     }
 
+    return ret;
+}
+
+_Bool _z_expire_pending_queries(_z_session_t *zn) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    zp_mutex_lock(&zn->_mutex_inner);
+#endif  // Z_FEATURE_MULTI_THREAD == 1
+
+    // The expired timers are no longer scheduled, unlink their queries and complete them once unlocked
+    _z_timer_t *expired = _z_timer_wheel_advance(&zn->_pending_queries_timeouts, __z_pending_queries_tick(zn));
+    for (_z_timer_t *timer = expired; timer != NULL; timer = timer->_next) {
+        __unsafe__z_unlink_pending_query(zn, (_z_pending_query_t *)timer->_arg);
+    }
+    _Bool pending = (_z_timer_wheel_is_empty(&zn->_pending_queries_timeouts) == false);
+
 #if Z_FEATURE_MULTI_THREAD == 1
     zp_mutex_unlock(&zn->_mutex_inner);
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
-    return ret;
+    while (expired != NULL) {
+        // The query owns the timer, step to the next one before releasing it
+        _z_pending_query_t *pen_qry = (_z_pending_query_t *)expired->_arg;
+        expired = expired->_next;
+        _Z_DEBUG(">>> Query %ju timed out after %ums", (uintmax_t)pen_qry->_id, (unsigned int)pen_qry->_timeout_ms);
+        __z_finalize_pending_query(zn, pen_qry);
+    }
+
+    return pending;
+}
+
+void _z_pending_query_release(_z_session_t *zn, _z_pending_query_t *pen_qry) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    zp_mutex_lock(&zn->_mutex_inner);
+#endif  // Z_FEATURE_MULTI_THREAD == 1
+
+    pen_qry->_refcount = pen_qry->_refcount - (size_t)1;
+    _Bool last = (pen_qry->_refcount == (size_t)0);
+
+#if Z_FEATURE_MULTI_THREAD == 1
+    zp_mutex_unlock(&zn->_mutex_inner);
+#endif  // Z_FEATURE_MULTI_THREAD == 1
+
+    // No one else reaches the query anymore, its dropper runs without the session mutex
+    if (last == true) {
+        __z_pending_query_free(pen_qry);
+    }
 }
 
 void _z_unregister_pending_query(_z_session_t *zn, _z_pending_query_t *pen_qry) {
@@ -273,7 +431,11 @@ void _z_unregister_pending_query(_z_session_t *zn, _z_pending_query_t *pen_qry)
     zp_mutex_lock(&zn->_mutex_inner);
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
-    zn->_pending_queries = _z_pending_query_list_drop_filter(zn->_pending_queries, _z_pending_query_eq, pen_qry);
+    // The query may have completed or expired in the meantime
+    if (__unsafe__z_get_pending_query_by_id(zn, pen_qry->_id) == pen_qry) {
+        __unsafe__z_unlink_pending_query(zn, pen_qry);
+        __unsafe__z_pending_query_release(pen_qry);
+    }
 
 #if Z_FEATURE_MULTI_THREAD == 1
     zp_mutex_unlock(&zn->_mutex_inner);
@@ -285,7 +447,9 @@ void _z_flush_pending_queries(_z_session_t *zn) {
     zp_mutex_lock(&zn->_mutex_inner);
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
-    _z_pending_query_list_free(&zn->_pending_queries);
+    // The queries own their timers, drop the timers before the references of the index
+    _z_timer_wheel_init(&zn->_pending_queries_timeouts, zn->_pending_queries_timeouts._now);
+    _z_hashmap_clear(&zn->_pending_queries_index, __z_pending_query_index_release);
 
 #if Z_FEATURE_MULTI_THREAD == 1
     zp_mutex_unlock(&zn->_mutex_inner);
@@ -35,6 +35,7 @@ void _z_session_queryable_clear(_z_session_queryable_t *qle) {
     if (qle->_dropper != NULL) {
         qle->_dropper(qle->_arg);
     }
+    _z_keyexpr_compiled_clear(&qle->_compiled);
     _z_keyexpr_clear(&qle->_key);
 }
 
@@ -60,11 +61,11 @@ _z_session_queryable_rc_list_t *__z_get_session_queryable_by_key(_z_session_quer
                                                                  const _z_keyexpr_t key) {
     _z_session_queryable_rc_list_t *ret = NULL;
 
+    size_t key_len = strlen(key._suffix);
     _z_session_queryable_rc_list_t *xs = qles;
     while (xs != NULL) {
         _z_session_queryable_rc_t *qle = _z_session_queryable_rc_list_head(xs);
-        if (_z_keyexpr_intersects(qle->in->val._key._suffix, strlen(qle->in->val._key._suffix), key._suffix,
-                                  strlen(key._suffix)) == true) {
+        if (_z_keyexpr_compiled_intersects(&qle->in->val._compiled, key._suffix, key_len) == true) {
             ret = _z_session_queryable_rc_list_push(ret, _z_session_queryable_rc_clone_as_ptr(qle));
         }
 
@@ -151,7 +152,8 @@ int8_t _z_trigger_queryables(_z_session_t *zn, const _z_msg_query_t *msgq, const
     zp_mutex_lock(&zn->_mutex_inner);
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
-    _z_keyexpr_t key = __unsafe_z_get_expanded_key_from_key(zn, &q_key);
+    _z_expanded_key_rc_t ref;
+    _z_keyexpr_t key = __unsafe_z_get_borrowed_expanded_key_from_key(zn, &q_key, &ref);
     if (key._suffix != NULL) {
         _z_session_queryable_rc_list_t *qles = __unsafe_z_get_session_queryable_by_key(zn, key);
 
@@ -172,6 +174,7 @@ int8_t _z_trigger_queryables(_z_session_t *zn, const _z_msg_query_t *msgq, const
         // Clean up
         _z_query_rc_drop(&query._val._rc);
         _z_keyexpr_clear(&key);
+        (void)_z_expanded_key_rc_drop(&ref);
         _z_session_queryable_rc_list_free(&qles);
     } else {
 #if Z_FEATURE_MULTI_THREAD == 1
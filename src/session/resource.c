@@ -16,6 +16,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "zenoh-pico/api/types.h"
 #include "zenoh-pico/config.h"
@@ -27,7 +28,21 @@
 
 _Bool _z_resource_eq(const _z_resource_t *other, const _z_resource_t *this_) { return this_->_id == other->_id; }
 
-void _z_resource_clear(_z_resource_t *res) { _z_keyexpr_clear(&res->_key); }
+void _z_expanded_key_clear(_z_expanded_key_t *key) {
+    _z_str_clear(key->_suffix);
+    key->_suffix = NULL;
+    key->_len = 0;
+}
+
+void _z_resource_clear(_z_resource_t *res) {
+    _z_keyexpr_clear(&res->_key);
+    (void)_z_expanded_key_rc_drop(&res->_expanded_key);
+    res->_expanded_key.in = NULL;
+#if Z_FEATURE_SUBSCRIPTION == 1
+    (void)_z_subscription_cache_rc_drop(&res->_subscriptions);
+    res->_subscriptions.in = NULL;
+#endif
+}
 
 void _z_resource_free(_z_resource_t **res) {
     _z_resource_t *ptr = *res;
@@ -45,101 +60,168 @@ uint32_t _z_get_entity_id(_z_session_t *zn) { return zn->_entity_id++; }
 
 uint16_t _z_get_resource_id(_z_session_t *zn) { return zn->_resource_id++; }
 
-/*------------------ Resource ------------------*/
-_z_resource_t *__z_get_resource_by_id(_z_resource_list_t *rl, uint16_t mapping, const _z_zint_t id) {
-    _z_resource_t *ret = NULL;
-
-    _z_resource_list_t *xs = rl;
-    while (xs != NULL) {
-        _z_resource_t *r = _z_resource_list_head(xs);
-        if (r->_id == id && _z_keyexpr_mapping_id(&r->_key) == mapping) {
-            ret = r;
-            break;
-        }
+/*------------------ Resource index ------------------*/
+typedef struct {
+    uint16_t _mapping;
+    _z_zint_t _id;
+    const char *_suffix;
+} __z_resource_lookup_t;
 
-        xs = _z_resource_list_tail(xs);
-    }
+static size_t __z_resource_id_hash(uint16_t mapping, _z_zint_t id) { return _z_hash_uint(mapping, (uint64_t)id); }
+
+static size_t __z_resource_key_hash(uint16_t mapping, _z_zint_t id, const char *suffix) {
+    return _z_hash_str(__z_resource_id_hash(mapping, id), suffix);
+}
+
+static _Bool __z_resource_id_eq(const void *val, const void *key) {
+    const _z_resource_t *r = (const _z_resource_t *)val;
+    const __z_resource_lookup_t *k = (const __z_resource_lookup_t *)key;
+    return (r->_id == k->_id) && (_z_keyexpr_mapping_id(&r->_key) == k->_mapping);
+}
+
+static _Bool __z_resource_key_eq(const void *val, const void *key) {
+    const _z_resource_t *r = (const _z_resource_t *)val;
+    const __z_resource_lookup_t *k = (const __z_resource_lookup_t *)key;
+    return (r->_key._id == k->_id) && (_z_keyexpr_mapping_id(&r->_key) == k->_mapping) &&
+           (_z_str_eq(r->_key._suffix, k->_suffix) == true);
+}
+
+static _Bool __z_resource_ptr_eq(const void *val, const void *key) { return val == key; }
+
+void _z_resource_index_init(_z_resource_index_t *idx) {
+    _z_hashmap_init(&idx->_by_id);
+    _z_hashmap_init(&idx->_by_key);
+}
+
+void _z_resource_index_clear(_z_resource_index_t *idx) {
+    // Resources are owned by the resource lists
+    _z_hashmap_clear(&idx->_by_id, _z_noop_free);
+    _z_hashmap_clear(&idx->_by_key, _z_noop_free);
+}
+
+static size_t __z_resource_index_id_hash(const _z_resource_t *res) {
+    return __z_resource_id_hash(_z_keyexpr_mapping_id(&res->_key), res->_id);
+}
+
+static size_t __z_resource_index_key_hash(const _z_resource_t *res) {
+    return __z_resource_key_hash(_z_keyexpr_mapping_id(&res->_key), res->_key._id, res->_key._suffix);
+}
 
+/**
+ * Indexes a resource, which is about to be pushed in front of its resource list. If other resources share the same
+ * keys, the new one shadows them as it would in the list.
+ */
+static int8_t __z_resource_index_insert(_z_resource_index_t *idx, _z_resource_t *res) {
+    __z_resource_lookup_t lookup = {._mapping = _z_keyexpr_mapping_id(&res->_key), ._id = res->_id, ._suffix = NULL};
+    size_t id_hash = __z_resource_index_id_hash(res);
+    (void)_z_hashmap_remove(&idx->_by_id, id_hash, __z_resource_id_eq, &lookup);
+    int8_t ret = _z_hashmap_insert(&idx->_by_id, id_hash, res);
+
+    if (ret == _Z_RES_OK) {
+        lookup._id = res->_key._id;
+        lookup._suffix = res->_key._suffix;
+        size_t key_hash = __z_resource_index_key_hash(res);
+        (void)_z_hashmap_remove(&idx->_by_key, key_hash, __z_resource_key_eq, &lookup);
+        ret = _z_hashmap_insert(&idx->_by_key, key_hash, res);
+        if (ret != _Z_RES_OK) {
+            (void)_z_hashmap_remove(&idx->_by_id, id_hash, __z_resource_ptr_eq, res);
+        }
+    }
     return ret;
 }
 
-_z_resource_t *__z_get_resource_by_key(_z_resource_list_t *rl, const _z_keyexpr_t *keyexpr) {
-    _z_resource_t *ret = NULL;
-    uint16_t mapping = _z_keyexpr_mapping_id(keyexpr);
-
-    _z_resource_list_t *xs = rl;
-    while (xs != NULL) {
-        _z_resource_t *r = _z_resource_list_head(xs);
-        if ((r->_key._id == keyexpr->_id) && _z_keyexpr_mapping_id(&r->_key) == mapping &&
-            (_z_str_eq(r->_key._suffix, keyexpr->_suffix) == true)) {
-            ret = r;
-            break;
+/**
+ * Removes a resource, already popped from its resource list, from the indexes. Resources of the list it was
+ * shadowing are indexed back.
+ */
+static void __z_resource_index_remove(_z_resource_index_t *idx, _z_resource_list_t *rl, _z_resource_t *res) {
+    size_t id_hash = __z_resource_index_id_hash(res);
+    if (_z_hashmap_remove(&idx->_by_id, id_hash, __z_resource_ptr_eq, res) != NULL) {
+        for (_z_resource_list_t *xs = rl; xs != NULL; xs = _z_resource_list_tail(xs)) {
+            _z_resource_t *r = _z_resource_list_head(xs);
+            if ((r->_id == res->_id) && (_z_keyexpr_mapping_id(&r->_key) == _z_keyexpr_mapping_id(&res->_key))) {
+                (void)_z_hashmap_insert(&idx->_by_id, id_hash, r);
+                break;
+            }
         }
+    }
 
-        xs = _z_resource_list_tail(xs);
+    size_t key_hash = __z_resource_index_key_hash(res);
+    if (_z_hashmap_remove(&idx->_by_key, key_hash, __z_resource_ptr_eq, res) != NULL) {
+        __z_resource_lookup_t lookup = {
+            ._mapping = _z_keyexpr_mapping_id(&res->_key), ._id = res->_key._id, ._suffix = res->_key._suffix};
+        for (_z_resource_list_t *xs = rl; xs != NULL; xs = _z_resource_list_tail(xs)) {
+            _z_resource_t *r = _z_resource_list_head(xs);
+            if (__z_resource_key_eq(r, &lookup) == true) {
+                (void)_z_hashmap_insert(&idx->_by_key, key_hash, r);
+                break;
+            }
+        }
     }
+}
 
-    return ret;
+/*------------------ Resource ------------------*/
+_z_resource_t *__z_get_resource_by_id(_z_resource_index_t *idx, uint16_t mapping, const _z_zint_t id) {
+    __z_resource_lookup_t lookup = {._mapping = mapping, ._id = id, ._suffix = NULL};
+    return (_z_resource_t *)_z_hashmap_get(&idx->_by_id, __z_resource_id_hash(mapping, id), __z_resource_id_eq,
+                                           &lookup);
 }
 
-_z_keyexpr_t __z_get_expanded_key_from_key(_z_resource_list_t *xs, const _z_keyexpr_t *keyexpr) {
-    _z_keyexpr_t ret = {._id = Z_RESOURCE_ID_NONE, ._suffix = NULL, ._mapping = _z_keyexpr_mapping(0, true)};
+_z_resource_t *__z_get_resource_by_key(_z_resource_index_t *idx, const _z_keyexpr_t *keyexpr) {
+    __z_resource_lookup_t lookup = {
+        ._mapping = _z_keyexpr_mapping_id(keyexpr), ._id = keyexpr->_id, ._suffix = keyexpr->_suffix};
+    return (_z_resource_t *)_z_hashmap_get(&idx->_by_key,
+                                           __z_resource_key_hash(lookup._mapping, lookup._id, lookup._suffix),
+                                           __z_resource_key_eq, &lookup);
+}
 
-    // Need to build the complete resource name, by recursively look at RIDs
-    // Resource names are looked up from right to left
-    _z_str_list_t *strs = NULL;
-    size_t len = 1;  // Start with space for the null-terminator
-
-    // Append suffix as the right-most segment
-    if (keyexpr->_suffix != NULL) {
-        len = len + strlen(keyexpr->_suffix);
-        strs = _z_str_list_push(strs, (char *)keyexpr->_suffix);  // Warning: list must be release with
-                                                                  //   _z_list_free(&strs, _z_noop_free);
-                                                                  //   or will release the suffix as well
-    }
+_z_keyexpr_t __z_get_expanded_key_from_key(_z_resource_index_t *idx, const _z_keyexpr_t *keyexpr) {
+    _z_keyexpr_t ret = {._id = Z_RESOURCE_ID_NONE, ._suffix = NULL, ._mapping = _z_keyexpr_mapping(0, true)};
 
-    // Recursively go through all the RIDs
-    _z_zint_t id = keyexpr->_id;
-    uint16_t mapping = _z_keyexpr_mapping_id(keyexpr);
-    while (id != Z_RESOURCE_ID_NONE) {
-        _z_resource_t *res = __z_get_resource_by_id(xs, mapping, id);
+    // Declared resources hold their expanded key, so that only the suffix has to be appended to it
+    const char *prefix = NULL;
+    size_t prefix_len = 0;
+    if (keyexpr->_id != Z_RESOURCE_ID_NONE) {
+        _z_resource_t *res = __z_get_resource_by_id(idx, _z_keyexpr_mapping_id(keyexpr), keyexpr->_id);
         if (res == NULL) {
-            len = 0;
-            break;
+            return ret;
         }
-
-        if (res->_key._suffix != NULL) {
-            len = len + strlen(res->_key._suffix);
-            strs = _z_str_list_push(strs, (char *)res->_key._suffix);  // Warning: list must be release with
-                                                                       //   _z_list_free(&strs, _z_noop_free);
-                                                                       //   or will release the suffix as well
-        }
-        id = res->_key._id;
+        prefix = res->_expanded_key.in->val._suffix;
+        prefix_len = res->_expanded_key.in->val._len;
     }
+    size_t suffix_len = (keyexpr->_suffix != NULL) ? strlen(keyexpr->_suffix) : (size_t)0;
 
-    if (len != (size_t)0) {
-        char *rname = NULL;
-        rname = (char *)zp_malloc(len);
-        if (rname != NULL) {
-            rname[0] = '\0';  // NULL terminator must be set (required to strcat)
-            len = len - (size_t)1;
-
-            // Concatenate all the partial resource names
-            _z_str_list_t *xstr = strs;
-            while (xstr != NULL) {
-                char *s = _z_str_list_head(xstr);
-                if (len > (size_t)0) {
-                    (void)strncat(rname, s, len);
-                    len = len - strlen(s);
-                }
-                xstr = _z_str_list_tail(xstr);
-            }
-            ret._suffix = rname;
+    char *rname = (char *)zp_malloc(prefix_len + suffix_len + (size_t)1);
+    if (rname != NULL) {
+        if (prefix_len > (size_t)0) {
+            (void)memcpy(rname, prefix, prefix_len);
+        }
+        if (suffix_len > (size_t)0) {
+            (void)memcpy(&rname[prefix_len], keyexpr->_suffix, suffix_len);
         }
+        rname[prefix_len + suffix_len] = '\0';
+        ret._suffix = rname;
     }
 
-    _z_list_free(&strs, _z_noop_free);
+    return ret;
+}
+
+_z_keyexpr_t __z_get_borrowed_expanded_key_from_key(_z_resource_index_t *idx, const _z_keyexpr_t *keyexpr,
+                                                    _z_expanded_key_rc_t *ref) {
+    ref->in = NULL;
+    if (keyexpr->_id == Z_RESOURCE_ID_NONE) {
+        return (keyexpr->_suffix != NULL) ? _z_keyexpr_alias(*keyexpr) : __z_get_expanded_key_from_key(idx, keyexpr);
+    }
+    if ((keyexpr->_suffix != NULL) && (keyexpr->_suffix[0] != '\0')) {
+        return __z_get_expanded_key_from_key(idx, keyexpr);
+    }
 
+    _z_keyexpr_t ret = {._id = Z_RESOURCE_ID_NONE, ._suffix = NULL, ._mapping = _z_keyexpr_mapping(0, false)};
+    _z_resource_t *res = __z_get_resource_by_id(idx, _z_keyexpr_mapping_id(keyexpr), keyexpr->_id);
+    if (res != NULL) {
+        *ref = _z_expanded_key_rc_clone(&res->_expanded_key);
+        ret._suffix = ref->in->val._suffix;
+    }
     return ret;
 }
 
@@ -149,8 +231,9 @@ _z_keyexpr_t __z_get_expanded_key_from_key(_z_resource_list_t *xs, const _z_keye
  *  - zn->_mutex_inner
  */
 _z_resource_t *__unsafe_z_get_resource_by_id(_z_session_t *zn, uint16_t mapping, _z_zint_t id) {
-    _z_resource_list_t *decls = (mapping == _Z_KEYEXPR_MAPPING_LOCAL) ? zn->_local_resources : zn->_remote_resources;
-    return __z_get_resource_by_id(decls, mapping, id);
+    _z_resource_index_t *idx =
+        (mapping == _Z_KEYEXPR_MAPPING_LOCAL) ? &zn->_local_resources_index : &zn->_remote_resources_index;
+    return __z_get_resource_by_id(idx, mapping, id);
 }
 
 /**
@@ -159,8 +242,9 @@ _z_resource_t *__unsafe_z_get_resource_by_id(_z_session_t *zn, uint16_t mapping,
  *  - zn->_mutex_inner
  */
 _z_resource_t *__unsafe_z_get_resource_by_key(_z_session_t *zn, const _z_keyexpr_t *keyexpr) {
-    _z_resource_list_t *decls = _z_keyexpr_is_local(keyexpr) ? zn->_local_resources : zn->_remote_resources;
-    return __z_get_resource_by_key(decls, keyexpr);
+    _z_resource_index_t *idx =
+        _z_keyexpr_is_local(keyexpr) ? &zn->_local_resources_index : &zn->_remote_resources_index;
+    return __z_get_resource_by_key(idx, keyexpr);
 }
 
 /**
@@ -169,8 +253,26 @@ _z_resource_t *__unsafe_z_get_resource_by_key(_z_session_t *zn, const _z_keyexpr
  *  - zn->_mutex_inner
  */
 _z_keyexpr_t __unsafe_z_get_expanded_key_from_key(_z_session_t *zn, const _z_keyexpr_t *keyexpr) {
-    _z_resource_list_t *decls = _z_keyexpr_is_local(keyexpr) ? zn->_local_resources : zn->_remote_resources;
-    return __z_get_expanded_key_from_key(decls, keyexpr);
+    _z_resource_index_t *idx =
+        _z_keyexpr_is_local(keyexpr) ? &zn->_local_resources_index : &zn->_remote_resources_index;
+    return __z_get_expanded_key_from_key(idx, keyexpr);
+}
+
+/**
+ * Same as :c:func:`__unsafe_z_get_expanded_key_from_key`, but avoids copying the expanded key when it is the one of a
+ * declared resource. In that case the returned key borrows it, and ``ref`` holds a reference keeping it alive after
+ * the lock is released, even if the resource gets undeclared. Callers must both clear the returned key and drop
+ * ``ref`` once done.
+ *
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_inner
+ */
+_z_keyexpr_t __unsafe_z_get_borrowed_expanded_key_from_key(_z_session_t *zn, const _z_keyexpr_t *keyexpr,
+                                                           _z_expanded_key_rc_t *ref) {
+    _z_resource_index_t *idx =
+        _z_keyexpr_is_local(keyexpr) ? &zn->_local_resources_index : &zn->_remote_resources_index;
+    return __z_get_borrowed_expanded_key_from_key(idx, keyexpr, ref);
 }
 
 _z_resource_t *_z_get_resource_by_id(_z_session_t *zn, uint16_t mapping, _z_zint_t rid) {
@@ -228,10 +330,13 @@ int16_t _z_register_resource(_z_session_t *zn, _z_keyexpr_t key, uint16_t id, ui
     zp_mutex_lock(&zn->_mutex_inner);
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
+    _z_resource_t *parent = NULL;
     if (key._id != Z_RESOURCE_ID_NONE) {
         if (parent_mapping == mapping) {
-            _z_resource_t *parent = __unsafe_z_get_resource_by_id(zn, parent_mapping, key._id);
-            parent->_refcount++;
+            parent = __unsafe_z_get_resource_by_id(zn, parent_mapping, key._id);
+            if (parent != NULL) {
+                parent->_refcount++;
+            }
         } else {
             key = __unsafe_z_get_expanded_key_from_key(zn, &key);
         }
@@ -246,14 +351,45 @@ int16_t _z_register_resource(_z_session_t *zn, _z_keyexpr_t key, uint16_t id, ui
             res->_key = _z_keyexpr_to_owned(key);
             ret = id == Z_RESOURCE_ID_NONE ? _z_get_resource_id(zn) : id;
             res->_id = ret;
+            // Expand the key once and for all, parents are kept alive by the reference held on them
+            _z_expanded_key_t expanded = {._suffix = NULL, ._len = 0};
+            expanded._suffix = (char *)__unsafe_z_get_expanded_key_from_key(zn, &res->_key)._suffix;
+            res->_expanded_key.in = NULL;
+#if Z_FEATURE_SUBSCRIPTION == 1
+            res->_subscriptions.in = NULL;
+#endif
+            if (expanded._suffix != NULL) {
+                expanded._len = strlen(expanded._suffix);
+                res->_expanded_key = _z_expanded_key_rc_new_from_val(expanded);
+                if (res->_expanded_key.in == NULL) {
+                    _z_expanded_key_clear(&expanded);
+                }
+            }
             // Register the resource
-            if (mapping == _Z_KEYEXPR_MAPPING_LOCAL) {
-                zn->_local_resources = _z_resource_list_push(zn->_local_resources, res);
+            if (res->_expanded_key.in == NULL) {
+                _z_resource_free(&res);
+                ret = Z_RESOURCE_ID_NONE;
+            } else if (mapping == _Z_KEYEXPR_MAPPING_LOCAL) {
+                if (__z_resource_index_insert(&zn->_local_resources_index, res) == _Z_RES_OK) {
+                    zn->_local_resources = _z_resource_list_push(zn->_local_resources, res);
+                } else {
+                    _z_resource_free(&res);
+                    ret = Z_RESOURCE_ID_NONE;
+                }
             } else {
-                zn->_remote_resources = _z_resource_list_push(zn->_remote_resources, res);
+                if (__z_resource_index_insert(&zn->_remote_resources_index, res) == _Z_RES_OK) {
+                    zn->_remote_resources = _z_resource_list_push(zn->_remote_resources, res);
+                } else {
+                    _z_resource_free(&res);
+                    ret = Z_RESOURCE_ID_NONE;
+                }
             }
         }
     }
+    // The resource was not registered, it does not hold its parent
+    if ((ret == Z_RESOURCE_ID_NONE) && (parent != NULL)) {
+        parent->_refcount--;
+    }
 
 #if Z_FEATURE_MULTI_THREAD == 1
     zp_mutex_unlock(&zn->_mutex_inner);
@@ -268,7 +404,9 @@ void _z_unregister_resource(_z_session_t *zn, uint16_t id, uint16_t mapping) {
 #if Z_FEATURE_MULTI_THREAD == 1
     zp_mutex_lock(&zn->_mutex_inner);
 #endif  // Z_FEATURE_MULTI_THREAD == 1
-    _z_resource_list_t **parent_mut = is_local ? &zn->_local_resources : &zn->_remote_resources;
+    _z_resource_list_t **decls = is_local ? &zn->_local_resources : &zn->_remote_resources;
+    _z_resource_index_t *idx = is_local ? &zn->_local_resources_index : &zn->_remote_resources_index;
+    _z_resource_list_t **parent_mut = decls;
     while (id != 0) {
         _z_resource_list_t *parent = *parent_mut;
         while (parent != NULL) {
@@ -277,6 +415,7 @@ void _z_unregister_resource(_z_session_t *zn, uint16_t id, uint16_t mapping) {
                 head->_refcount--;
                 if (head->_refcount == 0) {
                     *parent_mut = _z_resource_list_pop(parent, &head);
+                    __z_resource_index_remove(idx, *decls, head);
                     id = head->_key._id;
                     mapping = _z_keyexpr_mapping_id(&head->_key);
                     _z_resource_free(&head);
@@ -294,28 +433,56 @@ void _z_unregister_resource(_z_session_t *zn, uint16_t id, uint16_t mapping) {
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 }
 
-_Bool _z_unregister_resource_for_peer_filter(const _z_resource_t *candidate, const _z_resource_t *ctx) {
-    uint16_t mapping = ctx->_id;
-    return _z_keyexpr_mapping_id(&candidate->_key) == mapping;
-}
 void _z_unregister_resources_for_peer(_z_session_t *zn, uint16_t mapping) {
 #if Z_FEATURE_MULTI_THREAD == 1
     zp_mutex_lock(&zn->_mutex_inner);
 #endif  // Z_FEATURE_MULTI_THREAD == 1
-    _z_resource_t ctx = {._id = mapping, ._refcount = 0, ._key = {0}};
-    zn->_remote_resources =
-        _z_resource_list_drop_filter(zn->_remote_resources, _z_unregister_resource_for_peer_filter, &ctx);
+    _z_resource_list_t **parent_mut = &zn->_remote_resources;
+    while (*parent_mut != NULL) {
+        _z_resource_t *head = _z_resource_list_head(*parent_mut);
+        if (_z_keyexpr_mapping_id(&head->_key) == mapping) {
+            *parent_mut = _z_resource_list_pop(*parent_mut, &head);
+            __z_resource_index_remove(&zn->_remote_resources_index, zn->_remote_resources, head);
+            _z_resource_free(&head);
+        } else {
+            parent_mut = &(*parent_mut)->_tail;
+        }
+    }
 
 #if Z_FEATURE_MULTI_THREAD == 1
     zp_mutex_unlock(&zn->_mutex_inner);
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 }
 
+#if Z_FEATURE_SUBSCRIPTION == 1
+static void __z_invalidate_subscription_caches(_z_resource_list_t *rl) {
+    for (_z_resource_list_t *xs = rl; xs != NULL; xs = _z_resource_list_tail(xs)) {
+        _z_resource_t *res = _z_resource_list_head(xs);
+        (void)_z_subscription_cache_rc_drop(&res->_subscriptions);
+        res->_subscriptions.in = NULL;
+    }
+}
+
+/**
+ * Drops the local subscriptions cached on every resource, to be rebuilt on the next sample received on them.
+ *
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_inner
+ */
+void __unsafe_z_invalidate_subscription_caches(_z_session_t *zn) {
+    __z_invalidate_subscription_caches(zn->_local_resources);
+    __z_invalidate_subscription_caches(zn->_remote_resources);
+}
+#endif
+
 void _z_flush_resources(_z_session_t *zn) {
 #if Z_FEATURE_MULTI_THREAD == 1
     zp_mutex_lock(&zn->_mutex_inner);
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
+    _z_resource_index_clear(&zn->_local_resources_index);
+    _z_resource_index_clear(&zn->_remote_resources_index);
     _z_resource_list_free(&zn->_local_resources);
     _z_resource_list_free(&zn->_remote_resources);
 
@@ -16,10 +16,12 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/protocol/keyexpr.h"
+#include "zenoh-pico/protocol/ketrie.h"
 #include "zenoh-pico/session/resource.h"
 #include "zenoh-pico/session/session.h"
 #include "zenoh-pico/utils/logging.h"
@@ -33,6 +35,7 @@ void _z_subscription_clear(_z_subscription_t *sub) {
     if (sub->_dropper != NULL) {
         sub->_dropper(sub->_arg);
     }
+    _z_keyexpr_compiled_clear(&sub->_compiled);
     _z_keyexpr_clear(&sub->_key);
 }
 
@@ -56,21 +59,25 @@ _z_subscription_rc_t *__z_get_subscription_by_id(_z_subscription_rc_list_t *subs
     return ret;
 }
 
-_z_subscription_rc_list_t *__z_get_subscriptions_by_key(_z_subscription_rc_list_t *subs, const _z_keyexpr_t key) {
-    _z_subscription_rc_list_t *ret = NULL;
-
-    _z_subscription_rc_list_t *xs = subs;
-    while (xs != NULL) {
-        _z_subscription_rc_t *sub = _z_subscription_rc_list_head(xs);
-        if (_z_keyexpr_intersects(sub->in->val._key._suffix, strlen(sub->in->val._key._suffix), key._suffix,
-                                  strlen(key._suffix)) == true) {
-            ret = _z_subscription_rc_list_push(ret, _z_subscription_rc_clone_as_ptr(sub));
-        }
-
-        xs = _z_subscription_rc_list_tail(xs);
+typedef struct {
+    const _z_keyexpr_t *_key;
+    size_t _key_len;
+    _z_subscription_rc_list_t *_subs;
+} __z_subscriptions_by_key_ctx_t;
+
+static void __z_subscriptions_by_key_visit(void *val, void *arg) {
+    __z_subscriptions_by_key_ctx_t *ctx = (__z_subscriptions_by_key_ctx_t *)arg;
+    _z_subscription_rc_t *sub = (_z_subscription_rc_t *)val;
+    // The index only narrows down the candidates, confirm each of them
+    if (_z_keyexpr_compiled_intersects(&sub->in->val._compiled, ctx->_key->_suffix, ctx->_key_len) == true) {
+        ctx->_subs = _z_subscription_rc_list_push(ctx->_subs, _z_subscription_rc_clone_as_ptr(sub));
     }
+}
 
-    return ret;
+_z_subscription_rc_list_t *__z_get_subscriptions_by_key(_z_ketrie_t *index, const _z_keyexpr_t key) {
+    __z_subscriptions_by_key_ctx_t ctx = {._key = &key, ._key_len = strlen(key._suffix), ._subs = NULL};
+    _z_ketrie_intersecting(index, key._suffix, ctx._key_len, __z_subscriptions_by_key_visit, &ctx);
+    return ctx._subs;
 }
 
 /**
@@ -91,9 +98,45 @@ _z_subscription_rc_t *__unsafe_z_get_subscription_by_id(_z_session_t *zn, uint8_
  */
 _z_subscription_rc_list_t *__unsafe_z_get_subscriptions_by_key(_z_session_t *zn, uint8_t is_local,
                                                                const _z_keyexpr_t key) {
-    _z_subscription_rc_list_t *subs =
-        (is_local == _Z_RESOURCE_IS_LOCAL) ? zn->_local_subscriptions : zn->_remote_subscriptions;
-    return __z_get_subscriptions_by_key(subs, key);
+    _z_ketrie_t *index =
+        (is_local == _Z_RESOURCE_IS_LOCAL) ? &zn->_local_subscriptions_index : &zn->_remote_subscriptions_index;
+    return __z_get_subscriptions_by_key(index, key);
+}
+
+/**
+ * Returns a reference to the local subscriptions intersecting ``res``, computing and caching them on first use.
+ * The returned reference is empty if the cache could not be allocated.
+ *
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_inner
+ */
+static _z_subscription_cache_rc_t __unsafe_z_get_subscription_cache(_z_session_t *zn, _z_resource_t *res) {
+    _z_subscription_cache_rc_t ret = {.in = NULL};
+    if (res->_subscriptions.in == NULL) {
+        _z_keyexpr_t key = {._id = Z_RESOURCE_ID_NONE,
+                            ._mapping = _z_keyexpr_mapping(0, false),
+                            ._suffix = res->_expanded_key.in->val._suffix};
+        _z_subscription_rc_list_t *subs = __unsafe_z_get_subscriptions_by_key(zn, _Z_RESOURCE_IS_LOCAL, key);
+        size_t len = _z_subscription_rc_list_len(subs);
+        _z_subscription_cache_t cache = _z_subscription_rc_array_make(len);
+        if (cache._len == len) {
+            size_t i = 0;
+            for (_z_subscription_rc_list_t *xs = subs; xs != NULL; xs = _z_subscription_rc_list_tail(xs)) {
+                cache._val[i] = _z_subscription_rc_clone(_z_subscription_rc_list_head(xs));
+                i = i + (size_t)1;
+            }
+            res->_subscriptions = _z_subscription_cache_rc_new_from_val(cache);
+            if (res->_subscriptions.in == NULL) {
+                _z_subscription_cache_clear(&cache);
+            }
+        }
+        _z_subscription_rc_list_free(&subs);
+    }
+    if (res->_subscriptions.in != NULL) {
+        ret = _z_subscription_cache_rc_clone(&res->_subscriptions);
+    }
+    return ret;
 }
 
 _z_subscription_rc_t *_z_get_subscription_by_id(_z_session_t *zn, uint8_t is_local, const _z_zint_t id) {
@@ -137,13 +180,22 @@ _z_subscription_rc_t *_z_register_subscription(_z_session_t *zn, uint8_t is_loca
         ret = (_z_subscription_rc_t *)zp_malloc(sizeof(_z_subscription_rc_t));
         if (ret != NULL) {
             *ret = _z_subscription_rc_new_from_val(*s);
-            if (is_local == _Z_RESOURCE_IS_LOCAL) {
+            _z_ketrie_t *index =
+                (is_local == _Z_RESOURCE_IS_LOCAL) ? &zn->_local_subscriptions_index : &zn->_remote_subscriptions_index;
+            if (_z_ketrie_insert(index, s->_key._suffix, strlen(s->_key._suffix), ret) != _Z_RES_OK) {
+                // The subscription could never be triggered, release it without dropping the caller's data
+                zp_free(ret->in);
+                zp_free(ret);
+                ret = NULL;
+            } else if (is_local == _Z_RESOURCE_IS_LOCAL) {
                 zn->_local_subscriptions = _z_subscription_rc_list_push(zn->_local_subscriptions, ret);
+                __unsafe_z_invalidate_subscription_caches(zn);
             } else {
                 zn->_remote_subscriptions = _z_subscription_rc_list_push(zn->_remote_subscriptions, ret);
             }
         }
     }
+    _z_subscription_rc_list_free(&subs);
 
 #if Z_FEATURE_MULTI_THREAD == 1
     zp_mutex_unlock(&zn->_mutex_inner);
@@ -170,6 +222,19 @@ void _z_trigger_local_subscriptions(_z_session_t *zn, const _z_keyexpr_t keyexpr
     (void)ret;
 }
 
+// Runs the callback of a subscription, or hands the sample over to the dispatch pool if the subscription is pooled
+static void __z_subscription_dispatch(_z_session_t *zn, _z_subscription_rc_t *sub, const _z_sample_t *s) {
+#if Z_FEATURE_DISPATCH_POOL == 1
+    if ((sub->in->val._info.dispatch != Z_DISPATCH_POOLED) ||
+        (_z_dispatch_pool_enqueue(&zn->_dispatch_pool, sub, s) == false)) {
+        sub->in->val._callback(s, sub->in->val._arg);
+    }
+#else
+    _ZP_UNUSED(zn);
+    sub->in->val._callback(s, sub->in->val._arg);
+#endif
+}
+
 int8_t _z_trigger_subscriptions(_z_session_t *zn, const _z_keyexpr_t keyexpr, const _z_bytes_t payload,
                                 const _z_encoding_t encoding, const _z_zint_t kind, const _z_timestamp_t timestamp
 #if Z_FEATURE_ATTACHMENT == 1
@@ -184,10 +249,20 @@ int8_t _z_trigger_subscriptions(_z_session_t *zn, const _z_keyexpr_t keyexpr, co
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
     _Z_DEBUG("Resolving %d - %s on mapping 0x%x", keyexpr._id, keyexpr._suffix, _z_keyexpr_mapping_id(&keyexpr));
-    _z_keyexpr_t key = __unsafe_z_get_expanded_key_from_key(zn, &keyexpr);
+    _z_expanded_key_rc_t ref;
+    _z_keyexpr_t key = __unsafe_z_get_borrowed_expanded_key_from_key(zn, &keyexpr, &ref);
     _Z_DEBUG("Triggering subs for %d - %s", key._id, key._suffix);
     if (key._suffix != NULL) {
-        _z_subscription_rc_list_t *subs = __unsafe_z_get_subscriptions_by_key(zn, _Z_RESOURCE_IS_LOCAL, key);
+        // Samples on a declared resource are dispatched to its cached subscriptions, others need to be matched
+        _z_subscription_cache_rc_t cache = {.in = NULL};
+        _z_subscription_rc_list_t *subs = NULL;
+        if (ref.in != NULL) {
+            _z_resource_t *res = __unsafe_z_get_resource_by_id(zn, _z_keyexpr_mapping_id(&keyexpr), keyexpr._id);
+            cache = __unsafe_z_get_subscription_cache(zn, res);
+        }
+        if (cache.in == NULL) {
+            subs = __unsafe_z_get_subscriptions_by_key(zn, _Z_RESOURCE_IS_LOCAL, key);
+        }
 
 #if Z_FEATURE_MULTI_THREAD == 1
         zp_mutex_unlock(&zn->_mutex_inner);
@@ -203,15 +278,25 @@ int8_t _z_trigger_subscriptions(_z_session_t *zn, const _z_keyexpr_t keyexpr, co
 #if Z_FEATURE_ATTACHMENT == 1
         s.attachment = att;
 #endif
-        _z_subscription_rc_list_t *xs = subs;
-        _Z_DEBUG("Triggering %ju subs", (uintmax_t)_z_subscription_rc_list_len(xs));
-        while (xs != NULL) {
-            _z_subscription_rc_t *sub = _z_subscription_rc_list_head(xs);
-            sub->in->val._callback(&s, sub->in->val._arg);
-            xs = _z_subscription_rc_list_tail(xs);
+        if (cache.in != NULL) {
+            _Z_DEBUG("Triggering %ju cached subs", (uintmax_t)_z_subscription_rc_array_len(&cache.in->val));
+            for (size_t i = 0; i < _z_subscription_rc_array_len(&cache.in->val); i++) {
+                _z_subscription_rc_t *sub = _z_subscription_rc_array_get(&cache.in->val, i);
+                __z_subscription_dispatch(zn, sub, &s);
+            }
+        } else {
+            _z_subscription_rc_list_t *xs = subs;
+            _Z_DEBUG("Triggering %ju subs", (uintmax_t)_z_subscription_rc_list_len(xs));
+            while (xs != NULL) {
+                _z_subscription_rc_t *sub = _z_subscription_rc_list_head(xs);
+                __z_subscription_dispatch(zn, sub, &s);
+                xs = _z_subscription_rc_list_tail(xs);
+            }
         }
 
         _z_keyexpr_clear(&key);
+        (void)_z_expanded_key_rc_drop(&ref);
+        (void)_z_subscription_cache_rc_drop(&cache);
         _z_subscription_rc_list_free(&subs);
     } else {
 #if Z_FEATURE_MULTI_THREAD == 1
@@ -228,7 +313,13 @@ void _z_unregister_subscription(_z_session_t *zn, uint8_t is_local, _z_subscript
     zp_mutex_lock(&zn->_mutex_inner);
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
+    // Remove from the index first, as dropping the list entry releases the key
+    _z_ketrie_remove(
+        (is_local == _Z_RESOURCE_IS_LOCAL) ? &zn->_local_subscriptions_index : &zn->_remote_subscriptions_index,
+        sub->in->val._key._suffix, strlen(sub->in->val._key._suffix), sub);
     if (is_local == _Z_RESOURCE_IS_LOCAL) {
+        // Caches hold references, drop them before the list entry so that the subscription is released now
+        __unsafe_z_invalidate_subscription_caches(zn);
         zn->_local_subscriptions =
             _z_subscription_rc_list_drop_filter(zn->_local_subscriptions, _z_subscription_rc_eq, sub);
     } else {
@@ -246,6 +337,9 @@ void _z_flush_subscriptions(_z_session_t *zn) {
     zp_mutex_lock(&zn->_mutex_inner);
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
+    __unsafe_z_invalidate_subscription_caches(zn);
+    _z_ketrie_clear(&zn->_local_subscriptions_index);
+    _z_ketrie_clear(&zn->_remote_subscriptions_index);
     _z_subscription_rc_list_free(&zn->_local_subscriptions);
     _z_subscription_rc_list_free(&zn->_remote_subscriptions);
 
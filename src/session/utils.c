@@ -61,15 +61,24 @@ int8_t _z_session_init(_z_session_t *zn, _z_id_t *zid) {
     // Initialize the data structs
     zn->_local_resources = NULL;
     zn->_remote_resources = NULL;
+    _z_resource_index_init(&zn->_local_resources_index);
+    _z_resource_index_init(&zn->_remote_resources_index);
 #if Z_FEATURE_SUBSCRIPTION == 1
     zn->_local_subscriptions = NULL;
     zn->_remote_subscriptions = NULL;
+    _z_ketrie_init(&zn->_local_subscriptions_index);
+    _z_ketrie_init(&zn->_remote_subscriptions_index);
+#endif
+#if Z_FEATURE_DISPATCH_POOL == 1 && Z_FEATURE_SUBSCRIPTION == 1
+    _z_dispatch_pool_init(&zn->_dispatch_pool);
 #endif
 #if Z_FEATURE_QUERYABLE == 1
     zn->_local_queryable = NULL;
 #endif
 #if Z_FEATURE_QUERY == 1
-    zn->_pending_queries = NULL;
+    _z_hashmap_init(&zn->_pending_queries_index);
+    _z_timer_wheel_init(&zn->_pending_queries_timeouts, 0);
+    zn->_pending_queries_epoch = zp_clock_now();
 #endif
 
 #if Z_FEATURE_MULTI_THREAD == 1
@@ -101,8 +110,16 @@ int8_t _z_session_init(_z_session_t *zn, _z_id_t *zid) {
 void _z_session_clear(_z_session_t *zn) {
     // Clear Zenoh PID
 
+#if Z_FEATURE_DISPATCH_POOL == 1 && Z_FEATURE_SUBSCRIPTION == 1
+    // Run the pending callbacks while the transport is still open
+    (void)_z_dispatch_pool_stop(&zn->_dispatch_pool);
+#endif
+
     // Clean up transports
     _z_transport_clear(&zn->_tp);
+#if Z_FEATURE_DISPATCH_POOL == 1 && Z_FEATURE_SUBSCRIPTION == 1
+    _z_dispatch_pool_clear(&zn->_dispatch_pool);
+#endif
 
     // Clean up the entities
     _z_flush_resources(zn);
@@ -75,6 +75,8 @@ void zp_task_free(zp_task_t **task) {
     *task = NULL;
 }
 
+_Bool zp_task_is_current(const zp_task_t *task) { return false; }
+
 /*------------------ Mutex ------------------*/
 int8_t zp_mutex_init(zp_mutex_t *m) { return -1; }
 
@@ -58,6 +58,8 @@ void zp_task_free(zp_task_t **task) {
     *task = NULL;
 }
 
+_Bool zp_task_is_current(const zp_task_t *task) { return pthread_equal(*task, pthread_self()) != 0; }
+
 /*------------------ Mutex ------------------*/
 int8_t zp_mutex_init(zp_mutex_t *m) { return pthread_mutex_init(m, 0); }
 
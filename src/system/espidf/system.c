@@ -94,6 +94,8 @@ void zp_task_free(zp_task_t **task) {
     *task = NULL;
 }
 
+_Bool zp_task_is_current(const zp_task_t *task) { return *task == xTaskGetCurrentTaskHandle(); }
+
 /*------------------ Mutex ------------------*/
 int8_t zp_mutex_init(zp_mutex_t *m) { return pthread_mutex_init(m, NULL); }
 
@@ -134,6 +134,8 @@ void zp_task_free(zp_task_t **task) {
     zp_free(*task);
 }
 
+_Bool zp_task_is_current(const zp_task_t *task) { return task->handle == xTaskGetCurrentTaskHandle(); }
+
 /*------------------ Mutex ------------------*/
 int8_t zp_mutex_init(zp_mutex_t *m) {
     *m = xSemaphoreCreateRecursiveMutex();
@@ -65,6 +65,8 @@ void zp_task_free(zp_task_t **task) {
     *task = NULL;
 }
 
+_Bool zp_task_is_current(const zp_task_t *task) { return ((Thread *)*task)->get_id() == ThisThread::get_id(); }
+
 /*------------------ Mutex ------------------*/
 int8_t zp_mutex_init(zp_mutex_t *m) {
     *m = new Mutex();
@@ -12,8 +12,13 @@
 //   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
 //
 
+#if defined(ZENOH_LINUX) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  // Required for recvmmsg and sendmmsg
+#endif
+
 #include <arpa/inet.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <ifaddrs.h>
 #include <net/if.h>
 #include <netdb.h>
@@ -22,15 +27,47 @@
 #include <stddef.h>
 #include <string.h>
 #include <sys/ioctl.h>
+#include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
+#include <termios.h>
 #include <unistd.h>
 
 #include "zenoh-pico/collections/string.h"
 #include "zenoh-pico/config.h"
+#include "zenoh-pico/system/link/serial.h"
 #include "zenoh-pico/system/platform.h"
+#include "zenoh-pico/utils/checksum.h"
+#include "zenoh-pico/utils/encoding.h"
 #include "zenoh-pico/utils/logging.h"
 #include "zenoh-pico/utils/pointers.h"
 
+#if Z_FEATURE_LINK_TCP == 1 || Z_FEATURE_LINK_UDP_MULTICAST == 1 || Z_FEATURE_LINK_UDP_UNICAST == 1
+/*------------------ Vectored sends ------------------*/
+static size_t __z_send_vec(int fd, const _z_bytes_t *bufs, size_t count, struct sockaddr *addr, socklen_t addrlen,
+                           int flags) {
+    size_t ret = SIZE_MAX;
+
+    if (count <= (size_t)_Z_SYS_NET_SEND_VEC_MAX) {
+        struct iovec iov[_Z_SYS_NET_SEND_VEC_MAX];
+        for (size_t i = 0; i < count; i++) {
+            iov[i].iov_base = (void *)bufs[i].start;
+            iov[i].iov_len = bufs[i].len;
+        }
+
+        struct msghdr msg;
+        (void)memset(&msg, 0, sizeof(msg));
+        msg.msg_name = addr;
+        msg.msg_namelen = addrlen;
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        ret = sendmsg(fd, &msg, flags);
+    }
+
+    return ret;
+}
+#endif
+
 #if Z_FEATURE_LINK_TCP == 1
 
 /*------------------ TCP sockets ------------------*/
@@ -156,9 +193,87 @@ size_t _z_send_tcp(const _z_sys_net_socket_t sock, const uint8_t *ptr, size_t le
     return send(sock._fd, ptr, len, 0);
 #endif
 }
+
+size_t _z_send_vec_tcp(const _z_sys_net_socket_t sock, const _z_bytes_t *bufs, size_t count) {
+#if defined(ZENOH_LINUX)
+    return __z_send_vec(sock._fd, bufs, count, NULL, 0, MSG_NOSIGNAL);
+#else
+    return __z_send_vec(sock._fd, bufs, count, NULL, 0, 0);
+#endif
+}
 #endif
 
 #if Z_FEATURE_LINK_UDP_UNICAST == 1 || Z_FEATURE_LINK_UDP_MULTICAST == 1
+#if defined(_Z_SYS_NET_MULTI_DATAGRAM_MAX)
+/*------------------ Multi-datagram I/O ------------------*/
+// Receives up to count datagrams in a single system call, only blocking until the first one is available
+static size_t __z_read_multi(int fd, uint8_t *const *ptrs, size_t *lens, size_t count,
+                             struct sockaddr_storage *raddrs) {
+    size_t ret = SIZE_MAX;
+
+    if (count <= (size_t)_Z_SYS_NET_MULTI_DATAGRAM_MAX) {
+        struct mmsghdr msgs[_Z_SYS_NET_MULTI_DATAGRAM_MAX];
+        struct iovec iov[_Z_SYS_NET_MULTI_DATAGRAM_MAX];
+        (void)memset(msgs, 0, sizeof(msgs));
+        for (size_t i = 0; i < count; i++) {
+            iov[i].iov_base = ptrs[i];
+            iov[i].iov_len = lens[i];
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            if (raddrs != NULL) {
+                msgs[i].msg_hdr.msg_name = &raddrs[i];
+                msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+            }
+        }
+
+        int rb = recvmmsg(fd, msgs, (unsigned int)count, MSG_WAITFORONE, NULL);
+        if (rb >= 0) {
+            for (int i = 0; i < rb; i++) {
+                lens[i] = msgs[i].msg_len;
+            }
+            ret = (size_t)rb;
+        }
+    }
+
+    return ret;
+}
+
+// Sends count datagrams in as few system calls as possible
+static size_t __z_send_multi(int fd, const _z_bytes_t *dgrams, size_t count, struct sockaddr *addr,
+                             socklen_t addrlen) {
+    size_t ret = SIZE_MAX;
+
+    if (count <= (size_t)_Z_SYS_NET_MULTI_DATAGRAM_MAX) {
+        struct mmsghdr msgs[_Z_SYS_NET_MULTI_DATAGRAM_MAX];
+        struct iovec iov[_Z_SYS_NET_MULTI_DATAGRAM_MAX];
+        (void)memset(msgs, 0, sizeof(msgs));
+        for (size_t i = 0; i < count; i++) {
+            iov[i].iov_base = (void *)dgrams[i].start;
+            iov[i].iov_len = dgrams[i].len;
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_name = addr;
+            msgs[i].msg_hdr.msg_namelen = addrlen;
+        }
+
+        // The kernel may send fewer datagrams than requested, send the remaining ones
+        size_t sent = 0;
+        while (sent < count) {
+            int sb = sendmmsg(fd, &msgs[sent], (unsigned int)(count - sent), 0);
+            if (sb <= 0) {
+                break;
+            }
+            sent = sent + (size_t)sb;
+        }
+        if (sent == count) {
+            ret = count;
+        }
+    }
+
+    return ret;
+}
+#endif
+
 /*------------------ UDP sockets ------------------*/
 int8_t _z_create_endpoint_udp(_z_sys_net_endpoint_t *ep, const char *s_address, const char *s_port) {
     int8_t ret = _Z_RES_OK;
@@ -251,6 +366,22 @@ size_t _z_send_udp_unicast(const _z_sys_net_socket_t sock, const uint8_t *ptr, s
                            const _z_sys_net_endpoint_t rep) {
     return sendto(sock._fd, ptr, len, 0, rep._iptcp->ai_addr, rep._iptcp->ai_addrlen);
 }
+
+size_t _z_send_vec_udp_unicast(const _z_sys_net_socket_t sock, const _z_bytes_t *bufs, size_t count,
+                               const _z_sys_net_endpoint_t rep) {
+    return __z_send_vec(sock._fd, bufs, count, rep._iptcp->ai_addr, rep._iptcp->ai_addrlen, 0);
+}
+
+#if defined(_Z_SYS_NET_MULTI_DATAGRAM_MAX)
+size_t _z_read_multi_udp_unicast(const _z_sys_net_socket_t sock, uint8_t *const *ptrs, size_t *lens, size_t count) {
+    return __z_read_multi(sock._fd, ptrs, lens, count, NULL);
+}
+
+size_t _z_send_multi_udp_unicast(const _z_sys_net_socket_t sock, const _z_bytes_t *dgrams, size_t count,
+                                 const _z_sys_net_endpoint_t rep) {
+    return __z_send_multi(sock._fd, dgrams, count, rep._iptcp->ai_addr, rep._iptcp->ai_addrlen);
+}
+#endif
 #endif
 
 #if Z_FEATURE_LINK_UDP_MULTICAST == 1
@@ -512,6 +643,43 @@ void _z_close_udp_multicast(_z_sys_net_socket_t *sockrecv, _z_sys_net_socket_t *
     close(socksend->_fd);
 }
 
+// Returns false if the datagram comes from the local endpoint, i.e. it is one of our own looped back datagrams
+static _Bool __z_udp_multicast_is_remote(const _z_sys_net_endpoint_t lep, const struct sockaddr_storage *raddr,
+                                         _z_bytes_t *addr) {
+    _Bool ret = false;
+
+    if (lep._iptcp->ai_family == AF_INET) {
+        const struct sockaddr_in *a = ((const struct sockaddr_in *)lep._iptcp->ai_addr);
+        const struct sockaddr_in *b = ((const struct sockaddr_in *)raddr);
+        if (!((a->sin_port == b->sin_port) && (a->sin_addr.s_addr == b->sin_addr.s_addr))) {
+            // If addr is not NULL, it means that the rep was requested by the upper-layers
+            if (addr != NULL) {
+                *addr = _z_bytes_make(sizeof(in_addr_t) + sizeof(in_port_t));
+                (void)memcpy((uint8_t *)addr->start, &b->sin_addr.s_addr, sizeof(in_addr_t));
+                (void)memcpy((uint8_t *)(addr->start + sizeof(in_addr_t)), &b->sin_port, sizeof(in_port_t));
+            }
+            ret = true;
+        }
+    } else if (lep._iptcp->ai_family == AF_INET6) {
+        const struct sockaddr_in6 *a = ((const struct sockaddr_in6 *)lep._iptcp->ai_addr);
+        const struct sockaddr_in6 *b = ((const struct sockaddr_in6 *)raddr);
+        if (!((a->sin6_port == b->sin6_port) &&
+              (memcmp(a->sin6_addr.s6_addr, b->sin6_addr.s6_addr, sizeof(struct in6_addr)) == 0))) {
+            // If addr is not NULL, it means that the rep was requested by the upper-layers
+            if (addr != NULL) {
+                *addr = _z_bytes_make(sizeof(struct in6_addr) + sizeof(in_port_t));
+                (void)memcpy((uint8_t *)addr->start, &b->sin6_addr.s6_addr, sizeof(struct in6_addr));
+                (void)memcpy((uint8_t *)(addr->start + sizeof(struct in6_addr)), &b->sin6_port, sizeof(in_port_t));
+            }
+            ret = true;
+        }
+    } else {
+        // FIXME: support error report on invalid packet to the upper layer
+    }
+
+    return ret;
+}
+
 size_t _z_read_udp_multicast(const _z_sys_net_socket_t sock, uint8_t *ptr, size_t len, const _z_sys_net_endpoint_t lep,
                              _z_bytes_t *addr) {
     struct sockaddr_storage raddr;
@@ -524,36 +692,7 @@ size_t _z_read_udp_multicast(const _z_sys_net_socket_t sock, uint8_t *ptr, size_
             rb = SIZE_MAX;
             break;
         }
-
-        if (lep._iptcp->ai_family == AF_INET) {
-            struct sockaddr_in *a = ((struct sockaddr_in *)lep._iptcp->ai_addr);
-            struct sockaddr_in *b = ((struct sockaddr_in *)&raddr);
-            if (!((a->sin_port == b->sin_port) && (a->sin_addr.s_addr == b->sin_addr.s_addr))) {
-                // If addr is not NULL, it means that the rep was requested by the upper-layers
-                if (addr != NULL) {
-                    *addr = _z_bytes_make(sizeof(in_addr_t) + sizeof(in_port_t));
-                    (void)memcpy((uint8_t *)addr->start, &b->sin_addr.s_addr, sizeof(in_addr_t));
-                    (void)memcpy((uint8_t *)(addr->start + sizeof(in_addr_t)), &b->sin_port, sizeof(in_port_t));
-                }
-                break;
-            }
-        } else if (lep._iptcp->ai_family == AF_INET6) {
-            struct sockaddr_in6 *a = ((struct sockaddr_in6 *)lep._iptcp->ai_addr);
-            struct sockaddr_in6 *b = ((struct sockaddr_in6 *)&raddr);
-            if (!((a->sin6_port == b->sin6_port) &&
-                  (memcmp(a->sin6_addr.s6_addr, b->sin6_addr.s6_addr, sizeof(struct in6_addr)) == 0))) {
-                // If addr is not NULL, it means that the rep was requested by the upper-layers
-                if (addr != NULL) {
-                    *addr = _z_bytes_make(sizeof(struct in6_addr) + sizeof(in_port_t));
-                    (void)memcpy((uint8_t *)addr->start, &b->sin6_addr.s6_addr, sizeof(struct in6_addr));
-                    (void)memcpy((uint8_t *)(addr->start + sizeof(struct in6_addr)), &b->sin6_port, sizeof(in_port_t));
-                }
-                break;
-            }
-        } else {
-            continue;  // FIXME: support error report on invalid packet to the upper layer
-        }
-    } while (1);
+    } while (__z_udp_multicast_is_remote(lep, &raddr, addr) == false);
 
     return rb;
 }
@@ -582,6 +721,35 @@ size_t _z_send_udp_multicast(const _z_sys_net_socket_t sock, const uint8_t *ptr,
     return sendto(sock._fd, ptr, len, 0, rep._iptcp->ai_addr, rep._iptcp->ai_addrlen);
 }
 
+size_t _z_send_vec_udp_multicast(const _z_sys_net_socket_t sock, const _z_bytes_t *bufs, size_t count,
+                                 const _z_sys_net_endpoint_t rep) {
+    return __z_send_vec(sock._fd, bufs, count, rep._iptcp->ai_addr, rep._iptcp->ai_addrlen, 0);
+}
+
+#if defined(_Z_SYS_NET_MULTI_DATAGRAM_MAX)
+size_t _z_read_multi_udp_multicast(const _z_sys_net_socket_t sock, uint8_t *const *ptrs, size_t *lens, size_t count,
+                                   const _z_sys_net_endpoint_t lep, _z_bytes_t *addrs) {
+    struct sockaddr_storage raddrs[_Z_SYS_NET_MULTI_DATAGRAM_MAX];
+
+    size_t rb = __z_read_multi(sock._fd, ptrs, lens, count, raddrs);
+    if (rb != SIZE_MAX) {
+        for (size_t i = 0; i < rb; i++) {
+            // Our own looped back datagrams are reported as empty ones
+            if (__z_udp_multicast_is_remote(lep, &raddrs[i], (addrs != NULL) ? &addrs[i] : NULL) == false) {
+                lens[i] = 0;
+            }
+        }
+    }
+
+    return rb;
+}
+
+size_t _z_send_multi_udp_multicast(const _z_sys_net_socket_t sock, const _z_bytes_t *dgrams, size_t count,
+                                   const _z_sys_net_endpoint_t rep) {
+    return __z_send_multi(sock._fd, dgrams, count, rep._iptcp->ai_addr, rep._iptcp->ai_addrlen);
+}
+#endif
+
 #endif
 
 #if Z_FEATURE_LINK_BLUETOOTH == 1
@@ -589,5 +757,277 @@ size_t _z_send_udp_multicast(const _z_sys_net_socket_t sock, const uint8_t *ptr,
 #endif
 
 #if Z_FEATURE_LINK_SERIAL == 1
-#error "Serial not supported yet on Unix port of Zenoh-Pico"
+// Each frame is the COBS encoding of the payload length (2 bytes, little endian), the payload and its CRC32
+// (4 bytes, little endian), followed by a 0x00 delimiter. The buffers are allocated once per link, so that neither
+// reading nor sending a frame allocates.
+struct _z_serial_frames_t {
+    size_t _rx_start;  // Bytes received but not consumed yet, possibly the beginning of the next frames
+    size_t _rx_end;
+    uint8_t _rx[_Z_SERIAL_MAX_COBS_BUF_SIZE];
+    uint8_t _tx[_Z_SERIAL_MAX_COBS_BUF_SIZE];
+};
+
+static int8_t __z_serial_speed(uint32_t baudrate, speed_t *speed) {
+    int8_t ret = _Z_RES_OK;
+    switch (baudrate) {
+        case 9600: {
+            *speed = B9600;
+        } break;
+        case 19200: {
+            *speed = B19200;
+        } break;
+        case 38400: {
+            *speed = B38400;
+        } break;
+        case 57600: {
+            *speed = B57600;
+        } break;
+        case 115200: {
+            *speed = B115200;
+        } break;
+        case 230400: {
+            *speed = B230400;
+        } break;
+#if defined(B460800)
+        case 460800: {
+            *speed = B460800;
+        } break;
+#endif
+#if defined(B921600)
+        case 921600: {
+            *speed = B921600;
+        } break;
+#endif
+#if defined(B1000000)
+        case 1000000: {
+            *speed = B1000000;
+        } break;
+#endif
+#if defined(B2000000)
+        case 2000000: {
+            *speed = B2000000;
+        } break;
+#endif
+#if defined(B4000000)
+        case 4000000: {
+            *speed = B4000000;
+        } break;
+#endif
+        default: {
+            _Z_DEBUG("Unsupported serial baudrate: %u", baudrate);
+            ret = _Z_ERR_CONFIG_LOCATOR_INVALID;
+        } break;
+    }
+    return ret;
+}
+
+static int8_t __z_open_serial(_z_sys_net_socket_t *sock, const char *dev, uint32_t baudrate) {
+    speed_t speed = B0;
+    int8_t ret = __z_serial_speed(baudrate, &speed);
+
+    sock->_fd = -1;
+    sock->_serial = NULL;
+    if (ret == _Z_RES_OK) {
+        sock->_fd = open(dev, O_RDWR | O_NOCTTY);
+        if (sock->_fd == -1) {
+            ret = _Z_ERR_GENERIC;
+        }
+    }
+    if (ret == _Z_RES_OK) {
+        // Raw 8N1, blocking until at least one byte is available
+        struct termios tio;
+        if (tcgetattr(sock->_fd, &tio) == 0) {
+            cfmakeraw(&tio);
+            tio.c_cflag |= (tcflag_t)(CLOCAL | CREAD);
+            tio.c_cflag &= ~(tcflag_t)CSTOPB;
+            tio.c_cc[VMIN] = 1;
+            tio.c_cc[VTIME] = 0;
+            if ((cfsetispeed(&tio, speed) != 0) || (cfsetospeed(&tio, speed) != 0) ||
+                (tcsetattr(sock->_fd, TCSANOW, &tio) != 0)) {
+                ret = _Z_ERR_GENERIC;
+            }
+        } else {
+            ret = _Z_ERR_GENERIC;
+        }
+        (void)tcflush(sock->_fd, TCIOFLUSH);
+    }
+    if (ret == _Z_RES_OK) {
+        sock->_serial = (struct _z_serial_frames_t *)zp_malloc(sizeof(struct _z_serial_frames_t));
+        if (sock->_serial != NULL) {
+            sock->_serial->_rx_start = 0;
+            sock->_serial->_rx_end = 0;
+        } else {
+            ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+        }
+    }
+    if ((ret != _Z_RES_OK) && (sock->_fd != -1)) {
+        close(sock->_fd);
+        sock->_fd = -1;
+    }
+
+    return ret;
+}
+
+int8_t _z_open_serial_from_pins(_z_sys_net_socket_t *sock, uint32_t txpin, uint32_t rxpin, uint32_t baudrate) {
+    (void)(sock);
+    (void)(txpin);
+    (void)(rxpin);
+    (void)(baudrate);
+
+    // Serial devices are only addressed by their path on Unix
+    return _Z_ERR_CONFIG_LOCATOR_INVALID;
+}
+
+int8_t _z_open_serial_from_dev(_z_sys_net_socket_t *sock, char *dev, uint32_t baudrate) {
+    return __z_open_serial(sock, dev, baudrate);
+}
+
+int8_t _z_listen_serial_from_pins(_z_sys_net_socket_t *sock, uint32_t txpin, uint32_t rxpin, uint32_t baudrate) {
+    return _z_open_serial_from_pins(sock, txpin, rxpin, baudrate);
+}
+
+int8_t _z_listen_serial_from_dev(_z_sys_net_socket_t *sock, char *dev, uint32_t baudrate) {
+    // A serial line is point to point, listening on it is the same as opening it
+    return __z_open_serial(sock, dev, baudrate);
+}
+
+void _z_close_serial(_z_sys_net_socket_t *sock) {
+    close(sock->_fd);
+    zp_free(sock->_serial);
+    sock->_serial = NULL;
+}
+
+// Returns the length of the next frame in the receive buffer, its delimiter included, reading more bytes as needed
+static size_t __z_serial_next_frame(const _z_sys_net_socket_t sock) {
+    struct _z_serial_frames_t *f = sock._serial;
+    size_t scanned = 0;
+    size_t frame_len = SIZE_MAX;
+    while (frame_len == SIZE_MAX) {
+        uint8_t *pending = &f->_rx[f->_rx_start];
+        uint8_t *eop = (uint8_t *)memchr(&pending[scanned], 0x00, (f->_rx_end - f->_rx_start) - scanned);
+        if (eop != NULL) {
+            frame_len = _z_ptr_u8_diff(eop, pending) + (size_t)1;
+            break;
+        }
+        scanned = f->_rx_end - f->_rx_start;
+
+        if (f->_rx_end == sizeof(f->_rx)) {
+            if (f->_rx_start == (size_t)0) {
+                // No delimiter in a whole buffer: drop it, the frame it belongs to fails its CRC check later on
+                _Z_DEBUG("Serial frame exceeds %zu bytes, dropped", sizeof(f->_rx));
+                scanned = 0;
+                f->_rx_end = 0;
+            } else {
+                (void)memmove(f->_rx, pending, scanned);
+                f->_rx_start = 0;
+                f->_rx_end = scanned;
+            }
+        }
+
+        ssize_t rb = read(sock._fd, &f->_rx[f->_rx_end], sizeof(f->_rx) - f->_rx_end);
+        if (rb > (ssize_t)0) {
+            f->_rx_end = f->_rx_end + (size_t)rb;
+        } else if ((rb < (ssize_t)0) && (errno == EINTR)) {
+            // Do nothing. Required to be compliant with MISRA 15.7 rule
+        } else {
+            break;
+        }
+    }
+    return frame_len;
+}
+
+size_t _z_read_serial(const _z_sys_net_socket_t sock, uint8_t *ptr, size_t len) {
+    struct _z_serial_frames_t *f = sock._serial;
+    size_t rb = SIZE_MAX;
+
+    size_t frame_len = 1;
+    while (frame_len == (size_t)1) {  // Skip empty frames, a peer may send a delimiter alone to resynchronise
+        frame_len = __z_serial_next_frame(sock);
+        if (frame_len == (size_t)1) {
+            f->_rx_start = f->_rx_start + (size_t)1;
+        }
+    }
+    if (frame_len != SIZE_MAX) {
+        // COBS never decodes to more bytes than it reads, the frame is decoded in place
+        uint8_t *frame = &f->_rx[f->_rx_start];
+        size_t trb = _z_cobs_decode(frame, frame_len, frame);
+        f->_rx_start = f->_rx_start + frame_len;
+        if (f->_rx_start == f->_rx_end) {
+            f->_rx_start = 0;
+            f->_rx_end = 0;
+        }
+
+        if (trb >= (size_t)6) {
+            size_t payload_len = (size_t)frame[0] | ((size_t)frame[1] << 8);
+            if ((trb == (payload_len + (size_t)6)) && (payload_len <= len)) {
+                const uint8_t *tail = &frame[2 + payload_len];
+                uint32_t crc = (uint32_t)tail[0] | ((uint32_t)tail[1] << 8) | ((uint32_t)tail[2] << 16) |
+                               ((uint32_t)tail[3] << 24);
+                if (_z_crc32(&frame[2], payload_len) == crc) {
+                    (void)memcpy(ptr, &frame[2], payload_len);
+                    rb = payload_len;
+                }
+            }
+        }
+        if (rb == SIZE_MAX) {
+            _Z_DEBUG("Dropping an invalid serial frame of %zu bytes", trb);
+        }
+    }
+
+    return rb;
+}
+
+size_t _z_read_exact_serial(const _z_sys_net_socket_t sock, uint8_t *ptr, size_t len) {
+    size_t n = 0;
+    uint8_t *pos = &ptr[0];
+
+    do {
+        size_t rb = _z_read_serial(sock, pos, len - n);
+        if (rb == SIZE_MAX) {
+            n = rb;
+            break;
+        }
+
+        n = n + rb;
+        pos = _z_ptr_u8_offset(pos, (ptrdiff_t)rb);
+    } while (n != len);
+
+    return n;
+}
+
+size_t _z_send_serial(const _z_sys_net_socket_t sock, const uint8_t *ptr, size_t len) {
+    size_t sb = SIZE_MAX;
+    if (len <= (size_t)_Z_SERIAL_MTU_SIZE) {
+        uint8_t header[2] = {(uint8_t)(len & (size_t)0xFF), (uint8_t)(len >> 8)};
+        uint32_t crc = _z_crc32(ptr, len);
+        uint8_t trailer[4] = {(uint8_t)crc, (uint8_t)(crc >> 8), (uint8_t)(crc >> 16), (uint8_t)(crc >> 24)};
+
+        // The frame is encoded from its pieces, the payload is never copied into an intermediate buffer
+        _z_cobs_encoder_t enc;
+        _z_cobs_encoder_init(&enc, sock._serial->_tx);
+        _z_cobs_encoder_update(&enc, header, sizeof(header));
+        _z_cobs_encoder_update(&enc, ptr, len);
+        _z_cobs_encoder_update(&enc, trailer, sizeof(trailer));
+        size_t twb = _z_cobs_encoder_finish(&enc);
+        sock._serial->_tx[twb] = 0x00;
+        twb = twb + (size_t)1;
+
+        size_t wb = 0;
+        while (wb < twb) {
+            ssize_t n = write(sock._fd, &sock._serial->_tx[wb], twb - wb);
+            if (n >= (ssize_t)0) {
+                wb = wb + (size_t)n;
+            } else if (errno != EINTR) {
+                break;
+            } else {
+                // Do nothing. Required to be compliant with MISRA 15.7 rule
+            }
+        }
+        if (wb == twb) {
+            sb = len;
+        }
+    }
+
+    return sb;
+}
 #endif
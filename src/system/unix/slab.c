@@ -0,0 +1,266 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/system/platform.h"
+
+#if Z_FEATURE_SLAB_ALLOCATOR == 1
+#if Z_SLAB_MAGAZINE_SIZE < 2
+#error "Z_SLAB_MAGAZINE_SIZE must be at least 2"
+#endif
+#if Z_SLAB_CHUNK_SIZE < 4096
+#error "Z_SLAB_CHUNK_SIZE must be at least 4096"
+#endif
+
+#if Z_FEATURE_MULTI_THREAD == 1
+#include <pthread.h>
+
+#define __Z_SLAB_THREAD_LOCAL __thread
+#define __z_slab_lock(m) (void)pthread_mutex_lock(m)
+#define __z_slab_unlock(m) (void)pthread_mutex_unlock(m)
+#define __z_slab_count(c) (void)__atomic_fetch_add(&(c), 1, __ATOMIC_RELAXED)
+#define __z_slab_read(c) __atomic_load_n(&(c), __ATOMIC_RELAXED)
+#else
+#define __Z_SLAB_THREAD_LOCAL
+#define __z_slab_lock(m)
+#define __z_slab_unlock(m)
+#define __z_slab_count(c) ((c) += (size_t)1)
+#define __z_slab_read(c) (c)
+#endif
+
+// Block sizes of the size classes, spaced so that a block wastes at most a third of its size
+static const size_t __z_slab_sizes[] = {16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024};
+#define __Z_SLAB_CLASSES (sizeof(__z_slab_sizes) / sizeof(__z_slab_sizes[0]))
+// Size class of the blocks allocated from the system allocator
+#define __Z_SLAB_LARGE __Z_SLAB_CLASSES
+
+// Precedes each block with its size class, keeping the block aligned as by malloc
+typedef union {
+    size_t _class;
+    void *_ptr;
+    long double _ld;
+    uint64_t _u64;
+} __z_slab_header_t;
+
+// The shared pool of a size class, with its free blocks linked through their first bytes
+typedef struct {
+    void *_free;
+    void *_chunks;
+#if Z_FEATURE_MULTI_THREAD == 1
+    pthread_mutex_t _mutex;
+#endif
+} __z_slab_depot_t;
+
+// The free blocks of a size class cached by a thread
+typedef struct {
+    void *_blocks[Z_SLAB_MAGAZINE_SIZE];
+    size_t _len;
+} __z_slab_magazine_t;
+
+static __z_slab_depot_t __z_slab_depots[__Z_SLAB_CLASSES];
+static __Z_SLAB_THREAD_LOCAL __z_slab_magazine_t __z_slab_magazines[__Z_SLAB_CLASSES];
+static zp_malloc_stats_t __z_slab_stats = {0};
+
+static inline __z_slab_header_t *__z_slab_header(void *ptr) { return ((__z_slab_header_t *)ptr) - 1; }
+
+static inline size_t __z_slab_class(size_t size) {
+    size_t c = 0;
+    while ((c < __Z_SLAB_CLASSES) && (__z_slab_sizes[c] < size)) {
+        c = c + (size_t)1;
+    }
+    return c;
+}
+
+static inline void *__z_slab_next(void *block) { return *(void **)block; }
+
+static inline void __z_slab_set_next(void *block, void *next) { *(void **)block = next; }
+
+/*------------------ Thread caches ------------------*/
+// Gives len blocks of the cache back to the shared pool
+static void __z_slab_flush(__z_slab_magazine_t *mag, size_t c, size_t len) {
+    __z_slab_depot_t *depot = &__z_slab_depots[c];
+    __z_slab_lock(&depot->_mutex);
+    for (size_t i = 0; i < len; i++) {
+        mag->_len = mag->_len - (size_t)1;
+        void *block = mag->_blocks[mag->_len];
+        __z_slab_set_next(block, depot->_free);
+        depot->_free = block;
+    }
+    __z_slab_unlock(&depot->_mutex);
+    __z_slab_count(__z_slab_stats.flushes);
+}
+
+#if Z_FEATURE_MULTI_THREAD == 1
+static pthread_key_t __z_slab_key;
+static pthread_once_t __z_slab_once = PTHREAD_ONCE_INIT;
+static __Z_SLAB_THREAD_LOCAL _Bool __z_slab_registered = false;
+
+// Gives the cached blocks of an exiting thread back to the shared pools
+static void __z_slab_thread_exit(void *arg) {
+    (void)(arg);
+    for (size_t c = 0; c < __Z_SLAB_CLASSES; c++) {
+        if (__z_slab_magazines[c]._len > (size_t)0) {
+            __z_slab_flush(&__z_slab_magazines[c], c, __z_slab_magazines[c]._len);
+        }
+    }
+}
+
+static void __z_slab_init(void) {
+    for (size_t c = 0; c < __Z_SLAB_CLASSES; c++) {
+        (void)pthread_mutex_init(&__z_slab_depots[c]._mutex, NULL);
+    }
+    (void)pthread_key_create(&__z_slab_key, __z_slab_thread_exit);
+}
+
+// Makes the thread give its cached blocks back when exiting, must be called before using the shared pools
+static void __z_slab_register(void) {
+    if (__z_slab_registered == false) {
+        __z_slab_registered = true;
+        (void)pthread_once(&__z_slab_once, __z_slab_init);
+        (void)pthread_setspecific(__z_slab_key, &__z_slab_registered);
+    }
+}
+#else
+static void __z_slab_register(void) {}
+#endif
+
+// Requests a chunk from the system allocator and carves it into free blocks, the depot must be locked
+static void __z_slab_carve(__z_slab_depot_t *depot, size_t c) {
+    uint8_t *chunk = (uint8_t *)malloc(Z_SLAB_CHUNK_SIZE);
+    __z_slab_count(__z_slab_stats.system_allocs);
+    if (chunk != NULL) {
+        __z_slab_count(__z_slab_stats.chunks);
+        // The chunks stay referenced, they are never given back
+        __z_slab_set_next(chunk, depot->_chunks);
+        depot->_chunks = chunk;
+
+        size_t stride = sizeof(__z_slab_header_t) + __z_slab_sizes[c];
+        size_t pos = sizeof(__z_slab_header_t);
+        while ((pos + stride) <= (size_t)Z_SLAB_CHUNK_SIZE) {
+            __z_slab_header_t *hdr = (__z_slab_header_t *)&chunk[pos];
+            hdr->_class = c;
+            void *block = hdr + 1;
+            __z_slab_set_next(block, depot->_free);
+            depot->_free = block;
+            pos = pos + stride;
+        }
+    }
+}
+
+// Takes half a cache of blocks from the shared pool, carving a new chunk if it is empty
+static _Bool __z_slab_refill(__z_slab_magazine_t *mag, size_t c) {
+    __z_slab_register();
+
+    __z_slab_depot_t *depot = &__z_slab_depots[c];
+    __z_slab_lock(&depot->_mutex);
+    if (depot->_free == NULL) {
+        __z_slab_carve(depot, c);
+    }
+    while ((mag->_len < ((size_t)Z_SLAB_MAGAZINE_SIZE / (size_t)2)) && (depot->_free != NULL)) {
+        void *block = depot->_free;
+        depot->_free = __z_slab_next(block);
+        mag->_blocks[mag->_len] = block;
+        mag->_len = mag->_len + (size_t)1;
+    }
+    __z_slab_unlock(&depot->_mutex);
+    __z_slab_count(__z_slab_stats.refills);
+
+    return mag->_len > (size_t)0;
+}
+
+/*------------------ Memory ------------------*/
+void *zp_malloc(size_t size) {
+    void *ptr = NULL;
+
+    size_t c = __z_slab_class(size);
+    if (c < __Z_SLAB_CLASSES) {
+        __z_slab_magazine_t *mag = &__z_slab_magazines[c];
+        if ((mag->_len > (size_t)0) || (__z_slab_refill(mag, c) == true)) {
+            mag->_len = mag->_len - (size_t)1;
+            ptr = mag->_blocks[mag->_len];
+        }
+    } else if (size <= (SIZE_MAX - sizeof(__z_slab_header_t))) {
+        __z_slab_header_t *hdr = (__z_slab_header_t *)malloc(sizeof(__z_slab_header_t) + size);
+        __z_slab_count(__z_slab_stats.system_allocs);
+        if (hdr != NULL) {
+            hdr->_class = __Z_SLAB_LARGE;
+            ptr = hdr + 1;
+        }
+    }
+
+    return ptr;
+}
+
+void *zp_realloc(void *ptr, size_t size) {
+    void *ret = NULL;
+
+    if (ptr == NULL) {
+        ret = zp_malloc(size);
+    } else {
+        __z_slab_header_t *hdr = __z_slab_header(ptr);
+        size_t c = hdr->_class;
+        if (c < __Z_SLAB_CLASSES) {
+            if (size <= __z_slab_sizes[c]) {
+                ret = ptr;
+            } else {
+                ret = zp_malloc(size);
+                if (ret != NULL) {
+                    (void)memcpy(ret, ptr, __z_slab_sizes[c]);
+                    zp_free(ptr);
+                }
+            }
+        } else if (size <= (SIZE_MAX - sizeof(__z_slab_header_t))) {
+            __z_slab_header_t *rhdr = (__z_slab_header_t *)realloc(hdr, sizeof(__z_slab_header_t) + size);
+            __z_slab_count(__z_slab_stats.system_allocs);
+            if (rhdr != NULL) {
+                ret = rhdr + 1;
+            }
+        }
+    }
+
+    return ret;
+}
+
+void zp_free(void *ptr) {
+    if (ptr != NULL) {
+        __z_slab_header_t *hdr = __z_slab_header(ptr);
+        size_t c = hdr->_class;
+        if (c < __Z_SLAB_CLASSES) {
+            __z_slab_register();
+            __z_slab_magazine_t *mag = &__z_slab_magazines[c];
+            if (mag->_len == (size_t)Z_SLAB_MAGAZINE_SIZE) {
+                __z_slab_flush(mag, c, (size_t)Z_SLAB_MAGAZINE_SIZE / (size_t)2);
+            }
+            mag->_blocks[mag->_len] = ptr;
+            mag->_len = mag->_len + (size_t)1;
+        } else {
+            free(hdr);
+            __z_slab_count(__z_slab_stats.system_frees);
+        }
+    }
+}
+
+void zp_malloc_stats_get(zp_malloc_stats_t *stats) {
+    stats->system_allocs = __z_slab_read(__z_slab_stats.system_allocs);
+    stats->system_frees = __z_slab_read(__z_slab_stats.system_frees);
+    stats->chunks = __z_slab_read(__z_slab_stats.chunks);
+    stats->refills = __z_slab_read(__z_slab_stats.refills);
+    stats->flushes = __z_slab_read(__z_slab_stats.flushes);
+}
+#endif
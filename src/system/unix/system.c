@@ -93,11 +93,13 @@ void zp_random_fill(void *buf, size_t len) {
 }
 
 /*------------------ Memory ------------------*/
+#if Z_FEATURE_SLAB_ALLOCATOR == 0
 void *zp_malloc(size_t size) { return malloc(size); }
 
 void *zp_realloc(void *ptr, size_t size) { return realloc(ptr, size); }
 
 void zp_free(void *ptr) { free(ptr); }
+#endif
 
 #if Z_FEATURE_MULTI_THREAD == 1
 /*------------------ Task ------------------*/
@@ -115,6 +117,8 @@ void zp_task_free(zp_task_t **task) {
     *task = NULL;
 }
 
+_Bool zp_task_is_current(const zp_task_t *task) { return pthread_equal(*task, pthread_self()) != 0; }
+
 /*------------------ Mutex ------------------*/
 int8_t zp_mutex_init(zp_mutex_t *m) { return pthread_mutex_init(m, 0); }
 
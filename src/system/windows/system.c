@@ -89,6 +89,8 @@ void zp_task_free(zp_task_t **task) {
     *task = NULL;
 }
 
+_Bool zp_task_is_current(const zp_task_t *task) { return GetThreadId((HANDLE)*task) == GetCurrentThreadId(); }
+
 /*------------------ Mutex ------------------*/
 int8_t zp_mutex_init(zp_mutex_t *m) {
     int8_t ret = _Z_RES_OK;
@@ -0,0 +1,170 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/transport/common/defrag.h"
+
+#include <string.h>
+
+#include "zenoh-pico/protocol/codec/network.h"
+#include "zenoh-pico/utils/result.h"
+
+#if Z_FEATURE_FRAGMENTATION == 1
+static _z_zbuf_t __z_defrag_zbuf_empty(void) {
+    _z_zbuf_t zbf;
+    zbf._ios = _z_iosli_wrap(NULL, 0, 0, 0);
+    return zbf;
+}
+
+/*------------------ Defragmentation pool ------------------*/
+int8_t _z_defrag_pool_init(_z_defrag_pool_t *pool, size_t prealloc) {
+    int8_t ret = _Z_RES_OK;
+
+    pool->_len = 0;
+    while ((pool->_len < prealloc) && (pool->_len < (size_t)Z_DEFRAG_POOL_SIZE)) {
+        _z_zbuf_t zbf = _z_zbuf_make(Z_FRAG_MAX_SIZE);
+        if (_z_zbuf_capacity(&zbf) != Z_FRAG_MAX_SIZE) {
+            ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+            break;
+        }
+        pool->_bufs[pool->_len] = zbf;
+        pool->_len = pool->_len + (size_t)1;
+    }
+
+    if (ret != _Z_RES_OK) {
+        _z_defrag_pool_clear(pool);
+    }
+    return ret;
+}
+
+void _z_defrag_pool_clear(_z_defrag_pool_t *pool) {
+    for (size_t i = 0; i < pool->_len; i++) {
+        _z_zbuf_clear(&pool->_bufs[i]);
+    }
+    pool->_len = 0;
+}
+
+/*------------------ Defragmentation buffer ------------------*/
+void _z_defrag_init(_z_defrag_t *dbuf) {
+    dbuf->_zbuf = __z_defrag_zbuf_empty();
+    dbuf->_drop = false;
+}
+
+size_t _z_defrag_len(const _z_defrag_t *dbuf) { return _z_zbuf_len(&dbuf->_zbuf); }
+
+static void __z_defrag_give_back(_z_defrag_t *dbuf, _z_defrag_pool_t *pool) {
+    if (_z_zbuf_capacity(&dbuf->_zbuf) > (size_t)0) {
+        _z_zbuf_reset(&dbuf->_zbuf);
+        if (pool->_len < (size_t)Z_DEFRAG_POOL_SIZE) {
+            pool->_bufs[pool->_len] = dbuf->_zbuf;
+            pool->_len = pool->_len + (size_t)1;
+        } else {
+            _z_zbuf_clear(&dbuf->_zbuf);
+        }
+        dbuf->_zbuf = __z_defrag_zbuf_empty();
+    }
+}
+
+// Makes room for len bytes, borrowing a buffer from the pool or growing the current one
+static int8_t __z_defrag_reserve(_z_defrag_t *dbuf, _z_defrag_pool_t *pool, size_t len) {
+    int8_t ret = _Z_RES_OK;
+
+    if ((_z_zbuf_capacity(&dbuf->_zbuf) == (size_t)0) && (pool->_len > (size_t)0)) {
+        pool->_len = pool->_len - (size_t)1;
+        dbuf->_zbuf = pool->_bufs[pool->_len];
+    }
+
+    size_t capacity = _z_zbuf_capacity(&dbuf->_zbuf);
+    if (capacity < len) {
+#if Z_FEATURE_DYNAMIC_MEMORY_ALLOCATION == 1
+        // Doubling the capacity bounds the reallocations to a few per message, and to none once the buffer is pooled
+        if (capacity == (size_t)0) {
+            capacity = len;
+        }
+        while (capacity < len) {
+            capacity = capacity * (size_t)2;
+        }
+        if (capacity > (size_t)Z_FRAG_MAX_SIZE) {
+            capacity = Z_FRAG_MAX_SIZE;
+        }
+#else
+        capacity = Z_FRAG_MAX_SIZE;
+#endif
+        _z_zbuf_t zbf = _z_zbuf_make(capacity);
+        if (_z_zbuf_capacity(&zbf) == capacity) {
+            size_t w_pos = _z_zbuf_get_wpos(&dbuf->_zbuf);
+            if (w_pos > (size_t)0) {
+                (void)memcpy(_z_zbuf_get_wptr(&zbf), _z_zbuf_start(&dbuf->_zbuf), w_pos);
+            }
+            _z_zbuf_set_wpos(&zbf, w_pos);
+            _z_zbuf_clear(&dbuf->_zbuf);
+            dbuf->_zbuf = zbf;
+        } else {
+            ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+        }
+    }
+
+    return ret;
+}
+
+int8_t _z_defrag_push(_z_defrag_t *dbuf, _z_defrag_pool_t *pool, const _z_bytes_t *fragment) {
+    int8_t ret = _Z_RES_OK;
+
+    if (dbuf->_drop == false) {
+        size_t len = _z_zbuf_get_wpos(&dbuf->_zbuf) + fragment->len;
+        if (len > (size_t)Z_FRAG_MAX_SIZE) {
+            ret = _Z_ERR_TRANSPORT_NO_SPACE;
+        } else {
+            ret = __z_defrag_reserve(dbuf, pool, len);
+        }
+
+        if (ret == _Z_RES_OK) {
+            if (fragment->len > (size_t)0) {
+                (void)memcpy(_z_zbuf_get_wptr(&dbuf->_zbuf), fragment->start, fragment->len);
+                _z_zbuf_set_wpos(&dbuf->_zbuf, len);
+            }
+        } else {
+            // Drop the fragments until the last one of the message, and give the buffer back in the meantime
+            dbuf->_drop = true;
+            __z_defrag_give_back(dbuf, pool);
+        }
+    } else {
+        ret = _Z_ERR_TRANSPORT_NO_SPACE;
+    }
+
+    return ret;
+}
+
+/**
+ * Decodes the reassembled network message in place. The message borrows the buffer, and must be cleared before the
+ * buffer is released.
+ */
+int8_t _z_defrag_decode(_z_defrag_t *dbuf, _z_network_message_t *n_msg) {
+    return _z_network_message_decode(n_msg, &dbuf->_zbuf);
+}
+
+void _z_defrag_release(_z_defrag_t *dbuf, _z_defrag_pool_t *pool) {
+    __z_defrag_give_back(dbuf, pool);
+    dbuf->_drop = false;
+}
+
+void _z_defrag_copy(_z_defrag_t *dst, const _z_defrag_t *src) {
+    _z_iosli_copy(&dst->_zbuf._ios, &src->_zbuf._ios);
+    dst->_drop = src->_drop;
+}
+
+void _z_defrag_clear(_z_defrag_t *dbuf) {
+    _z_zbuf_clear(&dbuf->_zbuf);
+    _z_defrag_init(dbuf);
+}
+#endif
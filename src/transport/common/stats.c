@@ -0,0 +1,36 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/transport/common/stats.h"
+
+#include <string.h>
+
+void _z_stats_init(_z_stats_t *stats) { (void)memset(stats, 0, sizeof(_z_stats_t)); }
+
+void _z_stats_snapshot(_z_stats_t *dst, const _z_stats_t *src) {
+    dst->tx_bytes = _Z_STATS_LOAD(*src, tx_bytes);
+    dst->tx_batches = _Z_STATS_LOAD(*src, tx_batches);
+    dst->tx_n_msgs = _Z_STATS_LOAD(*src, tx_n_msgs);
+    dst->tx_fragments = _Z_STATS_LOAD(*src, tx_fragments);
+    dst->tx_keep_alives = _Z_STATS_LOAD(*src, tx_keep_alives);
+    dst->tx_cc_drops = _Z_STATS_LOAD(*src, tx_cc_drops);
+    dst->rx_bytes = _Z_STATS_LOAD(*src, rx_bytes);
+    dst->rx_batches = _Z_STATS_LOAD(*src, rx_batches);
+    dst->rx_n_msgs = _Z_STATS_LOAD(*src, rx_n_msgs);
+    dst->rx_fragments = _Z_STATS_LOAD(*src, rx_fragments);
+    dst->rx_keep_alives = _Z_STATS_LOAD(*src, rx_keep_alives);
+    dst->rx_sn_drops = _Z_STATS_LOAD(*src, rx_sn_drops);
+    dst->rx_decode_errors = _Z_STATS_LOAD(*src, rx_decode_errors);
+    dst->rx_reassembly_aborts = _Z_STATS_LOAD(*src, rx_reassembly_aborts);
+}
@@ -88,6 +88,23 @@ int8_t _z_send_t_msg(_z_transport_t *zt, const _z_transport_message_t *t_msg) {
     return ret;
 }
 
+int8_t _z_flush(_z_transport_t *zt) {
+    int8_t ret = _Z_RES_OK;
+    // Only unicast transports batch network messages, the others have nothing pending
+    switch (zt->_type) {
+        case _Z_TRANSPORT_UNICAST_TYPE:
+            ret = _z_unicast_flush(&zt->_transport._unicast);
+            break;
+        case _Z_TRANSPORT_MULTICAST_TYPE:
+        case _Z_TRANSPORT_RAWETH_TYPE:
+            break;
+        default:
+            ret = _Z_ERR_TRANSPORT_NOT_AVAILABLE;
+            break;
+    }
+    return ret;
+}
+
 int8_t _z_link_send_t_msg(const _z_link_t *zl, const _z_transport_message_t *t_msg) {
     int8_t ret = _Z_RES_OK;
 
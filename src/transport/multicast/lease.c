@@ -17,6 +17,7 @@
 #include <stddef.h>
 
 #include "zenoh-pico/config.h"
+#include "zenoh-pico/session/query.h"
 #include "zenoh-pico/session/utils.h"
 #include "zenoh-pico/transport/common/lease.h"
 #include "zenoh-pico/utils/logging.h"
@@ -99,6 +100,11 @@ void *_zp_multicast_lease_task(void *ztm_arg) {
 
     _z_transport_peer_entry_list_t *it = NULL;
     while (ztm->_lease_task_running == true) {
+#if Z_FEATURE_QUERY == 1
+        // Complete the queries that timed out
+        _Bool queries_pending = _z_expire_pending_queries((_z_session_t *)ztm->_session);
+#endif
+
         zp_mutex_lock(&ztm->_mutex_peer);
 
         if (next_lease <= 0) {
@@ -157,6 +163,12 @@ void *_zp_multicast_lease_task(void *ztm_arg) {
                 interval = next_join;
             }
         }
+#if Z_FEATURE_QUERY == 1
+        // Wake up on every tick of the query timeouts while some are pending
+        if ((queries_pending == true) && (interval > (_z_zint_t)Z_QUERY_TIMEOUT_TICK_MS)) {
+            interval = (_z_zint_t)Z_QUERY_TIMEOUT_TICK_MS;
+        }
+#endif
 
         zp_mutex_unlock(&ztm->_mutex_peer);
 
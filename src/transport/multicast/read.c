@@ -21,6 +21,7 @@
 #include "zenoh-pico/protocol/iobuf.h"
 #include "zenoh-pico/transport/multicast/rx.h"
 #include "zenoh-pico/transport/unicast/rx.h"
+#include "zenoh-pico/transport/utils.h"
 #include "zenoh-pico/utils/logging.h"
 
 #if Z_FEATURE_MULTICAST_TRANSPORT == 1
@@ -47,6 +48,50 @@ int8_t _zp_multicast_read(_z_transport_multicast_t *ztm) {
 
 #if Z_FEATURE_MULTI_THREAD == 1 && Z_FEATURE_MULTICAST_TRANSPORT == 1
 
+/**
+ * Receives several datagrams with a single system call and handles their messages before issuing the next one.
+ *
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - ztm->_mutex_rx
+ */
+static void __unsafe_z_multicast_read_slots(_z_transport_multicast_t *ztm) {
+    for (size_t i = 0; i < ztm->_slots_len; i++) {
+        _z_zbuf_reset(&ztm->_rx_slots[i]);
+        ztm->_rx_slot_addrs[i] = _z_bytes_empty();
+    }
+
+    size_t count = _z_link_recv_multi_zbuf(&ztm->_link, ztm->_rx_slots, ztm->_slots_len, ztm->_rx_slot_addrs);
+    if (count != SIZE_MAX) {
+        for (size_t i = 0; (i < count) && (ztm->_read_task_running == true); i++) {
+            _z_zbuf_t *zbuf = &ztm->_rx_slots[i];
+            _Z_STATS_INC(ztm->_stats, rx_batches);
+            _Z_STATS_ADD(ztm->_stats, rx_bytes, _z_zbuf_len(zbuf));
+            while ((_z_zbuf_len(zbuf) > 0) && (ztm->_read_task_running == true)) {
+                // Decode one session message
+                _z_transport_message_t t_msg;
+                int8_t ret = _z_transport_message_decode_stream(&t_msg, zbuf);
+                if (ret == _Z_RES_OK) {
+                    ret = _z_multicast_handle_transport_message(ztm, &t_msg, &ztm->_rx_slot_addrs[i]);
+                    if (ret == _Z_RES_OK) {
+                        _z_t_msg_clear(&t_msg);
+                    } else {
+                        ztm->_read_task_running = false;
+                    }
+                } else {
+                    _Z_ERROR("Connection closed due to malformed message");
+                    _Z_STATS_INC(ztm->_stats, rx_decode_errors);
+                    ztm->_read_task_running = false;
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < ztm->_slots_len; i++) {
+        _z_bytes_clear(&ztm->_rx_slot_addrs[i]);
+    }
+}
+
 void *_zp_multicast_read_task(void *ztm_arg) {
     _z_transport_multicast_t *ztm = (_z_transport_multicast_t *)ztm_arg;
 
@@ -86,6 +131,10 @@ void *_zp_multicast_read_task(void *ztm_arg) {
                 }
                 break;
             case Z_LINK_CAP_FLOW_DATAGRAM:
+                if (ztm->_rx_slots != NULL) {
+                    __unsafe_z_multicast_read_slots(ztm);
+                    continue;
+                }
                 _z_zbuf_compact(&ztm->_zbuf);
                 to_read = _z_link_recv_zbuf(&ztm->_link, &ztm->_zbuf, &addr);
                 if (to_read == SIZE_MAX) {
@@ -97,13 +146,15 @@ void *_zp_multicast_read_task(void *ztm_arg) {
         }
         // Wrap the main buffer for to_read bytes
         _z_zbuf_t zbuf = _z_zbuf_view(&ztm->_zbuf, to_read);
+        _Z_STATS_INC(ztm->_stats, rx_batches);
+        _Z_STATS_ADD(ztm->_stats, rx_bytes, _z_batch_wire_len(&ztm->_link, to_read));
 
         while (_z_zbuf_len(&zbuf) > 0) {
             int8_t ret = _Z_RES_OK;
 
             // Decode one session message
             _z_transport_message_t t_msg;
-            ret = _z_transport_message_decode(&t_msg, &zbuf);
+            ret = _z_transport_message_decode_stream(&t_msg, &zbuf);
             if (ret == _Z_RES_OK) {
                 ret = _z_multicast_handle_transport_message(ztm, &t_msg, &addr);
 
@@ -116,6 +167,7 @@ void *_zp_multicast_read_task(void *ztm_arg) {
                 }
             } else {
                 _Z_ERROR("Connection closed due to malformed message");
+                _Z_STATS_INC(ztm->_stats, rx_decode_errors);
                 ztm->_read_task_running = false;
                 continue;
             }
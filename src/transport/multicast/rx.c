@@ -77,8 +77,14 @@ static int8_t _z_multicast_recv_t_msg_na(_z_transport_multicast_t *ztm, _z_trans
     } while (false);  // The 1-iteration loop to use continue to break the entire loop on error
 
     if (ret == _Z_RES_OK) {
+        _Z_STATS_INC(ztm->_stats, rx_batches);
+        _Z_STATS_ADD(ztm->_stats, rx_bytes, _z_batch_wire_len(&ztm->_link, to_read));
+
         _Z_DEBUG(">> \t transport_message_decode: %ju", (uintmax_t)_z_zbuf_len(&ztm->_zbuf));
-        ret = _z_transport_message_decode(t_msg, &ztm->_zbuf);
+        ret = _z_transport_message_decode_stream(t_msg, &ztm->_zbuf);
+        if (ret != _Z_RES_OK) {
+            _Z_STATS_INC(ztm->_stats, rx_decode_errors);
+        }
     }
 
 #if Z_FEATURE_MULTI_THREAD == 1
@@ -120,6 +126,16 @@ static _z_transport_peer_entry_t *_z_find_peer_entry(_z_transport_peer_entry_lis
     return ret;
 }
 
+#if Z_FEATURE_FRAGMENTATION == 1
+// Gives up the message being reassembled from a peer, if any, and its defragmentation buffer
+static void __z_multicast_abort_reassembly(_z_transport_multicast_t *ztm, _z_defrag_t *dbuf) {
+    if (_z_defrag_len(dbuf) > (size_t)0) {
+        _Z_STATS_INC(ztm->_stats, rx_reassembly_aborts);
+    }
+    _z_defrag_release(dbuf, &ztm->_dbuf_pool);
+}
+#endif
+
 int8_t _z_multicast_handle_transport_message(_z_transport_multicast_t *ztm, _z_transport_message_t *t_msg,
                                              _z_bytes_t *addr) {
     int8_t ret = _Z_RES_OK;
@@ -133,45 +149,55 @@ int8_t _z_multicast_handle_transport_message(_z_transport_multicast_t *ztm, _z_t
     switch (_Z_MID(t_msg->_header)) {
         case _Z_MID_T_FRAME: {
             _Z_INFO("Received _Z_FRAME message");
+            _Bool drop = false;
             if (entry == NULL) {
-                break;
-            }
-            entry->_received = true;
+                drop = true;
+            } else {
+                entry->_received = true;
 
-            // Check if the SN is correct
-            if (_Z_HAS_FLAG(t_msg->_header, _Z_FLAG_T_FRAME_R) == true) {
-                // @TODO: amend once reliability is in place. For the time being only
-                //        monotonic SNs are ensured
-                if (_z_sn_precedes(entry->_sn_res, entry->_sn_rx_sns._val._plain._reliable, t_msg->_body._frame._sn) ==
-                    true) {
-                    entry->_sn_rx_sns._val._plain._reliable = t_msg->_body._frame._sn;
-                } else {
+                // Check if the SN is correct
+                if (_Z_HAS_FLAG(t_msg->_header, _Z_FLAG_T_FRAME_R) == true) {
+                    // @TODO: amend once reliability is in place. For the time being only
+                    //        monotonic SNs are ensured
+                    if (_z_sn_precedes(entry->_sn_res, entry->_sn_rx_sns._val._plain._reliable,
+                                       t_msg->_body._frame._sn) == true) {
+                        entry->_sn_rx_sns._val._plain._reliable = t_msg->_body._frame._sn;
+                    } else {
 #if Z_FEATURE_FRAGMENTATION == 1
-                    _z_wbuf_clear(&entry->_dbuf_reliable);
+                        __z_multicast_abort_reassembly(ztm, &entry->_dbuf_reliable);
 #endif
-                    _Z_INFO("Reliable message dropped because it is out of order");
-                    break;
-                }
-            } else {
-                if (_z_sn_precedes(entry->_sn_res, entry->_sn_rx_sns._val._plain._best_effort,
-                                   t_msg->_body._frame._sn) == true) {
-                    entry->_sn_rx_sns._val._plain._best_effort = t_msg->_body._frame._sn;
+                        _Z_INFO("Reliable message dropped because it is out of order");
+                        drop = true;
+                        _Z_STATS_INC(ztm->_stats, rx_sn_drops);
+                    }
                 } else {
+                    if (_z_sn_precedes(entry->_sn_res, entry->_sn_rx_sns._val._plain._best_effort,
+                                       t_msg->_body._frame._sn) == true) {
+                        entry->_sn_rx_sns._val._plain._best_effort = t_msg->_body._frame._sn;
+                    } else {
 #if Z_FEATURE_FRAGMENTATION == 1
-                    _z_wbuf_clear(&entry->_dbuf_best_effort);
+                        __z_multicast_abort_reassembly(ztm, &entry->_dbuf_best_effort);
 #endif
-                    _Z_INFO("Best effort message dropped because it is out of order");
-                    break;
+                        _Z_INFO("Best effort message dropped because it is out of order");
+                        drop = true;
+                        _Z_STATS_INC(ztm->_stats, rx_sn_drops);
+                    }
                 }
             }
 
-            // Handle all the zenoh message, one by one
-            uint16_t mapping = entry->_peer_id;
-            size_t len = _z_vec_len(&t_msg->_body._frame._messages);
-            for (size_t i = 0; i < len; i++) {
-                _z_network_message_t *zm = _z_network_message_vec_get(&t_msg->_body._frame._messages, i);
-                _z_msg_fix_mapping(zm, mapping);
-                _z_handle_network_message(ztm->_session, zm, mapping);
+            // Handle all the zenoh messages, one by one. They are decoded in place and must be consumed even if dropped
+            uint16_t mapping = (entry != NULL) ? entry->_peer_id : _Z_KEYEXPR_MAPPING_UNKNOWN_REMOTE;
+            _z_network_message_t zm;
+            while (_z_frame_next(&t_msg->_body._frame, &zm, &ret) == true) {
+                if (drop == false) {
+                    _Z_STATS_INC(ztm->_stats, rx_n_msgs);
+                    _z_msg_fix_mapping(&zm, mapping);
+                    _z_handle_network_message(ztm->_session, &zm, mapping);
+                }
+                _z_msg_clear(&zm);
+            }
+            if (ret != _Z_RES_OK) {
+                _Z_STATS_INC(ztm->_stats, rx_decode_errors);
             }
 
             break;
@@ -185,43 +211,36 @@ int8_t _z_multicast_handle_transport_message(_z_transport_multicast_t *ztm, _z_t
             }
             entry->_received = true;
 
-            _z_wbuf_t *dbuf = _Z_HAS_FLAG(t_msg->_header, _Z_FLAG_T_FRAGMENT_R)
-                                  ? &entry->_dbuf_reliable
-                                  : &entry->_dbuf_best_effort;  // Select the right defragmentation buffer
+            _z_defrag_t *dbuf = _Z_HAS_FLAG(t_msg->_header, _Z_FLAG_T_FRAGMENT_R)
+                                    ? &entry->_dbuf_reliable
+                                    : &entry->_dbuf_best_effort;  // Select the right defragmentation buffer
 
-            _Bool drop = false;
-            if ((_z_wbuf_len(dbuf) + t_msg->_body._fragment._payload.len) > Z_FRAG_MAX_SIZE) {
-                // Filling the wbuf capacity as a way to signaling the last fragment to reset the dbuf
-                // Otherwise, last (smaller) fragments can be understood as a complete message
-                _z_wbuf_write_bytes(dbuf, t_msg->_body._fragment._payload.start, 0, _z_wbuf_space_left(dbuf));
-                drop = true;
-            } else {
-                _z_wbuf_write_bytes(dbuf, t_msg->_body._fragment._payload.start, 0,
-                                    t_msg->_body._fragment._payload.len);
+            _Z_STATS_INC(ztm->_stats, rx_fragments);
+            _Bool dropping = dbuf->_drop;
+            (void)_z_defrag_push(dbuf, &ztm->_dbuf_pool, &t_msg->_body._fragment._payload);
+            if ((dropping == false) && (dbuf->_drop == true)) {
+                _Z_STATS_INC(ztm->_stats, rx_reassembly_aborts);
             }
 
             if (_Z_HAS_FLAG(t_msg->_header, _Z_FLAG_T_FRAGMENT_M) == false) {
-                if (drop == true) {  // Drop message if it exceeds the fragmentation size
-                    _z_wbuf_reset(dbuf);
-                    break;
-                }
-
-                _z_zbuf_t zbf = _z_wbuf_to_zbuf(dbuf);  // Convert the defragmentation buffer into a decoding buffer
-
-                _z_zenoh_message_t zm;
-                ret = _z_network_message_decode(&zm, &zbf);
-                if (ret == _Z_RES_OK) {
-                    uint16_t mapping = entry->_peer_id;
-                    _z_msg_fix_mapping(&zm, mapping);
-                    _z_handle_network_message(ztm->_session, &zm, mapping);
-                    _z_msg_clear(&zm);  // Clear must be explicitly called for fragmented zenoh messages. Non-fragmented
-                                        // zenoh messages are released when their transport message is released.
+                if (dbuf->_drop == false) {  // Drop the message if it exceeds the fragmentation size
+                    _z_zenoh_message_t zm;
+                    ret = _z_defrag_decode(dbuf, &zm);  // Decode in place from the defragmentation buffer
+                    if (ret == _Z_RES_OK) {
+                        _Z_STATS_INC(ztm->_stats, rx_n_msgs);
+                        uint16_t mapping = entry->_peer_id;
+                        _z_msg_fix_mapping(&zm, mapping);
+                        _z_handle_network_message(ztm->_session, &zm, mapping);
+                        // Clear must be explicitly called for fragmented zenoh messages. Non-fragmented zenoh
+                        // messages are released when their transport message is released.
+                        _z_msg_clear(&zm);
+                    } else {
+                        _Z_STATS_INC(ztm->_stats, rx_decode_errors);
+                    }
                 }
 
-                // Free the decoding buffer
-                _z_zbuf_clear(&zbf);
-                // Reset the defragmentation buffer
-                _z_wbuf_reset(dbuf);
+                // Give the defragmentation buffer back to the pool
+                _z_defrag_release(dbuf, &ztm->_dbuf_pool);
             }
 #else
             _Z_INFO("Fragment dropped because fragmentation feature is deactivated");
@@ -231,6 +250,7 @@ int8_t _z_multicast_handle_transport_message(_z_transport_multicast_t *ztm, _z_t
 
         case _Z_MID_T_KEEP_ALIVE: {
             _Z_INFO("Received _Z_KEEP_ALIVE message");
+            _Z_STATS_INC(ztm->_stats, rx_keep_alives);
             if (entry == NULL) {
                 break;
             }
@@ -276,18 +296,8 @@ int8_t _z_multicast_handle_transport_message(_z_transport_multicast_t *ztm, _z_t
                         _z_conduit_sn_list_decrement(entry->_sn_res, &entry->_sn_rx_sns);
 
 #if Z_FEATURE_FRAGMENTATION == 1
-#if Z_FEATURE_DYNAMIC_MEMORY_ALLOCATION == 1
-                        entry->_dbuf_reliable = _z_wbuf_make(0, true);
-                        entry->_dbuf_best_effort = _z_wbuf_make(0, true);
-#else
-                        entry->_dbuf_reliable = _z_wbuf_make(Z_FRAG_MAX_SIZE, false);
-                        entry->_dbuf_best_effort = _z_wbuf_make(Z_FRAG_MAX_SIZE, false);
-
-                        if ((_z_wbuf_capacity(&entry->_dbuf_reliable) != Z_FRAG_MAX_SIZE) ||
-                            (_z_wbuf_capacity(&entry->_dbuf_best_effort) != Z_FRAG_MAX_SIZE)) {
-                            _Z_ERROR("Not enough memory to allocate peer defragmentation buffers!");
-                        }
-#endif
+                        _z_defrag_init(&entry->_dbuf_reliable);
+                        _z_defrag_init(&entry->_dbuf_best_effort);
 #endif
                         // Update lease time (set as ms during)
                         entry->_lease = t_msg->_body._join._lease;
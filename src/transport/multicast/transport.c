@@ -31,6 +31,69 @@
 
 #if Z_FEATURE_MULTICAST_TRANSPORT == 1 || Z_FEATURE_RAWETH_TRANSPORT == 1
 
+static void __z_multicast_slots_clear(_z_transport_multicast_t *ztm) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    if (ztm->_rx_slots != NULL) {
+        for (size_t i = 0; i < ztm->_slots_len; i++) {
+            _z_zbuf_clear(&ztm->_rx_slots[i]);
+        }
+    }
+    zp_free(ztm->_rx_slots);
+    zp_free(ztm->_rx_slot_addrs);
+    ztm->_rx_slots = NULL;
+    ztm->_rx_slot_addrs = NULL;
+#endif  // Z_FEATURE_MULTI_THREAD == 1
+#if Z_FEATURE_FRAGMENTATION == 1
+    if (ztm->_tx_slots != NULL) {
+        for (size_t i = 0; i < ztm->_slots_len; i++) {
+            _z_wbuf_clear(&ztm->_tx_slots[i]);
+        }
+    }
+    zp_free(ztm->_tx_slots);
+    ztm->_tx_slots = NULL;
+#endif
+    ztm->_slots_len = 0;
+}
+
+// Allocates the datagram slots the link can use, the transport falls back to single datagrams on failure
+static void __z_multicast_slots_init(_z_transport_multicast_t *ztm, const _z_link_t *zl, size_t wbuf_size) {
+    _ZP_UNUSED(zl);
+    _ZP_UNUSED(wbuf_size);
+    size_t len = (Z_DATAGRAM_SLOTS < _Z_LINK_MULTI_DATAGRAM_MAX) ? Z_DATAGRAM_SLOTS : _Z_LINK_MULTI_DATAGRAM_MAX;
+    _Bool ok = true;
+
+#if Z_FEATURE_MULTI_THREAD == 1
+    ztm->_rx_slots = NULL;
+    ztm->_rx_slot_addrs = NULL;
+    if ((len > (size_t)1) && (zl->_read_multi_f != NULL)) {
+        ztm->_rx_slots = (_z_zbuf_t *)zp_malloc(len * sizeof(_z_zbuf_t));
+        ztm->_rx_slot_addrs = (_z_bytes_t *)zp_malloc(len * sizeof(_z_bytes_t));
+        ok = (ztm->_rx_slots != NULL) && (ztm->_rx_slot_addrs != NULL);
+        for (size_t i = 0; (i < len) && (ztm->_rx_slots != NULL); i++) {
+            ztm->_rx_slots[i] = _z_zbuf_make(Z_BATCH_MULTICAST_SIZE);
+            ok = ok && (_z_zbuf_capacity(&ztm->_rx_slots[i]) == Z_BATCH_MULTICAST_SIZE);
+        }
+    }
+#endif  // Z_FEATURE_MULTI_THREAD == 1
+#if Z_FEATURE_FRAGMENTATION == 1
+    ztm->_tx_slots = NULL;
+    if ((len > (size_t)1) && (zl->_write_multi_f != NULL)) {
+        ztm->_tx_slots = (_z_wbuf_t *)zp_malloc(len * sizeof(_z_wbuf_t));
+        ok = ok && (ztm->_tx_slots != NULL);
+        for (size_t i = 0; (i < len) && (ztm->_tx_slots != NULL); i++) {
+            ztm->_tx_slots[i] = _z_wbuf_make(wbuf_size, false);
+            ok = ok && (_z_wbuf_capacity(&ztm->_tx_slots[i]) == wbuf_size);
+        }
+    }
+#endif
+    ztm->_slots_len = len;
+
+    if (ok == false) {
+        _Z_INFO("Not enough memory to allocate transport datagram slots, reading one datagram at a time");
+        __z_multicast_slots_clear(ztm);
+    }
+}
+
 int8_t _z_multicast_transport_create(_z_transport_t *zt, _z_link_t *zl,
                                      _z_transport_multicast_establish_param_t *param) {
     int8_t ret = _Z_RES_OK;
@@ -72,6 +135,10 @@ int8_t _z_multicast_transport_create(_z_transport_t *zt, _z_link_t *zl,
         uint16_t mtu = (zl->_mtu < Z_BATCH_MULTICAST_SIZE) ? zl->_mtu : Z_BATCH_MULTICAST_SIZE;
         ztm->_wbuf = _z_wbuf_make(mtu, false);
         ztm->_zbuf = _z_zbuf_make(Z_BATCH_MULTICAST_SIZE);
+        if (zl->_write_vec_f != NULL) {
+            // Large payloads are gathered by the link from the user buffer
+            ztm->_wbuf._wrap_threshold = Z_TX_ZERO_COPY_MIN_SIZE;
+        }
 
         // Clean up the buffers if one of them failed to be allocated
         if ((_z_wbuf_capacity(&ztm->_wbuf) != mtu) || (_z_zbuf_capacity(&ztm->_zbuf) != Z_BATCH_MULTICAST_SIZE)) {
@@ -86,6 +153,8 @@ int8_t _z_multicast_transport_create(_z_transport_t *zt, _z_link_t *zl,
 
             _z_wbuf_clear(&ztm->_wbuf);
             _z_zbuf_clear(&ztm->_zbuf);
+        } else {
+            __z_multicast_slots_init(ztm, zl, mtu);
         }
     }
 
@@ -99,6 +168,10 @@ int8_t _z_multicast_transport_create(_z_transport_t *zt, _z_link_t *zl,
 
         // Initialize peer list
         ztm->_peers = _z_transport_peer_entry_list_new();
+#if Z_FEATURE_FRAGMENTATION == 1
+        // The defragmentation buffers are allocated when a peer starts sending a fragmented message
+        (void)_z_defrag_pool_init(&ztm->_dbuf_pool, 0);
+#endif
 
 #if Z_FEATURE_MULTI_THREAD == 1
         // Tasks
@@ -110,6 +183,10 @@ int8_t _z_multicast_transport_create(_z_transport_t *zt, _z_link_t *zl,
 
         ztm->_lease = Z_TRANSPORT_LEASE;
 
+#if Z_FEATURE_STATS == 1
+        _z_stats_init(&ztm->_stats);
+#endif
+
         // Notifiers
         ztm->_transmitted = false;
 
@@ -200,9 +277,13 @@ void _z_multicast_transport_clear(_z_transport_t *zt) {
     // Clean up the buffers
     _z_wbuf_clear(&ztm->_wbuf);
     _z_zbuf_clear(&ztm->_zbuf);
+    __z_multicast_slots_clear(ztm);
 
     // Clean up peer list
     _z_transport_peer_entry_list_free(&ztm->_peers);
+#if Z_FEATURE_FRAGMENTATION == 1
+    _z_defrag_pool_clear(&ztm->_dbuf_pool);
+#endif
     _z_link_clear(&ztm->_link);
 }
 
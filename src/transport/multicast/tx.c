@@ -61,6 +61,11 @@ int8_t _z_multicast_send_t_msg(_z_transport_multicast_t *ztm, const _z_transport
         ret = _z_link_send_wbuf(&ztm->_link, &ztm->_wbuf);
         if (ret == _Z_RES_OK) {
             ztm->_transmitted = true;  // Mark the session that we have transmitted data
+            _Z_STATS_INC(ztm->_stats, tx_batches);
+            _Z_STATS_ADD(ztm->_stats, tx_bytes, _z_wbuf_len(&ztm->_wbuf));
+            if (_Z_MID(t_msg->_header) == _Z_MID_T_KEEP_ALIVE) {
+                _Z_STATS_INC(ztm->_stats, tx_keep_alives);
+            }
         }
     }
 
@@ -91,6 +96,7 @@ int8_t _z_multicast_send_n_msg(_z_session_t *zn, const _z_network_message_t *n_m
             _Z_INFO("Dropping zenoh message because of congestion control");
             // We failed to acquire the lock, drop the message
             drop = true;
+            _Z_STATS_INC(ztm->_stats, tx_cc_drops);
         }
 #endif  // Z_FEATURE_MULTI_THREAD == 1
     }
@@ -106,12 +112,15 @@ int8_t _z_multicast_send_n_msg(_z_session_t *zn, const _z_network_message_t *n_m
         if (ret == _Z_RES_OK) {
             ret = _z_network_message_encode(&ztm->_wbuf, n_msg);  // Encode the network message
             if (ret == _Z_RES_OK) {
+                _Z_STATS_INC(ztm->_stats, tx_n_msgs);
                 // Write the message length in the reserved space if needed
                 __unsafe_z_finalize_wbuf(&ztm->_wbuf, ztm->_link._cap._flow);
 
                 ret = _z_link_send_wbuf(&ztm->_link, &ztm->_wbuf);  // Send the wbuf on the socket
                 if (ret == _Z_RES_OK) {
                     ztm->_transmitted = true;  // Mark the session that we have transmitted data
+                    _Z_STATS_INC(ztm->_stats, tx_batches);
+                    _Z_STATS_ADD(ztm->_stats, tx_bytes, _z_wbuf_len(&ztm->_wbuf));
                 }
             } else {
 #if Z_FEATURE_FRAGMENTATION == 1
@@ -121,26 +130,45 @@ int8_t _z_multicast_send_n_msg(_z_session_t *zn, const _z_network_message_t *n_m
 
                 ret = _z_network_message_encode(&fbf, n_msg);  // Encode the message on the expandable wbuf
                 if (ret == _Z_RES_OK) {
+                    _Z_STATS_INC(ztm->_stats, tx_n_msgs);
                     _Bool is_first = true;  // Fragment and send the message
+                    size_t queued = 0;      // Fragments serialized in the datagram slots and not sent yet
+                    size_t queued_bytes = 0;
                     while (_z_wbuf_len(&fbf) > 0) {
                         if (is_first == false) {  // Get the fragment sequence number
                             sn = __unsafe_z_multicast_get_sn(ztm, reliability);
                         }
                         is_first = false;
 
+                        // Serialize in the next datagram slot, if any, to send several fragments at once
+                        _z_wbuf_t *wbf = (ztm->_tx_slots != NULL) ? &ztm->_tx_slots[queued] : &ztm->_wbuf;
+
                         // Clear the buffer for serialization
-                        __unsafe_z_prepare_wbuf(&ztm->_wbuf, ztm->_link._cap._flow);
+                        __unsafe_z_prepare_wbuf(wbf, ztm->_link._cap._flow);
 
                         // Serialize one fragment
-                        ret = __unsafe_z_serialize_zenoh_fragment(&ztm->_wbuf, &fbf, reliability, sn);
+                        ret = __unsafe_z_serialize_zenoh_fragment(wbf, &fbf, reliability, sn);
                         if (ret == _Z_RES_OK) {
                             // Write the message length in the reserved space if needed
-                            __unsafe_z_finalize_wbuf(&ztm->_wbuf, ztm->_link._cap._flow);
-
-                            ret = _z_link_send_wbuf(&ztm->_link, &ztm->_wbuf);  // Send the wbuf on the socket
+                            __unsafe_z_finalize_wbuf(wbf, ztm->_link._cap._flow);
+
+                            queued = queued + (size_t)1;
+                            queued_bytes = queued_bytes + _z_wbuf_len(wbf);
+                            if (ztm->_tx_slots == NULL) {
+                                ret = _z_link_send_wbuf(&ztm->_link, wbf);  // Send the wbuf on the socket
+                            } else if ((queued == ztm->_slots_len) || (_z_wbuf_len(&fbf) == (size_t)0)) {
+                                ret = _z_link_send_multi_wbuf(&ztm->_link, ztm->_tx_slots, queued);
+                            } else {
+                                continue;
+                            }
                             if (ret == _Z_RES_OK) {
                                 ztm->_transmitted = true;  // Mark the session that we have transmitted data
+                                _Z_STATS_ADD(ztm->_stats, tx_batches, queued);
+                                _Z_STATS_ADD(ztm->_stats, tx_fragments, queued);
+                                _Z_STATS_ADD(ztm->_stats, tx_bytes, queued_bytes);
                             }
+                            queued = 0;
+                            queued_bytes = 0;
                         }
                     }
                 }
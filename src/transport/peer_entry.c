@@ -18,8 +18,8 @@
 
 void _z_transport_peer_entry_clear(_z_transport_peer_entry_t *src) {
 #if Z_FEATURE_FRAGMENTATION == 1
-    _z_wbuf_clear(&src->_dbuf_reliable);
-    _z_wbuf_clear(&src->_dbuf_best_effort);
+    _z_defrag_clear(&src->_dbuf_reliable);
+    _z_defrag_clear(&src->_dbuf_best_effort);
 #endif
 
     src->_remote_zid = _z_id_empty();
@@ -28,8 +28,8 @@ void _z_transport_peer_entry_clear(_z_transport_peer_entry_t *src) {
 
 void _z_transport_peer_entry_copy(_z_transport_peer_entry_t *dst, const _z_transport_peer_entry_t *src) {
 #if Z_FEATURE_FRAGMENTATION == 1
-    _z_wbuf_copy(&dst->_dbuf_reliable, &src->_dbuf_reliable);
-    _z_wbuf_copy(&dst->_dbuf_best_effort, &src->_dbuf_best_effort);
+    _z_defrag_copy(&dst->_dbuf_reliable, &src->_dbuf_reliable);
+    _z_defrag_copy(&dst->_dbuf_best_effort, &src->_dbuf_best_effort);
 #endif
 
     dst->_sn_res = src->_sn_res;
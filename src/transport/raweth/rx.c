@@ -92,6 +92,9 @@ int8_t _z_raweth_recv_t_msg_na(_z_transport_multicast_t *ztm, _z_transport_messa
             size_t to_read = _z_raweth_link_recv_zbuf(&ztm->_link, &ztm->_zbuf, addr);
             if (to_read == SIZE_MAX) {
                 ret = _Z_ERR_TRANSPORT_RX_FAILED;
+            } else {
+                _Z_STATS_INC(ztm->_stats, rx_batches);
+                _Z_STATS_ADD(ztm->_stats, rx_bytes, to_read);
             }
             break;
         }
@@ -102,7 +105,10 @@ int8_t _z_raweth_recv_t_msg_na(_z_transport_multicast_t *ztm, _z_transport_messa
     // Decode message
     if (ret == _Z_RES_OK) {
         _Z_DEBUG(">> \t transport_message_decode: %ju", (uintmax_t)_z_zbuf_len(&ztm->_zbuf));
-        ret = _z_transport_message_decode(t_msg, &ztm->_zbuf);
+        ret = _z_transport_message_decode_stream(t_msg, &ztm->_zbuf);
+        if (ret != _Z_RES_OK) {
+            _Z_STATS_INC(ztm->_stats, rx_decode_errors);
+        }
     }
 
 #if Z_FEATURE_MULTI_THREAD == 1
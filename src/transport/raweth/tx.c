@@ -211,6 +211,11 @@ int8_t _z_raweth_send_t_msg(_z_transport_multicast_t *ztm, const _z_transport_me
     _Z_CLEAN_RETURN_IF_ERR(_z_raweth_link_send_wbuf(&ztm->_link, &ztm->_wbuf), _zp_raweth_unlock_tx_mutex(ztm));
     // Mark the session that we have transmitted data
     ztm->_transmitted = true;
+    _Z_STATS_INC(ztm->_stats, tx_batches);
+    _Z_STATS_ADD(ztm->_stats, tx_bytes, _z_wbuf_len(&ztm->_wbuf));
+    if (_Z_MID(t_msg->_header) == _Z_MID_T_KEEP_ALIVE) {
+        _Z_STATS_INC(ztm->_stats, tx_keep_alives);
+    }
 
 #if Z_FEATURE_MULTI_THREAD == 1
     zp_mutex_unlock(&ztm->_mutex_tx);
@@ -233,6 +238,7 @@ int8_t _z_raweth_send_n_msg(_z_session_t *zn, const _z_network_message_t *n_msg,
         if (zp_mutex_trylock(&ztm->_mutex_tx) != (int8_t)0) {
             _Z_INFO("Dropping zenoh message because of congestion control");
             // We failed to acquire the lock, drop the message
+            _Z_STATS_INC(ztm->_stats, tx_cc_drops);
             return ret;
         }
     }
@@ -270,6 +276,7 @@ int8_t _z_raweth_send_n_msg(_z_session_t *zn, const _z_network_message_t *n_msg,
     _Z_CLEAN_RETURN_IF_ERR(_z_transport_message_encode(&ztm->_wbuf, &t_msg), _zp_raweth_unlock_tx_mutex(ztm));
     // Encode the network message
     if (_z_network_message_encode(&ztm->_wbuf, n_msg) == _Z_RES_OK) {
+        _Z_STATS_INC(ztm->_stats, tx_n_msgs);
         // Write the eth header
         _Z_CLEAN_RETURN_IF_ERR(__unsafe_z_raweth_write_header(&ztm->_link, &ztm->_wbuf),
                                _zp_raweth_unlock_tx_mutex(ztm));
@@ -277,12 +284,15 @@ int8_t _z_raweth_send_n_msg(_z_session_t *zn, const _z_network_message_t *n_msg,
         _Z_CLEAN_RETURN_IF_ERR(_z_raweth_link_send_wbuf(&ztm->_link, &ztm->_wbuf), _zp_raweth_unlock_tx_mutex(ztm));
         // Mark the session that we have transmitted data
         ztm->_transmitted = true;
+        _Z_STATS_INC(ztm->_stats, tx_batches);
+        _Z_STATS_ADD(ztm->_stats, tx_bytes, _z_wbuf_len(&ztm->_wbuf));
     } else {  // The message does not fit in the current batch, let's fragment it
 #if Z_FEATURE_FRAGMENTATION == 1
         // Create an expandable wbuf for fragmentation
         _z_wbuf_t fbf = _z_wbuf_make(_Z_FRAG_BUFF_BASE_SIZE, true);
         // Encode the message on the expandable wbuf
         _Z_CLEAN_RETURN_IF_ERR(_z_network_message_encode(&fbf, n_msg), _zp_raweth_unlock_tx_mutex(ztm));
+        _Z_STATS_INC(ztm->_stats, tx_n_msgs);
         // Fragment and send the message
         _Bool is_first = true;
         while (_z_wbuf_len(&fbf) > 0) {
@@ -305,6 +315,9 @@ int8_t _z_raweth_send_n_msg(_z_session_t *zn, const _z_network_message_t *n_msg,
             _Z_CLEAN_RETURN_IF_ERR(_z_raweth_link_send_wbuf(&ztm->_link, &ztm->_wbuf), _zp_raweth_unlock_tx_mutex(ztm));
             // Mark the session that we have transmitted data
             ztm->_transmitted = true;
+            _Z_STATS_INC(ztm->_stats, tx_batches);
+            _Z_STATS_INC(ztm->_stats, tx_fragments);
+            _Z_STATS_ADD(ztm->_stats, tx_bytes, _z_wbuf_len(&ztm->_wbuf));
         }
         // Clear the expandable buffer
         _z_wbuf_clear(&fbf);
@@ -66,6 +66,23 @@ void _z_transport_clear(_z_transport_t *zt) {
     }
 }
 
+#if Z_FEATURE_STATS == 1
+void _z_transport_get_stats(const _z_transport_t *zt, _z_stats_t *stats) {
+    switch (zt->_type) {
+        case _Z_TRANSPORT_UNICAST_TYPE:
+            _z_stats_snapshot(stats, &zt->_transport._unicast._stats);
+            break;
+        case _Z_TRANSPORT_MULTICAST_TYPE:
+        case _Z_TRANSPORT_RAWETH_TYPE:
+            _z_stats_snapshot(stats, &zt->_transport._multicast._stats);
+            break;
+        default:
+            _z_stats_init(stats);
+            break;
+    }
+}
+#endif
+
 void _z_transport_free(_z_transport_t **zt) {
     _z_transport_t *ptr = *zt;
     if (ptr == NULL) {
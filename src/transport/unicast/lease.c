@@ -14,6 +14,7 @@
 
 #include "zenoh-pico/transport/unicast/lease.h"
 
+#include "zenoh-pico/session/query.h"
 #include "zenoh-pico/transport/unicast/transport.h"
 #include "zenoh-pico/transport/unicast/tx.h"
 #include "zenoh-pico/utils/logging.h"
@@ -75,6 +76,18 @@ void *_zp_unicast_lease_task(void *ztu_arg) {
             next_keep_alive = (_z_zint_t)(ztu->_lease / Z_TRANSPORT_LEASE_EXPIRE_FACTOR);
         }
 
+#if Z_FEATURE_BATCHING == 1
+        // Send the batch if it has been pending for too long
+        if (_z_unicast_flush_expired(ztu) < 0) {
+            // TODO: Handle retransmission or error
+        }
+#endif
+
+#if Z_FEATURE_QUERY == 1
+        // Complete the queries that timed out
+        _Bool queries_pending = _z_expire_pending_queries((_z_session_t *)ztu->_session);
+#endif
+
         // Compute the target interval
         _z_zint_t interval;
         if (next_lease == 0) {
@@ -85,6 +98,18 @@ void *_zp_unicast_lease_task(void *ztu_arg) {
                 interval = next_keep_alive;
             }
         }
+#if Z_FEATURE_BATCHING == 1
+        // Wake up often enough to meet the batching deadline, only while there is traffic to batch
+        if ((_z_unicast_arm_batches(ztu) == true) && (interval > (_z_zint_t)Z_BATCH_FLUSH_DEADLINE_MS)) {
+            interval = (_z_zint_t)Z_BATCH_FLUSH_DEADLINE_MS;
+        }
+#endif
+#if Z_FEATURE_QUERY == 1
+        // Wake up on every tick of the query timeouts while some are pending
+        if ((queries_pending == true) && (interval > (_z_zint_t)Z_QUERY_TIMEOUT_TICK_MS)) {
+            interval = (_z_zint_t)Z_QUERY_TIMEOUT_TICK_MS;
+        }
+#endif
 
         // The keep alive and lease intervals are expressed in milliseconds
         zp_sleep_ms(interval);
@@ -92,6 +117,10 @@ void *_zp_unicast_lease_task(void *ztu_arg) {
         next_lease = next_lease - interval;
         next_keep_alive = next_keep_alive - interval;
     }
+#if Z_FEATURE_BATCHING == 1
+    // Nothing flushes open batches in time from now on
+    (void)_z_unicast_disarm_batches(ztu);
+#endif
     return 0;
 }
 
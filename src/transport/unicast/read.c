@@ -19,6 +19,8 @@
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/protocol/codec/transport.h"
 #include "zenoh-pico/transport/unicast/rx.h"
+#include "zenoh-pico/transport/unicast/tx.h"
+#include "zenoh-pico/transport/utils.h"
 #include "zenoh-pico/utils/logging.h"
 
 #if Z_FEATURE_UNICAST_TRANSPORT == 1
@@ -26,11 +28,18 @@
 int8_t _zp_unicast_read(_z_transport_unicast_t *ztu) {
     int8_t ret = _Z_RES_OK;
 
-    _z_transport_message_t t_msg;
-    ret = _z_unicast_recv_t_msg(ztu, &t_msg);
+#if Z_FEATURE_BATCHING == 1
+    // Send the batch if it has been pending for too long
+    ret = _z_unicast_flush_expired(ztu);
+#endif
+
     if (ret == _Z_RES_OK) {
-        ret = _z_unicast_handle_transport_message(ztu, &t_msg);
-        _z_t_msg_clear(&t_msg);
+        _z_transport_message_t t_msg;
+        ret = _z_unicast_recv_t_msg(ztu, &t_msg);
+        if (ret == _Z_RES_OK) {
+            ret = _z_unicast_handle_transport_message(ztu, &t_msg);
+            _z_t_msg_clear(&t_msg);
+        }
     }
 
     return ret;
@@ -95,10 +104,12 @@ void *_zp_unicast_read_task(void *ztu_arg) {
 
         // Mark the session that we have received data
         ztu->_received = true;
+        _Z_STATS_INC(ztu->_stats, rx_batches);
+        _Z_STATS_ADD(ztu->_stats, rx_bytes, _z_batch_wire_len(&ztu->_link, to_read));
 
         // Decode one session message
         _z_transport_message_t t_msg;
-        int8_t ret = _z_transport_message_decode(&t_msg, &zbuf);
+        int8_t ret = _z_transport_message_decode_stream(&t_msg, &zbuf);
 
         if (ret == _Z_RES_OK) {
             ret = _z_unicast_handle_transport_message(ztu, &t_msg);
@@ -110,6 +121,7 @@ void *_zp_unicast_read_task(void *ztu_arg) {
             }
         } else {
             _Z_ERROR("Connection closed due to malformed message");
+            _Z_STATS_INC(ztu->_stats, rx_decode_errors);
             ztu->_read_task_running = false;
             continue;
         }
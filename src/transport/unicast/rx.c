@@ -75,12 +75,17 @@ int8_t _z_unicast_recv_t_msg_na(_z_transport_unicast_t *ztu, _z_transport_messag
     } while (false);  // The 1-iteration loop to use continue to break the entire loop on error
 
     if (ret == _Z_RES_OK) {
+        _Z_STATS_INC(ztu->_stats, rx_batches);
+        _Z_STATS_ADD(ztu->_stats, rx_bytes, _z_batch_wire_len(&ztu->_link, to_read));
+
         _Z_DEBUG(">> \t transport_message_decode");
-        ret = _z_transport_message_decode(t_msg, &ztu->_zbuf);
+        ret = _z_transport_message_decode_stream(t_msg, &ztu->_zbuf);
 
         // Mark the session that we have received data
         if (ret == _Z_RES_OK) {
             ztu->_received = true;
+        } else {
+            _Z_STATS_INC(ztu->_stats, rx_decode_errors);
         }
     }
 
@@ -95,6 +100,16 @@ int8_t _z_unicast_recv_t_msg(_z_transport_unicast_t *ztu, _z_transport_message_t
     return _z_unicast_recv_t_msg_na(ztu, t_msg);
 }
 
+#if Z_FEATURE_FRAGMENTATION == 1
+// Gives up the message being reassembled, if any, and its defragmentation buffer
+static void __z_unicast_abort_reassembly(_z_transport_unicast_t *ztu, _z_defrag_t *dbuf) {
+    if (_z_defrag_len(dbuf) > (size_t)0) {
+        _Z_STATS_INC(ztu->_stats, rx_reassembly_aborts);
+    }
+    _z_defrag_release(dbuf, &ztu->_dbuf_pool);
+}
+#endif
+
 int8_t _z_unicast_handle_transport_message(_z_transport_unicast_t *ztu, _z_transport_message_t *t_msg) {
     int8_t ret = _Z_RES_OK;
 
@@ -102,6 +117,7 @@ int8_t _z_unicast_handle_transport_message(_z_transport_unicast_t *ztu, _z_trans
         case _Z_MID_T_FRAME: {
             _Z_INFO("Received Z_FRAME message");
             // Check if the SN is correct
+            _Bool drop = false;
             if (_Z_HAS_FLAG(t_msg->_header, _Z_FLAG_T_FRAME_R) == true) {
                 // @TODO: amend once reliability is in place. For the time being only
                 //        monotonic SNs are ensured
@@ -109,29 +125,36 @@ int8_t _z_unicast_handle_transport_message(_z_transport_unicast_t *ztu, _z_trans
                     ztu->_sn_rx_reliable = t_msg->_body._frame._sn;
                 } else {
 #if Z_FEATURE_FRAGMENTATION == 1
-                    _z_wbuf_clear(&ztu->_dbuf_reliable);
+                    __z_unicast_abort_reassembly(ztu, &ztu->_dbuf_reliable);
 #endif
                     _Z_INFO("Reliable message dropped because it is out of order");
-                    break;
+                    drop = true;
+                    _Z_STATS_INC(ztu->_stats, rx_sn_drops);
                 }
             } else {
                 if (_z_sn_precedes(ztu->_sn_res, ztu->_sn_rx_best_effort, t_msg->_body._frame._sn) == true) {
                     ztu->_sn_rx_best_effort = t_msg->_body._frame._sn;
                 } else {
 #if Z_FEATURE_FRAGMENTATION == 1
-                    _z_wbuf_clear(&ztu->_dbuf_best_effort);
+                    __z_unicast_abort_reassembly(ztu, &ztu->_dbuf_best_effort);
 #endif
                     _Z_INFO("Best effort message dropped because it is out of order");
-                    break;
+                    drop = true;
+                    _Z_STATS_INC(ztu->_stats, rx_sn_drops);
                 }
             }
 
-            // Handle all the zenoh message, one by one
-            size_t len = _z_vec_len(&t_msg->_body._frame._messages);
-            for (size_t i = 0; i < len; i++) {
-                _z_handle_network_message(ztu->_session,
-                                          (_z_zenoh_message_t *)_z_vec_get(&t_msg->_body._frame._messages, i),
-                                          _Z_KEYEXPR_MAPPING_UNKNOWN_REMOTE);
+            // Handle all the zenoh messages, one by one. They are decoded in place and must be consumed even if dropped
+            _z_network_message_t zm;
+            while (_z_frame_next(&t_msg->_body._frame, &zm, &ret) == true) {
+                if (drop == false) {
+                    _Z_STATS_INC(ztu->_stats, rx_n_msgs);
+                    _z_handle_network_message(ztu->_session, &zm, _Z_KEYEXPR_MAPPING_UNKNOWN_REMOTE);
+                }
+                _z_msg_clear(&zm);
+            }
+            if (ret != _Z_RES_OK) {
+                _Z_STATS_INC(ztu->_stats, rx_decode_errors);
             }
 
             break;
@@ -140,43 +163,35 @@ int8_t _z_unicast_handle_transport_message(_z_transport_unicast_t *ztu, _z_trans
         case _Z_MID_T_FRAGMENT: {
             _Z_INFO("Received Z_FRAGMENT message");
 #if Z_FEATURE_FRAGMENTATION == 1
-            _z_wbuf_t *dbuf = _Z_HAS_FLAG(t_msg->_header, _Z_FLAG_T_FRAGMENT_R)
-                                  ? &ztu->_dbuf_reliable
-                                  : &ztu->_dbuf_best_effort;  // Select the right defragmentation buffer
-
-            _Bool drop = false;
-            if ((_z_wbuf_len(dbuf) + t_msg->_body._fragment._payload.len) > Z_FRAG_MAX_SIZE) {
-                // Filling the wbuf capacity as a way to signal the last fragment to reset the dbuf
-                // Otherwise, last (smaller) fragments can be understood as a complete message
-                _z_wbuf_write_bytes(dbuf, t_msg->_body._fragment._payload.start, 0, _z_wbuf_space_left(dbuf));
-                drop = true;
-            } else {
-                _z_wbuf_write_bytes(dbuf, t_msg->_body._fragment._payload.start, 0,
-                                    t_msg->_body._fragment._payload.len);
+            _z_defrag_t *dbuf = _Z_HAS_FLAG(t_msg->_header, _Z_FLAG_T_FRAGMENT_R)
+                                    ? &ztu->_dbuf_reliable
+                                    : &ztu->_dbuf_best_effort;  // Select the right defragmentation buffer
+
+            _Z_STATS_INC(ztu->_stats, rx_fragments);
+            _Bool dropping = dbuf->_drop;
+            (void)_z_defrag_push(dbuf, &ztu->_dbuf_pool, &t_msg->_body._fragment._payload);
+            if ((dropping == false) && (dbuf->_drop == true)) {
+                _Z_STATS_INC(ztu->_stats, rx_reassembly_aborts);
             }
 
             if (_Z_HAS_FLAG(t_msg->_header, _Z_FLAG_T_FRAGMENT_M) == false) {
-                if (drop == true) {  // Drop message if it exceeds the fragmentation size
-                    _z_wbuf_reset(dbuf);
-                    break;
-                }
-
-                _z_zbuf_t zbf = _z_wbuf_to_zbuf(dbuf);  // Convert the defragmentation buffer into a decoding buffer
-
-                _z_zenoh_message_t zm;
-                int8_t ret = _z_network_message_decode(&zm, &zbf);
-                if (ret == _Z_RES_OK) {
-                    _z_handle_network_message(ztu->_session, &zm, _Z_KEYEXPR_MAPPING_UNKNOWN_REMOTE);
-                    _z_msg_clear(&zm);  // Clear must be explicitly called for fragmented zenoh messages. Non-fragmented
-                                        // zenoh messages are released when their transport message is released.
-                } else {
-                    _Z_DEBUG("Failed to decode defragmented message");
+                if (dbuf->_drop == false) {  // Drop the message if it exceeds the fragmentation size
+                    _z_zenoh_message_t zm;
+                    int8_t ret = _z_defrag_decode(dbuf, &zm);  // Decode in place from the defragmentation buffer
+                    if (ret == _Z_RES_OK) {
+                        _Z_STATS_INC(ztu->_stats, rx_n_msgs);
+                        _z_handle_network_message(ztu->_session, &zm, _Z_KEYEXPR_MAPPING_UNKNOWN_REMOTE);
+                        // Clear must be explicitly called for fragmented zenoh messages. Non-fragmented zenoh
+                        // messages are released when their transport message is released.
+                        _z_msg_clear(&zm);
+                    } else {
+                        _Z_DEBUG("Failed to decode defragmented message");
+                        _Z_STATS_INC(ztu->_stats, rx_decode_errors);
+                    }
                 }
 
-                // Free the decoding buffer
-                _z_zbuf_clear(&zbf);
-                // Reset the defragmentation buffer
-                _z_wbuf_reset(dbuf);
+                // Give the defragmentation buffer back to the pool
+                _z_defrag_release(dbuf, &ztu->_dbuf_pool);
             }
 #else
             _Z_INFO("Fragment dropped because fragmentation feature is deactivated");
@@ -186,6 +201,7 @@ int8_t _z_unicast_handle_transport_message(_z_transport_unicast_t *ztu, _z_trans
 
         case _Z_MID_T_KEEP_ALIVE: {
             _Z_INFO("Received Z_KEEP_ALIVE message");
+            _Z_STATS_INC(ztu->_stats, rx_keep_alives);
             break;
         }
 
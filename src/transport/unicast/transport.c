@@ -50,34 +50,34 @@ int8_t _z_unicast_transport_create(_z_transport_t *zt, _z_link_t *zl, _z_transpo
     // Initialize the read and write buffers
     if (ret == _Z_RES_OK) {
         uint16_t mtu = (zl->_mtu < Z_BATCH_UNICAST_SIZE) ? zl->_mtu : Z_BATCH_UNICAST_SIZE;
-        size_t dbuf_size = 0;
+        size_t dbuf_count = 0;
         size_t wbuf_size = 0;
         size_t zbuf_size = 0;
-        _Bool expandable = false;
 
         switch (zl->_cap._flow) {
             case Z_LINK_CAP_FLOW_STREAM:
                 // Add stream length field to buffer size
                 wbuf_size = mtu + _Z_MSG_LEN_ENC_SIZE;
                 zbuf_size = Z_BATCH_UNICAST_SIZE + _Z_MSG_LEN_ENC_SIZE;
-                expandable = true;
                 break;
             case Z_LINK_CAP_FLOW_DATAGRAM:
             default:
                 wbuf_size = mtu;
                 zbuf_size = Z_BATCH_UNICAST_SIZE;
-                expandable = false;
                 break;
         }
 
 #if Z_FEATURE_DYNAMIC_MEMORY_ALLOCATION == 0
-        expandable = false;
-        dbuf_size = Z_FRAG_MAX_SIZE;
+        dbuf_count = 2;
 #endif
 
         // Initialize tx rx buffers
         zt->_transport._unicast._wbuf = _z_wbuf_make(wbuf_size, false);
         zt->_transport._unicast._zbuf = _z_zbuf_make(zbuf_size);
+        if (zl->_write_vec_f != NULL) {
+            // Large payloads are gathered by the link from the user buffer
+            zt->_transport._unicast._wbuf._wrap_threshold = Z_TX_ZERO_COPY_MIN_SIZE;
+        }
 
         // Clean up the buffers if one of them failed to be allocated
         if ((_z_wbuf_capacity(&zt->_transport._unicast._wbuf) != wbuf_size) ||
@@ -96,24 +96,14 @@ int8_t _z_unicast_transport_create(_z_transport_t *zt, _z_link_t *zl, _z_transpo
 
 #if Z_FEATURE_FRAGMENTATION == 1
         // Initialize the defragmentation buffers
-        zt->_transport._unicast._dbuf_reliable = _z_wbuf_make(dbuf_size, expandable);
-        zt->_transport._unicast._dbuf_best_effort = _z_wbuf_make(dbuf_size, expandable);
-
-        // Clean up the buffers if one of them failed to be allocated
-        if (
-#if Z_FEATURE_DYNAMIC_MEMORY_ALLOCATION == 0
-            (_z_wbuf_capacity(&zt->_transport._unicast._dbuf_reliable) != dbuf_size) ||
-            (_z_wbuf_capacity(&zt->_transport._unicast._dbuf_best_effort) != dbuf_size)) {
-#else
-            (_z_wbuf_capacity(&zt->_transport._unicast._dbuf_reliable) != Z_IOSLICE_SIZE) ||
-            (_z_wbuf_capacity(&zt->_transport._unicast._dbuf_best_effort) != Z_IOSLICE_SIZE)) {
-#endif
+        _z_defrag_init(&zt->_transport._unicast._dbuf_reliable);
+        _z_defrag_init(&zt->_transport._unicast._dbuf_best_effort);
+        // Without dynamic allocation, the buffers of both reliability channels are allocated upfront
+        if ((ret == _Z_RES_OK) &&
+            (_z_defrag_pool_init(&zt->_transport._unicast._dbuf_pool, dbuf_count) != _Z_RES_OK)) {
             ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
             _Z_ERROR("Not enough memory to allocate transport defragmentation buffers!");
 
-            _z_wbuf_clear(&zt->_transport._unicast._dbuf_reliable);
-            _z_wbuf_clear(&zt->_transport._unicast._dbuf_best_effort);
-
 #if Z_FEATURE_MULTI_THREAD == 1
             zp_mutex_free(&zt->_transport._unicast._mutex_tx);
             zp_mutex_free(&zt->_transport._unicast._mutex_rx);
@@ -138,6 +128,18 @@ int8_t _z_unicast_transport_create(_z_transport_t *zt, _z_link_t *zl, _z_transpo
         zt->_transport._unicast._sn_rx_reliable = initial_sn_rx;
         zt->_transport._unicast._sn_rx_best_effort = initial_sn_rx;
 
+#if Z_FEATURE_BATCHING == 1
+        // No batch is open yet. With tasks, they are only kept open once the lease task is there to flush them in
+        // time. Without, the application flushes them through zp_read or zp_flush.
+        zt->_transport._unicast._batch_pending = false;
+#if Z_FEATURE_MULTI_THREAD == 1
+        zt->_transport._unicast._batch_armed = false;
+#else
+        zt->_transport._unicast._batch_armed = true;
+#endif
+        zt->_transport._unicast._batch_activity = false;
+#endif
+
 #if Z_FEATURE_MULTI_THREAD == 1
         // Tasks
         zt->_transport._unicast._read_task_running = false;
@@ -146,6 +148,17 @@ int8_t _z_unicast_transport_create(_z_transport_t *zt, _z_link_t *zl, _z_transpo
         zt->_transport._unicast._lease_task = NULL;
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
+#if Z_FEATURE_TX_QUEUE == 1
+        // The transmit queue is allocated when the TX task starts
+        zt->_transport._unicast._tx_queue_entries = NULL;
+        zt->_transport._unicast._tx_task_running = false;
+        zt->_transport._unicast._tx_task = NULL;
+#endif
+
+#if Z_FEATURE_STATS == 1
+        _z_stats_init(&zt->_transport._unicast._stats);
+#endif
+
         // Notifiers
         zt->_transport._unicast._received = 0;
         zt->_transport._unicast._transmitted = 0;
@@ -279,6 +292,10 @@ int8_t _z_unicast_send_close(_z_transport_unicast_t *ztu, uint8_t reason, _Bool
 }
 
 int8_t _z_unicast_transport_close(_z_transport_unicast_t *ztu, uint8_t reason) {
+#if Z_FEATURE_TX_QUEUE == 1
+    // Send the queued network messages before closing
+    (void)_zp_unicast_stop_tx_task(ztu);
+#endif
     return _z_unicast_send_close(ztu, reason, false);
 }
 
@@ -294,6 +311,9 @@ void _z_unicast_transport_clear(_z_transport_t *zt) {
         zp_task_join(ztu->_lease_task);
         zp_task_free(&ztu->_lease_task);
     }
+#if Z_FEATURE_TX_QUEUE == 1
+    _z_unicast_tx_queue_clear(ztu);
+#endif
 
     // Clean up the mutexes
     zp_mutex_free(&ztu->_mutex_tx);
@@ -304,8 +324,9 @@ void _z_unicast_transport_clear(_z_transport_t *zt) {
     _z_wbuf_clear(&ztu->_wbuf);
     _z_zbuf_clear(&ztu->_zbuf);
 #if Z_FEATURE_FRAGMENTATION == 1
-    _z_wbuf_clear(&ztu->_dbuf_reliable);
-    _z_wbuf_clear(&ztu->_dbuf_best_effort);
+    _z_defrag_clear(&ztu->_dbuf_reliable);
+    _z_defrag_clear(&ztu->_dbuf_best_effort);
+    _z_defrag_pool_clear(&ztu->_dbuf_pool);
 #endif
 
     // Clean up PIDs
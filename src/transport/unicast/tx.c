@@ -15,6 +15,7 @@
 #include "zenoh-pico/transport/unicast/tx.h"
 
 #include <assert.h>
+#include <string.h>
 
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/protocol/codec/network.h"
@@ -43,6 +44,161 @@ _z_zint_t __unsafe_z_unicast_get_sn(_z_transport_unicast_t *ztu, z_reliability_t
     return sn;
 }
 
+/**
+ * Sends the batch in the wbuf, writing its length in the reserved space if needed.
+ *
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - ztu->_mutex_tx
+ */
+static int8_t __unsafe_z_unicast_send_batch(_z_transport_unicast_t *ztu) {
+    __unsafe_z_finalize_wbuf(&ztu->_wbuf, ztu->_link._cap._flow);
+    int8_t ret = _z_link_send_wbuf(&ztu->_link, &ztu->_wbuf);  // Send the wbuf on the socket
+    if (ret == _Z_RES_OK) {
+        ztu->_transmitted = true;  // Mark the session that we have transmitted data
+        _Z_STATS_INC(ztu->_stats, tx_batches);
+        _Z_STATS_ADD(ztu->_stats, tx_bytes, _z_wbuf_len(&ztu->_wbuf));
+    }
+    return ret;
+}
+
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - ztu->_mutex_tx
+ */
+static int8_t __unsafe_z_unicast_flush(_z_transport_unicast_t *ztu) {
+    int8_t ret = _Z_RES_OK;
+#if Z_FEATURE_BATCHING == 1
+    if (ztu->_batch_pending == true) {
+        ztu->_batch_pending = false;
+        ret = __unsafe_z_unicast_send_batch(ztu);
+    }
+#else
+    _ZP_UNUSED(ztu);
+#endif
+    return ret;
+}
+
+int8_t _z_unicast_flush(_z_transport_unicast_t *ztu) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    zp_mutex_lock(&ztu->_mutex_tx);
+#endif  // Z_FEATURE_MULTI_THREAD == 1
+
+    int8_t ret = __unsafe_z_unicast_flush(ztu);
+
+#if Z_FEATURE_MULTI_THREAD == 1
+    zp_mutex_unlock(&ztu->_mutex_tx);
+#endif  // Z_FEATURE_MULTI_THREAD == 1
+
+    return ret;
+}
+
+int8_t _z_unicast_flush_expired(_z_transport_unicast_t *ztu) {
+    int8_t ret = _Z_RES_OK;
+#if Z_FEATURE_BATCHING == 1
+    // Unlocked check, to avoid contending with the senders when there is nothing to flush
+    if (ztu->_batch_pending == true) {
+#if Z_FEATURE_MULTI_THREAD == 1
+        zp_mutex_lock(&ztu->_mutex_tx);
+#endif  // Z_FEATURE_MULTI_THREAD == 1
+
+        if ((ztu->_batch_pending == true) &&
+            (zp_clock_elapsed_ms(&ztu->_batch_start) >= (unsigned long)Z_BATCH_FLUSH_DEADLINE_MS)) {
+            ret = __unsafe_z_unicast_flush(ztu);
+        }
+
+#if Z_FEATURE_MULTI_THREAD == 1
+        zp_mutex_unlock(&ztu->_mutex_tx);
+#endif  // Z_FEATURE_MULTI_THREAD == 1
+    }
+#else
+    _ZP_UNUSED(ztu);
+#endif
+    return ret;
+}
+
+/**
+ * Tells whether the network messages sent until the next call may be kept in an open batch, in which case the caller
+ * must call again within Z_BATCH_FLUSH_DEADLINE_MS to flush it. Batches are kept open while network messages keep
+ * being sent, otherwise they are sent right away so that the caller may sleep longer.
+ */
+_Bool _z_unicast_arm_batches(_z_transport_unicast_t *ztu) {
+    _Bool armed = false;
+#if Z_FEATURE_BATCHING == 1
+#if Z_FEATURE_MULTI_THREAD == 1
+    zp_mutex_lock(&ztu->_mutex_tx);
+#endif  // Z_FEATURE_MULTI_THREAD == 1
+
+    ztu->_batch_armed = (ztu->_batch_pending == true) || (ztu->_batch_activity == true);
+    ztu->_batch_activity = false;
+    armed = ztu->_batch_armed;
+
+#if Z_FEATURE_MULTI_THREAD == 1
+    zp_mutex_unlock(&ztu->_mutex_tx);
+#endif  // Z_FEATURE_MULTI_THREAD == 1
+#else
+    _ZP_UNUSED(ztu);
+#endif
+    return armed;
+}
+
+/**
+ * Sends the pending batch and stops keeping batches open, for when nothing calls _z_unicast_arm_batches anymore.
+ */
+int8_t _z_unicast_disarm_batches(_z_transport_unicast_t *ztu) {
+    int8_t ret = _Z_RES_OK;
+#if Z_FEATURE_BATCHING == 1
+#if Z_FEATURE_MULTI_THREAD == 1
+    zp_mutex_lock(&ztu->_mutex_tx);
+#endif  // Z_FEATURE_MULTI_THREAD == 1
+
+    ztu->_batch_armed = false;
+    ret = __unsafe_z_unicast_flush(ztu);
+
+#if Z_FEATURE_MULTI_THREAD == 1
+    zp_mutex_unlock(&ztu->_mutex_tx);
+#endif  // Z_FEATURE_MULTI_THREAD == 1
+#else
+    _ZP_UNUSED(ztu);
+#endif
+    return ret;
+}
+
+#if Z_FEATURE_FRAGMENTATION == 1
+/**
+ * Fragments an encoded network message and sends the fragments, the first one with the given sequence number.
+ *
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - ztu->_mutex_tx
+ */
+static int8_t __unsafe_z_unicast_send_fragments(_z_transport_unicast_t *ztu, _z_wbuf_t *fbf,
+                                                z_reliability_t reliability, _z_zint_t sn) {
+    int8_t ret = _Z_RES_OK;
+    _Bool is_first = true;  // Fragment and send the message
+    while (_z_wbuf_len(fbf) > 0) {
+        if (is_first == false) {  // Get the fragment sequence number
+            sn = __unsafe_z_unicast_get_sn(ztu, reliability);
+        }
+        is_first = false;
+
+        // Clear the buffer for serialization
+        __unsafe_z_prepare_wbuf(&ztu->_wbuf, ztu->_link._cap._flow);
+
+        // Serialize one fragment
+        ret = __unsafe_z_serialize_zenoh_fragment(&ztu->_wbuf, fbf, reliability, sn);
+        if (ret == _Z_RES_OK) {
+            ret = __unsafe_z_unicast_send_batch(ztu);
+            if (ret == _Z_RES_OK) {
+                _Z_STATS_INC(ztu->_stats, tx_fragments);
+            }
+        }
+    }
+    return ret;
+}
+#endif
+
 int8_t _z_unicast_send_t_msg(_z_transport_unicast_t *ztu, const _z_transport_message_t *t_msg) {
     int8_t ret = _Z_RES_OK;
     _Z_DEBUG(">> send session message");
@@ -52,19 +208,19 @@ int8_t _z_unicast_send_t_msg(_z_transport_unicast_t *ztu, const _z_transport_mes
     zp_mutex_lock(&ztu->_mutex_tx);
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
+    // Send the pending batch first, as the buffer is about to be reused
+    (void)__unsafe_z_unicast_flush(ztu);
+
     // Prepare the buffer eventually reserving space for the message length
     __unsafe_z_prepare_wbuf(&ztu->_wbuf, ztu->_link._cap._flow);
 
     // Encode the session message
     ret = _z_transport_message_encode(&ztu->_wbuf, t_msg);
     if (ret == _Z_RES_OK) {
-        // Write the message length in the reserved space if needed
-        __unsafe_z_finalize_wbuf(&ztu->_wbuf, ztu->_link._cap._flow);
-        // Send the wbuf on the socket
-        ret = _z_link_send_wbuf(&ztu->_link, &ztu->_wbuf);
-        if (ret == _Z_RES_OK) {
-            ztu->_transmitted = true;  // Mark the session that we have transmitted data
-        }
+        ret = __unsafe_z_unicast_send_batch(ztu);
+    }
+    if ((ret == _Z_RES_OK) && (_Z_MID(t_msg->_header) == _Z_MID_T_KEEP_ALIVE)) {
+        _Z_STATS_INC(ztu->_stats, tx_keep_alives);
     }
 
 #if Z_FEATURE_MULTI_THREAD == 1
@@ -74,10 +230,13 @@ int8_t _z_unicast_send_t_msg(_z_transport_unicast_t *ztu, const _z_transport_mes
     return ret;
 }
 
-int8_t _z_unicast_send_n_msg(_z_session_t *zn, const _z_network_message_t *n_msg, z_reliability_t reliability,
-                             z_congestion_control_t cong_ctrl) {
+#if Z_FEATURE_TX_QUEUE == 1
+static int8_t __unsafe_z_unicast_drain_closed_tx_queue(_z_transport_unicast_t *ztu);
+#endif
+
+static int8_t __z_unicast_send_n_msg(_z_session_t *zn, const _z_network_message_t *n_msg, z_reliability_t reliability,
+                                     z_congestion_control_t cong_ctrl) {
     int8_t ret = _Z_RES_OK;
-    _Z_DEBUG(">> send network message");
 
     _z_transport_unicast_t *ztu = &zn->_tp._transport._unicast;
 
@@ -94,34 +253,78 @@ int8_t _z_unicast_send_n_msg(_z_session_t *zn, const _z_network_message_t *n_msg
             _Z_INFO("Dropping zenoh message because of congestion control");
             // We failed to acquire the lock, drop the message
             drop = true;
+            _Z_STATS_INC(ztu->_stats, tx_cc_drops);
         }
 #endif  // Z_FEATURE_MULTI_THREAD == 1
     }
 
+#if Z_FEATURE_TX_QUEUE == 1
+    if (drop == false) {
+        // The network messages the TX task left in the queues are sent first, not to be overtaken
+        (void)__unsafe_z_unicast_drain_closed_tx_queue(ztu);
+    }
+#endif
+
+    _Bool batched = false;
+#if Z_FEATURE_BATCHING == 1
     if (drop == false) {
+        ztu->_batch_activity = true;
+    }
+    if ((drop == false) && (ztu->_batch_pending == true)) {
+        if (ztu->_batch_reliability == reliability) {
+            // Append the network message to the open frame, rolling it back if it does not fit.
+            // Payloads are copied, as the ones wrapped in place would have to be sent before returning.
+            size_t wpos = _z_wbuf_get_wpos(&ztu->_wbuf);
+            size_t wrap_threshold = ztu->_wbuf._wrap_threshold;
+            ztu->_wbuf._wrap_threshold = 0;
+            if (_z_network_message_encode(&ztu->_wbuf, n_msg) == _Z_RES_OK) {
+                batched = true;
+            } else {
+                _z_wbuf_set_wpos(&ztu->_wbuf, wpos);
+            }
+            ztu->_wbuf._wrap_threshold = wrap_threshold;
+        }
+
+        if (batched == true) {
+            _Z_STATS_INC(ztu->_stats, tx_n_msgs);
+            if (_z_wbuf_len(&ztu->_wbuf) >= (size_t)Z_BATCH_FLUSH_THRESHOLD) {
+                ret = __unsafe_z_unicast_flush(ztu);
+            }
+        } else {
+            // The message goes in a new frame, send the pending one
+            (void)__unsafe_z_unicast_flush(ztu);
+        }
+    }
+#endif
+
+    if ((drop == false) && (batched == false)) {
         // Prepare the buffer eventually reserving space for the message length
         __unsafe_z_prepare_wbuf(&ztu->_wbuf, ztu->_link._cap._flow);
 
-        _z_zint_t sn = __unsafe_z_unicast_get_sn(ztu, reliability);  // Get the next sequence number
+        // Only take the next sequence number once the message is known to be sent, a dropped one would leave a gap
+        _z_zint_t sn = (reliability == Z_RELIABILITY_RELIABLE) ? ztu->_sn_tx_reliable : ztu->_sn_tx_best_effort;
 
         _z_transport_message_t t_msg = _z_t_msg_make_frame_header(sn, reliability);
         ret = _z_transport_message_encode(&ztu->_wbuf, &t_msg);  // Encode the frame header
         if (ret == _Z_RES_OK) {
             ret = _z_network_message_encode(&ztu->_wbuf, n_msg);  // Encode the network message
             if (ret == _Z_RES_OK) {
-                // Write the message length in the reserved space if needed
-                __unsafe_z_finalize_wbuf(&ztu->_wbuf, ztu->_link._cap._flow);
-
-                if (ztu->_wbuf._ioss._len == 1) {
-                    ret = _z_link_send_wbuf(&ztu->_link, &ztu->_wbuf);  // Send the wbuf on the socket
-                } else {
-                    // Change the MID
-
-                    // for ()
-                }
-                if (ret == _Z_RES_OK) {
-                    ztu->_transmitted = true;  // Mark the session that we have transmitted data
+                (void)__unsafe_z_unicast_get_sn(ztu, reliability);
+                _Z_STATS_INC(ztu->_stats, tx_n_msgs);
+#if Z_FEATURE_BATCHING == 1
+                // Keep the frame open for the next network messages, it is sent once flushed
+                ztu->_batch_pending = true;
+                ztu->_batch_reliability = reliability;
+                ztu->_batch_start = zp_clock_now();
+                // Payloads wrapped in place are only valid until returning, as is the frame referencing them.
+                // Nor is the frame kept open if nothing flushes it in time.
+                if ((ztu->_batch_armed == false) || (_z_wbuf_len_iosli(&ztu->_wbuf) > (size_t)1) ||
+                    (_z_wbuf_len(&ztu->_wbuf) >= (size_t)Z_BATCH_FLUSH_THRESHOLD)) {
+                    ret = __unsafe_z_unicast_flush(ztu);
                 }
+#else
+                ret = __unsafe_z_unicast_send_batch(ztu);
+#endif
             } else {
 #if Z_FEATURE_FRAGMENTATION == 1
                 // The message does not fit in the current batch, let's fragment it
@@ -130,28 +333,9 @@ int8_t _z_unicast_send_n_msg(_z_session_t *zn, const _z_network_message_t *n_msg
 
                 ret = _z_network_message_encode(&fbf, n_msg);  // Encode the message on the expandable wbuf
                 if (ret == _Z_RES_OK) {
-                    _Bool is_first = true;  // Fragment and send the message
-                    while (_z_wbuf_len(&fbf) > 0) {
-                        if (is_first == false) {  // Get the fragment sequence number
-                            sn = __unsafe_z_unicast_get_sn(ztu, reliability);
-                        }
-                        is_first = false;
-
-                        // Clear the buffer for serialization
-                        __unsafe_z_prepare_wbuf(&ztu->_wbuf, ztu->_link._cap._flow);
-
-                        // Serialize one fragment
-                        ret = __unsafe_z_serialize_zenoh_fragment(&ztu->_wbuf, &fbf, reliability, sn);
-                        if (ret == _Z_RES_OK) {
-                            // Write the message length in the reserved space if needed
-                            __unsafe_z_finalize_wbuf(&ztu->_wbuf, ztu->_link._cap._flow);
-
-                            ret = _z_link_send_wbuf(&ztu->_link, &ztu->_wbuf);  // Send the wbuf on the socket
-                            if (ret == _Z_RES_OK) {
-                                ztu->_transmitted = true;  // Mark the session that we have transmitted data
-                            }
-                        }
-                    }
+                    (void)__unsafe_z_unicast_get_sn(ztu, reliability);
+                    _Z_STATS_INC(ztu->_stats, tx_n_msgs);
+                    ret = __unsafe_z_unicast_send_fragments(ztu, &fbf, reliability, sn);
                 }
 
                 // Clear the buffer as it's no longer required
@@ -161,15 +345,476 @@ int8_t _z_unicast_send_n_msg(_z_session_t *zn, const _z_network_message_t *n_msg
 #endif
             }
         }
+    }
 
 #if Z_FEATURE_MULTI_THREAD == 1
+    if (drop == false) {
         zp_mutex_unlock(&ztu->_mutex_tx);
+    }
 #endif  // Z_FEATURE_MULTI_THREAD == 1
+
+    return ret;
+}
+
+#if Z_FEATURE_TX_QUEUE == 1
+static inline size_t __z_unicast_tx_queue_class(z_priority_t priority) {
+    // Spread the priorities evenly over the classes, the highest priority having the value 0
+    return ((size_t)priority * (size_t)Z_TX_QUEUE_PRIORITIES) / (size_t)Z_PRIORITIES_NUM;
+}
+
+static inline _z_tx_queue_entry_t *__z_unicast_tx_queue_entry(_z_transport_unicast_t *ztu, size_t c, size_t slot) {
+    return &ztu->_tx_queue_entries[(c * (size_t)Z_TX_QUEUE_SIZE) + slot];
+}
+
+// Returns the highest priority class with a published message, or Z_TX_QUEUE_PRIORITIES if all the queues are empty
+static size_t __z_unicast_tx_queue_peek(const _z_transport_unicast_t *ztu, size_t *slot) {
+    size_t c = 0;
+    *slot = SIZE_MAX;
+    while (c < (size_t)Z_TX_QUEUE_PRIORITIES) {
+        *slot = _z_mpsc_peek(&ztu->_tx_queues[c]);
+        if (*slot != SIZE_MAX) {
+            break;
+        }
+        c = c + (size_t)1;
+    }
+    return c;
+}
+
+static void __z_unicast_tx_queue_entry_reset(_z_tx_queue_entry_t *entry) {
+    if (_z_wbuf_capacity(&entry->_wbuf) != (size_t)Z_TX_QUEUE_ENTRY_SIZE) {
+        // Give back the buffer of a large message
+        _z_wbuf_clear(&entry->_wbuf);
+        entry->_wbuf = _z_wbuf_make(Z_TX_QUEUE_ENTRY_SIZE, false);
+    } else {
+        _z_wbuf_reset(&entry->_wbuf);
+    }
+}
+
+static void __z_unicast_tx_queue_pop(_z_transport_unicast_t *ztu, size_t c, _z_tx_queue_entry_t *entry) {
+    __z_unicast_tx_queue_entry_reset(entry);
+    if (_z_mpsc_pop(&ztu->_tx_queues[c]) == true) {
+        zp_mutex_lock(&ztu->_mutex_tx_queue);
+        zp_condvar_signal(&ztu->_cond_tx_space[c]);
+        zp_mutex_unlock(&ztu->_mutex_tx_queue);
+    }
+}
+
+static int8_t __z_unicast_tx_queue_entry_encode_large(_z_tx_queue_entry_t *entry, const _z_network_message_t *n_msg) {
+    // Payloads are wrapped when encoding on an expandable buffer, copy them as the message outlives the caller
+    _z_wbuf_t ebf = _z_wbuf_make(Z_TX_QUEUE_ENTRY_SIZE, true);
+    int8_t ret = _z_network_message_encode(&ebf, n_msg);
+    if (ret == _Z_RES_OK) {
+        _z_wbuf_t wbf = _z_wbuf_make(_z_wbuf_len(&ebf), false);
+        for (size_t i = 0; (i < _z_wbuf_len_iosli(&ebf)) && (ret == _Z_RES_OK); i++) {
+            _z_iosli_t *ios = _z_wbuf_get_iosli(&ebf, i);
+            ret = _z_wbuf_write_bytes(&wbf, ios->_buf, ios->_r_pos, _z_iosli_readable(ios));
+        }
+        if (ret == _Z_RES_OK) {
+            _z_wbuf_clear(&entry->_wbuf);
+            entry->_wbuf = wbf;
+        } else {
+            _z_wbuf_clear(&wbf);
+        }
+    }
+    _z_wbuf_clear(&ebf);
+    return ret;
+}
+
+/**
+ * Encodes a network message in the transmit queue of its priority class, for the TX task to send it. In blocking
+ * congestion control, waits for a free slot if the queue is full, otherwise drops the message.
+ *
+ * Returns false if the TX task stopped, closing the queue, leaving the message to the caller.
+ */
+static _Bool __z_unicast_enqueue_n_msg(_z_transport_unicast_t *ztu, const _z_network_message_t *n_msg,
+                                       z_reliability_t reliability, z_congestion_control_t cong_ctrl, int8_t *ret) {
+    _Bool queued = true;
+    size_t c = __z_unicast_tx_queue_class(_z_n_msg_get_priority(n_msg));
+    _z_mpsc_t *queue = &ztu->_tx_queues[c];
+
+    size_t slot = _z_mpsc_claim(queue);
+    if ((slot == SIZE_MAX) && (_z_mpsc_closer_is_parked(queue) == true)) {
+        // The sender draining the closed queue waits for this claim to be given up
+        zp_mutex_lock(&ztu->_mutex_tx_queue);
+        zp_condvar_signal(&ztu->_cond_tx_claims);
+        zp_mutex_unlock(&ztu->_mutex_tx_queue);
+    }
+    if ((slot == SIZE_MAX) && (_z_mpsc_is_closed(queue) == true)) {
+        // The TX task is stopping and sends the messages queued so far, the later ones are sent by their producer
+        queued = false;
+    } else if ((slot == SIZE_MAX) && (cong_ctrl == Z_CONGESTION_CONTROL_BLOCK)) {
+        zp_mutex_lock(&ztu->_mutex_tx_queue);
+        while ((slot == SIZE_MAX) && (ztu->_tx_task_running == true)) {
+            if (_z_mpsc_producer_park(queue) == true) {
+                zp_condvar_wait(&ztu->_cond_tx_space[c], &ztu->_mutex_tx_queue);
+            }
+            _z_mpsc_producer_unpark(queue);
+            slot = _z_mpsc_claim(queue);
+        }
+        if (slot == SIZE_MAX) {
+            // The TX task stopped, pass the wake up on to the other waiting producers
+            zp_condvar_signal(&ztu->_cond_tx_space[c]);
+            queued = false;
+        }
+        zp_mutex_unlock(&ztu->_mutex_tx_queue);
+    }
+
+    if (slot != SIZE_MAX) {
+        _z_tx_queue_entry_t *entry = __z_unicast_tx_queue_entry(ztu, c, slot);
+        entry->_reliability = reliability;
+        *ret = _z_network_message_encode(&entry->_wbuf, n_msg);
+        if (*ret != _Z_RES_OK) {
+            // The message does not fit in the entry
+            _z_wbuf_reset(&entry->_wbuf);
+            *ret = __z_unicast_tx_queue_entry_encode_large(entry, n_msg);
+        }
+        if (*ret == _Z_RES_OK) {
+            _Z_STATS_INC(ztu->_stats, tx_n_msgs);
+        } else {
+            // A claimed slot must be published, the TX task skips the empty ones
+            _z_wbuf_reset(&entry->_wbuf);
+        }
+        if (_z_mpsc_publish(queue, slot) == true) {
+            zp_mutex_lock(&ztu->_mutex_tx_queue);
+            zp_condvar_signal(&ztu->_cond_tx_ready);
+            zp_condvar_signal(&ztu->_cond_tx_claims);
+            zp_mutex_unlock(&ztu->_mutex_tx_queue);
+        }
+    } else if (queued == true) {
+        _Z_INFO("Dropping zenoh message because the transmit queue is full");
+        _Z_STATS_INC(ztu->_stats, tx_cc_drops);
+    }
+
+    return queued;
+}
+
+/**
+ * Appends a queued network message to the frame open in the wbuf, sending it and opening a new one if needed.
+ * Returns false, leaving the message aside, if it does not fit in a frame.
+ *
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - ztu->_mutex_tx
+ */
+static _Bool __unsafe_z_unicast_frame_queued(_z_transport_unicast_t *ztu, _z_tx_queue_entry_t *entry, _Bool *open,
+                                             z_reliability_t *reliability, int8_t *ret) {
+    _Bool framed = true;
+    size_t len = _z_wbuf_len(&entry->_wbuf);
+
+    // Send the open frame if the message does not go in it
+    if ((*open == true) && ((entry->_reliability != *reliability) || (len > _z_wbuf_space_left(&ztu->_wbuf)))) {
+        *ret = __unsafe_z_unicast_send_batch(ztu);
+        *open = false;
+    }
+    if ((*open == false) && (len > (size_t)0)) {
+        __unsafe_z_prepare_wbuf(&ztu->_wbuf, ztu->_link._cap._flow);
+        // Only take the sequence number once the message is known to fit
+        _z_zint_t sn =
+            (entry->_reliability == Z_RELIABILITY_RELIABLE) ? ztu->_sn_tx_reliable : ztu->_sn_tx_best_effort;
+        _z_transport_message_t t_msg = _z_t_msg_make_frame_header(sn, entry->_reliability);
+        *ret = _z_transport_message_encode(&ztu->_wbuf, &t_msg);  // Encode the frame header
+        if ((*ret == _Z_RES_OK) && (len <= _z_wbuf_space_left(&ztu->_wbuf))) {
+            (void)__unsafe_z_unicast_get_sn(ztu, entry->_reliability);
+            *reliability = entry->_reliability;
+            *open = true;
+        } else {
+            framed = false;
+        }
+    }
+    if ((*open == true) && (len > (size_t)0)) {
+        // Copy the encoded message in the frame
+        for (size_t i = 0; (i < _z_wbuf_len_iosli(&entry->_wbuf)) && (*ret == _Z_RES_OK); i++) {
+            _z_iosli_t *ios = _z_wbuf_get_iosli(&entry->_wbuf, i);
+            *ret = _z_wbuf_write_bytes(&ztu->_wbuf, ios->_buf, ios->_r_pos, _z_iosli_readable(ios));
+        }
+    }
+
+    return framed;
+}
+
+#if Z_FEATURE_FRAGMENTATION == 1
+/**
+ * Sends the fragments of a queued message back to back. The peers reassemble the fragments of a reliability channel
+ * from consecutive sequence numbers, so no frame goes in between, whatever its priority.
+ *
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - ztu->_mutex_tx
+ */
+static int8_t __unsafe_z_unicast_send_queued_fragments(_z_transport_unicast_t *ztu, _z_tx_queue_entry_t *entry) {
+    int8_t ret = _Z_RES_OK;
+    while (_z_wbuf_len(&entry->_wbuf) > 0) {
+        _z_zint_t sn = __unsafe_z_unicast_get_sn(ztu, entry->_reliability);  // Get the fragment sequence number
+        __unsafe_z_prepare_wbuf(&ztu->_wbuf, ztu->_link._cap._flow);      // Clear the buffer for serialization
+
+        // Serialize and send one fragment
+        ret = __unsafe_z_serialize_zenoh_fragment(&ztu->_wbuf, &entry->_wbuf, entry->_reliability, sn);
+        if (ret == _Z_RES_OK) {
+            ret = __unsafe_z_unicast_send_batch(ztu);
+        }
+        if (ret == _Z_RES_OK) {
+            _Z_STATS_INC(ztu->_stats, tx_fragments);
+        }
+    }
+    return ret;
+}
+#endif
+
+/**
+ * Frames and sends the network messages in the transmit queues, the higher priority classes first. Consecutive
+ * messages of the same reliability are sent in the same frame.
+ *
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - ztu->_mutex_tx
+ */
+static int8_t __unsafe_z_unicast_drain_tx_queue(_z_transport_unicast_t *ztu) {
+    int8_t ret = _Z_RES_OK;
+
+    _Bool open = false;
+    z_reliability_t reliability = Z_RELIABILITY_RELIABLE;
+    size_t slot = SIZE_MAX;
+    size_t c = __z_unicast_tx_queue_peek(ztu, &slot);
+    if (c < (size_t)Z_TX_QUEUE_PRIORITIES) {
+        // Send the pending batch first, as the buffer is about to be reused
+        (void)__unsafe_z_unicast_flush(ztu);
+    }
+    while (c < (size_t)Z_TX_QUEUE_PRIORITIES) {
+        _z_tx_queue_entry_t *entry = __z_unicast_tx_queue_entry(ztu, c, slot);
+        if (__unsafe_z_unicast_frame_queued(ztu, entry, &open, &reliability, &ret) == false) {
+#if Z_FEATURE_FRAGMENTATION == 1
+            // The message does not fit in a frame, let's fragment it
+            ret = __unsafe_z_unicast_send_queued_fragments(ztu, entry);
+#else
+            _Z_INFO("Sending the message required fragmentation feature that is deactivated.");
+#endif
+        }
+        __z_unicast_tx_queue_pop(ztu, c, entry);
+        c = __z_unicast_tx_queue_peek(ztu, &slot);
+    }
+    if (open == true) {
+        ret = __unsafe_z_unicast_send_batch(ztu);
+    }
+
+    return ret;
+}
+
+/**
+ * Sends the network messages left in the closed transmit queues, once the producers that claimed a slot before they
+ * closed published it. The producers send their messages themselves from then on, after the queued ones.
+ *
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - ztu->_mutex_tx
+ */
+static int8_t __unsafe_z_unicast_drain_closed_tx_queue(_z_transport_unicast_t *ztu) {
+    int8_t ret = _Z_RES_OK;
+
+    // Only allocated once the TX task started
+    if (ztu->_tx_queue_entries != NULL) {
+        zp_mutex_lock(&ztu->_mutex_tx_queue);
+        for (size_t c = 0; c < (size_t)Z_TX_QUEUE_PRIORITIES; c++) {
+            while (_z_mpsc_closer_park(&ztu->_tx_queues[c]) == true) {
+                zp_condvar_wait(&ztu->_cond_tx_claims, &ztu->_mutex_tx_queue);
+            }
+            _z_mpsc_closer_unpark(&ztu->_tx_queues[c]);
+        }
+        zp_mutex_unlock(&ztu->_mutex_tx_queue);
+        ret = __unsafe_z_unicast_drain_tx_queue(ztu);
+    }
+
+    return ret;
+}
+
+static void *_zp_unicast_tx_task(void *ztu_arg) {
+    _z_transport_unicast_t *ztu = (_z_transport_unicast_t *)ztu_arg;
+
+    while (ztu->_tx_task_running == true) {
+        size_t slot = SIZE_MAX;
+        if (__z_unicast_tx_queue_peek(ztu, &slot) < (size_t)Z_TX_QUEUE_PRIORITIES) {
+            zp_mutex_lock(&ztu->_mutex_tx);
+            (void)__unsafe_z_unicast_drain_tx_queue(ztu);
+            zp_mutex_unlock(&ztu->_mutex_tx);
+        } else {
+            // Sleep until a network message is published, or the task is stopped
+            zp_mutex_lock(&ztu->_mutex_tx_queue);
+            if (ztu->_tx_task_running == true) {
+                _Bool empty = true;
+                for (size_t c = 0; c < (size_t)Z_TX_QUEUE_PRIORITIES; c++) {
+                    if (_z_mpsc_consumer_park(&ztu->_tx_queues[c]) == false) {
+                        empty = false;
+                    }
+                }
+                if (empty == true) {
+                    zp_condvar_wait(&ztu->_cond_tx_ready, &ztu->_mutex_tx_queue);
+                }
+                for (size_t c = 0; c < (size_t)Z_TX_QUEUE_PRIORITIES; c++) {
+                    _z_mpsc_consumer_unpark(&ztu->_tx_queues[c]);
+                }
+            }
+            zp_mutex_unlock(&ztu->_mutex_tx_queue);
+        }
+    }
+
+    return NULL;
+}
+
+static void __z_unicast_tx_queue_free(_z_transport_unicast_t *ztu) {
+    for (size_t i = 0; i < ((size_t)Z_TX_QUEUE_PRIORITIES * (size_t)Z_TX_QUEUE_SIZE); i++) {
+        _z_wbuf_clear(&ztu->_tx_queue_entries[i]._wbuf);
+    }
+    zp_free(ztu->_tx_queue_entries);
+    ztu->_tx_queue_entries = NULL;
+    for (size_t c = 0; c < (size_t)Z_TX_QUEUE_PRIORITIES; c++) {
+        _z_mpsc_clear(&ztu->_tx_queues[c]);
+    }
+}
+
+static int8_t __z_unicast_tx_queue_init(_z_transport_unicast_t *ztu) {
+    int8_t ret = _Z_RES_OK;
+
+    size_t len = (size_t)Z_TX_QUEUE_PRIORITIES * (size_t)Z_TX_QUEUE_SIZE;
+    ztu->_tx_queue_entries = (_z_tx_queue_entry_t *)zp_malloc(len * sizeof(_z_tx_queue_entry_t));
+    if (ztu->_tx_queue_entries != NULL) {
+        for (size_t i = 0; i < len; i++) {
+            ztu->_tx_queue_entries[i]._wbuf = _z_wbuf_make(Z_TX_QUEUE_ENTRY_SIZE, false);
+            ztu->_tx_queue_entries[i]._reliability = Z_RELIABILITY_RELIABLE;
+        }
+        for (size_t c = 0; c < (size_t)Z_TX_QUEUE_PRIORITIES; c++) {
+            int8_t res = _z_mpsc_init(&ztu->_tx_queues[c], (size_t)Z_TX_QUEUE_SIZE);
+            if (res != _Z_RES_OK) {
+                ret = res;
+            }
+        }
+        if (ret != _Z_RES_OK) {
+            __z_unicast_tx_queue_free(ztu);
+        }
+    } else {
+        ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+    }
+
+    if (ret == _Z_RES_OK) {
+        ret = zp_mutex_init(&ztu->_mutex_tx_queue);
+    }
+    if (ret == _Z_RES_OK) {
+        ret = zp_condvar_init(&ztu->_cond_tx_ready);
+    }
+    for (size_t c = 0; (c < (size_t)Z_TX_QUEUE_PRIORITIES) && (ret == _Z_RES_OK); c++) {
+        ret = zp_condvar_init(&ztu->_cond_tx_space[c]);
+    }
+    if (ret == _Z_RES_OK) {
+        ret = zp_condvar_init(&ztu->_cond_tx_claims);
+    }
+    if ((ret != _Z_RES_OK) && (ztu->_tx_queue_entries != NULL)) {
+        __z_unicast_tx_queue_free(ztu);
     }
 
     return ret;
 }
+
+int8_t _zp_unicast_start_tx_task(_z_transport_unicast_t *ztu, zp_task_attr_t *attr, zp_task_t *task) {
+    int8_t ret = _Z_RES_OK;
+
+    if (ztu->_tx_task != NULL) {
+        // The queues have a single consumer
+        ret = _Z_ERR_GENERIC;
+    } else if (ztu->_tx_queue_entries == NULL) {
+        // The queues are kept once allocated
+        ret = __z_unicast_tx_queue_init(ztu);
+    } else {
+        for (size_t c = 0; c < (size_t)Z_TX_QUEUE_PRIORITIES; c++) {
+            _z_mpsc_open(&ztu->_tx_queues[c]);
+        }
+    }
+    if (ret == _Z_RES_OK) {
+        // Init memory
+        (void)memset(task, 0, sizeof(zp_task_t));
+        // Init task
+        ztu->_tx_task_running = true;
+        if (zp_task_init(task, attr, _zp_unicast_tx_task, ztu) == _Z_RES_OK) {
+            // Attach task
+            ztu->_tx_task = task;
+        } else {
+            ztu->_tx_task_running = false;
+            for (size_t c = 0; c < (size_t)Z_TX_QUEUE_PRIORITIES; c++) {
+                _z_mpsc_close(&ztu->_tx_queues[c]);
+            }
+            ret = _Z_ERR_SYSTEM_TASK_FAILED;
+        }
+    }
+
+    return ret;
+}
+
+int8_t _zp_unicast_stop_tx_task(_z_transport_unicast_t *ztu) {
+    if (ztu->_tx_task != NULL) {
+        // Close the queues, the producers send their messages themselves from now on
+        for (size_t c = 0; c < (size_t)Z_TX_QUEUE_PRIORITIES; c++) {
+            _z_mpsc_close(&ztu->_tx_queues[c]);
+        }
+        ztu->_tx_task_running = false;
+        // Wake up the TX task, and the producers waiting for it to free a slot
+        zp_mutex_lock(&ztu->_mutex_tx_queue);
+        zp_condvar_signal(&ztu->_cond_tx_ready);
+        for (size_t c = 0; c < (size_t)Z_TX_QUEUE_PRIORITIES; c++) {
+            zp_condvar_signal(&ztu->_cond_tx_space[c]);
+        }
+        zp_mutex_unlock(&ztu->_mutex_tx_queue);
+
+        zp_task_join(ztu->_tx_task);
+        zp_task_free(&ztu->_tx_task);
+
+        // Send the network messages queued so far, unless a producer already did
+        zp_mutex_lock(&ztu->_mutex_tx);
+        (void)__unsafe_z_unicast_drain_closed_tx_queue(ztu);
+        zp_mutex_unlock(&ztu->_mutex_tx);
+    }
+    return _Z_RES_OK;
+}
+
+void _z_unicast_tx_queue_clear(_z_transport_unicast_t *ztu) {
+    (void)_zp_unicast_stop_tx_task(ztu);
+    if (ztu->_tx_queue_entries != NULL) {
+        __z_unicast_tx_queue_free(ztu);
+        for (size_t c = 0; c < (size_t)Z_TX_QUEUE_PRIORITIES; c++) {
+            zp_condvar_free(&ztu->_cond_tx_space[c]);
+        }
+        zp_condvar_free(&ztu->_cond_tx_claims);
+        zp_condvar_free(&ztu->_cond_tx_ready);
+        zp_mutex_free(&ztu->_mutex_tx_queue);
+    }
+}
+#endif
+
+int8_t _z_unicast_send_n_msg(_z_session_t *zn, const _z_network_message_t *n_msg, z_reliability_t reliability,
+                             z_congestion_control_t cong_ctrl) {
+    int8_t ret = _Z_RES_OK;
+    _Z_DEBUG(">> send network message");
+
+#if Z_FEATURE_TX_QUEUE == 1
+    // Hand the network message over to the TX task if it runs, otherwise send it from the calling thread
+    _z_transport_unicast_t *ztu = &zn->_tp._transport._unicast;
+    if ((ztu->_tx_task_running == false) ||
+        (__z_unicast_enqueue_n_msg(ztu, n_msg, reliability, cong_ctrl, &ret) == false)) {
+        ret = __z_unicast_send_n_msg(zn, n_msg, reliability, cong_ctrl);
+    }
 #else
+    ret = __z_unicast_send_n_msg(zn, n_msg, reliability, cong_ctrl);
+#endif
+
+    return ret;
+}
+#else
+int8_t _z_unicast_flush(_z_transport_unicast_t *ztu) {
+    _ZP_UNUSED(ztu);
+    return _Z_ERR_TRANSPORT_NOT_AVAILABLE;
+}
+
+int8_t _z_unicast_flush_expired(_z_transport_unicast_t *ztu) {
+    _ZP_UNUSED(ztu);
+    return _Z_ERR_TRANSPORT_NOT_AVAILABLE;
+}
+
 int8_t _z_unicast_send_t_msg(_z_transport_unicast_t *ztu, const _z_transport_message_t *t_msg) {
     _ZP_UNUSED(ztu);
     _ZP_UNUSED(t_msg);
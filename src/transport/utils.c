@@ -116,3 +116,8 @@ void _z_conduit_sn_list_decrement(const _z_zint_t sn_resolution, _z_conduit_sn_l
         }
     }
 }
+
+size_t _z_batch_wire_len(const _z_link_t *zl, size_t len) {
+    // Stream links prefix each batch with its length
+    return (zl->_cap._flow == Z_LINK_CAP_FLOW_STREAM) ? (len + (size_t)_Z_MSG_LEN_ENC_SIZE) : len;
+}
@@ -46,6 +46,35 @@ size_t _z_cobs_encode(const uint8_t *input, size_t input_len, uint8_t *output) {
     return _z_ptr_u8_diff(pos, output);
 }
 
+void _z_cobs_encoder_init(_z_cobs_encoder_t *enc, uint8_t *output) {
+    enc->_start = output;
+    enc->_code = output;
+    enc->_pos = _z_ptr_u8_offset(output, 1);
+    enc->_count = 1;
+}
+
+void _z_cobs_encoder_update(_z_cobs_encoder_t *enc, const uint8_t *input, size_t input_len) {
+    for (size_t i = 0; i < input_len; i++) {
+        if (input[i] != (uint8_t)0x00) {
+            *enc->_pos = input[i];
+            enc->_pos = _z_ptr_u8_offset(enc->_pos, 1);
+            enc->_count = enc->_count + (uint8_t)1;
+        }
+        // A block ends on a zero or when full, like in _z_cobs_encode the next block is always opened
+        if ((input[i] == (uint8_t)0x00) || (enc->_count == (uint8_t)0xFF)) {
+            *enc->_code = enc->_count;
+            enc->_code = enc->_pos;
+            enc->_pos = _z_ptr_u8_offset(enc->_pos, 1);
+            enc->_count = 1;
+        }
+    }
+}
+
+size_t _z_cobs_encoder_finish(_z_cobs_encoder_t *enc) {
+    *enc->_code = enc->_count;
+    return _z_ptr_u8_diff(enc->_pos, enc->_start);
+}
+
 size_t _z_cobs_decode(const uint8_t *input, size_t input_len, uint8_t *output) {
     const uint8_t *byte = input;
     uint8_t *pos = output;
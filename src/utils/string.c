@@ -19,56 +19,194 @@
 
 #include "zenoh-pico/utils/pointers.h"
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define _Z_STR_SIMD_AVX2
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define _Z_STR_SIMD_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define _Z_STR_SIMD_NEON
+#endif
+
+/*------------------ Byte classification ------------------*/
+#if defined(_Z_STR_SIMD_AVX2)
+typedef __m256i _z_str_block_t;
+
+static inline _z_str_block_t _z_str_block_load(const char *start) { return _mm256_loadu_si256((const __m256i *)start); }
+
+static inline uint32_t _z_str_block_eq(_z_str_block_t block, char c) {
+    return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(c)));
+}
+#elif defined(_Z_STR_SIMD_SSE2)
+typedef __m128i _z_str_block_t;
+
+static inline _z_str_block_t _z_str_block_load(const char *start) { return _mm_loadu_si128((const __m128i *)start); }
+
+static inline uint32_t _z_str_block_eq(_z_str_block_t block, char c) {
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_set1_epi8(c)));
+}
+#elif defined(_Z_STR_SIMD_NEON)
+typedef uint8x16_t _z_str_block_t;
+
+static inline _z_str_block_t _z_str_block_load(const char *start) { return vld1q_u8((const uint8_t *)start); }
+
+static inline uint32_t _z_str_block_eq(_z_str_block_t block, char c) {
+    // NEON has no movemask: weight each matching byte with its bit, then add the weights of each half
+    static const uint8_t weights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t bits = vandq_u8(vceqq_u8(block, vdupq_n_u8((uint8_t)c)), vld1q_u8(weights));
+    return (uint32_t)vaddv_u8(vget_low_u8(bits)) | ((uint32_t)vaddv_u8(vget_high_u8(bits)) << 8);
+}
+#endif
+
+#if defined(_Z_STR_SIMD_AVX2) || defined(_Z_STR_SIMD_SSE2) || defined(_Z_STR_SIMD_NEON)
+#define _Z_STR_SIMD
+// Only reached with GCC or Clang, which define the SIMD macros above
+#define _Z_BITS_FIRST(mask) ((size_t)__builtin_ctz(mask))
+#define _Z_BITS_LAST(mask) ((size_t)31 - (size_t)__builtin_clz(mask))
+#endif
+
+void _z_str_classify(const char *start, size_t len, _z_str_class_t *cls) {
+#if defined(_Z_STR_SIMD)
+    _z_str_block_t block;
+    if (len == (size_t)_Z_STR_CLASS_BLOCK) {
+        block = _z_str_block_load(start);
+    } else {
+        // Never load past the end of the key expression, NUL bytes belong to none of the classes
+        char tail[_Z_STR_CLASS_BLOCK] = {0};
+        (void)memcpy(tail, start, len);
+        block = _z_str_block_load(tail);
+    }
+    cls->slash = _z_str_block_eq(block, '/');
+    cls->star = _z_str_block_eq(block, '*');
+    cls->dollar = _z_str_block_eq(block, '$');
+    cls->at = _z_str_block_eq(block, '@');
+#else
+    (void)memset(cls, 0, sizeof(_z_str_class_t));
+    for (size_t i = 0; i < len; i++) {
+        uint32_t bit = (uint32_t)1 << i;
+        switch (start[i]) {
+            case '/': {
+                cls->slash |= bit;
+            } break;
+            case '*': {
+                cls->star |= bit;
+            } break;
+            case '$': {
+                cls->dollar |= bit;
+            } break;
+            case '@': {
+                cls->at |= bit;
+            } break;
+            default: {
+                // Do nothing
+            } break;
+        }
+    }
+#endif
+}
+
+char const *_z_strchr_se(char const *start, char const *end, char c) {
+    char const *s = start;
+    char const *result = NULL;
+#if defined(_Z_STR_SIMD)
+    for (; (result == NULL) && ((end - s) >= _Z_STR_CLASS_BLOCK); s += _Z_STR_CLASS_BLOCK) {
+        uint32_t mask = _z_str_block_eq(_z_str_block_load(s), c);
+        if (mask != (uint32_t)0) {
+            result = s + _Z_BITS_FIRST(mask);
+        }
+    }
+#endif
+    for (; (result == NULL) && (s < end); s++) {
+        if (s[0] == c) {
+            result = s;
+        }
+    }
+    return result;
+}
+
+char const *_z_strrchr_se(char const *start, char const *end, char c) {
+    char const *e = end;
+    char const *result = NULL;
+#if defined(_Z_STR_SIMD)
+    while ((result == NULL) && ((e - start) >= _Z_STR_CLASS_BLOCK)) {
+        e -= _Z_STR_CLASS_BLOCK;
+        uint32_t mask = _z_str_block_eq(_z_str_block_load(e), c);
+        if (mask != (uint32_t)0) {
+            result = e + _Z_BITS_LAST(mask);
+        }
+    }
+#endif
+    while ((result == NULL) && (e > start)) {
+        e--;
+        if (e[0] == c) {
+            result = e;
+        }
+    }
+    return result;
+}
+
+size_t _z_bits_count(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_popcount(mask);
+#else
+    size_t count = 0;
+    for (uint32_t m = mask; m != (uint32_t)0; m &= m - (uint32_t)1) {
+        count = count + (size_t)1;
+    }
+    return count;
+#endif
+}
+
 _z_str_se_t _z_bstrnew(const char *start) { return (_z_str_se_t){.start = start, .end = strchr(start, 0)}; }
 
 char const *_z_rstrstr(char const *haystack_start, char const *haystack_end, const char *needle_start) {
-    char const *hs = haystack_start;
-    char const *he = haystack_end;
-
     const char *needle_end = strchr(needle_start, 0);
-    hs = _z_cptr_char_offset(hs, _z_ptr_char_diff(needle_end, needle_start));
+    size_t needle_len = _z_ptr_char_diff(needle_end, needle_start);
     char const *result = NULL;
-    while ((result == false) && (he >= hs)) {
-        char found = 1;
-        char const *needle = _z_cptr_char_offset(needle_end, -1);
-        char const *haystack = _z_cptr_char_offset(he, -1);
-        while (needle >= needle_start) {
-            if (needle[0] != haystack[0]) {
-                found = 0;
+    if (needle_len == (size_t)0) {
+        result = haystack_end;
+    } else if (_z_ptr_char_diff(haystack_end, haystack_start) >= needle_len) {
+        // Only the candidates found for the first byte of the needle get compared as a whole
+        char const *he = _z_cptr_char_offset(haystack_end, 1 - (ptrdiff_t)needle_len);
+        while ((result == NULL) && (he > haystack_start)) {
+            char const *candidate = _z_strrchr_se(haystack_start, he, needle_start[0]);
+            if (candidate == NULL) {
                 break;
             }
-
-            needle = _z_cptr_char_offset(needle, -1);
-            haystack = _z_cptr_char_offset(haystack, -1);
-        }
-        if (found == true) {
-            result = he;
+            if (memcmp(candidate, needle_start, needle_len) == 0) {
+                result = _z_cptr_char_offset(candidate, (ptrdiff_t)needle_len);
+            }
+            he = candidate;
         }
-        he = _z_cptr_char_offset(he, -1);
+    } else {
+        // Do nothing. Required to be compliant with MISRA 15.7 rule
     }
     return result;
 }
 
 char const *_z_bstrstr(_z_str_se_t haystack, _z_str_se_t needle) {
-    haystack.end = _z_cptr_char_offset(haystack.end, -1 * _z_ptr_char_diff(needle.end, needle.start));
+    size_t needle_len = _z_ptr_char_diff(needle.end, needle.start);
     char const *result = NULL;
-    for (; (result == false) && (haystack.start <= haystack.end);
-         haystack.start = _z_cptr_char_offset(haystack.start, 1)) {
-        _Bool found = true;
-        char const *n = needle.start;
-        char const *h = haystack.start;
-        while (_z_ptr_char_diff(needle.end, n) > 0) {
-            if (n[0] != h[0]) {
-                found = false;
+    if (needle_len == (size_t)0) {
+        result = haystack.start;
+    } else if (_z_ptr_char_diff(haystack.end, haystack.start) >= needle_len) {
+        // Only the candidates found for the first byte of the needle get compared as a whole
+        char const *hs = haystack.start;
+        char const *he = _z_cptr_char_offset(haystack.end, 1 - (ptrdiff_t)needle_len);
+        while ((result == NULL) && (hs < he)) {
+            char const *candidate = _z_strchr_se(hs, he, needle.start[0]);
+            if (candidate == NULL) {
                 break;
             }
-
-            n = _z_cptr_char_offset(n, 1);
-            h = _z_cptr_char_offset(h, 1);
-        }
-        if (found == true) {
-            result = haystack.start;
+            if (memcmp(candidate, needle.start, needle_len) == 0) {
+                result = candidate;
+            }
+            hs = _z_cptr_char_offset(candidate, 1);
         }
+    } else {
+        // Do nothing. Required to be compliant with MISRA 15.7 rule
     }
     return result;
 }
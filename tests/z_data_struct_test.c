@@ -13,13 +13,21 @@
 //
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include "zenoh-pico/collections/hashmap.h"
+#include "zenoh-pico/collections/mpsc.h"
 #include "zenoh-pico/collections/string.h"
+#include "zenoh-pico/collections/timer_wheel.h"
+#include "zenoh-pico/protocol/codec/network.h"
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/system/platform.h"
+#include "zenoh-pico/transport/common/defrag.h"
 #include "zenoh-pico/transport/transport.h"
+#include "zenoh-pico/utils/checksum.h"
 
 #undef NDEBUG
 #include <assert.h>
@@ -48,8 +56,451 @@ void entry_list_test(void) {
     _z_transport_peer_entry_list_free(&root);
 }
 
+_Bool hashmap_int_eq(const void *val, const void *key) { return *(const int *)val == *(const int *)key; }
+
+void hashmap_test(void) {
+    int vals[100];
+    _z_hashmap_t map = _z_hashmap_make();
+    for (int i = 0; i < 100; i++) {
+        vals[i] = i;
+        // Force collisions by using only 8 distinct hashes
+        assert(_z_hashmap_insert(&map, _z_hash_uint(0, (uint64_t)(i % 8)), &vals[i]) == _Z_RES_OK);
+    }
+    assert(_z_hashmap_len(&map) == 100);
+    for (int i = 0; i < 100; i++) {
+        assert(_z_hashmap_get(&map, _z_hash_uint(0, (uint64_t)(i % 8)), hashmap_int_eq, &i) == &vals[i]);
+    }
+    for (int i = 0; i < 100; i += 2) {
+        assert(_z_hashmap_remove(&map, _z_hash_uint(0, (uint64_t)(i % 8)), hashmap_int_eq, &i) == &vals[i]);
+    }
+    assert(_z_hashmap_len(&map) == 50);
+    for (int i = 0; i < 100; i++) {
+        void *expected = (i % 2 == 0) ? NULL : &vals[i];
+        assert(_z_hashmap_get(&map, _z_hash_uint(0, (uint64_t)(i % 8)), hashmap_int_eq, &i) == expected);
+    }
+    // Removed slots are reused
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 100; i += 2) {
+            assert(_z_hashmap_insert(&map, _z_hash_uint(0, (uint64_t)(i % 8)), &vals[i]) == _Z_RES_OK);
+        }
+        for (int i = 0; i < 100; i += 2) {
+            assert(_z_hashmap_remove(&map, _z_hash_uint(0, (uint64_t)(i % 8)), hashmap_int_eq, &i) == &vals[i]);
+        }
+    }
+    assert(map._capacity <= 256);
+    assert(_z_hash_str(0, "a/b") == _z_hash_bytes(0, "a/b", 3));
+    assert(_z_hash_str(0, "a/b") != _z_hash_str(0, "a/c"));
+    _z_hashmap_clear(&map, _z_noop_free);
+    assert(_z_hashmap_is_empty(&map));
+}
+
+#define TIMERS 3000
+
+void timer_wheel_test(void) {
+    printf(">>> timer wheel\r\n");
+    static _z_timer_t timers[TIMERS];
+    static uint64_t expiries[TIMERS];
+    static _Bool fired[TIMERS];
+    _z_timer_wheel_t tw;
+    _z_timer_wheel_init(&tw, 1000);
+
+    // Deadlines on every level and beyond, at an unaligned start
+    uint32_t seed = 0x12345678;
+    for (size_t i = 0; i < TIMERS; i++) {
+        static const uint64_t spans[] = {1, 70, 5000, 300000, 2000000};
+        seed = seed * 1103515245 + 12345;
+        expiries[i] = 1000 + ((uint64_t)(seed >> 8) % spans[i % 5]);
+        fired[i] = false;
+        _z_timer_init(&timers[i], &fired[i]);
+        _z_timer_wheel_add(&tw, &timers[i], expiries[i]);
+    }
+    // Cancelled timers never fire
+    for (size_t i = 0; i < TIMERS; i += 3) {
+        _z_timer_wheel_remove(&tw, &timers[i]);
+        assert(_z_timer_is_scheduled(&timers[i]) == false);
+        fired[i] = true;
+    }
+    _z_timer_wheel_remove(&tw, &timers[0]);
+    assert(_z_timer_wheel_len(&tw) == TIMERS - ((TIMERS + 2) / 3));
+
+    // Each timer expires on the first advance past its deadline, in deadline order
+    uint64_t now = 999;
+    while (_z_timer_wheel_is_empty(&tw) == false) {
+        uint64_t last = now;
+        seed = seed * 1103515245 + 12345;
+        now = now + (uint64_t)(seed >> 8) % 3000;
+        uint64_t previous = 0;
+        for (_z_timer_t *t = _z_timer_wheel_advance(&tw, now); t != NULL; t = t->_next) {
+            size_t i = (size_t)(t - timers);
+            assert(fired[i] == false);
+            assert((expiries[i] > last) && (expiries[i] <= now));
+            assert(expiries[i] >= previous);
+            assert(_z_timer_is_scheduled(t) == false);
+            previous = expiries[i];
+            fired[i] = true;
+        }
+    }
+    for (size_t i = 0; i < TIMERS; i++) {
+        assert(fired[i] == true);
+    }
+
+    // Deadlines already passed expire on the next tick
+    _z_timer_wheel_add(&tw, &timers[0], 10);
+    assert(_z_timer_wheel_advance(&tw, now + 1) == &timers[0]);
+    assert(_z_timer_wheel_advance(&tw, now + 100000) == NULL);
+}
+
+#define MPSC_PRODUCERS 4
+#define MPSC_COUNT 10000
+
+typedef struct {
+    _z_mpsc_t *q;
+    size_t *vals;
+    size_t id;
+} mpsc_producer_t;
+
+void *mpsc_produce(void *arg) {
+    mpsc_producer_t *p = (mpsc_producer_t *)arg;
+    for (size_t i = 0; i < MPSC_COUNT; i++) {
+        size_t slot = _z_mpsc_claim(p->q);
+        while (slot == SIZE_MAX) {
+            zp_sleep_us(10);
+            slot = _z_mpsc_claim(p->q);
+        }
+        p->vals[slot] = (p->id * MPSC_COUNT) + i;
+        _z_mpsc_publish(p->q, slot);
+    }
+    return NULL;
+}
+
+void mpsc_test(void) {
+    printf(">>> mpsc\r\n");
+
+    _z_mpsc_t q;
+    assert(_z_mpsc_init(&q, 6) != _Z_RES_OK);
+    assert(_z_mpsc_init(&q, 4) == _Z_RES_OK);
+    assert(_z_mpsc_capacity(&q) == 4);
+    assert(_z_mpsc_is_empty(&q) == true);
+    assert(_z_mpsc_peek(&q) == SIZE_MAX);
+
+    // Slots are consumed in claim order, once published
+    size_t a = _z_mpsc_claim(&q);
+    size_t b = _z_mpsc_claim(&q);
+    assert((a != SIZE_MAX) && (b != SIZE_MAX) && (a != b));
+    assert(_z_mpsc_is_empty(&q) == false);
+    _z_mpsc_publish(&q, b);
+    assert(_z_mpsc_peek(&q) == SIZE_MAX);
+    _z_mpsc_publish(&q, a);
+    assert(_z_mpsc_peek(&q) == a);
+    _z_mpsc_pop(&q);
+    assert(_z_mpsc_peek(&q) == b);
+    _z_mpsc_pop(&q);
+    assert(_z_mpsc_is_empty(&q) == true);
+
+    // Claims fail when the queue is full, and wrap around once slots are popped
+    for (size_t round = 0; round < 3; round++) {
+        for (size_t i = 0; i < 4; i++) {
+            size_t slot = _z_mpsc_claim(&q);
+            assert(slot != SIZE_MAX);
+            _z_mpsc_publish(&q, slot);
+        }
+        assert(_z_mpsc_claim(&q) == SIZE_MAX);
+        for (size_t i = 0; i < 4; i++) {
+            assert(_z_mpsc_peek(&q) != SIZE_MAX);
+            _z_mpsc_pop(&q);
+        }
+        assert(_z_mpsc_peek(&q) == SIZE_MAX);
+    }
+
+    // Parked sides are reported to the other one
+    assert(_z_mpsc_consumer_park(&q) == true);
+    a = _z_mpsc_claim(&q);
+    assert(_z_mpsc_publish(&q, a) == true);
+    assert(_z_mpsc_consumer_park(&q) == false);
+    _z_mpsc_consumer_unpark(&q);
+    for (size_t i = 0; i < 3; i++) {
+        assert(_z_mpsc_publish(&q, _z_mpsc_claim(&q)) == false);
+    }
+    assert(_z_mpsc_producer_park(&q) == true);
+    assert(_z_mpsc_pop(&q) == true);
+    assert(_z_mpsc_producer_park(&q) == false);
+    _z_mpsc_producer_unpark(&q);
+    _z_mpsc_producer_unpark(&q);
+    assert(_z_mpsc_pop(&q) == false);
+    while (_z_mpsc_peek(&q) != SIZE_MAX) {
+        _z_mpsc_pop(&q);
+    }
+
+    // Closing fails the next claims, the slots claimed before being awaited until published
+    a = _z_mpsc_claim(&q);
+    assert(_z_mpsc_has_claims(&q) == true);
+    _z_mpsc_close(&q);
+    assert(_z_mpsc_is_closed(&q) == true);
+    assert(_z_mpsc_claim(&q) == SIZE_MAX);
+    assert(_z_mpsc_has_claims(&q) == true);
+    assert(_z_mpsc_closer_park(&q) == true);
+    assert(_z_mpsc_closer_is_parked(&q) == true);
+    assert(_z_mpsc_publish(&q, a) == true);
+    assert(_z_mpsc_has_claims(&q) == false);
+    assert(_z_mpsc_closer_park(&q) == false);
+    _z_mpsc_closer_unpark(&q);
+    assert(_z_mpsc_closer_is_parked(&q) == false);
+    assert(_z_mpsc_peek(&q) == a);
+    _z_mpsc_pop(&q);
+    assert(_z_mpsc_is_empty(&q) == true);
+    _z_mpsc_open(&q);
+    assert(_z_mpsc_is_closed(&q) == false);
+    a = _z_mpsc_claim(&q);
+    assert(a != SIZE_MAX);
+    _z_mpsc_publish(&q, a);
+    _z_mpsc_clear(&q);
+
+#if Z_FEATURE_MULTI_THREAD == 1
+    // Concurrent producers, each one's values are consumed in order
+    size_t vals[16];
+    assert(_z_mpsc_init(&q, 16) == _Z_RES_OK);
+    zp_task_t tasks[MPSC_PRODUCERS];
+    mpsc_producer_t producers[MPSC_PRODUCERS];
+    for (size_t i = 0; i < MPSC_PRODUCERS; i++) {
+        producers[i] = (mpsc_producer_t){.q = &q, .vals = vals, .id = i};
+        assert(zp_task_init(&tasks[i], NULL, mpsc_produce, &producers[i]) == _Z_RES_OK);
+    }
+    size_t next[MPSC_PRODUCERS] = {0};
+    for (size_t n = 0; n < MPSC_PRODUCERS * MPSC_COUNT; n++) {
+        size_t slot = _z_mpsc_peek(&q);
+        while (slot == SIZE_MAX) {
+            slot = _z_mpsc_peek(&q);
+        }
+        size_t id = vals[slot] / MPSC_COUNT;
+        assert(vals[slot] % MPSC_COUNT == next[id]);
+        next[id]++;
+        _z_mpsc_pop(&q);
+    }
+    for (size_t i = 0; i < MPSC_PRODUCERS; i++) {
+        zp_task_join(&tasks[i]);
+        assert(next[i] == MPSC_COUNT);
+    }
+    assert(_z_mpsc_is_empty(&q) == true);
+    _z_mpsc_clear(&q);
+#endif
+}
+
+#if Z_FEATURE_FRAGMENTATION == 1
+#define DEFRAG_PAYLOAD_SIZE 1000
+#define DEFRAG_FRAGMENT_SIZE 64
+
+void defrag_test(void) {
+    printf(">>> defrag\r\n");
+
+    _z_defrag_pool_t pool;
+    assert(_z_defrag_pool_init(&pool, Z_DEFRAG_POOL_SIZE + 1) == _Z_RES_OK);
+    assert(pool._len == (size_t)Z_DEFRAG_POOL_SIZE);
+    _z_defrag_t dbuf;
+    _z_defrag_init(&dbuf);
+    assert(_z_defrag_len(&dbuf) == 0);
+
+    // A network message split in fragments, reassembled in a buffer borrowed from the pool
+    uint8_t payload[DEFRAG_PAYLOAD_SIZE];
+    for (size_t i = 0; i < DEFRAG_PAYLOAD_SIZE; i++) {
+        payload[i] = (uint8_t)i;
+    }
+    _z_network_message_t n_msg = {
+        ._tag = _Z_N_PUSH,
+        ._body._push =
+            {
+                ._key = _z_rid_with_suffix(1, NULL),
+                ._qos = _z_n_qos_make(0, 1, Z_PRIORITY_DEFAULT),
+                ._timestamp = _z_timestamp_null(),
+                ._body._is_put = true,
+                ._body._body._put =
+                    {
+                        ._commons = {._timestamp = _z_timestamp_null(), ._source_info = _z_source_info_null()},
+                        ._payload = _z_bytes_wrap(payload, DEFRAG_PAYLOAD_SIZE),
+                    },
+            },
+    };
+    _z_wbuf_t wbf = _z_wbuf_make(2 * DEFRAG_PAYLOAD_SIZE, false);
+    assert(_z_network_message_encode(&wbf, &n_msg) == _Z_RES_OK);
+    const uint8_t *encoded = _z_wbuf_get_iosli(&wbf, 0)->_buf;
+    size_t encoded_len = _z_wbuf_len(&wbf);
+
+    const uint8_t *pooled = NULL;
+    for (size_t round = 0; round < 2; round++) {
+        for (size_t pos = 0; pos < encoded_len; pos += DEFRAG_FRAGMENT_SIZE) {
+            size_t len = (encoded_len - pos < DEFRAG_FRAGMENT_SIZE) ? encoded_len - pos : DEFRAG_FRAGMENT_SIZE;
+            _z_bytes_t fragment = _z_bytes_wrap(&encoded[pos], len);
+            assert(_z_defrag_push(&dbuf, &pool, &fragment) == _Z_RES_OK);
+            assert(_z_defrag_len(&dbuf) == pos + len);
+            assert(pool._len == (size_t)Z_DEFRAG_POOL_SIZE - 1);
+        }
+        // The buffer released by a message is the one lent to the next
+        if (round == 0) {
+            pooled = _z_zbuf_start(&dbuf._zbuf);
+        } else {
+            assert(_z_zbuf_start(&dbuf._zbuf) == pooled);
+        }
+
+        _z_zenoh_message_t zm;
+        assert(_z_defrag_decode(&dbuf, &zm) == _Z_RES_OK);
+        assert(zm._tag == _Z_N_PUSH);
+        _z_bytes_t decoded = zm._body._push._body._body._put._payload;
+        assert(decoded.len == DEFRAG_PAYLOAD_SIZE);
+        assert(memcmp(decoded.start, payload, DEFRAG_PAYLOAD_SIZE) == 0);
+        _z_msg_clear(&zm);
+
+        _z_defrag_release(&dbuf, &pool);
+        assert(_z_defrag_len(&dbuf) == 0);
+        assert(pool._len == (size_t)Z_DEFRAG_POOL_SIZE);
+    }
+
+    // A gap in the sequence numbers gives up the partial message, the next one starting from an empty buffer
+    _z_bytes_t fragment = _z_bytes_wrap(encoded, DEFRAG_FRAGMENT_SIZE);
+    assert(_z_defrag_push(&dbuf, &pool, &fragment) == _Z_RES_OK);
+    _z_defrag_release(&dbuf, &pool);
+    assert(pool._len == (size_t)Z_DEFRAG_POOL_SIZE);
+    assert(_z_defrag_push(&dbuf, &pool, &fragment) == _Z_RES_OK);
+    assert(_z_defrag_len(&dbuf) == DEFRAG_FRAGMENT_SIZE);
+    assert(_z_zbuf_start(&dbuf._zbuf) == pooled);
+
+    // A message exceeding Z_FRAG_MAX_SIZE is dropped until its last fragment, its buffer going back to the pool
+    uint8_t *large = (uint8_t *)zp_malloc(Z_FRAG_MAX_SIZE);
+    assert(large != NULL);
+    (void)memset(large, 0, Z_FRAG_MAX_SIZE);
+    _z_bytes_t oversize = _z_bytes_wrap(large, Z_FRAG_MAX_SIZE);
+    assert(_z_defrag_push(&dbuf, &pool, &oversize) == _Z_ERR_TRANSPORT_NO_SPACE);
+    assert(dbuf._drop == true);
+    assert(_z_defrag_len(&dbuf) == 0);
+    assert(pool._len == (size_t)Z_DEFRAG_POOL_SIZE);
+    assert(_z_defrag_push(&dbuf, &pool, &fragment) == _Z_ERR_TRANSPORT_NO_SPACE);
+    assert(pool._len == (size_t)Z_DEFRAG_POOL_SIZE);
+    _z_defrag_release(&dbuf, &pool);
+    assert(dbuf._drop == false);
+    assert(_z_defrag_push(&dbuf, &pool, &fragment) == _Z_RES_OK);
+    _z_defrag_release(&dbuf, &pool);
+
+    // A message of exactly Z_FRAG_MAX_SIZE bytes still fits
+    assert(_z_defrag_push(&dbuf, &pool, &oversize) == _Z_RES_OK);
+    assert(_z_defrag_len(&dbuf) == Z_FRAG_MAX_SIZE);
+    _z_defrag_release(&dbuf, &pool);
+    zp_free(large);
+
+    // Buffers beyond Z_DEFRAG_POOL_SIZE are freed on release rather than pooled
+    _z_defrag_t dbufs[Z_DEFRAG_POOL_SIZE + 1];
+    for (size_t i = 0; i < (size_t)Z_DEFRAG_POOL_SIZE + 1; i++) {
+        _z_defrag_init(&dbufs[i]);
+        assert(_z_defrag_push(&dbufs[i], &pool, &fragment) == _Z_RES_OK);
+    }
+    assert(pool._len == 0);
+    for (size_t i = 0; i < (size_t)Z_DEFRAG_POOL_SIZE + 1; i++) {
+        _z_defrag_release(&dbufs[i], &pool);
+        assert(_z_defrag_len(&dbufs[i]) == 0);
+    }
+    assert(pool._len == (size_t)Z_DEFRAG_POOL_SIZE);
+
+    _z_wbuf_clear(&wbf);
+    _z_defrag_clear(&dbuf);
+    _z_defrag_pool_clear(&pool);
+    assert(pool._len == 0);
+}
+#endif
+
+#if Z_FEATURE_SLAB_ALLOCATOR == 1
+#define SLAB_BLOCKS 256
+
+void slab_test(void) {
+    printf(">>> slab\r\n");
+
+    void *blocks[SLAB_BLOCKS];
+    zp_malloc_stats_t before;
+    zp_malloc_stats_t after;
+
+    // Warm up the pools, then allocating the same blocks again must not reach the system allocator
+    for (size_t round = 0; round < 2; round++) {
+        if (round == 1) {
+            zp_malloc_stats_get(&before);
+        }
+        for (size_t i = 0; i < SLAB_BLOCKS; i++) {
+            size_t size = (i % 64) * 16 + 1;
+            blocks[i] = zp_malloc(size);
+            assert(blocks[i] != NULL);
+            assert(((uintptr_t)blocks[i] % sizeof(void *)) == 0);
+            memset(blocks[i], (int)i, size);
+        }
+        for (size_t i = 0; i < SLAB_BLOCKS; i++) {
+            assert(((uint8_t *)blocks[i])[0] == (uint8_t)i);
+            zp_free(blocks[i]);
+        }
+    }
+    zp_malloc_stats_get(&after);
+    assert(after.system_allocs == before.system_allocs);
+    assert(after.chunks == before.chunks);
+
+    // Blocks keep their content when growing out of their size class
+    char *s = (char *)zp_malloc(10);
+    memcpy(s, "slab", 5);
+    s = (char *)zp_realloc(s, 12);
+    assert(strcmp(s, "slab") == 0);
+    s = (char *)zp_realloc(s, 200);
+    assert(strcmp(s, "slab") == 0);
+    s = (char *)zp_realloc(s, 4096);
+    assert(strcmp(s, "slab") == 0);
+    zp_free(s);
+
+    // Large blocks go to the system allocator
+    zp_malloc_stats_get(&before);
+    void *large = zp_malloc(4096);
+    assert(large != NULL);
+    zp_free(large);
+    zp_malloc_stats_get(&after);
+    assert(after.system_allocs == before.system_allocs + 1);
+    assert(after.system_frees == before.system_frees + 1);
+}
+#endif
+
+// The bit-at-a-time definition, which the table and folding kernels must match bit for bit
+uint32_t crc32_bitwise(const uint8_t *message, size_t len) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc = crc ^ (uint32_t)message[i];
+        for (uint8_t j = 0; j < (uint8_t)8; j++) {
+            crc = (crc >> 1) ^ ((uint32_t)0x04C11DB7 & (uint32_t)(-(int32_t)(crc & (uint32_t)1)));
+        }
+    }
+    return ~crc;
+}
+
+void crc32_test(void) {
+    printf(">>> crc32\r\n");
+
+    assert(_z_crc32((const uint8_t *)"123456789", 9) == 0xFC4F2BE9);
+
+    uint8_t buf[1024 + 16];
+    uint32_t seed = 0x12345678;
+    for (size_t i = 0; i < sizeof(buf); i++) {
+        seed = seed * 1103515245 + 12345;
+        buf[i] = (uint8_t)(seed >> 16);
+    }
+    // Every tail length around the 8 and 16 bytes steps, at every alignment
+    for (size_t offset = 0; offset < 16; offset++) {
+        for (size_t len = 0; len <= 300; len++) {
+            assert(_z_crc32(&buf[offset], len) == crc32_bitwise(&buf[offset], len));
+        }
+        assert(_z_crc32(&buf[offset], 1024) == crc32_bitwise(&buf[offset], 1024));
+    }
+}
+
 int main(void) {
     entry_list_test();
+    hashmap_test();
+    timer_wheel_test();
+    mpsc_test();
+#if Z_FEATURE_FRAGMENTATION == 1
+    defrag_test();
+#endif
+    crc32_test();
+#if Z_FEATURE_SLAB_ALLOCATOR == 1
+    slab_test();
+#endif
     char *s = (char *)malloc(64);
     size_t len = 128;
 
@@ -0,0 +1,316 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico/session/dispatch.h"
+#include "zenoh-pico/system/platform.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_FEATURE_DISPATCH_POOL == 1 && Z_FEATURE_SUBSCRIPTION == 1
+#define N_SAMPLES 1000
+
+// The samples received by a subscription callback
+typedef struct {
+    size_t count;
+    _Bool ordered;
+    size_t inlined;
+} received_t;
+
+static zp_mutex_t gate;
+static size_t dropped;
+static _z_dispatch_pool_t pool;
+static _z_subscription_rc_t inner;
+static uint32_t inner_next;
+static uint32_t burst;
+
+_z_sample_t sample(uint32_t *value) {
+    _z_sample_t s = {
+        .keyexpr = _z_rname("test/dispatch"),
+        .payload = _z_bytes_wrap((const uint8_t *)value, sizeof(uint32_t)),
+        .timestamp = _z_timestamp_null(),
+        .encoding = {.prefix = Z_ENCODING_PREFIX_DEFAULT, .suffix = _z_bytes_empty()},
+        .kind = Z_SAMPLE_KIND_PUT,
+#if Z_FEATURE_ATTACHMENT == 1
+        .attachment = z_attachment_null(),
+#endif
+    };
+    return s;
+}
+
+void data_handler(const _z_sample_t *s, void *arg) {
+    received_t *r = (received_t *)arg;
+    uint32_t value = 0;
+    (void)memcpy(&value, s->payload.start, sizeof(value));
+    if ((size_t)value != r->count) {
+        r->ordered = false;
+    }
+    r->count++;
+}
+
+// Holds the worker on the first sample until the gate opens
+void gated_handler(const _z_sample_t *s, void *arg) {
+    if (((received_t *)arg)->count == (size_t)0) {
+        zp_mutex_lock(&gate);
+        zp_mutex_unlock(&gate);
+    }
+    data_handler(s, arg);
+}
+
+// Publishes a burst of samples locally from a pooled callback
+void publishing_handler(const _z_sample_t *s, void *arg) {
+    received_t *r = (received_t *)arg;
+    for (uint32_t i = 0; i < burst; i++) {
+        uint32_t value = inner_next;
+        inner_next++;
+        _z_sample_t is = sample(&value);
+        if (_z_dispatch_pool_enqueue(&pool, &inner, &is) == false) {
+            // Dispatched inline, as the subscriptions do when the pool leaves them the sample
+            inner.in->val._callback(&is, inner.in->val._arg);
+            r->inlined++;
+        }
+    }
+    data_handler(s, arg);
+}
+
+void drop_handler(void *arg) {
+    (void)(arg);
+    dropped++;
+}
+
+_z_subscription_rc_t subscription(uint32_t id, _z_data_handler_t callback, received_t *r) {
+    (void)memset(r, 0, sizeof(received_t));
+    r->ordered = true;
+    _z_subscription_t s;
+    (void)memset(&s, 0, sizeof(_z_subscription_t));
+    s._id = id;
+    s._callback = callback;
+    s._dropper = drop_handler;
+    s._arg = r;
+    s._info.dispatch = Z_DISPATCH_POOLED;
+    return _z_subscription_rc_new_from_val(s);
+}
+
+void enqueue(_z_subscription_rc_t *sub, uint32_t from, uint32_t to) {
+    for (uint32_t i = from; i < to; i++) {
+        _z_sample_t s = sample(&i);
+        assert(_z_dispatch_pool_enqueue(&pool, sub, &s) == true);
+    }
+}
+
+void order_test(void) {
+    printf("Test: samples dispatched in order\n");
+    received_t r[3];
+    _z_subscription_rc_t subs[3];
+    _z_dispatch_pool_init(&pool);
+    assert(_z_dispatch_pool_start(&pool, NULL, 2) == _Z_RES_OK);
+    for (size_t i = 0; i < 3; i++) {
+        subs[i] = subscription((uint32_t)i, data_handler, &r[i]);
+    }
+
+    // Interleaved, the samples of each subscription go through the same worker
+    for (uint32_t v = 0; v < N_SAMPLES; v++) {
+        for (size_t i = 0; i < 3; i++) {
+            enqueue(&subs[i], v, v + 1);
+        }
+    }
+    assert(_z_dispatch_pool_stop(&pool) == _Z_RES_OK);
+    for (size_t i = 0; i < 3; i++) {
+        assert(r[i].count == N_SAMPLES);
+        assert(r[i].ordered == true);
+        (void)_z_subscription_rc_drop(&subs[i]);
+    }
+    _z_dispatch_pool_clear(&pool);
+}
+
+static received_t full_r;
+static _z_subscription_rc_t full_sub;
+static volatile size_t produced;
+
+void *producer_task(void *arg) {
+    (void)(arg);
+    for (uint32_t i = 0; i <= (uint32_t)Z_DISPATCH_POOL_QUEUE_SIZE; i++) {
+        enqueue(&full_sub, i, i + 1);
+        produced = produced + (size_t)1;
+    }
+    return NULL;
+}
+
+void queue_full_test(void) {
+    printf("Test: producers wait for room when the queue is full\n");
+    _z_dispatch_pool_init(&pool);
+    assert(_z_dispatch_pool_start(&pool, NULL, 1) == _Z_RES_OK);
+    full_sub = subscription(0, gated_handler, &full_r);
+    produced = 0;
+
+    // The first sample holds the worker, the queue fills up behind it
+    zp_mutex_lock(&gate);
+    zp_task_t *task = (zp_task_t *)zp_malloc(sizeof(zp_task_t));
+    assert(zp_task_init(task, NULL, producer_task, NULL) == _Z_RES_OK);
+    while (produced < (size_t)Z_DISPATCH_POOL_QUEUE_SIZE) {
+        zp_sleep_ms(1);
+    }
+    zp_sleep_ms(100);
+    assert(produced == (size_t)Z_DISPATCH_POOL_QUEUE_SIZE);
+    assert(full_r.count == 0);
+
+    // Nothing is dropped once the worker makes room
+    zp_mutex_unlock(&gate);
+    zp_task_join(task);
+    zp_task_free(&task);
+    assert(produced == (size_t)Z_DISPATCH_POOL_QUEUE_SIZE + 1);
+    assert(_z_dispatch_pool_stop(&pool) == _Z_RES_OK);
+    assert(full_r.count == (size_t)Z_DISPATCH_POOL_QUEUE_SIZE + 1);
+    assert(full_r.ordered == true);
+    (void)_z_subscription_rc_drop(&full_sub);
+    _z_dispatch_pool_clear(&pool);
+}
+
+void shutdown_test(void) {
+    printf("Test: stopping runs the queued samples\n");
+    received_t r;
+    _z_dispatch_pool_init(&pool);
+    assert(_z_dispatch_pool_start(&pool, NULL, 1) == _Z_RES_OK);
+    _z_subscription_rc_t sub = subscription(0, gated_handler, &r);
+    dropped = 0;
+
+    zp_mutex_lock(&gate);
+    enqueue(&sub, 0, 10);
+    // The queued samples keep the undeclared subscription alive
+    (void)_z_subscription_rc_drop(&sub);
+    assert(dropped == 0);
+    zp_mutex_unlock(&gate);
+    assert(_z_dispatch_pool_stop(&pool) == _Z_RES_OK);
+    assert(r.count == 10);
+    assert(r.ordered == true);
+    assert(dropped == 1);
+
+    // Stopped, the pool leaves the samples to the caller
+    sub = subscription(0, data_handler, &r);
+    uint32_t value = 0;
+    _z_sample_t s = sample(&value);
+    assert(_z_dispatch_pool_enqueue(&pool, &sub, &s) == false);
+    assert(r.count == 0);
+
+    // Restarted, the pool queues them again
+    assert(_z_dispatch_pool_start(&pool, NULL, 1) == _Z_RES_OK);
+    enqueue(&sub, 0, 10);
+    assert(_z_dispatch_pool_stop(&pool) == _Z_RES_OK);
+    assert(r.count == 10);
+    (void)_z_subscription_rc_drop(&sub);
+    _z_dispatch_pool_clear(&pool);
+}
+
+void reentrancy_test(size_t workers) {
+    printf("Test: callbacks publishing locally from a worker, %zu worker(s)\n", workers);
+    received_t r;
+    received_t inner_r;
+    _z_dispatch_pool_init(&pool);
+    assert(_z_dispatch_pool_start(&pool, NULL, workers) == _Z_RES_OK);
+    // With a single worker, both subscriptions go to it, which would wait for itself once its queue is full
+    _z_subscription_rc_t sub = subscription(0, publishing_handler, &r);
+    inner = subscription(1, data_handler, &inner_r);
+    inner_next = 0;
+
+    // The samples published from a worker are queued in order while there is room
+    burst = (uint32_t)(Z_DISPATCH_POOL_QUEUE_SIZE / 2);
+    enqueue(&sub, 0, 1);
+    // Let the worker run the callback, stopping the pool would run it on this task
+    while (r.count < (size_t)1) {
+        zp_sleep_ms(1);
+    }
+    assert(_z_dispatch_pool_stop(&pool) == _Z_RES_OK);
+    assert(r.inlined == 0);
+    assert(inner_r.count == (size_t)burst);
+    assert(inner_r.ordered == true);
+
+    // Then left to the worker publishing them, rather than waiting for room
+    assert(_z_dispatch_pool_start(&pool, NULL, workers) == _Z_RES_OK);
+    burst = (uint32_t)(2 * Z_DISPATCH_POOL_QUEUE_SIZE);
+    enqueue(&sub, 1, 2);
+    while (r.count < (size_t)2) {
+        zp_sleep_ms(1);
+    }
+    assert(_z_dispatch_pool_stop(&pool) == _Z_RES_OK);
+    if (workers == (size_t)1) {
+        // Another worker may keep up with the burst
+        assert(r.inlined > 0);
+    }
+    assert(inner_r.count == (size_t)(Z_DISPATCH_POOL_QUEUE_SIZE / 2) + (size_t)burst);
+
+    (void)_z_subscription_rc_drop(&sub);
+    (void)_z_subscription_rc_drop(&inner);
+    _z_dispatch_pool_clear(&pool);
+}
+
+static volatile _Bool stopped;
+
+void *stop_task(void *arg) {
+    (void)(arg);
+    assert(_z_dispatch_pool_stop(&pool) == _Z_RES_OK);
+    stopped = true;
+    return NULL;
+}
+
+void claim_test(void) {
+    printf("Test: stopping waits for the samples being queued\n");
+    _z_dispatch_pool_init(&pool);
+    assert(_z_dispatch_pool_start(&pool, NULL, 1) == _Z_RES_OK);
+    _z_dispatch_worker_t *w = &pool._workers[0];
+
+    // A producer claims a slot, then the pool is stopped
+    size_t slot = _z_mpsc_claim(&w->_queue);
+    assert(slot != SIZE_MAX);
+    stopped = false;
+    zp_task_t stopper;
+    assert(zp_task_init(&stopper, NULL, stop_task, NULL) == _Z_RES_OK);
+    zp_sleep_ms(100);
+    assert(stopped == false);
+    assert(_z_mpsc_is_closed(&w->_queue) == true);
+
+    // Published empty, as when the sample could not be copied, as the producers do
+    if (_z_mpsc_publish(&w->_queue, slot) == true) {
+        zp_mutex_lock(&w->_mutex);
+        zp_condvar_signal(&w->_cond_ready);
+        zp_mutex_unlock(&w->_mutex);
+    }
+    zp_task_join(&stopper);
+    assert(stopped == true);
+    assert(_z_mpsc_is_empty(&w->_queue) == true);
+    _z_dispatch_pool_clear(&pool);
+}
+
+int main(void) {
+    assert(zp_mutex_init(&gate) == _Z_RES_OK);
+    order_test();
+    queue_full_test();
+    shutdown_test();
+    reentrancy_test(1);
+    reentrancy_test(2);
+    claim_test();
+    zp_mutex_free(&gate);
+    return 0;
+}
+#else
+int main(void) {
+    printf("ERROR: Zenoh pico was compiled without Z_FEATURE_DISPATCH_POOL but this test requires it.\n");
+    return 0;
+}
+#endif
@@ -19,6 +19,7 @@
 #include <string.h>
 
 #include "zenoh-pico/protocol/iobuf.h"
+#include "zenoh-pico/utils/result.h"
 
 #undef NDEBUG
 #include <assert.h>
@@ -554,6 +555,164 @@ void wbuf_add_iosli(void) {
     _z_wbuf_clear(&wbf);
 }
 
+void wbuf_wrap_bytes_fixed(void) {
+    size_t len = 64;
+    _z_wbuf_t wbf = _z_wbuf_make(len, false);
+    printf("\n>>> WBuf => Wrap bytes in a non-expandable WBuf\n");
+    print_wbuf_overview(&wbf);
+
+    uint8_t bytes[32];
+    for (uint8_t i = 0; i < 32; i++) {
+        bytes[i] = (uint8_t)(i + 16);
+    }
+
+    for (int r = 0; r < 2; r++) {
+        for (uint8_t i = 0; i < 16; i++) {
+            assert(_z_wbuf_write(&wbf, i) == 0);
+        }
+        // The wrapped bytes are aliased, and count against the capacity
+        assert(_z_wbuf_wrap_bytes(&wbf, bytes, 0, sizeof(bytes)) == 0);
+        assert(_z_wbuf_len_iosli(&wbf) == 3);
+        assert(_z_wbuf_get_iosli(&wbf, 1)->_buf == bytes);
+        assert(_z_wbuf_capacity(&wbf) == len);
+        assert(_z_wbuf_wrap_bytes(&wbf, bytes, 0, sizeof(bytes)) == _Z_ERR_TRANSPORT_NO_SPACE);
+        for (uint8_t i = 48; i < 64; i++) {
+            assert(_z_wbuf_write(&wbf, i) == 0);
+        }
+        assert(_z_wbuf_write(&wbf, 0) == _Z_ERR_TRANSPORT_NO_SPACE);
+
+        _z_zbuf_t zbf = _z_wbuf_to_zbuf(&wbf);
+        assert(_z_zbuf_len(&zbf) == len);
+        for (uint8_t i = 0; i < len; i++) {
+            assert(_z_zbuf_read(&zbf) == i);
+        }
+        _z_zbuf_clear(&zbf);
+
+        // Resetting drops the wrapped bytes and restores the whole capacity
+        _z_wbuf_reset(&wbf);
+        assert(_z_wbuf_len_iosli(&wbf) == 1);
+        assert(_z_wbuf_space_left(&wbf) == len);
+    }
+
+    _z_wbuf_clear(&wbf);
+}
+
+void wbuf_siphon(void) {
+    size_t len = 64;
+    printf("\n>>> WBuf => Siphon bytes from an expandable WBuf\n");
+
+    uint8_t bytes[32];
+    for (uint8_t i = 0; i < 32; i++) {
+        bytes[i] = (uint8_t)(i + 4);
+    }
+
+    for (size_t threshold = 0; threshold <= 32; threshold += 32) {
+        _z_wbuf_t src = _z_wbuf_make(8, true);
+        for (uint8_t i = 0; i < 4; i++) {
+            assert(_z_wbuf_write(&src, i) == 0);
+        }
+        assert(_z_wbuf_wrap_bytes(&src, bytes, 0, sizeof(bytes)) == 0);
+        for (uint8_t i = 36; i < 48; i++) {
+            assert(_z_wbuf_write(&src, i) == 0);
+        }
+
+        // The chunks at least as large as the threshold are wrapped rather than copied
+        _z_wbuf_t dst = _z_wbuf_make(len, false);
+        dst._wrap_threshold = threshold;
+        assert(_z_wbuf_siphon(&dst, &src, 40) == 0);
+        assert(_z_wbuf_len(&src) == 8);
+        assert(_z_wbuf_len(&dst) == 40);
+        assert(_z_wbuf_space_left(&dst) == len - 40);
+        if (threshold == 0) {
+            assert(_z_wbuf_len_iosli(&dst) == 1);
+        } else {
+            assert(_z_wbuf_len_iosli(&dst) == 3);
+            assert(_z_wbuf_get_iosli(&dst, 1)->_buf == bytes);
+        }
+        assert(_z_wbuf_siphon(&dst, &src, 8) == 0);
+        assert(_z_wbuf_len(&src) == 0);
+
+        _z_zbuf_t zbf = _z_wbuf_to_zbuf(&dst);
+        assert(_z_zbuf_len(&zbf) == 48);
+        for (uint8_t i = 0; i < 48; i++) {
+            assert(_z_zbuf_read(&zbf) == i);
+        }
+        _z_zbuf_clear(&zbf);
+        _z_wbuf_clear(&dst);
+        _z_wbuf_clear(&src);
+    }
+}
+
+void wbuf_reserve_commit(void) {
+    size_t len = 16;
+    printf("\n>>> WBuf => Reserve and commit\n");
+
+    // Only the committed bytes are written
+    _z_wbuf_t wbf = _z_wbuf_make(len, false);
+    uint8_t *cursor = _z_wbuf_reserve(&wbf, 8);
+    assert(cursor == _z_wbuf_get_iosli(&wbf, 0)->_buf);
+    for (uint8_t i = 0; i < 8; i++) {
+        cursor[i] = i;
+    }
+    _z_wbuf_commit(&wbf, 5);
+    assert(_z_wbuf_len(&wbf) == 5);
+    assert(_z_wbuf_space_left(&wbf) == len - 5);
+    assert(_z_wbuf_reserve(&wbf, len - 5) != NULL);
+    assert(_z_wbuf_reserve(&wbf, len - 4) == NULL);
+    _z_wbuf_commit(&wbf, 0);
+    assert(_z_wbuf_len(&wbf) == 5);
+
+    // A reservation follows the bytes wrapped before it, in the ioslice after them
+    uint8_t bytes[4] = {5, 6, 7, 8};
+    assert(_z_wbuf_wrap_bytes(&wbf, bytes, 0, sizeof(bytes)) == 0);
+    cursor = _z_wbuf_reserve(&wbf, 3);
+    assert(cursor != NULL);
+    assert(cursor == _z_wbuf_get_iosli(&wbf, _z_wbuf_len_iosli(&wbf) - 1)->_buf);
+    for (uint8_t i = 0; i < 3; i++) {
+        cursor[i] = (uint8_t)(9 + i);
+    }
+    _z_wbuf_commit(&wbf, 3);
+    assert(_z_wbuf_reserve(&wbf, len - 12) != NULL);
+    assert(_z_wbuf_reserve(&wbf, len - 11) == NULL);
+
+    _z_zbuf_t zbf = _z_wbuf_to_zbuf(&wbf);
+    assert(_z_zbuf_len(&zbf) == 12);
+    for (uint8_t i = 0; i < 12; i++) {
+        assert(_z_zbuf_read(&zbf) == i);
+    }
+    _z_zbuf_clear(&zbf);
+    _z_wbuf_clear(&wbf);
+
+    // A reservation never spans ioslices, nor expands the buffer: the bytes left in the current ioslice are written
+    // byte-wise, expanding it, and the next reservation goes to the new ioslice
+    wbf = _z_wbuf_make(len, true);
+    for (uint8_t i = 0; i < 12; i++) {
+        assert(_z_wbuf_write(&wbf, i) == 0);
+    }
+    assert(_z_wbuf_reserve(&wbf, 4) != NULL);
+    assert(_z_wbuf_reserve(&wbf, 8) == NULL);
+    assert(_z_wbuf_len_iosli(&wbf) == 1);
+    for (uint8_t i = 12; i < 20; i++) {
+        assert(_z_wbuf_write(&wbf, i) == 0);
+    }
+    assert(_z_wbuf_len_iosli(&wbf) == 2);
+    cursor = _z_wbuf_reserve(&wbf, 8);
+    assert(cursor == &_z_wbuf_get_iosli(&wbf, 1)->_buf[4]);
+    for (uint8_t i = 0; i < 8; i++) {
+        cursor[i] = (uint8_t)(20 + i);
+    }
+    _z_wbuf_commit(&wbf, 8);
+    assert(_z_wbuf_reserve(&wbf, len - 11) == NULL);
+
+    zbf = _z_wbuf_to_zbuf(&wbf);
+    assert(_z_zbuf_len(&zbf) == 28);
+    for (uint8_t i = 0; i < 28; i++) {
+        assert(_z_zbuf_read(&zbf) == i);
+    }
+    _z_zbuf_clear(&zbf);
+    _z_wbuf_clear(&wbf);
+}
+
 /*=============================*/
 /*            Main             */
 /*=============================*/
@@ -570,6 +729,9 @@ int main(void) {
         wbuf_writable_readable();
         wbuf_set_pos_wbuf_get_pos();
         wbuf_add_iosli();
+        wbuf_wrap_bytes_fixed();
+        wbuf_siphon();
+        wbuf_reserve_commit();
         // WBuf and ZBuf
         wbuf_write_zbuf_read();
         wbuf_write_zbuf_read_bytes();
@@ -16,10 +16,160 @@
 
 #include "zenoh-pico/api/primitives.h"
 #include "zenoh-pico/protocol/keyexpr.h"
+#include "zenoh-pico/protocol/ketrie.h"
+#include "zenoh-pico/utils/string.h"
 
 #undef NDEBUG
 #include <assert.h>
 
+#define KETRIE_N 16
+const char *ketrie_keys[KETRIE_N] = {"a",    "a/b",    "a/*",  "a/**", "**",    "a/b/c", "a/$*b",    "**/c",
+                                     "a/@v/c", "a/**/c", "x/y/z", "a/b$*", "*/b", "@v/**", "a/*/c/**", "b"};
+
+void ketrie_visit(void *val, void *arg) {
+    int *found = (int *)arg;
+    found[(size_t)val] += 1;
+}
+
+void ketrie_test(void) {
+    const char *queries[] = {"a",     "a/b",    "a/b/c", "a/xb", "a/@v/c", "a/b/c/d/c", "x/y/z",
+                             "a/*",   "a/**",   "**",    "a/@v", "@v/c",   "b",         "c/c",
+                             "",      "a/b/c/d", "a/$*", "*/*/c", "x/**/z", "a/bb"};
+    _z_ketrie_t trie = _z_ketrie_make();
+    for (size_t i = 0; i < KETRIE_N; i++) {
+        assert(_z_ketrie_insert(&trie, ketrie_keys[i], strlen(ketrie_keys[i]), (void *)i) == _Z_RES_OK);
+    }
+
+    for (size_t q = 0; q < _ZP_ARRAY_SIZE(queries); q++) {
+        int found[KETRIE_N] = {0};
+        _z_ketrie_intersecting(&trie, queries[q], strlen(queries[q]), ketrie_visit, found);
+        for (size_t i = 0; i < KETRIE_N; i++) {
+            // Each candidate is reported at most once, and no intersecting key is missed
+            assert(found[i] <= 1);
+            if (_z_keyexpr_intersects(ketrie_keys[i], strlen(ketrie_keys[i]), queries[q], strlen(queries[q]))) {
+                assert(found[i] == 1);
+            }
+        }
+    }
+
+    // Removing a key prunes its now useless nodes, leaving the other keys reachable
+    for (size_t i = 0; i < KETRIE_N; i += 2) {
+        _z_ketrie_remove(&trie, ketrie_keys[i], strlen(ketrie_keys[i]), (void *)i);
+    }
+    int found[KETRIE_N] = {0};
+    _z_ketrie_intersecting(&trie, "**", 2, ketrie_visit, found);
+    for (size_t i = 0; i < KETRIE_N; i++) {
+        assert(found[i] == (int)(i % 2));
+    }
+    for (size_t i = 1; i < KETRIE_N; i += 2) {
+        _z_ketrie_remove(&trie, ketrie_keys[i], strlen(ketrie_keys[i]), (void *)i);
+    }
+    assert(_z_ketrie_is_empty(&trie));
+    _z_ketrie_clear(&trie);
+}
+
+void scan_test(void) {
+    // Every position of the needle, on both sides of the block boundaries, and every haystack length
+    char buf[3 * _Z_STR_CLASS_BLOCK + 1];
+    const size_t len = sizeof(buf) - 1;
+    for (size_t i = 0; i < len; i++) {
+        memset(buf, 'a', len);
+        buf[len] = '\0';
+        buf[i] = '/';
+        for (size_t n = 0; n <= len; n++) {
+            const char *first = _z_strchr_se(buf, buf + n, '/');
+            const char *last = _z_strrchr_se(buf, buf + n, '/');
+            assert(first == ((i < n) ? buf + i : NULL));
+            assert(last == first);
+        }
+        buf[len - 1 - i] = '/';
+        assert(_z_strchr_se(buf, buf + len, '/') == buf + ((i < len - 1 - i) ? i : len - 1 - i));
+        assert(_z_strrchr_se(buf, buf + len, '/') == buf + ((i > len - 1 - i) ? i : len - 1 - i));
+        assert(_z_strstr(buf, buf + len, "/") == _z_strchr_se(buf, buf + len, '/'));
+        assert(_z_rstrstr(buf, buf + len, "/") == _z_strrchr_se(buf, buf + len, '/') + 1);
+    }
+
+    memset(buf, 'a', len);
+    buf[_Z_STR_CLASS_BLOCK - 1] = '$';
+    buf[_Z_STR_CLASS_BLOCK] = '*';
+    buf[2 * _Z_STR_CLASS_BLOCK] = '$';
+    assert(_z_strstr(buf, buf + len, "$*") == buf + _Z_STR_CLASS_BLOCK - 1);
+    assert(_z_rstrstr(buf, buf + len, "$*") == buf + _Z_STR_CLASS_BLOCK + 1);
+    assert(_z_strstr(buf, buf + _Z_STR_CLASS_BLOCK, "$*") == NULL);
+
+    // Long keys, with their wildcards and verbatim chunks straddling the block boundaries
+    const char *uuid_key =
+        "fleet/3f2b8c1e-6d4a-4b7e-9c2f-0a1b2c3d4e5f/robot/7e1d2c3b-4a59-4687-b7c6-d5e4f3a2b1c0/sensor/lidar";
+    assert(_z_keyexpr_intersects(uuid_key, strlen(uuid_key), uuid_key, strlen(uuid_key)));
+    assert(zp_keyexpr_intersect_null_terminated("fleet/*/robot/*/sensor/lidar", uuid_key) == 0);
+    assert(zp_keyexpr_intersect_null_terminated("fleet/**/lidar", uuid_key) == 0);
+    assert(zp_keyexpr_intersect_null_terminated("fleet/**/robot/$*b1c0/**", uuid_key) == 0);
+    assert(zp_keyexpr_intersect_null_terminated("fleet/*/robot/$*b1c1/sensor/lidar", uuid_key) == -1);
+    assert(zp_keyexpr_includes_null_terminated("fleet/3f2b8c1e-6d4a-4b7e-9c2f-0a1b2c3d4e5f/**", uuid_key) == 0);
+    assert(zp_keyexpr_includes_null_terminated(uuid_key, "fleet/3f2b8c1e-6d4a-4b7e-9c2f-0a1b2c3d4e5f/**") == -1);
+    assert(zp_keyexpr_intersect_null_terminated(
+               "fleet/3f2b8c1e-6d4a-4b7e-9c2f-0a1b2c3d4e5f/robot/7e1d2c3b-4a59-4687-b7c6-d5e4f3a2b1c0/**",
+               "fleet/3f2b8c1e-6d4a-4b7e-9c2f-0a1b2c3d4e5f/robot/7e1d2c3b-4a59-4687-b7c6-d5e4f3a2b1c0/@v/x") == -1);
+    assert(zp_keyexpr_includes_null_terminated(
+               "fleet/3f2b8c1e-6d4a-4b7e-9c2f-0a1b2c3d4e5f/robot/7e1d2c3b-4a59-4687-b7c6-d5e4f3a2b1c0/*",
+               "fleet/3f2b8c1e-6d4a-4b7e-9c2f-0a1b2c3d4e5f/robot/7e1d2c3b-4a59-4687-b7c6-d5e4f3a2b1c0/lidar") == 0);
+    // The two stars of a superchunk in two different blocks
+    for (size_t pad = 0; pad < (size_t)_Z_STR_CLASS_BLOCK; pad++) {
+        char key[2 * _Z_STR_CLASS_BLOCK + 16];
+        memset(key, 'k', pad);
+        strcpy(key + pad, "/**/lidar");
+        assert(zp_keyexpr_intersect_null_terminated(key, "k/a/b/lidar") == ((pad == 1) ? 0 : -1));
+        assert(zp_keyexpr_intersect_null_terminated(key, uuid_key) == -1);
+        strcpy(key + pad, "/**/**/$*$*");
+        size_t canon_len = strlen(key);
+        zp_keyexpr_canon_status_t status = z_keyexpr_canonize(key, &canon_len);
+        assert(status == ((pad == 0) ? Z_KEYEXPR_CANON_EMPTY_CHUNK : Z_KEYEXPR_CANON_SUCCESS));
+        if (pad != 0) {
+            assert((canon_len == pad + 5) && (strncmp(key + pad, "/*/**", 5) == 0));
+        }
+    }
+}
+
+void compiled_test(void) {
+    const char *keys[] = {"a",     "a/b",      "a/b/c", "a/xb",   "a/@v/c", "a/b/c/d/c", "x/y/z",
+                          "@v/c",  "b",        "c/c",   "a/b/c/d", "a/bb",  "a/@v",      "a/b/@v/c"};
+    for (size_t i = 0; i < KETRIE_N; i++) {
+        _z_keyexpr_compiled_t ke;
+        assert(_z_keyexpr_compile(&ke, ketrie_keys[i], strlen(ketrie_keys[i])) == _Z_RES_OK);
+        for (size_t k = 0; k < _ZP_ARRAY_SIZE(keys); k++) {
+            // The compiled form agrees with the string matchers on the keys a session receives
+            assert(_z_keyexpr_compiled_includes(&ke, keys[k], strlen(keys[k])) ==
+                   _z_keyexpr_includes(ketrie_keys[i], strlen(ketrie_keys[i]), keys[k], strlen(keys[k])));
+        }
+        _z_keyexpr_compiled_clear(&ke);
+        assert(ke._chunks == NULL);
+    }
+
+    zp_keyexpr_compiled_t ke;
+    assert(zp_keyexpr_compile(&ke, "a/**/c/*/e") == 0);
+    assert(ke._n_prefix_chunks == 1);
+    assert(zp_keyexpr_compiled_intersects(&ke, z_keyexpr("a/b/c/d/e/f")) == -1);
+    assert(zp_keyexpr_compiled_intersects(&ke, z_keyexpr("a/b/c/c/c/d/e")) == 0);
+    assert(zp_keyexpr_compiled_intersects(&ke, z_keyexpr("a/c/d/e")) == 0);
+    assert(zp_keyexpr_compiled_intersects(&ke, z_keyexpr("a/@v/c/d/e")) == -1);
+    assert(zp_keyexpr_compiled_includes(&ke, z_keyexpr("a/b/**/c/d/e")) == 0);
+    assert(zp_keyexpr_compiled_includes(&ke, z_keyexpr("a/b/**/c/*/f")) == -1);
+    assert(zp_keyexpr_compiled_intersects(&ke, _z_rid_with_suffix(1, NULL)) == _Z_ERR_GENERIC);
+    zp_keyexpr_compiled_drop(&ke);
+
+    assert(zp_keyexpr_compile(&ke, "robot/$*bot/@v/lidar") == 0);
+    assert(zp_keyexpr_compiled_intersects(&ke, z_keyexpr("robot/robot/@v/lidar")) == 0);
+    assert(zp_keyexpr_compiled_intersects(&ke, z_keyexpr("robot/bot/@v/lidar")) == 0);
+    assert(zp_keyexpr_compiled_intersects(&ke, z_keyexpr("robot/robots/@v/lidar")) == -1);
+    assert(zp_keyexpr_compiled_intersects(&ke, z_keyexpr("robot/robot/@w/lidar")) == -1);
+    zp_keyexpr_compiled_drop(&ke);
+
+    // A keyexpr that is not canon is not compiled
+    assert(zp_keyexpr_compile(&ke, "a/**/**/c") == Z_KEYEXPR_CANON_DOUBLE_STAR_AFTER_DOUBLE_STAR);
+    assert(zp_keyexpr_compiled_includes(&ke, z_keyexpr("a/b/c")) == _Z_ERR_GENERIC);
+    zp_keyexpr_compiled_drop(&ke);
+}
+
 int main(void) {
     assert(_z_keyexpr_intersects("a", strlen("a"), "a", strlen("a")));
     assert(_z_keyexpr_intersects("a/b", strlen("a/b"), "a/b", strlen("a/b")));
@@ -283,6 +433,18 @@ int main(void) {
     assert((zp_keyexpr_includes_null_terminated("@a/**/@b", "@a/@b") == 0));
     assert((zp_keyexpr_includes_null_terminated("@a/@b/**", "@a/@b") == 0));
 
+    // A `*` may follow the chunks after a `**`
+    assert(zp_keyexpr_is_canon_null_terminated("a/**/c/*") == 0);
+    assert(zp_keyexpr_is_canon_null_terminated("**/a/*/b/*") == 0);
+    assert(zp_keyexpr_is_canon_null_terminated("a/**/*") == Z_KEYEXPR_CANON_SINGLE_STAR_AFTER_DOUBLE_STAR);
+    // A `**` left to match once the key is exhausted
+    assert(zp_keyexpr_includes_null_terminated("a/**/b", "a") == -1);
+    assert(zp_keyexpr_includes_null_terminated("a/**/b/**", "a") == -1);
+    // Chunks without `$*` of key expressions that have some elsewhere
+    assert(zp_keyexpr_intersect_null_terminated("ab/x$*", "a/xy") == -1);
+    assert(zp_keyexpr_intersect_null_terminated("a/xy", "ab/x$*") == -1);
+    assert(zp_keyexpr_intersect_null_terminated("ab/x$*", "ab/xy") == 0);
+
     // clang-format off
 
 #define N 31
@@ -419,5 +581,9 @@ int main(void) {
     assert(zp_keyexpr_equals_null_terminated("a/bc", "a/cb") == -1);
     assert(zp_keyexpr_equals_null_terminated("greetings/hello/there", "greetings/hello/there") == 0);
 
+    ketrie_test();
+    scan_test();
+    compiled_test();
+
     return 0;
 }
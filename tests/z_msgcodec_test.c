@@ -463,6 +463,55 @@ void zbuf_extension(void) {
 /*=============================*/
 /*       Message Fields        */
 /*=============================*/
+/*------------------ Zint field ------------------*/
+void zint_field(void) {
+    printf("\n>> Zint field\n");
+    const size_t capacity = 16;
+    for (uint8_t bits = 0; bits <= 64; bits++) {
+        uint64_t val = 0;
+        if (bits > 0) {
+            val = (gen_uint64() >> (64 - bits)) | ((uint64_t)1 << (bits - 1));
+        }
+        size_t len = _z_zint_len((_z_zint_t)val);
+        assert(len == (size_t)((bits + 6) / 7) + ((bits == 0) ? 1 : 0));
+        // Every position of the varint up to the end of the buffer, through the word and byte by byte paths
+        for (size_t pad = 0; pad + len <= capacity; pad++) {
+            _z_wbuf_t wbf = _z_wbuf_make(capacity, false);
+            for (size_t i = 0; i < pad; i++) {
+                assert(_z_uint8_encode(&wbf, 0xff) == _Z_RES_OK);
+            }
+            assert(_z_zint64_encode(&wbf, val) == _Z_RES_OK);
+            assert(_z_wbuf_len(&wbf) == pad + len);
+            // Followed by bytes with the continuation bit, which must not be read as part of the varint
+            while (_z_wbuf_space_left(&wbf) > 0) {
+                assert(_z_uint8_encode(&wbf, 0x80) == _Z_RES_OK);
+            }
+            assert(_z_zint64_encode(&wbf, 0) == _Z_ERR_TRANSPORT_NO_SPACE);
+
+            _z_zbuf_t zbf = _z_wbuf_to_zbuf(&wbf);
+            uint64_t expected = val;
+            for (size_t i = pad; i < pad + len; i++) {
+                uint8_t b = _z_zbuf_get(&zbf, i);
+                assert((b & 0x7f) == (uint8_t)(expected & 0x7f));
+                assert((b > 0x7f) == (i + 1 < pad + len));
+                expected = expected >> 7;
+            }
+            _z_zbuf_set_rpos(&zbf, pad);
+            uint64_t d_val = 0;
+            assert(_z_zint64_decode(&d_val, &zbf) == _Z_RES_OK);
+            assert(d_val == val);
+            assert(_z_zbuf_get_rpos(&zbf) == pad + len);
+            // A truncated varint is an error, whichever path reads it
+            _z_zbuf_set_rpos(&zbf, pad);
+            _z_zbuf_set_wpos(&zbf, pad + len - 1);
+            assert(_z_zint64_decode(&d_val, &zbf) == _Z_ERR_MESSAGE_DESERIALIZATION_FAILED);
+
+            _z_zbuf_clear(&zbf);
+            _z_wbuf_clear(&wbf);
+        }
+    }
+}
+
 /*------------------ Payload field ------------------*/
 void assert_eq_bytes(const _z_bytes_t *left, const _z_bytes_t *right) { assert_eq_uint8_array(left, right); }
 
@@ -1467,6 +1516,47 @@ void response_final_message(void) {
     _z_wbuf_clear(&wbf);
 }
 
+// Single byte ioslices never have room for a reservation, the encoders fall back to byte-wise writes
+_z_wbuf_t gen_fallback_wbuf(void) { return _z_wbuf_make(1, true); }
+
+void assert_eq_encoded(_z_wbuf_t *left, _z_wbuf_t *right) {
+    _z_zbuf_t lzbf = _z_wbuf_to_zbuf(left);
+    _z_zbuf_t rzbf = _z_wbuf_to_zbuf(right);
+    assert(_z_zbuf_len(&lzbf) == _z_zbuf_len(&rzbf));
+    assert(memcmp(_z_zbuf_get_rptr(&lzbf), _z_zbuf_get_rptr(&rzbf), _z_zbuf_len(&lzbf)) == 0);
+    _z_zbuf_clear(&lzbf);
+    _z_zbuf_clear(&rzbf);
+    _z_wbuf_clear(left);
+    _z_wbuf_clear(right);
+}
+
+void reserved_encoding(void) {
+    printf("\n>> Reserved and byte-wise encodings\n");
+    _z_wbuf_t reserved = _z_wbuf_make(UINT16_MAX, false);
+    _z_wbuf_t fallback = gen_fallback_wbuf();
+    _z_n_msg_push_t push = gen_push();
+    assert(_z_push_encode(&reserved, &push) == _Z_RES_OK);
+    assert(_z_push_encode(&fallback, &push) == _Z_RES_OK);
+    assert_eq_encoded(&reserved, &fallback);
+    _z_n_msg_push_clear(&push);
+
+    reserved = _z_wbuf_make(UINT16_MAX, false);
+    fallback = gen_fallback_wbuf();
+    _z_n_msg_request_t request = gen_request();
+    assert(_z_request_encode(&reserved, &request) == _Z_RES_OK);
+    assert(_z_request_encode(&fallback, &request) == _Z_RES_OK);
+    assert_eq_encoded(&reserved, &fallback);
+    _z_n_msg_request_clear(&request);
+
+    reserved = _z_wbuf_make(UINT16_MAX, false);
+    fallback = gen_fallback_wbuf();
+    _z_n_msg_response_t response = gen_response();
+    assert(_z_response_encode(&reserved, &response) == _Z_RES_OK);
+    assert(_z_response_encode(&fallback, &response) == _Z_RES_OK);
+    assert_eq_encoded(&reserved, &fallback);
+    _z_n_msg_response_clear(&response);
+}
+
 _z_transport_message_t gen_join(void) {
     _z_conduit_sn_list_t conduit = {._is_qos = gen_bool()};
     if (conduit._is_qos) {
@@ -1693,6 +1783,35 @@ void frame_message(void) {
     _z_wbuf_clear(&wbf);
 }
 
+void frame_stream_message(void) {
+    printf("\n>> frame stream message\n");
+    _z_wbuf_t wbf = gen_wbuf(UINT16_MAX);
+    _z_transport_message_t expected = gen_frame();
+    assert(_z_transport_message_encode(&wbf, &expected) == _Z_RES_OK);
+    _z_transport_message_t decoded;
+    _z_zbuf_t zbf = _z_wbuf_to_zbuf(&wbf);
+    int8_t ret = _z_transport_message_decode_stream(&decoded, &zbf);
+    assert(_Z_RES_OK == ret);
+    assert(decoded._header == expected._header);
+    assert(decoded._body._frame._sn == expected._body._frame._sn);
+    assert(_z_network_message_vec_len(&decoded._body._frame._messages) == 0);
+    size_t n = 0;
+    _z_network_message_t nm;
+    while (_z_frame_next(&decoded._body._frame, &nm, &ret) == true) {
+        assert(n < _z_network_message_vec_len(&expected._body._frame._messages));
+        assert_eq_net_msg(_z_network_message_vec_get(&expected._body._frame._messages, n), &nm);
+        _z_n_msg_clear(&nm);
+        n++;
+    }
+    assert(_Z_RES_OK == ret);
+    assert(n == _z_network_message_vec_len(&expected._body._frame._messages));
+    assert(_z_zbuf_len(&zbf) == 0);
+    _z_t_msg_clear(&decoded);
+    _z_t_msg_clear(&expected);
+    _z_zbuf_clear(&zbf);
+    _z_wbuf_clear(&wbf);
+}
+
 _z_transport_message_t gen_fragment(void) {
     return _z_t_msg_make_fragment(gen_uint(), gen_bytes(gen_uint8()), gen_bool(), gen_bool());
 }
@@ -1837,6 +1956,7 @@ int main(void) {
         printf("\n\n== RUN %u", i);
 
         // Message fields
+        zint_field();
         payload_field();
         timestamp_field();
         keyexpr_field();
@@ -1863,6 +1983,7 @@ int main(void) {
         request_message();
         response_message();
         response_final_message();
+        reserved_encoding();
 
         // Transport messages
         join_message();
@@ -1871,6 +1992,7 @@ int main(void) {
         close_message();
         keep_alive_message();
         frame_message();
+        frame_stream_message();
         fragment_message();
         transport_message();
 
@@ -22,13 +22,23 @@
 #define TEST_DURATION_US 10000000
 
 #if Z_FEATURE_PUBLICATION == 1
-int send_packets(unsigned long pkt_len, z_owned_publisher_t *pub, uint8_t *value) {
+int send_packets(unsigned long pkt_len, z_session_t s, z_owned_publisher_t *pub, uint8_t *value) {
     zp_clock_t test_start = zp_clock_now();
     unsigned long elapsed_us = 0;
+    unsigned long sent = 0;
     while (elapsed_us < TEST_DURATION_US) {
-        z_publisher_put(z_loan(*pub), (const uint8_t *)value, pkt_len, NULL);
+        if (z_publisher_put(z_loan(*pub), (const uint8_t *)value, pkt_len, NULL) == 0) {
+            sent++;
+        }
         elapsed_us = zp_clock_elapsed_us(&test_start);
     }
+    // Don't leave messages of this run in a pending batch
+    zp_flush(s, NULL);
+    elapsed_us = zp_clock_elapsed_us(&test_start);
+    // Report the send throughput, to compare builds with and without Z_FEATURE_BATCHING
+    double msg_per_s = (double)sent * 1000000.0 / (double)elapsed_us;
+    printf("Sent %lu msgs of %lu bytes: %.0f msg/s, %.2f MB/s\n", sent, pkt_len, msg_per_s,
+           msg_per_s * (double)pkt_len / 1000000.0);
     return 0;
 }
 
@@ -88,13 +98,14 @@ int main(int argc, char **argv) {
     // Send packets
     for (size_t i = 0; i < ARRAY_SIZE(len_array); i++) {
         printf("Start sending pkt len: %lu\n", len_array[i]);
-        if (send_packets(len_array[i], &pub, value) != 0) {
+        if (send_packets(len_array[i], z_loan(s), &pub, value) != 0) {
             break;
         }
     }
     // Send end packet
     printf("Sending end pkt\n");
     z_publisher_put(z_loan(pub), (const uint8_t *)value, 1, NULL);
+    zp_flush(z_loan(s), NULL);
     // Clean up
     z_undeclare_publisher(z_move(pub));
     zp_stop_read_task(z_loan(s));
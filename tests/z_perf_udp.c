@@ -0,0 +1,164 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/system/link/udp.h"
+
+#if Z_FEATURE_LINK_UDP_UNICAST == 1 && defined(_Z_SYS_NET_MULTI_DATAGRAM_MAX)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define TEST_BURST _Z_SYS_NET_MULTI_DATAGRAM_MAX
+
+typedef struct {
+    unsigned long packets;
+    unsigned long syscalls;
+    unsigned long elapsed_ms;
+} z_udp_stats_t;
+
+// Sends and receives the packets in bursts over the loopback, one datagram or one burst per system call
+static int run(_z_sys_net_socket_t tx, _z_sys_net_socket_t rx, _z_sys_net_endpoint_t rep, size_t pkt_len,
+               unsigned long pkt_count, _Bool multi, z_udp_stats_t *stats) {
+    uint8_t *bufs = (uint8_t *)malloc(TEST_BURST * pkt_len);
+    if (bufs == NULL) {
+        return -1;
+    }
+    memset(bufs, 1, TEST_BURST * pkt_len);
+    _z_bytes_t dgrams[TEST_BURST];
+    uint8_t *ptrs[TEST_BURST];
+    size_t lens[TEST_BURST];
+    for (size_t i = 0; i < TEST_BURST; i++) {
+        dgrams[i] = _z_bytes_wrap(&bufs[i * pkt_len], pkt_len);
+        ptrs[i] = &bufs[i * pkt_len];
+    }
+
+    stats->packets = 0;
+    stats->syscalls = 0;
+    zp_clock_t start = zp_clock_now();
+    while (stats->packets < pkt_count) {
+        // Send a burst
+        if (multi == true) {
+            if (_z_send_multi_udp_unicast(tx, dgrams, TEST_BURST, rep) != TEST_BURST) {
+                break;
+            }
+            stats->syscalls++;
+        } else {
+            for (size_t i = 0; i < TEST_BURST; i++) {
+                _z_send_udp_unicast(tx, dgrams[i].start, pkt_len, rep);
+                stats->syscalls++;
+            }
+        }
+        // Receive it back
+        size_t received = 0;
+        while (received < TEST_BURST) {
+            size_t rb = 0;
+            if (multi == true) {
+                for (size_t i = 0; i < TEST_BURST; i++) {
+                    lens[i] = pkt_len;
+                }
+                rb = _z_read_multi_udp_unicast(rx, ptrs, lens, TEST_BURST - received);
+            } else {
+                rb = (_z_read_udp_unicast(rx, ptrs[0], pkt_len) != SIZE_MAX) ? 1 : SIZE_MAX;
+            }
+            stats->syscalls++;
+            if (rb == SIZE_MAX) {
+                break;
+            }
+            received += rb;
+        }
+        if (received < TEST_BURST) {
+            printf("Lost packets, socket timed out\n");
+            break;
+        }
+        stats->packets += TEST_BURST;
+    }
+    stats->elapsed_ms = zp_clock_elapsed_ms(&start);
+
+    free(bufs);
+    return 0;
+}
+
+static void print_stats(const char *name, const z_udp_stats_t *stats) {
+    unsigned long ms = (stats->elapsed_ms == 0) ? 1 : stats->elapsed_ms;
+    printf("%-8s packets: %lu, syscalls: %lu, time ms: %lu, packets/s: %lu, syscalls/s: %lu, packets/syscall: %.2f\n",
+           name, stats->packets, stats->syscalls, stats->elapsed_ms, stats->packets * 1000 / ms,
+           stats->syscalls * 1000 / ms, (double)stats->packets * 2 / (double)stats->syscalls);
+}
+
+int main(int argc, char **argv) {
+    size_t pkt_len = 1024;
+    unsigned long pkt_count = 1000000;
+    if (argc > 1) {
+        pkt_len = (size_t)atoi(argv[1]);
+    }
+    if (argc > 2) {
+        pkt_count = (unsigned long)atol(argv[2]);
+    }
+
+    // Bind the receiving socket on an ephemeral loopback port
+    _z_sys_net_socket_t rx;
+    rx._fd = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addrlen = sizeof(addr);
+    struct timeval tv = {.tv_sec = 1, .tv_usec = 0};
+    if ((rx._fd < 0) || (bind(rx._fd, (struct sockaddr *)&addr, addrlen) < 0) ||
+        (getsockname(rx._fd, (struct sockaddr *)&addr, &addrlen) < 0) ||
+        (setsockopt(rx._fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) < 0)) {
+        printf("Unable to bind the receiving socket\n");
+        return -1;
+    }
+
+    char port[8];
+    snprintf(port, sizeof(port), "%u", (unsigned)ntohs(addr.sin_port));
+    _z_sys_net_endpoint_t rep;
+    _z_sys_net_socket_t tx;
+    if ((_z_create_endpoint_udp(&rep, "127.0.0.1", port) != _Z_RES_OK) ||
+        (_z_open_udp_unicast(&tx, rep, Z_CONFIG_SOCKET_TIMEOUT) != _Z_RES_OK)) {
+        printf("Unable to open the sending socket\n");
+        return -1;
+    }
+
+    printf("Packet size: %zu, burst: %d\n", pkt_len, TEST_BURST);
+    z_udp_stats_t single;
+    z_udp_stats_t multi;
+    if ((run(tx, rx, rep, pkt_len, pkt_count, false, &single) == 0) &&
+        (run(tx, rx, rep, pkt_len, pkt_count, true, &multi) == 0)) {
+        print_stats("single", &single);
+        print_stats("multi", &multi);
+        unsigned long single_ms = (single.elapsed_ms == 0) ? 1 : single.elapsed_ms;
+        unsigned long multi_ms = (multi.elapsed_ms == 0) ? 1 : multi.elapsed_ms;
+        double speedup = ((double)multi.packets / (double)multi_ms) / ((double)single.packets / (double)single_ms);
+        printf("Speedup: %.2fx\n", speedup);
+    }
+
+    _z_close_udp_unicast(&tx);
+    close(rx._fd);
+    _z_free_endpoint_udp(&rep);
+    return 0;
+}
+#else
+int main(void) {
+    printf("ERROR: z_perf_udp requires UDP unicast links and multi-datagram socket I/O\n");
+    return -2;
+}
+#endif
@@ -0,0 +1,319 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico/net/session.h"
+#include "zenoh-pico/session/query.h"
+#include "zenoh-pico/system/platform.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_FEATURE_QUERY == 1
+#define N_KEYS 300
+
+// The replies received by the callback, by key index
+typedef struct {
+    size_t count;
+    size_t per_key[N_KEYS];
+    uint8_t last_payload[N_KEYS];
+} replies_t;
+
+static replies_t replies;
+static size_t dropped;
+
+void reply_handler(_z_reply_t *reply, struct __z_reply_handler_wrapper_t *arg) {
+    (void)(arg);
+    size_t key = (size_t)atoi(strchr(reply->data.sample.keyexpr._suffix, '/') + 1);
+    assert(key < N_KEYS);
+    replies.count++;
+    replies.per_key[key]++;
+    replies.last_payload[key] = reply->data.sample.payload.start[0];
+    _z_reply_free(&reply);
+}
+
+void drop_handler(void *arg) {
+    (void)(arg);
+    dropped++;
+}
+
+// The transport is left out, the reply path only needs the pending queries and the resources of the session
+void session_init(_z_session_t *zn) {
+    (void)memset(zn, 0, sizeof(_z_session_t));
+    zn->_pending_queries_epoch = zp_clock_now();
+#if Z_FEATURE_MULTI_THREAD == 1
+    assert(zp_mutex_init(&zn->_mutex_inner) == _Z_RES_OK);
+#endif
+}
+
+void session_clear(_z_session_t *zn) {
+    _z_flush_pending_queries(zn);
+#if Z_FEATURE_MULTI_THREAD == 1
+    zp_mutex_free(&zn->_mutex_inner);
+#endif
+}
+
+_z_pending_query_t *pending_query(_z_session_t *zn, _z_zint_t id, z_consolidation_mode_t consolidation,
+                                  uint32_t timeout_ms) {
+    _z_pending_query_t *pq = (_z_pending_query_t *)zp_malloc(sizeof(_z_pending_query_t));
+    (void)memset(pq, 0, sizeof(_z_pending_query_t));
+    pq->_id = id;
+    pq->_key = _z_keyexpr_duplicate(_z_rname("sensors/**"));
+    pq->_parameters = _z_str_clone("");
+    pq->_consolidation = consolidation;
+    pq->_callback = reply_handler;
+    pq->_dropper = drop_handler;
+    pq->_timeout_ms = timeout_ms;
+    _z_pending_replies_init(&pq->_pending_replies);
+    pq->_refcount = 1;
+    assert(_z_register_pending_query(zn, pq) == _Z_RES_OK);
+    // The session keeps the query alive until it completes
+    _z_pending_query_release(zn, pq);
+    return pq;
+}
+
+int8_t reply(_z_session_t *zn, _z_zint_t id, size_t key, uint64_t time, uint8_t value) {
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), "sensors/%zu", key);
+    _z_timestamp_t ts = _z_timestamp_null();
+    ts.time = time;
+    ts.id.id[0] = 1;
+    _z_encoding_t encoding = {.prefix = 0, .suffix = _z_bytes_empty()};
+    return _z_trigger_query_reply_partial(zn, id, _z_rname(suffix), _z_bytes_wrap(&value, 1), encoding,
+                                          Z_SAMPLE_KIND_PUT, ts);
+}
+
+void consolidation_test(z_consolidation_mode_t mode) {
+    printf(">>> consolidation %d\n", (int)mode);
+    _z_session_t zn;
+    session_init(&zn);
+    (void)memset(&replies, 0, sizeof(replies));
+    (void)pending_query(&zn, 1, mode, 0);
+
+    // Three rounds over every key, the second one older than the first
+    for (size_t key = 0; key < N_KEYS; key++) {
+        assert(reply(&zn, 1, key, 10, 1) == _Z_RES_OK);
+    }
+    for (size_t key = 0; key < N_KEYS; key++) {
+        assert(reply(&zn, 1, key, 5, 2) == _Z_RES_OK);
+    }
+    for (size_t key = 0; key < N_KEYS; key += 2) {
+        assert(reply(&zn, 1, key, 20, 3) == _Z_RES_OK);
+    }
+    assert(reply(&zn, 2, 0, 30, 4) == _Z_ERR_ENTITY_UNKNOWN);
+
+    switch (mode) {
+        case Z_CONSOLIDATION_MODE_NONE:
+            assert(replies.count == N_KEYS + N_KEYS + (N_KEYS / 2));
+            break;
+        case Z_CONSOLIDATION_MODE_MONOTONIC:
+            // Older replies are dropped, newer ones are delivered right away
+            assert(replies.count == N_KEYS + (N_KEYS / 2));
+            for (size_t key = 0; key < N_KEYS; key++) {
+                assert(replies.last_payload[key] == ((key % 2 == 0) ? 3 : 1));
+            }
+            break;
+        default:
+            // Nothing is delivered before the final reply
+            assert(replies.count == 0);
+            break;
+    }
+
+    assert(_z_trigger_query_reply_final(&zn, 1) == _Z_RES_OK);
+    if (mode == Z_CONSOLIDATION_MODE_LATEST) {
+        // Then the newest reply of each key, once
+        assert(replies.count == N_KEYS);
+        for (size_t key = 0; key < N_KEYS; key++) {
+            assert(replies.per_key[key] == 1);
+            assert(replies.last_payload[key] == ((key % 2 == 0) ? 3 : 1));
+        }
+    }
+    assert(_z_trigger_query_reply_final(&zn, 1) == _Z_ERR_ENTITY_UNKNOWN);
+
+    // Replies still pending when the session closes are released with it
+    (void)pending_query(&zn, 3, mode, 0);
+    assert(reply(&zn, 3, 0, 10, 1) == _Z_RES_OK);
+    session_clear(&zn);
+}
+
+#define N_QUERIES 1000
+
+void index_test(void) {
+    printf(">>> index\n");
+    _z_session_t zn;
+    session_init(&zn);
+    (void)memset(&replies, 0, sizeof(replies));
+    dropped = 0;
+
+    for (_z_zint_t id = 0; id < N_QUERIES; id++) {
+        (void)pending_query(&zn, id, Z_CONSOLIDATION_MODE_NONE, 0);
+    }
+    assert(_z_get_pending_query_by_id(&zn, N_QUERIES / 2)->_id == N_QUERIES / 2);
+    assert(_z_get_pending_query_by_id(&zn, N_QUERIES) == NULL);
+
+    // Query ids are unique
+    _z_pending_query_t dup;
+    (void)memset(&dup, 0, sizeof(dup));
+    dup._id = 7;
+    dup._key = _z_rname("sensors/**");
+    assert(_z_register_pending_query(&zn, &dup) == _Z_ERR_ENTITY_DECLARATION_FAILED);
+
+    // Replies reach their own query
+    for (_z_zint_t id = 0; id < N_QUERIES; id++) {
+        assert(reply(&zn, id, (size_t)(id % N_KEYS), 10, 1) == _Z_RES_OK);
+    }
+    assert(replies.count == N_QUERIES);
+    for (_z_zint_t id = 1; id < N_QUERIES; id += 2) {
+        assert(_z_trigger_query_reply_final(&zn, id) == _Z_RES_OK);
+    }
+    assert(dropped == N_QUERIES / 2);
+    for (_z_zint_t id = 0; id < N_QUERIES; id++) {
+        int8_t expected = (id % 2 == 0) ? _Z_RES_OK : _Z_ERR_ENTITY_UNKNOWN;
+        assert(reply(&zn, id, 0, 20, 2) == expected);
+    }
+
+    session_clear(&zn);
+    assert(dropped == N_QUERIES);
+}
+
+static _z_session_t *expiring_session;
+
+// Completed queries run their callbacks without the session mutex, which the lease task must not hold for long
+void assert_unlocked(void) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    assert(zp_mutex_trylock(&expiring_session->_mutex_inner) == _Z_RES_OK);
+    zp_mutex_unlock(&expiring_session->_mutex_inner);
+#endif
+}
+
+void unlocked_reply_handler(_z_reply_t *reply, struct __z_reply_handler_wrapper_t *arg) {
+    assert_unlocked();
+    reply_handler(reply, arg);
+}
+
+void unlocked_drop_handler(void *arg) {
+    assert_unlocked();
+    drop_handler(arg);
+}
+
+void timeout_test(void) {
+    printf(">>> timeout\n");
+    _z_session_t zn;
+    session_init(&zn);
+    (void)memset(&replies, 0, sizeof(replies));
+    dropped = 0;
+
+    expiring_session = &zn;
+    _z_pending_query_t *pq = pending_query(&zn, 1, Z_CONSOLIDATION_MODE_LATEST, 1);
+    pq->_callback = unlocked_reply_handler;
+    pq->_dropper = unlocked_drop_handler;
+    (void)pending_query(&zn, 2, Z_CONSOLIDATION_MODE_NONE, 0);
+    pq = pending_query(&zn, 3, Z_CONSOLIDATION_MODE_NONE, 60000);
+    pq->_dropper = unlocked_drop_handler;
+    for (size_t key = 0; key < 10; key++) {
+        assert(reply(&zn, 1, key, 10, 1) == _Z_RES_OK);
+    }
+    assert(replies.count == 0);
+
+    // The expired query completes as on its final reply, the others go on
+    zp_sleep_ms(2 * Z_QUERY_TIMEOUT_TICK_MS);
+    assert(_z_expire_pending_queries(&zn) == true);
+    assert(replies.count == 10);
+    assert(dropped == 1);
+    assert(reply(&zn, 1, 0, 20, 2) == _Z_ERR_ENTITY_UNKNOWN);
+    assert(reply(&zn, 2, 0, 20, 2) == _Z_RES_OK);
+    assert(reply(&zn, 3, 0, 20, 2) == _Z_RES_OK);
+
+    // Completing a query cancels its timeout
+    assert(_z_trigger_query_reply_final(&zn, 3) == _Z_RES_OK);
+    assert(_z_expire_pending_queries(&zn) == false);
+    assert(dropped == 2);
+
+    session_clear(&zn);
+    assert(dropped == 3);
+}
+
+static _z_session_t *completing_session;
+
+// Completes its own query from the reply callback, as a concurrent final reply or timeout would
+void completing_reply_handler(_z_reply_t *reply, struct __z_reply_handler_wrapper_t *arg) {
+    (void)(arg);
+    replies.count++;
+    _z_reply_free(&reply);
+    assert(_z_trigger_query_reply_final(completing_session, 1) == _Z_RES_OK);
+    // The query outlives the callback in progress
+    assert(dropped == 0);
+}
+
+void in_flight_test(void) {
+    printf(">>> in flight\n");
+    _z_session_t zn;
+    session_init(&zn);
+    (void)memset(&replies, 0, sizeof(replies));
+    dropped = 0;
+
+    // Completed while a reply callback runs
+    _z_pending_query_t *pq = pending_query(&zn, 1, Z_CONSOLIDATION_MODE_NONE, 0);
+    pq->_callback = completing_reply_handler;
+    completing_session = &zn;
+    assert(reply(&zn, 1, 0, 10, 1) == _Z_RES_OK);
+    assert(replies.count == 1);
+    assert(dropped == 1);
+
+    // Expired while its creator still sends it, as _z_query does
+    pq = (_z_pending_query_t *)zp_malloc(sizeof(_z_pending_query_t));
+    (void)memset(pq, 0, sizeof(_z_pending_query_t));
+    pq->_id = 2;
+    pq->_key = _z_keyexpr_duplicate(_z_rname("sensors/**"));
+    pq->_parameters = _z_str_clone("");
+    pq->_callback = reply_handler;
+    pq->_dropper = drop_handler;
+    pq->_timeout_ms = 1;
+    pq->_refcount = 1;
+    assert(_z_register_pending_query(&zn, pq) == _Z_RES_OK);
+    zp_sleep_ms(2 * Z_QUERY_TIMEOUT_TICK_MS);
+    assert(_z_expire_pending_queries(&zn) == false);
+    assert(reply(&zn, 2, 0, 10, 1) == _Z_ERR_ENTITY_UNKNOWN);
+    assert(dropped == 1);
+    // The send fails: unregistering the expired query again is harmless, releasing it completes it
+    assert(pq->_id == 2);
+    _z_unregister_pending_query(&zn, pq);
+    assert(dropped == 1);
+    _z_pending_query_release(&zn, pq);
+    assert(dropped == 2);
+
+    session_clear(&zn);
+    assert(dropped == 2);
+}
+
+int main(void) {
+    consolidation_test(Z_CONSOLIDATION_MODE_NONE);
+    consolidation_test(Z_CONSOLIDATION_MODE_MONOTONIC);
+    consolidation_test(Z_CONSOLIDATION_MODE_LATEST);
+    index_test();
+    timeout_test();
+    in_flight_test();
+    return 0;
+}
+#else
+int main(void) {
+    printf("ERROR: Zenoh pico was compiled without Z_FEATURE_QUERY but this test requires it.\n");
+    return 0;
+}
+#endif
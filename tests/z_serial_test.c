@@ -0,0 +1,196 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <pty.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "zenoh-pico/link/endpoint.h"
+#include "zenoh-pico/link/manager.h"
+#include "zenoh-pico/system/link/serial.h"
+#include "zenoh-pico/utils/checksum.h"
+#include "zenoh-pico/utils/encoding.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+// The link runs on the slave side of a pseudo terminal, the test plays the peer on the master side
+static int master = -1;
+
+// Frames the payload like the other serial backends do, with an intermediate buffer
+size_t legacy_frame(const uint8_t *payload, size_t len, uint8_t *out) {
+    uint8_t *before = (uint8_t *)malloc(len + 6);
+    before[0] = (uint8_t)len;
+    before[1] = (uint8_t)(len >> 8);
+    memcpy(&before[2], payload, len);
+    uint32_t crc = _z_crc32(payload, len);
+    for (size_t j = 0; j < 4; j++) {
+        before[2 + len + j] = (uint8_t)(crc >> (j * 8));
+    }
+    size_t n = _z_cobs_encode(before, len + 6, out);
+    out[n] = 0x00;
+    free(before);
+    return n + 1;
+}
+
+size_t read_wire_frame(uint8_t *out, size_t cap) {
+    size_t n = 0;
+    do {
+        assert(n < cap);
+        assert(read(master, &out[n], 1) == 1);
+        n++;
+    } while (out[n - 1] != 0x00);
+    return n;
+}
+
+void write_wire(const uint8_t *bytes, size_t len) { assert(write(master, bytes, len) == (ssize_t)len); }
+
+void fill(uint8_t *payload, size_t len, size_t pattern) {
+    for (size_t i = 0; i < len; i++) {
+        switch (pattern) {
+            case 0:
+                payload[i] = (uint8_t)i;
+                break;
+            case 1:
+                payload[i] = 0x00;
+                break;
+            default:
+                payload[i] = 0xFF;
+                break;
+        }
+    }
+}
+
+void roundtrip_test(_z_sys_net_socket_t sock) {
+    printf(">>> roundtrip\n");
+    static const size_t lens[] = {0, 1, 2, 253, 254, 255, 256, 508, 509, 1024, _Z_SERIAL_MTU_SIZE};
+    uint8_t payload[_Z_SERIAL_MTU_SIZE];
+    uint8_t got[_Z_SERIAL_MTU_SIZE];
+    uint8_t wire[_Z_SERIAL_MAX_COBS_BUF_SIZE];
+    uint8_t expected[_Z_SERIAL_MAX_COBS_BUF_SIZE];
+
+    for (size_t pattern = 0; pattern < 3; pattern++) {
+        for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+            size_t len = lens[i];
+            fill(payload, len, pattern);
+
+            // What the link sends is bit for bit what the other backends send
+            assert(_z_send_serial(sock, payload, len) == len);
+            size_t wire_len = read_wire_frame(wire, sizeof(wire));
+            size_t expected_len = legacy_frame(payload, len, expected);
+            assert(wire_len == expected_len);
+            assert(memcmp(wire, expected, wire_len) == 0);
+
+            // And it reads it back
+            write_wire(wire, wire_len);
+            memset(got, 0xA5, sizeof(got));
+            assert(_z_read_serial(sock, got, sizeof(got)) == len);
+            assert(memcmp(got, payload, len) == 0);
+        }
+    }
+}
+
+void stream_test(_z_sys_net_socket_t sock) {
+    printf(">>> stream\n");
+    uint8_t payload[64];
+    uint8_t got[64];
+    uint8_t wire[4 * _Z_SERIAL_MAX_COBS_BUF_SIZE];
+    fill(payload, sizeof(payload), 0);
+
+    // Several frames, a lone delimiter and a corrupted frame in a single write
+    size_t n = 0;
+    n += legacy_frame(payload, 10, &wire[n]);
+    wire[n++] = 0x00;
+    size_t corrupted = n;
+    n += legacy_frame(payload, 20, &wire[n]);
+    wire[corrupted + 5] ^= 0x10;
+    n += legacy_frame(payload, 30, &wire[n]);
+    n += legacy_frame(payload, 40, &wire[n]);
+    write_wire(wire, n);
+
+    assert(_z_read_serial(sock, got, sizeof(got)) == 10);
+    assert(_z_read_serial(sock, got, sizeof(got)) == SIZE_MAX);
+    assert(_z_read_serial(sock, got, sizeof(got)) == 30);
+    assert(memcmp(got, payload, 30) == 0);
+    // Too large for the destination
+    assert(_z_read_serial(sock, got, 39) == SIZE_MAX);
+
+    // Frames split across reads
+    n = legacy_frame(payload, sizeof(payload), wire);
+    write_wire(wire, n / 2);
+    write_wire(&wire[n / 2], n - (n / 2));
+    assert(_z_read_serial(sock, got, sizeof(got)) == sizeof(payload));
+    assert(memcmp(got, payload, sizeof(payload)) == 0);
+
+    // Longer than the maximum frame: dropped, and the link resynchronises on the next delimiter
+    uint8_t garbage[_Z_SERIAL_MAX_COBS_BUF_SIZE + 100];
+    memset(garbage, 0x42, sizeof(garbage));
+    write_wire(garbage, sizeof(garbage));
+    wire[0] = 0x00;
+    n = 1 + legacy_frame(payload, 7, &wire[1]);
+    write_wire(wire, n);
+    size_t rb = _z_read_serial(sock, got, sizeof(got));
+    assert(rb == SIZE_MAX);
+    assert(_z_read_serial(sock, got, sizeof(got)) == 7);
+
+    assert(_z_send_serial(sock, garbage, _Z_SERIAL_MTU_SIZE + 1) == SIZE_MAX);
+}
+
+void link_test(const char *dev) {
+    printf(">>> link\n");
+    char locator[128];
+    snprintf(locator, sizeof(locator), "serial/%s#baudrate=115200", dev);
+    _z_endpoint_t ep;
+    assert(_z_endpoint_from_str(&ep, locator) == _Z_RES_OK);
+
+    _z_link_t zl;
+    assert(_z_new_link_serial(&zl, ep) == _Z_RES_OK);
+    assert(zl._open_f(&zl) == _Z_RES_OK);
+
+    uint8_t payload[] = {0x00, 0x01, 0x00, 0x02};
+    uint8_t wire[32];
+    uint8_t got[8];
+    assert(zl._write_all_f(&zl, payload, sizeof(payload)) == sizeof(payload));
+    size_t n = read_wire_frame(wire, sizeof(wire));
+    write_wire(wire, n);
+    assert(zl._read_f(&zl, got, sizeof(got), NULL) == sizeof(payload));
+    assert(memcmp(got, payload, sizeof(payload)) == 0);
+
+    zl._close_f(&zl);
+    _z_endpoint_clear(&zl._endpoint);
+}
+
+int main(void) {
+    int slave = -1;
+    char dev[128];
+    assert(openpty(&master, &slave, dev, NULL, NULL) == 0);
+
+    _z_sys_net_socket_t sock;
+    assert(_z_open_serial_from_dev(&sock, "/nonexistent/tty", 115200) != _Z_RES_OK);
+    assert(_z_open_serial_from_dev(&sock, dev, 12345) == _Z_ERR_CONFIG_LOCATOR_INVALID);
+    assert(_z_open_serial_from_dev(&sock, dev, 115200) == _Z_RES_OK);
+    roundtrip_test(sock);
+    stream_test(sock);
+    _z_close_serial(&sock);
+
+    link_test(dev);
+
+    close(slave);
+    close(master);
+    return 0;
+}
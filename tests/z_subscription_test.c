@@ -0,0 +1,219 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico/net/session.h"
+#include "zenoh-pico/session/resource.h"
+#include "zenoh-pico/session/subscription.h"
+#include "zenoh-pico/system/platform.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_FEATURE_SUBSCRIPTION == 1
+// The samples received by a subscription callback
+typedef struct {
+    size_t count;
+    size_t dropped;
+} received_t;
+
+void data_handler(const _z_sample_t *s, void *arg) {
+    (void)(s);
+    ((received_t *)arg)->count++;
+}
+
+void drop_handler(void *arg) { ((received_t *)arg)->dropped++; }
+
+// The transport is left out, the sample path only needs the subscriptions and the resources of the session
+void session_init(_z_session_t *zn) {
+    (void)memset(zn, 0, sizeof(_z_session_t));
+    zn->_entity_id = 1;
+    zn->_resource_id = 1;
+    _z_resource_index_init(&zn->_local_resources_index);
+    _z_resource_index_init(&zn->_remote_resources_index);
+    _z_ketrie_init(&zn->_local_subscriptions_index);
+    _z_ketrie_init(&zn->_remote_subscriptions_index);
+#if Z_FEATURE_MULTI_THREAD == 1
+    assert(zp_mutex_init(&zn->_mutex_inner) == _Z_RES_OK);
+#endif
+}
+
+void session_clear(_z_session_t *zn) {
+    _z_flush_resources(zn);
+    _z_flush_subscriptions(zn);
+#if Z_FEATURE_MULTI_THREAD == 1
+    zp_mutex_free(&zn->_mutex_inner);
+#endif
+}
+
+uint32_t subscribe(_z_session_t *zn, const char *key, received_t *r) {
+    (void)memset(r, 0, sizeof(received_t));
+    _z_subscription_t s;
+    (void)memset(&s, 0, sizeof(_z_subscription_t));
+    s._id = _z_get_entity_id(zn);
+    s._key = _z_keyexpr_duplicate(_z_rname(key));
+    (void)_z_keyexpr_compile(&s._compiled, s._key._suffix, strlen(s._key._suffix));
+    s._callback = data_handler;
+    s._dropper = drop_handler;
+    s._arg = r;
+    assert(_z_register_subscription(zn, _Z_RESOURCE_IS_LOCAL, &s) != NULL);
+    return s._id;
+}
+
+void unsubscribe(_z_session_t *zn, uint32_t id) {
+    _z_subscription_rc_t *sub = _z_get_subscription_by_id(zn, _Z_RESOURCE_IS_LOCAL, id);
+    assert(sub != NULL);
+    _z_unregister_subscription(zn, _Z_RESOURCE_IS_LOCAL, sub);
+}
+
+// A resource declared by the remote peer, as received from the transport
+void declare_resource(_z_session_t *zn, uint16_t id, const char *key) {
+    _z_keyexpr_t ke = _z_rname(key);
+    _z_keyexpr_set_mapping(&ke, _Z_KEYEXPR_MAPPING_UNKNOWN_REMOTE);
+    assert(_z_register_resource(zn, ke, id, _Z_KEYEXPR_MAPPING_UNKNOWN_REMOTE) == id);
+}
+
+_z_resource_t *resource(_z_session_t *zn, uint16_t id) {
+    return _z_get_resource_by_id(zn, _Z_KEYEXPR_MAPPING_UNKNOWN_REMOTE, id);
+}
+
+int8_t sample(_z_session_t *zn, _z_keyexpr_t ke) {
+    uint8_t value = 0;
+    _z_encoding_t encoding = {.prefix = Z_ENCODING_PREFIX_DEFAULT, .suffix = _z_bytes_empty()};
+    return _z_trigger_subscriptions(zn, ke, _z_bytes_wrap(&value, 1), encoding, Z_SAMPLE_KIND_PUT,
+                                    _z_timestamp_null()
+#if Z_FEATURE_ATTACHMENT == 1
+                                        ,
+                                    z_attachment_null()
+#endif
+    );
+}
+
+// A sample on a resource declared by the remote peer
+int8_t sample_on(_z_session_t *zn, uint16_t id) {
+    _z_keyexpr_t ke = _z_rid_with_suffix(id, NULL);
+    _z_keyexpr_set_mapping(&ke, _Z_KEYEXPR_MAPPING_UNKNOWN_REMOTE);
+    return sample(zn, ke);
+}
+
+void cache_test(void) {
+    printf(">>> cache\n");
+    _z_session_t zn;
+    session_init(&zn);
+    received_t temp;
+    received_t humidity;
+    received_t other;
+    uint32_t temp_id = subscribe(&zn, "sensors/temp", &temp);
+    (void)subscribe(&zn, "actuators/*", &other);
+    declare_resource(&zn, 1, "sensors/temp");
+    declare_resource(&zn, 2, "sensors/*");
+
+    // The subscriptions are matched once, on the first sample, then the cached ones are reused
+    assert(resource(&zn, 1)->_subscriptions.in == NULL);
+    assert(sample_on(&zn, 1) == _Z_RES_OK);
+    _z_subscription_cache_rc_t cache = resource(&zn, 1)->_subscriptions;
+    assert(cache.in != NULL);
+    assert(_z_subscription_rc_array_len(&cache.in->val) == 1);
+    assert(sample_on(&zn, 1) == _Z_RES_OK);
+    assert(resource(&zn, 1)->_subscriptions.in == cache.in);
+    assert((temp.count == 2) && (other.count == 0));
+
+    // Samples on a plain key are matched without the cache
+    assert(sample(&zn, _z_rname("sensors/temp")) == _Z_RES_OK);
+    assert(temp.count == 3);
+    assert(resource(&zn, 1)->_subscriptions.in == cache.in);
+
+    // Declaring a subscription drops the caches of every resource, which then include it where it matches
+    assert(sample_on(&zn, 2) == _Z_RES_OK);
+    assert(temp.count == 4);
+    uint32_t humidity_id = subscribe(&zn, "sensors/humidity", &humidity);
+    assert(resource(&zn, 1)->_subscriptions.in == NULL);
+    assert(resource(&zn, 2)->_subscriptions.in == NULL);
+    assert(sample_on(&zn, 1) == _Z_RES_OK);
+    assert(_z_subscription_rc_array_len(&resource(&zn, 1)->_subscriptions.in->val) == 1);
+    assert(sample_on(&zn, 2) == _Z_RES_OK);
+    assert(_z_subscription_rc_array_len(&resource(&zn, 2)->_subscriptions.in->val) == 2);
+    assert((temp.count == 6) && (humidity.count == 1));
+
+    // Undeclaring one drops the caches as well, and releases the subscription right away
+    unsubscribe(&zn, temp_id);
+    assert(resource(&zn, 1)->_subscriptions.in == NULL);
+    assert(resource(&zn, 2)->_subscriptions.in == NULL);
+    assert(temp.dropped == 1);
+    assert(sample_on(&zn, 1) == _Z_RES_OK);
+    assert(_z_subscription_rc_array_len(&resource(&zn, 1)->_subscriptions.in->val) == 0);
+    assert(sample_on(&zn, 2) == _Z_RES_OK);
+    assert(_z_subscription_rc_array_len(&resource(&zn, 2)->_subscriptions.in->val) == 1);
+    assert((temp.count == 6) && (humidity.count == 2) && (other.count == 0));
+    unsubscribe(&zn, humidity_id);
+    assert(humidity.dropped == 1);
+
+    session_clear(&zn);
+    assert(other.dropped == 1);
+}
+
+void resource_test(void) {
+    printf(">>> resources\n");
+    _z_session_t zn;
+    session_init(&zn);
+    received_t temp;
+    received_t humidity;
+    (void)subscribe(&zn, "sensors/temp", &temp);
+    (void)subscribe(&zn, "sensors/humidity", &humidity);
+
+    // Each resource caches its own subscriptions, declaring one leaves the others cached
+    declare_resource(&zn, 1, "sensors/temp");
+    assert(sample_on(&zn, 1) == _Z_RES_OK);
+    _z_subscription_cache_rc_t cache = resource(&zn, 1)->_subscriptions;
+    declare_resource(&zn, 2, "sensors/humidity");
+    assert(resource(&zn, 1)->_subscriptions.in == cache.in);
+    assert(resource(&zn, 2)->_subscriptions.in == NULL);
+    assert(sample_on(&zn, 2) == _Z_RES_OK);
+    assert((temp.count == 1) && (humidity.count == 1));
+
+    // An undeclared resource takes its cache along, a new resource with the same id does not reuse it
+    _z_unregister_resource(&zn, 1, _Z_KEYEXPR_MAPPING_UNKNOWN_REMOTE);
+    assert(resource(&zn, 1) == NULL);
+    assert(sample_on(&zn, 1) == _Z_ERR_KEYEXPR_UNKNOWN);
+    declare_resource(&zn, 1, "sensors/humidity");
+    assert(resource(&zn, 1)->_subscriptions.in == NULL);
+    assert(sample_on(&zn, 1) == _Z_RES_OK);
+    assert((temp.count == 1) && (humidity.count == 2));
+
+    // A resource matching no subscription caches an empty array
+    declare_resource(&zn, 3, "actuators/fan");
+    assert(sample_on(&zn, 3) == _Z_RES_OK);
+    assert(_z_subscription_rc_array_len(&resource(&zn, 3)->_subscriptions.in->val) == 0);
+    assert((temp.count == 1) && (humidity.count == 2));
+
+    session_clear(&zn);
+    assert((temp.dropped == 1) && (humidity.dropped == 1));
+}
+
+int main(void) {
+    cache_test();
+    resource_test();
+    return 0;
+}
+#else
+int main(void) {
+    printf("ERROR: Zenoh pico was compiled without Z_FEATURE_SUBSCRIPTION but this test requires it.\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,331 @@
+//
+// Copyright (c) 2022 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico/net/session.h"
+#include "zenoh-pico/protocol/codec/network.h"
+#include "zenoh-pico/protocol/codec/transport.h"
+#include "zenoh-pico/protocol/definitions/network.h"
+#include "zenoh-pico/system/platform.h"
+#include "zenoh-pico/transport/unicast/tx.h"
+#include "zenoh-pico/transport/utils.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_FEATURE_TX_QUEUE == 1 && Z_FEATURE_UNICAST_TRANSPORT == 1
+#define MTU 1024
+#define MAX_SENT 64
+
+// The network messages written on the link, in the order they were sent
+typedef struct {
+    uint8_t tag;
+    int decl;   // The declaration tag of declarations, -1 otherwise
+    size_t id;  // The entity id of declarations, the payload of pushes
+    z_reliability_t reliability;
+    _z_zint_t sn;
+} sent_t;
+
+static sent_t sent[MAX_SENT];
+static size_t sent_len;
+
+size_t link_write(const _z_link_t *link, const uint8_t *ptr, size_t len) {
+    (void)(link);
+    _z_zbuf_t zbf = _z_zbytes_as_zbuf(_z_bytes_wrap(ptr, len));
+
+    _z_transport_message_t t_msg;
+    assert(_z_transport_message_decode(&t_msg, &zbf) == _Z_RES_OK);
+    assert(_Z_MID(t_msg._header) == _Z_MID_T_FRAME);
+    z_reliability_t reliability =
+        _Z_HAS_FLAG(t_msg._header, _Z_FLAG_T_FRAME_R) ? Z_RELIABILITY_RELIABLE : Z_RELIABILITY_BEST_EFFORT;
+    _z_network_message_vec_t *msgs = &t_msg._body._frame._messages;
+    for (size_t i = 0; i < _z_network_message_vec_len(msgs); i++) {
+        _z_network_message_t *n_msg = _z_network_message_vec_get(msgs, i);
+        assert(sent_len < MAX_SENT);
+        sent_t *s = &sent[sent_len++];
+        s->tag = (uint8_t)n_msg->_tag;
+        s->decl = -1;
+        s->id = 0;
+        s->reliability = reliability;
+        s->sn = t_msg._body._frame._sn;
+        if (n_msg->_tag == _Z_N_DECLARE) {
+            _z_declaration_t *decl = &n_msg->_body._declare._decl;
+            s->decl = (int)decl->_tag;
+            s->id = (decl->_tag == _Z_DECL_SUBSCRIBER) ? decl->_body._decl_subscriber._id
+                                                       : decl->_body._undecl_subscriber._id;
+        } else if (n_msg->_tag == _Z_N_PUSH) {
+            s->id = n_msg->_body._push._body._body._put._payload.start[0];
+        }
+    }
+
+    _z_t_msg_clear(&t_msg);
+    return len;
+}
+
+// The transport only has what the TX path needs, with a datagram link recording what it writes
+void session_init(_z_session_t *zn) {
+    (void)memset(zn, 0, sizeof(_z_session_t));
+    zn->_tp._type = _Z_TRANSPORT_UNICAST_TYPE;
+    _z_transport_unicast_t *ztu = &zn->_tp._transport._unicast;
+    ztu->_session = zn;
+    ztu->_link._cap._flow = Z_LINK_CAP_FLOW_DATAGRAM;
+    ztu->_link._mtu = MTU;
+    ztu->_link._write_f = link_write;
+    ztu->_wbuf = _z_wbuf_make(MTU, false);
+    ztu->_sn_res = _z_sn_max(Z_SN_RESOLUTION);
+    assert(zp_mutex_init(&ztu->_mutex_tx) == _Z_RES_OK);
+#if Z_FEATURE_BATCHING == 1
+    ztu->_batch_armed = false;
+#endif
+    sent_len = 0;
+}
+
+void session_clear(_z_session_t *zn) {
+    _z_transport_unicast_t *ztu = &zn->_tp._transport._unicast;
+    _z_unicast_tx_queue_clear(ztu);
+    zp_mutex_free(&ztu->_mutex_tx);
+    _z_wbuf_clear(&ztu->_wbuf);
+}
+
+_z_network_message_t push(z_priority_t priority, const uint8_t *payload, size_t len) {
+    _z_network_message_t n_msg = {
+        ._tag = _Z_N_PUSH,
+        ._body._push =
+            {
+                ._key = _z_rid_with_suffix(1, NULL),
+                ._qos = _z_n_qos_make(0, 1, priority),
+                ._timestamp = _z_timestamp_null(),
+                ._body._is_put = true,
+                ._body._body._put =
+                    {
+                        ._commons = {._timestamp = _z_timestamp_null(), ._source_info = _z_source_info_null()},
+                        ._payload = _z_bytes_wrap(payload, len),
+                    },
+            },
+    };
+    return n_msg;
+}
+
+int8_t send_push(_z_session_t *zn, z_priority_t priority, uint8_t value) {
+    uint8_t payload[1] = {value};
+    _z_network_message_t n_msg = push(priority, payload, sizeof(payload));
+    return _z_unicast_send_n_msg(zn, &n_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK);
+}
+
+int8_t send_declare(_z_session_t *zn, _z_declaration_t decl) {
+    _z_network_message_t n_msg = _z_n_msg_make_declare(decl);
+    int8_t ret = _z_unicast_send_n_msg(zn, &n_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK);
+    _z_n_msg_clear(&n_msg);
+    return ret;
+}
+
+void assert_sent(size_t i, uint8_t tag, int decl, size_t id) {
+    assert(i < sent_len);
+    assert(sent[i].tag == tag);
+    assert(sent[i].decl == decl);
+    assert(sent[i].id == id);
+}
+
+void priority_test(void) {
+    printf("Test: scheduling by priority\n");
+    _z_session_t zn;
+    session_init(&zn);
+    _z_transport_unicast_t *ztu = &zn._tp._transport._unicast;
+    zp_task_t *task = (zp_task_t *)zp_malloc(sizeof(zp_task_t));
+    assert(_zp_unicast_start_tx_task(ztu, NULL, task) == _Z_RES_OK);
+
+    // Hold the TX task back until all the messages are queued
+    zp_mutex_lock(&ztu->_mutex_tx);
+    assert(send_push(&zn, Z_PRIORITY_DATA, 1) == _Z_RES_OK);
+    _z_keyexpr_t key = _z_rid_with_suffix(1, NULL);
+    assert(send_declare(&zn, _z_make_decl_subscriber(&key, 7, true, false)) == _Z_RES_OK);
+    assert(send_push(&zn, Z_PRIORITY_REAL_TIME, 2) == _Z_RES_OK);
+    assert(send_push(&zn, Z_PRIORITY_DATA, 3) == _Z_RES_OK);
+    assert(send_declare(&zn, _z_make_undecl_subscriber(7, &key)) == _Z_RES_OK);
+    assert(send_push(&zn, Z_PRIORITY_INTERACTIVE_HIGH, 4) == _Z_RES_OK);
+    zp_mutex_unlock(&ztu->_mutex_tx);
+    assert(_zp_unicast_stop_tx_task(ztu) == _Z_RES_OK);
+
+    // Declarations overtake the messages queued before them, in the higher class, and stay in order with each other
+    assert(sent_len == 6);
+    assert_sent(0, _Z_N_DECLARE, _Z_DECL_SUBSCRIBER, 7);
+    assert_sent(1, _Z_N_PUSH, -1, 2);
+    assert_sent(2, _Z_N_DECLARE, _Z_UNDECL_SUBSCRIBER, 7);
+    assert_sent(3, _Z_N_PUSH, -1, 4);
+    assert_sent(4, _Z_N_PUSH, -1, 1);
+    assert_sent(5, _Z_N_PUSH, -1, 3);
+
+    session_clear(&zn);
+}
+
+// Publishes a push in a slot claimed by the test, as the producers do
+void publish(_z_transport_unicast_t *ztu, size_t c, size_t slot, uint8_t value) {
+    uint8_t payload[1] = {value};
+    _z_network_message_t n_msg = push(Z_PRIORITY_BACKGROUND, payload, sizeof(payload));
+    _z_tx_queue_entry_t *entry = &ztu->_tx_queue_entries[(c * (size_t)Z_TX_QUEUE_SIZE) + slot];
+    entry->_reliability = Z_RELIABILITY_RELIABLE;
+    assert(_z_network_message_encode(&entry->_wbuf, &n_msg) == _Z_RES_OK);
+    if (_z_mpsc_publish(&ztu->_tx_queues[c], slot) == true) {
+        zp_mutex_lock(&ztu->_mutex_tx_queue);
+        zp_condvar_signal(&ztu->_cond_tx_ready);
+        zp_condvar_signal(&ztu->_cond_tx_claims);
+        zp_mutex_unlock(&ztu->_mutex_tx_queue);
+    }
+}
+
+static volatile _Bool stopped;
+
+void *stop_task(void *arg) {
+    assert(_zp_unicast_stop_tx_task((_z_transport_unicast_t *)arg) == _Z_RES_OK);
+    stopped = true;
+    return NULL;
+}
+
+void stop_test(void) {
+    printf("Test: stopping the TX task\n");
+    _z_session_t zn;
+    session_init(&zn);
+    _z_transport_unicast_t *ztu = &zn._tp._transport._unicast;
+    zp_task_t *task = (zp_task_t *)zp_malloc(sizeof(zp_task_t));
+    assert(_zp_unicast_start_tx_task(ztu, NULL, task) == _Z_RES_OK);
+
+    // A producer claims a slot, background messages going to the last class, then the TX task is stopped
+    size_t c = (size_t)Z_TX_QUEUE_PRIORITIES - 1;
+    size_t slot = _z_mpsc_claim(&ztu->_tx_queues[c]);
+    assert(slot != SIZE_MAX);
+    stopped = false;
+    zp_task_t stopper;
+    assert(zp_task_init(&stopper, NULL, stop_task, ztu) == _Z_RES_OK);
+    zp_sleep_ms(100);
+    // The queue is closed, but the drain waits for the message being queued
+    assert(stopped == false);
+    assert(_z_mpsc_is_closed(&ztu->_tx_queues[c]) == true);
+    publish(ztu, c, slot, 1);
+    zp_task_join(&stopper);
+    assert(stopped == true);
+    assert(sent_len == 1);
+    assert_sent(0, _Z_N_PUSH, -1, 1);
+
+    // Once stopped, the messages are sent by their producer, none is left in the queues
+    assert(send_push(&zn, Z_PRIORITY_BACKGROUND, 2) == _Z_RES_OK);
+    assert(sent_len == 2);
+    assert_sent(1, _Z_N_PUSH, -1, 2);
+    for (size_t i = 0; i < (size_t)Z_TX_QUEUE_PRIORITIES; i++) {
+        assert(_z_mpsc_is_empty(&ztu->_tx_queues[i]) == true);
+    }
+
+    // Restarted, the TX task sends the messages again
+    task = (zp_task_t *)zp_malloc(sizeof(zp_task_t));
+    assert(_zp_unicast_start_tx_task(ztu, NULL, task) == _Z_RES_OK);
+    assert(send_push(&zn, Z_PRIORITY_BACKGROUND, 3) == _Z_RES_OK);
+    assert(_zp_unicast_stop_tx_task(ztu) == _Z_RES_OK);
+    assert(sent_len == 3);
+    assert_sent(2, _Z_N_PUSH, -1, 3);
+
+    session_clear(&zn);
+}
+
+void *send_task(void *arg) {
+    assert(send_push((_z_session_t *)arg, Z_PRIORITY_BACKGROUND, 3) == _Z_RES_OK);
+    return NULL;
+}
+
+void closed_test(void) {
+    printf("Test: sending from the producer once the queues closed\n");
+    _z_session_t zn;
+    session_init(&zn);
+    _z_transport_unicast_t *ztu = &zn._tp._transport._unicast;
+    zp_task_t *task = (zp_task_t *)zp_malloc(sizeof(zp_task_t));
+    assert(_zp_unicast_start_tx_task(ztu, NULL, task) == _Z_RES_OK);
+
+    // A producer claims a slot, and another message is queued behind it
+    size_t c = (size_t)Z_TX_QUEUE_PRIORITIES - 1;
+    size_t slot = _z_mpsc_claim(&ztu->_tx_queues[c]);
+    assert(slot != SIZE_MAX);
+    assert(send_push(&zn, Z_PRIORITY_BACKGROUND, 2) == _Z_RES_OK);
+
+    // The queues close as the TX task stops, a producer sending its message itself waits for the queued ones
+    for (size_t i = 0; i < (size_t)Z_TX_QUEUE_PRIORITIES; i++) {
+        _z_mpsc_close(&ztu->_tx_queues[i]);
+    }
+    ztu->_tx_task_running = false;
+    zp_task_t sender;
+    assert(zp_task_init(&sender, NULL, send_task, &zn) == _Z_RES_OK);
+    zp_sleep_ms(100);
+    assert(sent_len == 0);
+    publish(ztu, c, slot, 1);
+    zp_task_join(&sender);
+    assert(sent_len == 3);
+    assert_sent(0, _Z_N_PUSH, -1, 1);
+    assert_sent(1, _Z_N_PUSH, -1, 2);
+    assert_sent(2, _Z_N_PUSH, -1, 3);
+
+    assert(_zp_unicast_stop_tx_task(ztu) == _Z_RES_OK);
+    assert(sent_len == 3);
+    session_clear(&zn);
+}
+
+#if Z_FEATURE_FRAGMENTATION == 0
+void oversize_test(void) {
+    printf("Test: dropping oversize messages without fragmentation\n");
+    _z_session_t zn;
+    session_init(&zn);
+    _z_transport_unicast_t *ztu = &zn._tp._transport._unicast;
+    uint8_t payload[2 * MTU];
+    (void)memset(payload, 0, sizeof(payload));
+    _z_network_message_t n_msg = push(Z_PRIORITY_DATA, payload, sizeof(payload));
+
+    // Sent by the producer, the dropped message takes no sequence number
+    assert(_z_unicast_send_n_msg(&zn, &n_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK) != _Z_RES_OK);
+    assert(send_push(&zn, Z_PRIORITY_DATA, 1) == _Z_RES_OK);
+    assert(sent_len == 1);
+    assert(sent[0].sn == 0);
+
+    // Nor does it when queued
+    zp_task_t *task = (zp_task_t *)zp_malloc(sizeof(zp_task_t));
+    assert(_zp_unicast_start_tx_task(ztu, NULL, task) == _Z_RES_OK);
+    zp_mutex_lock(&ztu->_mutex_tx);
+    (void)_z_unicast_send_n_msg(&zn, &n_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK);
+    assert(send_push(&zn, Z_PRIORITY_DATA, 2) == _Z_RES_OK);
+    zp_mutex_unlock(&ztu->_mutex_tx);
+    assert(_zp_unicast_stop_tx_task(ztu) == _Z_RES_OK);
+    assert(sent_len == 2);
+    assert(sent[1].sn == 1);
+
+    session_clear(&zn);
+}
+#endif
+
+int main(void) {
+#if Z_TX_QUEUE_PRIORITIES > 1
+    priority_test();
+#endif
+    stop_test();
+    closed_test();
+#if Z_FEATURE_FRAGMENTATION == 0
+    oversize_test();
+#endif
+    return 0;
+}
+#else
+int main(void) {
+    printf("ERROR: Zenoh pico was compiled without Z_FEATURE_TX_QUEUE but this test requires it.\n");
+    return 0;
+}
+#endif